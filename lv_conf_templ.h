@@ -44,10 +44,24 @@
 #define LV_VDB_SIZE         (20 * 1024)  /*Size of VDB in pixel count*/
 #define LV_VDB_ADR          0            /*Place VDB to a specific address (e.g. in external RAM) (0: allocate automatically  into RAM)*/
 
-/* Use two Virtual Display buffers (VDB) parallelize rendering and flushing (optional)
- * The flushing should use DMA to write the frame buffer in the background*/
-#define LV_VDB_DOUBLE       0       /*1: Enable the use of 2 VDBs*/
+/* Use more Virtual Display buffers (VDB) to parallelize rendering and flushing (optional)
+ * The VDBs are flushed in order. While one is flushing the next ones can be rendered.
+ * The flushing should use DMA or an other thread to write the frame buffer in the background*/
+#define LV_VDB_NUM          1       /*Number of VDBs in the flush ring (1: single VDB, 2: double VDB ...)*/
 #define LV_VDB2_ADR         0       /*Place VDB2 to a specific address (e.g. in external RAM) (0: allocate automatically into RAM)*/
+#define LV_VDB_FLUSH_COND   0       /*1: Sleep on a POSIX condition variable until 'lv_flush_ready()' instead of busy-waiting*/
+
+/* Render directly into the full screen frame buffers of the display driver instead of a VDB (optional)
+ * The driver gives a frame buffer and its age with 'disp_get_fb' and shows it with 'disp_flip'.
+ * Only the areas changed since the buffer was shown are redrawn.
+ * LV_VDB_SIZE has to be non-zero (but no VDB is allocated) and LV_ANTIALIAS has to be 0*/
+#define LV_VDB_DIRECT           0   /*1: Enable direct frame buffer rendering*/
+#define LV_VDB_DIRECT_AGE_MAX   3   /*Max. handled frame buffer age (>= 2). Older buffers are fully redrawn*/
+
+/* Render the VDB bands of an area in parallel on worker threads (optional, requires POSIX threads)
+ * Every worker has its own VDB (LV_VDB_SIZE each) and the bands are flushed in order*/
+#define LV_REFR_THREAD_CNT  0       /*Number of rendering worker threads (0: render on the caller thread)*/
+/*#define LV_REFR_THREAD_ERROR(id, err) my_log_error(id, err)*/   /*Called if a worker can't be started (default: nothing)*/
 
 /* Enable anti-aliasing
  * If enabled everything will be rendered in double size and filtered to normal size.
@@ -59,9 +73,29 @@
  * Much faster then normal anti-aliasing  */
 #define LV_FONT_ANTIALIAS   0       /*1: Enable font anti-aliasing*/
 
+/* Anti-alias the rounded corners of the rectangles (body and border) analytically if LV_ANTIALIAS is 0
+ * The coverage of the edge pixels is computed so the corners are smooth without double size rendering*/
+#define LV_RECT_AA          1       /*1: Enable anti-aliased corners*/
+
+/* Anti-alias the edges of the lines (line, chart, gauge needle) analytically if LV_ANTIALIAS is 0
+ * The coverage of the edge pixels is computed from their distance to the line*/
+#define LV_LINE_AA          1       /*1: Enable anti-aliased lines*/
+
+/* Anti-alias the edges of the filled polygons (area chart) if LV_ANTIALIAS is 0
+ * The coverage of the edge pixels is averaged from a few sub-rows*/
+#define LV_POLYGON_AA       1       /*1: Enable anti-aliased polygons*/
+
 /*Screen refresh settings*/
 #define LV_REFR_PERIOD      50    /*Screen refresh period in milliseconds*/
-#define LV_INV_FIFO_SIZE    32    /*The average count of objects on a screen */
+#define LV_INV_FIFO_SIZE    32    /*Max. number of separately stored invalid areas (more areas are joined to the stored ones)*/
+#define LV_REFR_DRAW_LIST_SIZE  128 /*Max. number of drawings collected once for an area which is drawn in more VDB bands (0: walk the objects in every band)*/
+#define LV_OBJ_CACHE_SIZE   0     /*Memory for the drawings of the objects with 'cache' attribute in bytes. Allocated with 'lv_mem_alloc' (0: disable the caching, requires LV_VDB_SIZE != 0)*/
+#define LV_CORNER_CACHE_SIZE (4 * 1024) /*Memory for the precomputed corner and shadow masks of the rectangles in bytes. Allocated with 'lv_mem_alloc' (0: compute them on every drawing)*/
+#define LV_GRAD_CACHE_NUM   4     /*Number of cached gradients (the colors of the rows of a gradient body). Allocated with 'lv_mem_alloc' (0: mix them for every rectangle)*/
+#define LV_GRAD_DITHER      0     /*1: Dither the rows of the gradients with LV_COLOR_DEPTH 16 to avoid visible bands*/
+#define LV_IMG_CACHE_SIZE   0     /*Memory for the headers and the pixels of the image files in bytes. Allocated with 'lv_mem_alloc' (0: read the files on every drawing)*/
+#define LV_REFR_STAT_NUM    0     /*Keep the statistics of the last N refreshed frames (0: disable the statistics, see 'lv_refr_get_stat')*/
+/*#define LV_REFR_STAT_TIME() my_us_counter()*/   /*Time source of the statistics: a free running counter (default: 'lv_tick_get()' in ms)*/
 
 /*=================
    Misc. setting
@@ -88,7 +122,11 @@
 #define USE_LV_SHADOW           1               /*1: Enable shadows*/
 #define USE_LV_GROUP            1               /*1: Enable object groups (for keyboards)*/
 #define USE_LV_GPU              1               /*1: Enable GPU interface*/
+#define USE_LV_SIMD             1               /*1: Use SIMD (SSE2/AVX2/NEON) drawing kernels if the CPU supports them (detected at runtime)*/
 #define USE_LV_FILESYSTEM       1               /*1: Enable file system (required by images*/
+#define USE_LV_FS_POSIX         0               /*1: Register a read only driver for POSIX systems which maps the files into the memory (images drawn without copying)*/
+#define LV_FS_POSIX_LETTER      'P'             /*Driver letter of the POSIX files (e.g. "P:/usr/share/img.bin")*/
+#define LV_FS_POSIX_ROOT        "/"             /*The paths of the driver are relative to this directory*/
 
 /*================
  *  THEME USAGE
@@ -216,18 +216,38 @@ void lv_group_set_style_mod_cb(lv_group_t * group, void (*style_cb)(lv_style_t *
 
 /**
  * Modify a style with the set 'style_mod' function. The input style remains unchanged.
+ * Every rendering thread gets its own copy. It is valid until the thread calls this function again.
  * @param group pointer to group
  * @param style pointer to a style to modify
  * @return a copy of the input style but modified with the 'style_mod' function
  */
 lv_style_t * lv_group_mod_style(lv_group_t * group, const lv_style_t * style)
 {
-    lv_style_copy(&group->style_tmp, style);
+    lv_style_t * style_res = &group->style_tmp;
 
-    if(group->style_mod != NULL) group->style_mod(&group->style_tmp);
-    else style_mod_def(&group->style_tmp);
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_CNT != 0
+    /*The focused object can be drawn parallel on more threads*/
+    int16_t worker_id = lv_vdb_get_worker_id();
+    if(worker_id >= 0) style_res = &group->style_tmp_worker[worker_id];
+#endif
 
-    return &group->style_tmp;
+    lv_group_mod_style_copy(group, style, style_res);
+
+    return style_res;
+}
+
+/**
+ * Modify a copy of a style with the set 'style_mod' function. The input style remains unchanged.
+ * @param group pointer to group
+ * @param style pointer to a style to modify
+ * @param style_res pointer to a style (e.g. a local variable) to store the modified copy
+ */
+void lv_group_mod_style_copy(lv_group_t * group, const lv_style_t * style, lv_style_t * style_res)
+{
+    lv_style_copy(style_res, style);
+
+    if(group->style_mod != NULL) group->style_mod(style_res);
+    else style_mod_def(style_res);
 }
 
 /**
@@ -15,6 +15,7 @@ extern "C" {
  *********************/
 #include "../../lv_conf.h"
 #include "lv_obj.h"
+#include "lv_vdb.h"
 
 /*********************
  *      DEFINES
@@ -40,6 +41,9 @@ typedef struct _lv_group_t
     lv_obj_t ** obj_focus;
     void (*style_mod)(lv_style_t * style);
     lv_style_t style_tmp;
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_CNT != 0
+    lv_style_t style_tmp_worker[LV_REFR_THREAD_CNT];    /*'style_tmp' of the rendering worker threads*/
+#endif
     uint8_t frozen:1;
 }lv_group_t;
 
@@ -108,12 +112,21 @@ void lv_group_set_style_mod_cb(lv_group_t * group, void (*style_cb)(lv_style_t *
 
 /**
  * Modify a style with the set 'style_mod' function. The input style remains unchanged.
+ * Every rendering thread gets its own copy. It is valid until the thread calls this function again.
  * @param group pointer to group
  * @param style pointer to a style to modify
  * @return a copy of the input style but modified with the 'style_mod' function
  */
 lv_style_t * lv_group_mod_style(lv_group_t * group, const lv_style_t * style);
 
+/**
+ * Modify a copy of a style with the set 'style_mod' function. The input style remains unchanged.
+ * @param group pointer to group
+ * @param style pointer to a style to modify
+ * @param style_res pointer to a style (e.g. a local variable) to store the modified copy
+ */
+void lv_group_mod_style_copy(lv_group_t * group, const lv_style_t * style, lv_style_t * style_res);
+
 /**
  * Get the focused object or NULL if there isn't one
  * @param group pointer to a group
@@ -13,10 +13,15 @@
 #include "../lv_themes/lv_theme.h"
 #include "../lv_draw/lv_draw.h"
 #include "../lv_draw/lv_draw_rbasic.h"
+#include "../lv_draw/lv_draw_simd.h"
+#include "../lv_draw/lv_draw_corner.h"
+#include "../lv_draw/lv_draw_img_cache.h"
 #include "../lv_misc/lv_anim.h"
 #include "../lv_misc/lv_task.h"
 #include "../lv_misc/lv_fs.h"
 #include "../lv_misc/lv_ufs.h"
+#include "../lv_misc/lv_fs_posix.h"
+#include "../lv_misc/lv_math.h"
 #include <stdint.h>
 #include <string.h>
 
@@ -34,6 +39,8 @@
  *  STATIC PROTOTYPES
  **********************/
 static void refresh_childen_position(lv_obj_t * obj, lv_coord_t x_diff, lv_coord_t y_diff);
+static bool blit_move(lv_obj_t * obj, lv_coord_t x_diff, lv_coord_t y_diff);
+static void blit_inv_overlay(const lv_area_t * ov_p, const lv_area_t * area_p, lv_coord_t x_diff, lv_coord_t y_diff);
 static void report_style_mod_core(void * style_p, lv_obj_t * obj);
 static void refresh_childen_style(lv_obj_t * obj);
 static void delete_children(lv_obj_t * obj);
@@ -69,6 +76,9 @@ void lv_init(void)
 #if USE_LV_FILESYSTEM
     lv_fs_init();
     lv_ufs_init();
+#if USE_LV_FS_POSIX
+    lv_fs_posix_init();
+#endif
 #endif
 
     lv_font_init();
@@ -76,6 +86,17 @@ void lv_init(void)
     lv_anim_init();
 #endif
 
+    /*Select the drawing kernels by the CPU features*/
+    lv_simd_init();
+
+    /*Init. the cache of the rectangle masks*/
+    lv_draw_corner_init();
+
+#if USE_LV_FILESYSTEM
+    /*Init. the cache of the images*/
+    lv_draw_img_cache_init();
+#endif
+
     /*Init. the sstyles*/
     lv_style_init();
     
@@ -161,6 +182,8 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, lv_obj_t * copy)
 		new_obj->drag_parent = 0;
 		new_obj->hidden = 0;
 		new_obj->top = 0;
+		new_obj->cache = 0;
+		new_obj->blit = 0;
         new_obj->protect = LV_PROTECT_NONE;
 
 		new_obj->ext_attr = NULL;
@@ -207,6 +230,8 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, lv_obj_t * copy)
         new_obj->drag_parent = 0;
         new_obj->hidden = 0;
         new_obj->top = 0;
+        new_obj->cache = 0;
+        new_obj->blit = 0;
         new_obj->protect = LV_PROTECT_NONE;
         
         new_obj->ext_attr = NULL;
@@ -230,6 +255,8 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, lv_obj_t * copy)
         new_obj->drag_parent = copy->drag_parent;
         new_obj->hidden = copy->hidden;
         new_obj->top = copy->top;
+        new_obj->cache = copy->cache;
+        new_obj->blit = copy->blit;
         new_obj->protect = copy->protect;
 
         new_obj->style_p = copy->style_p;
@@ -314,6 +341,9 @@ lv_res_t lv_obj_del(lv_obj_t * obj)
      * Now clean up the object specific data*/
     obj->signal_func(obj, LV_SIGNAL_CLEANUP, NULL);
 
+    /*Free the cached drawing*/
+    if(obj->cache != 0) lv_refr_cache_del(obj);
+
     /*Delete the base objects*/
     if(obj->ext_attr != NULL)  lv_mem_free(obj->ext_attr);
     lv_mem_free(obj); /*Free the object itself*/
@@ -346,25 +376,51 @@ void lv_obj_clean(lv_obj_t *obj)
  */
 void lv_obj_invalidate(lv_obj_t * obj)
 {
-    /*Invalidate the object only if it belongs to the 'act_scr'*/
+    /*Invalidate the whole object with its extended area*/
+    lv_area_t area;
+    lv_coord_t ext_size = obj->ext_size;
+    lv_area_copy(&area, &obj->coords);
+    area.x1 -= ext_size;
+    area.y1 -= ext_size;
+    area.x2 += ext_size;
+    area.y2 += ext_size;
+
+    lv_obj_invalidate_area(obj, &area);
+}
+
+/**
+ * Mark an area of an object as invalid therefore only this area will be redrawn by 'lv_refr_task'
+ * @param obj pointer to an object
+ * @param area the area to redraw in absolute coordinates (truncated to the object and its parents)
+ */
+void lv_obj_invalidate_area(lv_obj_t * obj, const lv_area_t * area)
+{
+    /*The cached drawing of the object and its parents is not valid anymore*/
+    lv_obj_t * cache_p = obj;
+    while(cache_p != NULL) {
+        if(cache_p->cache != 0) lv_refr_cache_invalidate(cache_p);
+        cache_p = lv_obj_get_parent(cache_p);
+    }
+
+    /*Invalidate the area only if the object belongs to the 'act_scr'*/
     lv_obj_t * obj_scr = lv_obj_get_screen(obj);
     if(obj_scr == lv_scr_act() ||
        obj_scr == lv_layer_top() ||
        obj_scr == lv_layer_sys()) {
-        /*Truncate recursively to the parents*/
+        /*Truncate to the object's extended area*/
         lv_area_t area_trunc;
-        lv_obj_t * par = lv_obj_get_parent(obj);
-        bool union_ok = true;
-        /*Start with the original coordinates*/
+        lv_area_t obj_area;
         lv_coord_t ext_size = obj->ext_size;
-        lv_area_copy(&area_trunc, &obj->coords);
-        area_trunc.x1 -= ext_size;
-        area_trunc.y1 -= ext_size;
-        area_trunc.x2 += ext_size;
-        area_trunc.y2 += ext_size;
-
-        /*Check through all parents*/
-        while(par != NULL) {
+        lv_area_copy(&obj_area, &obj->coords);
+        obj_area.x1 -= ext_size;
+        obj_area.y1 -= ext_size;
+        obj_area.x2 += ext_size;
+        obj_area.y2 += ext_size;
+        bool union_ok = lv_area_union(&area_trunc, area, &obj_area);
+
+        /*Truncate recursively to the parents*/
+        lv_obj_t * par = lv_obj_get_parent(obj);
+        while(par != NULL && union_ok != false) {
             union_ok = lv_area_union(&area_trunc, &area_trunc, &par->coords);
             if(union_ok == false) break; /*If no common parts with parent break;*/
 
@@ -375,7 +431,6 @@ void lv_obj_invalidate(lv_obj_t * obj)
     }
 }
 
-
 /*=====================
  * Setter functions 
  *====================*/
@@ -453,9 +508,11 @@ void lv_obj_set_pos(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     /* It is very important else recursive positioning can
      * occur without position change*/
     if(diff.x == 0 && diff.y == 0) return;
-        
-    /*Invalidate the original area*/
-    lv_obj_invalidate(obj);
+
+    /*Move the drawn pixels if possible else invalidate the original area*/
+    bool blit = false;
+    if(obj->blit != 0) blit = blit_move(obj, diff.x, diff.y);
+    if(blit == false) lv_obj_invalidate(obj);
 
     /*Save the original coordinates*/
     lv_area_t ori;
@@ -475,7 +532,7 @@ void lv_obj_set_pos(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     par->signal_func(par, LV_SIGNAL_CHILD_CHG, obj);
     
     /*Invalidate the new area*/
-    lv_obj_invalidate(obj);
+    if(blit == false) lv_obj_invalidate(obj);
 }
 
 
@@ -782,6 +839,32 @@ void lv_obj_set_top(lv_obj_t * obj, bool en)
     obj->top = (en == true ? 1 : 0);
 }
 
+/**
+ * Draw the object and its children into a buffer once and copy the buffer
+ * while the object or its children are not invalidated.
+ * Only objects which fully cover their area can be cached. (See 'LV_OBJ_CACHE_SIZE')
+ * @param obj pointer to an object
+ * @param en true: enable the caching of the object
+ */
+void lv_obj_set_cache(lv_obj_t * obj, bool en)
+{
+    if(en == false) lv_refr_cache_del(obj);
+    obj->cache = (en == true ? 1 : 0);
+
+    lv_obj_invalidate(obj);
+}
+
+/**
+ * Move the drawn pixels of the object when it's moved (e.g. scrolled) and redraw only the exposed parts.
+ * Requires LV_VDB_DIRECT or 'disp_copy_area' in the display driver. Else the object is simply redrawn.
+ * @param obj pointer to an object
+ * @param en true: enable the pixel moving of the object
+ */
+void lv_obj_set_blit(lv_obj_t * obj, bool en)
+{
+    obj->blit = (en == true ? 1 : 0);
+}
+
 /**
  * Enable the dragging of an object
  * @param obj pointer to an object
@@ -1256,6 +1339,26 @@ bool lv_obj_get_top(lv_obj_t * obj)
     return obj->top == 0 ? false : true;
 }
 
+/**
+ * Get the cache attribute of an object
+ * @param obj pointer to an object
+ * @return true: the drawing of the object is cached
+ */
+bool lv_obj_get_cache(lv_obj_t * obj)
+{
+    return obj->cache == 0 ? false : true;
+}
+
+/**
+ * Get the blit attribute of an object
+ * @param obj pointer to an object
+ * @return true: the drawn pixels of the object are moved when it's moved
+ */
+bool lv_obj_get_blit(lv_obj_t * obj)
+{
+    return obj->blit == 0 ? false : true;
+}
+
 /**
  * Get the drag enable attribute of an object
  * @param obj pointer to an object
@@ -1477,6 +1580,172 @@ static void refresh_childen_position(lv_obj_t * obj, lv_coord_t x_diff, lv_coord
     }
 }
 
+/**
+ * Move the drawn pixels of an object instead of redrawing it (see 'lv_inv_scroll').
+ * Invalidate the parts which can't be copied and the objects drawn over it.
+ * Called before the object is moved.
+ * @param obj pointer to an object with 'blit' attribute
+ * @param x_diff horizontal movement
+ * @param y_diff vertical movement
+ * @return true: the pixels will be moved and the required areas are invalidated;
+ *         false: the object should be invalidated normally
+ */
+static bool blit_move(lv_obj_t * obj, lv_coord_t x_diff, lv_coord_t y_diff)
+{
+    lv_obj_t * par = lv_obj_get_parent(obj);
+    if(par == NULL || lv_obj_get_screen(obj) != lv_scr_act()) return false;
+
+    /*The pixels of a hidden or cached object are not on the screen as they are drawn*/
+    lv_obj_t * i;
+    for(i = obj; i != NULL; i = lv_obj_get_parent(i)) {
+        if(i->hidden != 0 || i->cache != 0) return false;
+    }
+
+    /* The parent's border can be drawn over the object so it is not in the moved area.
+     * The farther ancestors should not draw anything over it (plain objects).*/
+    lv_style_t * par_style = lv_obj_get_style(par);
+    lv_area_t vis_area;
+    lv_area_copy(&vis_area, &par->coords);
+    vis_area.x1 += par_style->body.border.width;
+    vis_area.y1 += par_style->body.border.width;
+    vis_area.x2 -= par_style->body.border.width;
+    vis_area.y2 -= par_style->body.border.width;
+    for(i = lv_obj_get_parent(par); i != NULL; i = lv_obj_get_parent(i)) {
+        if(i->design_func != lv_obj_design) return false;
+        if(lv_area_union(&vis_area, &vis_area, &i->coords) == false) return false;
+    }
+
+    /*The moved area: visible before and after the move and covered by the object*/
+    lv_area_t new_coords;
+    lv_area_copy(&new_coords, &obj->coords);
+    new_coords.x1 += x_diff;
+    new_coords.y1 += y_diff;
+    new_coords.x2 += x_diff;
+    new_coords.y2 += y_diff;
+
+    lv_area_t blit_area;
+    if(lv_area_union(&blit_area, &obj->coords, &vis_area) == false) return false;
+    if(lv_area_union(&blit_area, &blit_area, &new_coords) == false) return false;
+
+    /*The object has to cover the area (except its rounded corners)*/
+    lv_style_t * style = lv_obj_get_style(obj);
+    if(style->body.empty != 0 || style->body.opa != LV_OPA_COVER) return false;
+
+    if(lv_inv_scroll(&blit_area, x_diff, y_diff) == false) return false;
+
+    /*The background in the rounded corners was moved with the object. Redraw them.*/
+    lv_coord_t r = style->body.radius;
+    if(r == LV_RADIUS_CIRCLE) r = LV_MATH_MIN(lv_area_get_width(&new_coords), lv_area_get_height(&new_coords)) >> 1;
+    lv_area_t corner;
+    if(r > 0) {
+        lv_area_set(&corner, new_coords.x1, new_coords.y1, new_coords.x1 + r - 1, new_coords.y1 + r - 1);
+        if(lv_area_union(&corner, &corner, &blit_area) != false) lv_inv_area(&corner);
+        lv_area_set(&corner, new_coords.x2 - r + 1, new_coords.y1, new_coords.x2, new_coords.y1 + r - 1);
+        if(lv_area_union(&corner, &corner, &blit_area) != false) lv_inv_area(&corner);
+        lv_area_set(&corner, new_coords.x1, new_coords.y2 - r + 1, new_coords.x1 + r - 1, new_coords.y2);
+        if(lv_area_union(&corner, &corner, &blit_area) != false) lv_inv_area(&corner);
+        lv_area_set(&corner, new_coords.x2 - r + 1, new_coords.y2 - r + 1, new_coords.x2, new_coords.y2);
+        if(lv_area_union(&corner, &corner, &blit_area) != false) lv_inv_area(&corner);
+    }
+
+    /*Invalidate the other parts of the old and new areas (truncated to the parents)*/
+    lv_area_t old_area;
+    lv_area_copy(&old_area, &obj->coords);
+    old_area.x1 -= obj->ext_size;
+    old_area.y1 -= obj->ext_size;
+    old_area.x2 += obj->ext_size;
+    old_area.y2 += obj->ext_size;
+    lv_area_t new_area;
+    lv_area_copy(&new_area, &old_area);
+    new_area.x1 += x_diff;
+    new_area.y1 += y_diff;
+    new_area.x2 += x_diff;
+    new_area.y2 += y_diff;
+
+    bool old_ok = true;
+    bool new_ok = true;
+    for(i = par; i != NULL; i = lv_obj_get_parent(i)) {
+        if(old_ok) old_ok = lv_area_union(&old_area, &old_area, &i->coords);
+        if(new_ok) new_ok = lv_area_union(&new_area, &new_area, &i->coords);
+    }
+    lv_area_t parts[4];
+    uint8_t part_cnt = 0;
+    uint8_t p;
+    if(old_ok) part_cnt = lv_area_sub(parts, &old_area, &blit_area);
+    for(p = 0; p < part_cnt; p++) lv_inv_area(&parts[p]);
+
+    part_cnt = 0;
+    if(new_ok) part_cnt = lv_area_sub(parts, &new_area, &blit_area);
+    for(p = 0; p < part_cnt; p++) lv_inv_area(&parts[p]);
+
+    /*The rounded corners of the parent are drawn over the object too*/
+    r = par_style->body.radius;
+    if(r == LV_RADIUS_CIRCLE) r = LV_MATH_MIN(lv_obj_get_width(par), lv_obj_get_height(par)) >> 1;
+    if(r > par_style->body.border.width) {
+        lv_area_set(&corner, par->coords.x1, par->coords.y1, par->coords.x1 + r - 1, par->coords.y1 + r - 1);
+        blit_inv_overlay(&corner, &blit_area, x_diff, y_diff);
+        lv_area_set(&corner, par->coords.x2 - r + 1, par->coords.y1, par->coords.x2, par->coords.y1 + r - 1);
+        blit_inv_overlay(&corner, &blit_area, x_diff, y_diff);
+        lv_area_set(&corner, par->coords.x1, par->coords.y2 - r + 1, par->coords.x1 + r - 1, par->coords.y2);
+        blit_inv_overlay(&corner, &blit_area, x_diff, y_diff);
+        lv_area_set(&corner, par->coords.x2 - r + 1, par->coords.y2 - r + 1, par->coords.x2, par->coords.y2);
+        blit_inv_overlay(&corner, &blit_area, x_diff, y_diff);
+    }
+
+    /*The younger siblings of the object and its parents are drawn over it*/
+    lv_obj_t * child;
+    lv_area_t ov_area;
+    for(i = obj; lv_obj_get_parent(i) != NULL; i = lv_obj_get_parent(i)) {
+        child = lv_ll_get_prev(&lv_obj_get_parent(i)->child_ll, i);
+        while(child != NULL) {
+            lv_obj_get_coords(child, &ov_area);
+            ov_area.x1 -= child->ext_size;
+            ov_area.y1 -= child->ext_size;
+            ov_area.x2 += child->ext_size;
+            ov_area.y2 += child->ext_size;
+            blit_inv_overlay(&ov_area, &blit_area, x_diff, y_diff);
+            child = lv_ll_get_prev(&lv_obj_get_parent(i)->child_ll, child);
+        }
+    }
+
+    /*The objects on the top layers are drawn over it too*/
+    lv_obj_t * layers[2] = {lv_layer_top(), lv_layer_sys()};
+    uint8_t l;
+    for(l = 0; l < 2; l++) {
+        LL_READ(layers[l]->child_ll, child) {
+            lv_obj_get_coords(child, &ov_area);
+            ov_area.x1 -= child->ext_size;
+            ov_area.y1 -= child->ext_size;
+            ov_area.x2 += child->ext_size;
+            ov_area.y2 += child->ext_size;
+            blit_inv_overlay(&ov_area, &blit_area, x_diff, y_diff);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Invalidate an area drawn over a moved area. The overlay was moved with the pixels
+ * so invalidate it on its real position and on the moved position too.
+ * @param ov_p pointer to the area of the overlay
+ * @param area_p pointer to the moved area
+ * @param x_diff horizontal movement
+ * @param y_diff vertical movement
+ */
+static void blit_inv_overlay(const lv_area_t * ov_p, const lv_area_t * area_p, lv_coord_t x_diff, lv_coord_t y_diff)
+{
+    lv_area_t inv_area;
+    if(lv_area_union(&inv_area, ov_p, area_p) != false) lv_inv_area(&inv_area);
+
+    lv_area_copy(&inv_area, ov_p);
+    inv_area.x1 += x_diff;
+    inv_area.y1 += y_diff;
+    inv_area.x2 += x_diff;
+    inv_area.y2 += y_diff;
+    if(lv_area_union(&inv_area, &inv_area, area_p) != false) lv_inv_area(&inv_area);
+}
+
 /**
  * Refresh the style of all children of an object. (Called recursively)
  * @param style_p refresh objects only with this style. (ignore is if NULL)
@@ -1553,6 +1822,9 @@ static void delete_children(lv_obj_t * obj)
    /* Clean up the object specific data*/
    obj->signal_func(obj, LV_SIGNAL_CLEANUP, NULL);
 
+   /*Free the cached drawing*/
+   if(obj->cache != 0) lv_refr_cache_del(obj);
+
    /*Delete the base objects*/
    if(obj->ext_attr != NULL)  lv_mem_free(obj->ext_attr);
    lv_mem_free(obj); /*Free the object itself*/
@@ -125,7 +125,8 @@ typedef struct _lv_obj_t
     uint8_t drag_parent  :1;    /*1: Parent will be dragged instead*/
     uint8_t hidden       :1;    /*1: Object is hidden*/
     uint8_t top       :1;    /*1: If the object or its children is clicked it goes to the foreground*/
-    uint8_t reserved     :1;
+    uint8_t cache     :1;    /*1: Draw the object and its children into a buffer and copy it until they are invalidated*/
+    uint8_t blit      :1;    /*1: Move the drawn pixels when the object is moved instead of redrawing it*/
 
     uint8_t protect;            /*Automatically happening actions can be prevented. 'OR'ed values from lv_obj_prot_t*/
 
@@ -225,6 +226,13 @@ void lv_obj_clean(lv_obj_t *obj);
  */
 void lv_obj_invalidate(lv_obj_t * obj);
 
+/**
+ * Mark an area of an object as invalid therefore only this area will be redrawn by 'lv_refr_task'
+ * @param obj pointer to an object
+ * @param area the area to redraw in absolute coordinates (truncated to the object and its parents)
+ */
+void lv_obj_invalidate_area(lv_obj_t * obj, const lv_area_t * area);
+
 
 /*=====================
  * Setter functions
@@ -360,6 +368,23 @@ void lv_obj_set_click(lv_obj_t * obj, bool en);
  */
 void lv_obj_set_top(lv_obj_t * obj, bool en);
 
+/**
+ * Draw the object and its children into a buffer once and copy the buffer
+ * while the object or its children are not invalidated.
+ * Only objects which fully cover their area can be cached. (See 'LV_OBJ_CACHE_SIZE')
+ * @param obj pointer to an object
+ * @param en true: enable the caching of the object
+ */
+void lv_obj_set_cache(lv_obj_t * obj, bool en);
+
+/**
+ * Move the drawn pixels of the object when it's moved (e.g. scrolled) and redraw only the exposed parts.
+ * Requires LV_VDB_DIRECT or 'disp_copy_area' in the display driver. Else the object is simply redrawn.
+ * @param obj pointer to an object
+ * @param en true: enable the pixel moving of the object
+ */
+void lv_obj_set_blit(lv_obj_t * obj, bool en);
+
 /**
  * Enable the dragging of an object
  * @param obj pointer to an object
@@ -613,6 +638,20 @@ bool lv_obj_get_click(lv_obj_t * obj);
  */
 bool lv_obj_get_top(lv_obj_t * obj);
 
+/**
+ * Get the cache attribute of an object
+ * @param obj pointer to an object
+ * @return true: the drawing of the object is cached
+ */
+bool lv_obj_get_cache(lv_obj_t * obj);
+
+/**
+ * Get the blit attribute of an object
+ * @param obj pointer to an object
+ * @return true: the drawn pixels of the object are moved when it's moved
+ */
+bool lv_obj_get_blit(lv_obj_t * obj);
+
 /**
  * Get the drag enable attribute of an object
  * @param obj pointer to an object
@@ -13,47 +13,204 @@
 #include "../lv_hal/lv_hal_tick.h"
 #include "../lv_misc/lv_task.h"
 #include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_math.h"
+#include "../lv_hal/lv_hal_disp.h"
+#include "../lv_draw/lv_draw.h"
+
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_CNT != 0
+#include <pthread.h>
+#endif
 
 /*********************
  *      DEFINES
  *********************/
+/* Fix cost of refreshing an area (object tree traversal, flushing etc.) in pixels.
+ * Two invalid areas are joined if the joined area is not bigger then the two areas plus this cost*/
+#define LV_REFR_AREA_COST      (LV_HOR_RES)
+
+/*Collect the drawings of an area once and replay them in every VDB band*/
+#define LV_REFR_DRAW_LIST      (LV_VDB_SIZE != 0 && LV_VDB_DIRECT == 0 && LV_REFR_DRAW_LIST_SIZE != 0)
+
+/*Draw the objects with 'cache' attribute into buffers (the buffers are drawn like a VDB)*/
+#define LV_REFR_CACHE          (LV_VDB_SIZE != 0 && LV_OBJ_CACHE_SIZE != 0)
+
+/*Collect statistics about the refreshed frames*/
+#define LV_REFR_STAT           (LV_REFR_STAT_NUM != 0)
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_CNT != 0
 typedef struct
 {
-    lv_area_t area;
-    uint8_t joined;
-}lv_join_t;
+    pthread_t thread;
+    lv_area_t area;         /*The area to refresh. The band to draw is in the VDB of the worker*/
+    uint8_t id;
+    uint8_t busy :1;        /*1: a band is given to the worker and it's not ready yet*/
+}lv_refr_worker_t;
+#endif
+
+#if LV_REFR_DRAW_LIST
+typedef struct
+{
+    lv_obj_t * obj;
+    lv_area_t mask;             /*Mask of the drawing in the whole area. Reduced to the band when replayed*/
+    lv_design_mode_t mode;      /*LV_DESIGN_DRAW_MAIN or LV_DESIGN_DRAW_POST*/
+    uint8_t cache :1;           /*1: copy the object and its children from the cache ('mode' is not used)*/
+}lv_refr_draw_rec_t;
+#endif
+
+#if LV_REFR_CACHE
+typedef struct
+{
+    lv_obj_t * obj;
+    lv_area_t area;             /*Coordinates of the object when it was drawn into 'buf'*/
+    lv_color_t * buf;           /*The drawing of the object (in double size with LV_ANTIALIAS). NULL if freed*/
+    uint32_t buf_size;          /*Size of 'buf' in bytes*/
+    uint32_t last_use;          /*Value of 'cache_tick' when it was used last time (for LRU eviction)*/
+    uint16_t ref_cnt;           /*Number of drawings using 'buf'. It can't be evicted or redrawn meanwhile*/
+    uint8_t valid :1;           /*0: the object or its children are invalidated since it was drawn*/
+    uint8_t drawing :1;         /*1: 'buf' is being drawn, it can't be copied yet*/
+}lv_refr_cache_t;
+#endif
+
+#if LV_REFR_STAT
+/*Statistics collected by a thread while it draws a band. Added to the frame's statistics after the band*/
+typedef struct
+{
+    uint32_t draw_px;
+    uint32_t time_draw;
+    uint16_t design_other_cnt;
+    lv_refr_stat_design_t design[LV_REFR_STAT_DESIGN_NUM];
+}lv_refr_stat_band_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void lv_refr_task(void * param);
-static void lv_refr_join_area(void);
+static void lv_refr_inv_buf_add(const lv_area_t * area_p);
 static void lv_refr_areas(void);
 #if LV_VDB_SIZE == 0
 static void lv_refr_area_no_vdb(const lv_area_t * area_p);
 #else
+#if LV_VDB_DIRECT == 0
 static void lv_refr_area_with_vdb(const lv_area_t * area_p);
+#else
+static void lv_refr_damage_add(uint8_t age);
+#endif
 static void lv_refr_area_part_vdb(const lv_area_t * area_p);
+static void lv_refr_area_objs(const lv_area_t * mask_p);
+#if LV_REFR_DRAW_LIST
+static bool lv_refr_draw_list_build(const lv_area_t * area_p);
+static void lv_refr_draw_list_replay(const lv_area_t * mask_p);
+static void lv_refr_draw_list_add(lv_obj_t * obj, const lv_area_t * mask_p, lv_design_mode_t mode, bool cache);
+#endif
+#if LV_REFR_THREAD_CNT != 0
+static void lv_refr_area_with_workers(const lv_area_t * area_p, lv_coord_t max_row, lv_coord_t y2);
+static void * lv_refr_worker_task(void * param);
+#endif
+#endif
+static void lv_refr_scroll_get_src(lv_area_t * src_p);
+#if LV_VDB_SIZE == 0 || LV_VDB_DIRECT == 0
+static void lv_refr_scroll_exec(void);
+#else
+static void lv_refr_scroll_fb(lv_color_t * fb);
 #endif
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p);
 static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p);
+static void lv_refr_obj_draw(lv_obj_t * obj, const lv_area_t * mask_ori_p);
+static bool lv_refr_obj_clip_covered(lv_obj_t * obj, lv_area_t * mask_p);
+static void lv_refr_obj_design(lv_obj_t * obj, const lv_area_t * mask_p, lv_design_mode_t mode);
+static void lv_refr_design_call(lv_obj_t * obj, const lv_area_t * mask_p, lv_design_mode_t mode);
+#if LV_REFR_STAT
+static void lv_refr_stat_band_end(uint32_t start);
+#endif
+#if LV_REFR_CACHE
+static bool lv_refr_cache_usable(lv_obj_t * obj);
+static void lv_refr_cache_draw(lv_obj_t * obj, const lv_area_t * mask_p);
+static bool lv_refr_cache_alloc(lv_refr_cache_t * cache);
+static void lv_refr_cache_render(lv_refr_cache_t * cache);
+static void lv_refr_cache_draw_ext(lv_obj_t * obj, const lv_area_t * mask_p);
+static lv_refr_cache_t * lv_refr_cache_find(lv_obj_t * obj);
+static bool lv_refr_cache_evict(void);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
-static lv_join_t inv_buf[LV_INV_FIFO_SIZE];
+static lv_area_t inv_buf[LV_INV_FIFO_SIZE];
 static uint16_t inv_buf_p;
 static void (*monitor_cb)(uint32_t, uint32_t);
 static uint32_t px_num;
+static lv_area_t scroll_area;           /*The content of this area is moved at the next refresh...*/
+static lv_point_t scroll_diff;          /*...by this offset*/
+static bool scroll_pending;
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_CNT != 0
+static lv_refr_worker_t workers[LV_REFR_THREAD_CNT];
+static uint8_t worker_num;              /*Number of started workers (0: draw the bands on the caller thread)*/
+static pthread_mutex_t worker_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t worker_start_cond = PTHREAD_COND_INITIALIZER;  /*Signaled when bands are given to the workers*/
+static pthread_cond_t worker_ready_cond = PTHREAD_COND_INITIALIZER;  /*Signaled when every worker is ready*/
+static uint8_t worker_busy_cnt;
+#endif
+#if LV_VDB_SIZE != 0 && LV_VDB_DIRECT != 0
+static lv_area_t damage_hist[LV_VDB_DIRECT_AGE_MAX - 1][LV_INV_FIFO_SIZE];   /*Invalid areas of the previous frames*/
+static uint16_t damage_hist_cnt[LV_VDB_DIRECT_AGE_MAX - 1];
+static uint8_t damage_hist_act;         /*Index of the previous frame in 'damage_hist'*/
+static uint8_t damage_hist_num;         /*Number of frames saved in 'damage_hist'*/
+static lv_color_t * fb_shown;           /*The frame buffer shown last time (the source of the scrolling)*/
+#endif
+#if LV_REFR_DRAW_LIST
+static lv_refr_draw_rec_t draw_list[LV_REFR_DRAW_LIST_SIZE];
+static uint16_t draw_list_cnt;
+static bool draw_list_rec;              /*true: collect the drawings into 'draw_list' instead of drawing*/
+static bool draw_list_ovf;              /*true: 'draw_list' was too small for the drawings of the area*/
+static bool draw_list_valid;            /*true: replay 'draw_list' in the bands instead of walking the objects*/
+#endif
+#if LV_REFR_CACHE
+static lv_ll_t cache_ll;                /*Linked list of 'lv_refr_cache_t'*/
+static uint32_t cache_used;             /*Size of the cache buffers in bytes*/
+static uint32_t cache_tick;             /*Incremented on every use of a cache*/
+static uint32_t cache_hit_cnt;
+static uint32_t cache_miss_cnt;
+static uint32_t cache_evict_cnt;
+#if LV_REFR_THREAD_CNT != 0
+static pthread_mutex_t cache_mutex = PTHREAD_MUTEX_INITIALIZER;  /*Not held while a cache is drawn or copied*/
+#endif
+#endif
+#if LV_REFR_STAT
+static lv_refr_stat_t stat_act;                     /*Statistics of the frame being refreshed*/
+static lv_refr_stat_t stat_ring[LV_REFR_STAT_NUM];  /*Statistics of the last frames*/
+static uint32_t stat_frame_cnt;                     /*Number of frames saved into 'stat_ring'*/
+static uint16_t stat_inv_cnt;                       /*Invalidated areas since the last refresh*/
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_CNT != 0
+static __thread lv_refr_stat_band_t stat_band;      /*Every worker thread collects its own band statistics*/
+static pthread_mutex_t stat_mutex = PTHREAD_MUTEX_INITIALIZER;
+#else
+static lv_refr_stat_band_t stat_band;
+#endif
+#endif
 
 /**********************
  *      MACROS
  **********************/
+#if LV_REFR_CACHE && LV_REFR_THREAD_CNT != 0
+#define LV_REFR_CACHE_LOCK()       pthread_mutex_lock(&cache_mutex)
+#define LV_REFR_CACHE_UNLOCK()     pthread_mutex_unlock(&cache_mutex)
+#else
+#define LV_REFR_CACHE_LOCK()
+#define LV_REFR_CACHE_UNLOCK()
+#endif
+
+#if LV_REFR_STAT && LV_VDB_SIZE != 0 && LV_REFR_THREAD_CNT != 0
+#define LV_REFR_STAT_LOCK()        pthread_mutex_lock(&stat_mutex)
+#define LV_REFR_STAT_UNLOCK()      pthread_mutex_unlock(&stat_mutex)
+#else
+#define LV_REFR_STAT_LOCK()
+#define LV_REFR_STAT_UNLOCK()
+#endif
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -67,6 +224,27 @@ void lv_refr_init(void)
     inv_buf_p = 0;
     memset(inv_buf, 0, sizeof(inv_buf));
 
+#if LV_REFR_CACHE
+    lv_ll_init(&cache_ll, sizeof(lv_refr_cache_t));
+#endif
+
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_CNT != 0
+    /* Start the rendering workers. They wait for bands to draw.
+     * If a worker can't be started render with the already started ones*/
+    worker_num = 0;
+    while(worker_num < LV_REFR_THREAD_CNT) {
+        lv_refr_worker_t * worker = &workers[worker_num];
+        worker->id = worker_num;
+        worker->busy = 0;
+        int err = pthread_create(&worker->thread, NULL, lv_refr_worker_task, worker);
+        if(err != 0) {
+            LV_REFR_THREAD_ERROR(worker_num, err);
+            break;
+        }
+        worker_num++;
+    }
+#endif
+
     lv_task_t* task;
     task = lv_task_create(lv_refr_task, LV_REFR_PERIOD, LV_TASK_PRIO_MID, NULL);
     lv_mem_assert(task);
@@ -81,6 +259,7 @@ void lv_inv_area(const lv_area_t * area_p)
     /*Clear the invalidate buffer if the parameter is NULL*/
     if(area_p == NULL) {
         inv_buf_p = 0;
+        scroll_pending = false;
         return;
     }
     
@@ -106,22 +285,98 @@ void lv_inv_area(const lv_area_t * area_p)
     	com_area.y2 = com_area.y2 | 0x1;
 #endif
 
-    	/*Save only if this area is not in one of the saved areas*/
-    	uint16_t i;
-    	for(i = 0; i < inv_buf_p; i++) {
-    	    if(lv_area_is_in(&com_area, &inv_buf[i].area) != false) return;
-    	}
+        lv_refr_inv_buf_add(&com_area);
+#if LV_REFR_STAT
+        stat_inv_cnt++;
+#endif
+    }
+}
 
+/**
+ * Move the drawn content of an area at the next refresh instead of redrawing it (e.g. to scroll).
+ * Only the parts of the area not covered by the moved content are invalidated.
+ * Every pixel of the area should belong to the moved content before and after the move.
+ * @param area_p pointer to an area. The content is moved inside this area.
+ * @param dx horizontal offset of the content
+ * @param dy vertical offset of the content
+ * @return true: the area is handled; false: moving is not possible, the area should be invalidated
+ */
+bool lv_inv_scroll(const lv_area_t * area_p, lv_coord_t dx, lv_coord_t dy)
+{
+#if LV_VDB_SIZE == 0 || LV_VDB_DIRECT == 0
+    /*The display has to copy the pixels. (In direct mode they are copied between the frame buffers)*/
+    if(lv_disp_is_copy_area_supported() == false) return false;
+#endif
 
-        /*Save the area*/
-    	if(inv_buf_p < LV_INV_FIFO_SIZE) {
-            lv_area_copy(&inv_buf[inv_buf_p].area,&com_area);
-    	} else {/*If no place for the area add the screen*/
-    	    inv_buf_p = 0;
-            lv_area_copy(&inv_buf[inv_buf_p].area,&scr_area);
-        }
-    	inv_buf_p ++;
+    lv_area_t scr_area;
+    lv_area_set(&scr_area, 0, 0, LV_HOR_RES - 1, LV_VER_RES - 1);
+
+    lv_area_t area;
+    if(lv_area_union(&area, area_p, &scr_area) == false) return true;     /*Not visible*/
+    if(dx == 0 && dy == 0) return true;
+
+    /*Only one area can be moved in a refresh period but it can be moved more times*/
+    lv_coord_t dx_sum = dx;
+    lv_coord_t dy_sum = dy;
+    if(scroll_pending) {
+        if(memcmp(&area, &scroll_area, sizeof(lv_area_t)) != 0) return false;
+        dx_sum += scroll_diff.x;
+        dy_sum += scroll_diff.y;
+    }
+
+    uint16_t i;
+    for(i = 0; i < inv_buf_p; i++) {
+        /*Nothing to move if the whole area will be redrawn anyway*/
+        if(lv_area_is_in(&area, &inv_buf[i]) != false) return true;
+    }
+
+    if(LV_MATH_ABS(dx_sum) >= lv_area_get_width(&area) ||
+       LV_MATH_ABS(dy_sum) >= lv_area_get_height(&area)) {
+        /*The content is moved out from the area so nothing remains to copy*/
+        scroll_pending = false;
+        lv_inv_area(&area);
+        return true;
+    }
+
+    /* The invalid areas are not drawn yet so their old content is moved too.
+     * Invalidate them on the new position as well.*/
+    lv_area_t inv_ori[LV_INV_FIFO_SIZE];
+    uint16_t inv_cnt = inv_buf_p;
+    memcpy(inv_ori, inv_buf, inv_cnt * sizeof(lv_area_t));
+    lv_area_t moved;
+    for(i = 0; i < inv_cnt; i++) {
+        if(lv_area_union(&moved, &inv_ori[i], &area) == false) continue;
+        moved.x1 += dx;
+        moved.x2 += dx;
+        moved.y1 += dy;
+        moved.y2 += dy;
+        if(lv_area_union(&moved, &moved, &area) != false) lv_inv_area(&moved);
     }
+
+    /*Invalidate the exposed strips*/
+    lv_area_t strip;
+    if(dx > 0) {
+        lv_area_set(&strip, area.x1, area.y1, area.x1 + dx - 1, area.y2);
+        lv_inv_area(&strip);
+    } else if(dx < 0) {
+        lv_area_set(&strip, area.x2 + dx + 1, area.y1, area.x2, area.y2);
+        lv_inv_area(&strip);
+    }
+
+    if(dy > 0) {
+        lv_area_set(&strip, area.x1, area.y1, area.x2, area.y1 + dy - 1);
+        lv_inv_area(&strip);
+    } else if(dy < 0) {
+        lv_area_set(&strip, area.x1, area.y2 + dy + 1, area.x2, area.y2);
+        lv_inv_area(&strip);
+    }
+
+    lv_area_copy(&scroll_area, &area);
+    scroll_diff.x = dx_sum;
+    scroll_diff.y = dy_sum;
+    scroll_pending = true;
+
+    return true;
 }
 
 /**
@@ -136,6 +391,116 @@ void lv_refr_set_monitor_cb(void (*cb)(uint32_t, uint32_t))
     monitor_cb = cb;
 }
 
+/**
+ * Get the statistics of a recently refreshed frame (see 'LV_REFR_STAT_NUM')
+ * @param stat_p pointer to a lv_refr_stat_t variable, the statistics will be copied here
+ * @param back 0: the last refreshed frame, 1: the frame before it ... (< LV_REFR_STAT_NUM)
+ * @return false: there are no statistics about the frame (not refreshed yet or the statistics are disabled)
+ */
+bool lv_refr_get_stat(lv_refr_stat_t * stat_p, uint16_t back)
+{
+#if LV_REFR_STAT
+    if(back >= LV_REFR_STAT_NUM || back >= stat_frame_cnt) return false;
+
+    uint32_t id = stat_frame_cnt - 1 - back;
+    memcpy(stat_p, &stat_ring[id % LV_REFR_STAT_NUM], sizeof(lv_refr_stat_t));
+    return true;
+#else
+    (void)stat_p;   /*Unused if the statistics are disabled*/
+    (void)back;
+    return false;
+#endif
+}
+
+/**
+ * Add a measured value to the statistics of the actual frame.
+ * Used by the VDB handling and the drawing functions.
+ * @param id the type of the value
+ * @param value number of pixels or time
+ */
+void lv_refr_stat_add(lv_refr_stat_id_t id, uint32_t value)
+{
+#if LV_REFR_STAT
+    /*The pixels are counted in the band of the drawing thread. No need to lock*/
+    if(id == LV_REFR_STAT_DRAW_PX) {
+        stat_band.draw_px += value;
+        return;
+    }
+
+    LV_REFR_STAT_LOCK();
+    if(id == LV_REFR_STAT_TIME_AA) stat_act.time_aa += value;
+    else if(id == LV_REFR_STAT_TIME_FLUSH_WAIT) stat_act.time_flush_wait += value;
+    LV_REFR_STAT_UNLOCK();
+#else
+    (void)id;       /*Unused if the statistics are disabled*/
+    (void)value;
+#endif
+}
+
+/**
+ * Mark the cached drawing of an object as invalid. It will be redrawn when it's refreshed next time.
+ * Called by 'lv_obj_invalidate' for the invalidated object and its parents.
+ * @param obj pointer to an object with 'cache' attribute
+ */
+void lv_refr_cache_invalidate(lv_obj_t * obj)
+{
+#if LV_REFR_CACHE
+    LV_REFR_CACHE_LOCK();
+    lv_refr_cache_t * cache = lv_refr_cache_find(obj);
+    if(cache != NULL) cache->valid = 0;
+    LV_REFR_CACHE_UNLOCK();
+#else
+    (void)obj;      /*Unused if the caching is disabled*/
+#endif
+}
+
+/**
+ * Free the cached drawing of an object
+ * @param obj pointer to an object
+ */
+void lv_refr_cache_del(lv_obj_t * obj)
+{
+#if LV_REFR_CACHE
+    LV_REFR_CACHE_LOCK();
+    lv_refr_cache_t * cache = lv_refr_cache_find(obj);
+    if(cache != NULL) {
+        if(cache->buf != NULL) {
+            lv_mem_free(cache->buf);
+            cache_used -= cache->buf_size;
+        }
+        lv_ll_rem(&cache_ll, cache);
+        lv_mem_free(cache);
+    }
+    LV_REFR_CACHE_UNLOCK();
+#else
+    (void)obj;      /*Unused if the caching is disabled*/
+#endif
+}
+
+/**
+ * Give information about the cached drawings of the objects
+ * @param mon_p pointer to a lv_refr_cache_monitor_t variable,
+ *              the result of the analysis will be stored here
+ */
+void lv_refr_cache_monitor(lv_refr_cache_monitor_t * mon_p)
+{
+    memset(mon_p, 0, sizeof(lv_refr_cache_monitor_t));
+
+#if LV_REFR_CACHE
+    LV_REFR_CACHE_LOCK();
+    mon_p->hit_cnt = cache_hit_cnt;
+    mon_p->miss_cnt = cache_miss_cnt;
+    mon_p->evict_cnt = cache_evict_cnt;
+    mon_p->used_size = cache_used;
+
+    lv_refr_cache_t * cache;
+    LL_READ(cache_ll, cache) {
+        if(cache->buf != NULL) mon_p->buf_cnt++;
+    }
+    LV_REFR_CACHE_UNLOCK();
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -150,14 +515,34 @@ static void lv_refr_task(void * param)
 
     uint32_t start = lv_tick_get();
 
-    lv_refr_join_area();
-    
+#if LV_REFR_STAT
+    LV_REFR_STAT_LOCK();
+    memset(&stat_act, 0, sizeof(stat_act));
+    stat_act.time_start = LV_REFR_STAT_TIME();
+    stat_act.inv_cnt = stat_inv_cnt;
+    stat_act.area_cnt = inv_buf_p;
+    LV_REFR_STAT_UNLOCK();
+#endif
+
     lv_refr_areas();
 
     bool refr_done = false;
     if(inv_buf_p != 0) refr_done = true;
+
+#if LV_REFR_STAT
+    if(refr_done != false) {
+        LV_REFR_STAT_LOCK();
+        stat_act.time_total = LV_REFR_STAT_TIME() - stat_act.time_start;
+        stat_act.frame_id = stat_frame_cnt;
+        memcpy(&stat_ring[stat_frame_cnt % LV_REFR_STAT_NUM], &stat_act, sizeof(lv_refr_stat_t));
+        stat_frame_cnt++;
+        LV_REFR_STAT_UNLOCK();
+    }
+    stat_inv_cnt = 0;
+#endif
     memset(inv_buf, 0, sizeof(inv_buf));
     inv_buf_p = 0;
+    scroll_pending = false;
 
     /* In the callback lv_obj_inv can occur
      * therefore be sure the inv_buf is cleared prior to it*/
@@ -168,45 +553,71 @@ static void lv_refr_task(void * param)
     }
 }
 
-
 /**
- * Join the areas which has got common parts
+ * Save an invalid area. The areas are joined already here if refreshing them together is cheaper
+ * than one by one (see 'LV_REFR_AREA_COST'). If the buffer is full the area is joined to the
+ * saved area which grows the least, so it never falls back to refresh the whole screen.
+ * @param area_p pointer to an area (already truncated to the screen)
  */
-static void lv_refr_join_area(void)
+static void lv_refr_inv_buf_add(const lv_area_t * area_p)
 {
-    uint32_t join_from;
-    uint32_t join_in;
+    lv_area_t new_area;
     lv_area_t joined_area;
-    for(join_in = 0; join_in < inv_buf_p; join_in++) {
-        if(inv_buf[join_in].joined != 0) continue;
-        
-        /*Check all areas to join them in 'join_in'*/
-        for(join_from = 0; join_from < inv_buf_p; join_from++) {
-            /*Handle only unjoined areas and ignore itself*/
-            if(inv_buf[join_from].joined != 0 || join_in == join_from) {
-                continue;
-            }
+    uint32_t new_size;
+    uint32_t joined_size;
+    uint32_t saved_size;
+    uint16_t i;
 
-            /*Check if the areas are on each other*/
-            if(lv_area_is_on(&inv_buf[join_in].area,
-                          &inv_buf[join_from].area) == false)
-            {
-                continue;
+    lv_area_copy(&new_area, area_p);
+    new_size = lv_area_get_size(&new_area);
+
+    while(1) {
+        i = 0;
+        while(i < inv_buf_p) {
+            /*Nothing to do if the area is already saved*/
+            if(lv_area_is_in(&new_area, &inv_buf[i]) != false) return;
+
+            lv_area_join(&joined_area, &new_area, &inv_buf[i]);
+            joined_size = lv_area_get_size(&joined_area);
+            saved_size = lv_area_get_size(&inv_buf[i]);
+
+            if(joined_size <= new_size + saved_size + LV_REFR_AREA_COST) {
+                /*Continue with the joined area and remove the saved one (move the last to its place)*/
+                lv_area_copy(&new_area, &joined_area);
+                new_size = joined_size;
+                inv_buf_p--;
+                lv_area_copy(&inv_buf[i], &inv_buf[inv_buf_p]);
+
+                /*The greater area might be worth to join with the already checked areas too*/
+                i = 0;
+            } else {
+                i++;
             }
-            
-            lv_area_join(&joined_area, &inv_buf[join_in].area,
-                                    &inv_buf[join_from].area);
+        }
 
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < 
-             (lv_area_get_size(&inv_buf[join_in].area) + lv_area_get_size(&inv_buf[join_from].area))) {
-                lv_area_copy(&inv_buf[join_in].area, &joined_area);
+        if(inv_buf_p < LV_INV_FIFO_SIZE) break;
 
-                /*Mark 'join_form' is joined into 'join_in'*/
-                inv_buf[join_from].joined = 1;
+        /*No free place: join with the saved area which causes the smallest growth*/
+        uint16_t best_i = 0;
+        uint32_t best_growth = UINT32_MAX;
+        for(i = 0; i < inv_buf_p; i++) {
+            lv_area_join(&joined_area, &new_area, &inv_buf[i]);
+            joined_size = lv_area_get_size(&joined_area) - lv_area_get_size(&inv_buf[i]);
+            if(joined_size < best_growth) {
+                best_growth = joined_size;
+                best_i = i;
             }
-        }   
+        }
+
+        lv_area_join(&new_area, &new_area, &inv_buf[best_i]);
+        new_size = lv_area_get_size(&new_area);
+        inv_buf_p--;
+        lv_area_copy(&inv_buf[best_i], &inv_buf[inv_buf_p]);
+        /*Check the other areas again with the joined one*/
     }
+
+    lv_area_copy(&inv_buf[inv_buf_p], &new_area);
+    inv_buf_p++;
 }
 
 /**
@@ -217,21 +628,90 @@ static void lv_refr_areas(void)
     px_num = 0;
     uint32_t i;
 
+#if LV_VDB_SIZE != 0 && LV_VDB_DIRECT != 0
+    if(inv_buf_p == 0) return;
+
+    /*Get the frame buffer to draw into and add the areas changed since it was shown*/
+    uint8_t age;
+    lv_color_t * fb = lv_disp_get_fb(&age);
+    if(fb == NULL) return;
+
+    lv_vdb_set_fb(fb);
+
+    /*Nothing to copy the scrolled area from. Redraw it.*/
+    if(scroll_pending && fb_shown == NULL) {
+        lv_refr_inv_buf_add(&scroll_area);
+        scroll_pending = false;
+    }
+
+    lv_refr_damage_add(age);
+
+    /*Move the scrolled content from the shown frame buffer (the whole screen is redrawn if the content is unknown)*/
+    if(scroll_pending && age != 0 && fb_shown != NULL) lv_refr_scroll_fb(fb);
+#else
+    lv_refr_scroll_exec();
+#endif
+
     for(i = 0; i < inv_buf_p; i++) {
-        /*Refresh the unjoined areas*/
-        if(inv_buf[i].joined == 0) {
-            /*If there is no VDB do simple drawing*/
+        /*If there is no VDB do simple drawing*/
 #if LV_VDB_SIZE == 0
-            lv_refr_area_no_vdb(&inv_buf[i].area);
+        lv_refr_area_no_vdb(&inv_buf[i]);
+#elif LV_VDB_DIRECT == 0
+        /*If VDB is used...*/
+        lv_refr_area_with_vdb(&inv_buf[i]);
 #else
-            /*If VDB is used...*/
-            lv_refr_area_with_vdb(&inv_buf[i].area);
+        /*Draw directly to the frame buffer (the 'VDB' is the whole screen)*/
+        lv_refr_area_part_vdb(&inv_buf[i]);
+#endif
+        if(monitor_cb != NULL) px_num += lv_area_get_size(&inv_buf[i]);
+#if LV_REFR_STAT
+        stat_act.area_px += lv_area_get_size(&inv_buf[i]);
 #endif
-            if(monitor_cb != NULL) px_num += lv_area_get_size(&inv_buf[i].area);
-        }
     }
 
+#if LV_VDB_SIZE != 0 && LV_VDB_DIRECT == 0
+    /*Start the flushing of the bands which are still in the flush queue*/
+    lv_vdb_flush_queued();
+#elif LV_VDB_SIZE != 0
+    /*Show the new frame*/
+    lv_disp_flip(fb);
+    fb_shown = fb;
+#endif
+}
+
+/**
+ * Get the part of the scrolled area whose content remains visible after the move
+ * @param src_p store the source area of the copy here
+ */
+static void lv_refr_scroll_get_src(lv_area_t * src_p)
+{
+    lv_area_copy(src_p, &scroll_area);
+    if(scroll_diff.x > 0) src_p->x2 -= scroll_diff.x;
+    else src_p->x1 -= scroll_diff.x;
+    if(scroll_diff.y > 0) src_p->y2 -= scroll_diff.y;
+    else src_p->y1 -= scroll_diff.y;
+}
+
+#if LV_VDB_SIZE == 0 || LV_VDB_DIRECT == 0
+/**
+ * Let the display move the content of the scrolled area (see 'lv_inv_scroll')
+ */
+static void lv_refr_scroll_exec(void)
+{
+    if(scroll_pending == false) return;
+
+#if LV_VDB_SIZE != 0
+    /*The copied pixels have to be on the display already*/
+    lv_vdb_flush_wait();
+#endif
+
+    lv_area_t src;
+    lv_refr_scroll_get_src(&src);
+
+    lv_disp_copy_area(src.x1, src.y1, src.x2, src.y2, scroll_diff.x, scroll_diff.y);
+    scroll_pending = false;
 }
+#endif
 
 #if LV_VDB_SIZE == 0
 /**
@@ -240,6 +720,10 @@ static void lv_refr_areas(void)
  */
 static void lv_refr_area_no_vdb(const lv_area_t * area_p)
 {
+#if LV_REFR_STAT
+    uint32_t stat_start = LV_REFR_STAT_TIME();
+#endif
+
     lv_obj_t * top_p;
     
     /*Get top object which is not covered by others*/    
@@ -247,10 +731,15 @@ static void lv_refr_area_no_vdb(const lv_area_t * area_p)
     
     /*Do the refreshing*/
     lv_refr_obj_and_children(top_p, area_p);
+
+#if LV_REFR_STAT
+    lv_refr_stat_band_end(stat_start);
+#endif
 }
 
 #else
 
+#if LV_VDB_DIRECT == 0
 /**
  * Refresh an area if there is Virtual Display Buffer
  * @param area_p  pointer to an area to refresh
@@ -262,41 +751,165 @@ static void lv_refr_area_with_vdb(const lv_area_t * area_p)
     lv_coord_t h = lv_area_get_height(area_p);
     lv_coord_t y2 = area_p->y2 >= LV_VER_RES ? y2 = LV_VER_RES - 1 : area_p->y2;
 
-    uint32_t max_row = (uint32_t) LV_VDB_SIZE / (w << LV_AA);
+    int32_t max_row = (int32_t) LV_VDB_SIZE / (w << LV_AA);
     if(max_row > (h << LV_AA)) max_row = (h << LV_AA);
 
     max_row = max_row >> LV_AA ;
 
-    /*Always use the full row*/
-    uint32_t row;
-    lv_coord_t row_last = 0;
-    for(row = area_p->y1; row  + max_row - 1 <= y2; row += max_row)  {
-        lv_vdb_t * vdb_p = lv_vdb_get();
-
-        /*Calc. the next y coordinates of VDB*/
-        vdb_p->area.x1 = area_p->x1;
-        vdb_p->area.x2 = area_p->x2;
-        vdb_p->area.y1 = row;
-        vdb_p->area.y2 = row + max_row - 1;
-        if(vdb_p->area.y2 > y2) vdb_p->area.y2 = y2;
-        row_last = vdb_p->area.y2;
-        lv_refr_area_part_vdb(area_p);
+#if LV_REFR_DRAW_LIST
+    /*If the area is drawn in more bands walk the objects only once*/
+    if(max_row < h) {
+#if LV_REFR_STAT
+        uint32_t stat_start = LV_REFR_STAT_TIME();
+        draw_list_valid = lv_refr_draw_list_build(area_p);
+        uint32_t stat_time = LV_REFR_STAT_TIME() - stat_start;
+        LV_REFR_STAT_LOCK();
+        stat_act.time_traverse += stat_time;
+        LV_REFR_STAT_UNLOCK();
+#else
+        draw_list_valid = lv_refr_draw_list_build(area_p);
+#endif
     }
-    
-    /*If the last y coordinates are not handled yet ...*/
-    if(y2 != row_last) {
-        lv_vdb_t * vdb_p = lv_vdb_get();
+#endif
 
-        /*Calc. the next y coordinates of VDB*/
-        vdb_p->area.x1 = area_p->x1;
-        vdb_p->area.x2 = area_p->x2;
-        vdb_p->area.y1 = row;
-        vdb_p->area.y2 = y2;
+#if LV_REFR_THREAD_CNT != 0
+    /*Draw the bands parallel on the worker threads if they are started*/
+    if(worker_num != 0) {
+        lv_refr_area_with_workers(area_p, max_row, y2);
+    } else
+#endif
+    {
+        /*Always use the full row*/
+        int32_t row;
+        lv_coord_t row_last = 0;
+        for(row = area_p->y1; row  + max_row - 1 <= y2; row += max_row)  {
+            lv_vdb_t * vdb_p = lv_vdb_get();
+
+            /*Calc. the next y coordinates of VDB*/
+            vdb_p->area.x1 = area_p->x1;
+            vdb_p->area.x2 = area_p->x2;
+            vdb_p->area.y1 = row;
+            vdb_p->area.y2 = row + max_row - 1;
+            if(vdb_p->area.y2 > y2) vdb_p->area.y2 = y2;
+            row_last = vdb_p->area.y2;
+            lv_refr_area_part_vdb(area_p);
+            lv_vdb_flush();
+        }
 
-        /*Refresh this part too*/
-        lv_refr_area_part_vdb(area_p);
+        /*If the last y coordinates are not handled yet ...*/
+        if(y2 != row_last) {
+            lv_vdb_t * vdb_p = lv_vdb_get();
+
+            /*Calc. the next y coordinates of VDB*/
+            vdb_p->area.x1 = area_p->x1;
+            vdb_p->area.x2 = area_p->x2;
+            vdb_p->area.y1 = row;
+            vdb_p->area.y2 = y2;
+
+            /*Refresh this part too*/
+            lv_refr_area_part_vdb(area_p);
+            lv_vdb_flush();
+        }
+    }
+
+#if LV_REFR_DRAW_LIST
+    draw_list_valid = false;
+#endif
+}
+
+#else
+
+/**
+ * Add the areas changed since the frame buffer was shown to the invalid areas
+ * and save the invalid areas of this frame for the next frames.
+ * @param age age of the frame buffer (1: it shows the previous frame, 0: unknown content)
+ */
+static void lv_refr_damage_add(uint8_t age)
+{
+    /*Save the invalid areas of this frame before the older areas are joined to them*/
+    lv_area_t act_buf[LV_INV_FIFO_SIZE];
+    uint16_t act_cnt = inv_buf_p;
+    memcpy(act_buf, inv_buf, act_cnt * sizeof(lv_area_t));
+
+    /*The whole scrolled area changes in this frame*/
+    if(scroll_pending) {
+        if(act_cnt < LV_INV_FIFO_SIZE) {
+            lv_area_copy(&act_buf[act_cnt], &scroll_area);
+            act_cnt++;
+        } else {
+            lv_area_join(&act_buf[act_cnt - 1], &act_buf[act_cnt - 1], &scroll_area);
+        }
+    }
+
+    if(age == 0 || age - 1 > damage_hist_num) {
+        /*The content of the buffer is unknown so redraw the whole screen*/
+        lv_area_t scr_area;
+        lv_area_set(&scr_area, 0, 0, LV_HOR_RES - 1, LV_VER_RES - 1);
+        lv_refr_inv_buf_add(&scr_area);
+    } else {
+        /*Add the invalid areas of the previous 'age - 1' frames*/
+        uint8_t hist_id = damage_hist_act;
+        uint8_t f;
+        /*The scrolled area is copied from the shown (up to date) frame buffer so it's not required to redraw it*/
+        lv_area_t copy_area;
+        if(scroll_pending) {
+            lv_refr_scroll_get_src(&copy_area);
+            copy_area.x1 += scroll_diff.x;
+            copy_area.y1 += scroll_diff.y;
+            copy_area.x2 += scroll_diff.x;
+            copy_area.y2 += scroll_diff.y;
+        }
+
+        for(f = 1; f < age; f++) {
+            uint16_t a;
+            for(a = 0; a < damage_hist_cnt[hist_id]; a++) {
+                if(scroll_pending == false) {
+                    lv_refr_inv_buf_add(&damage_hist[hist_id][a]);
+                } else {
+                    lv_area_t parts[4];
+                    uint8_t part_cnt = lv_area_sub(parts, &damage_hist[hist_id][a], &copy_area);
+                    uint8_t p;
+                    for(p = 0; p < part_cnt; p++) lv_refr_inv_buf_add(&parts[p]);
+                }
+            }
+            hist_id = hist_id == 0 ? LV_VDB_DIRECT_AGE_MAX - 2 : hist_id - 1;
+        }
+    }
+
+    /*Save the areas of this frame as the latest ones*/
+    damage_hist_act++;
+    if(damage_hist_act >= LV_VDB_DIRECT_AGE_MAX - 1) damage_hist_act = 0;
+    memcpy(damage_hist[damage_hist_act], act_buf, act_cnt * sizeof(lv_area_t));
+    damage_hist_cnt[damage_hist_act] = act_cnt;
+    if(damage_hist_num < LV_VDB_DIRECT_AGE_MAX - 1) damage_hist_num++;
+}
+
+/**
+ * Copy the content of the scrolled area from the shown frame buffer to its new position (see 'lv_inv_scroll')
+ * @param fb pointer to the frame buffer to draw into (can be the shown frame buffer)
+ */
+static void lv_refr_scroll_fb(lv_color_t * fb)
+{
+    lv_area_t src;
+    lv_refr_scroll_get_src(&src);
+
+    uint32_t row_size = lv_area_get_width(&src) * sizeof(lv_color_t);
+    lv_coord_t y;
+
+    /*Copy the rows in an order which doesn't overwrite the not copied ones in the same buffer*/
+    if(scroll_diff.y > 0) {
+        for(y = src.y2; y >= src.y1; y--) {
+            memmove(&fb[(y + scroll_diff.y) * LV_HOR_RES + src.x1 + scroll_diff.x],
+                    &fb_shown[y * LV_HOR_RES + src.x1], row_size);
+        }
+    } else {
+        for(y = src.y1; y <= src.y2; y++) {
+            memmove(&fb[(y + scroll_diff.y) * LV_HOR_RES + src.x1 + scroll_diff.x],
+                    &fb_shown[y * LV_HOR_RES + src.x1], row_size);
+        }
     }
 }
+#endif
 
 /**
  * Refresh a part of an area which is on the actual Virtual Display Buffer
@@ -304,8 +917,11 @@ static void lv_refr_area_with_vdb(const lv_area_t * area_p)
  */
 static void lv_refr_area_part_vdb(const lv_area_t * area_p)
 {
+#if LV_REFR_STAT
+    uint32_t stat_start = LV_REFR_STAT_TIME();
+#endif
+
     lv_vdb_t * vdb_p = lv_vdb_get();
-    lv_obj_t * top_p;
 
     /*Get the new mask from the original area and the act. VDB
      It will be a part of 'area_p'*/
@@ -319,20 +935,168 @@ static void lv_refr_area_part_vdb(const lv_area_t * area_p)
     vdb_p->area.y2 = (vdb_p->area.y2 << LV_AA) + 1;
 #endif
 
+#if LV_REFR_DRAW_LIST
+    /*Replay the drawings collected for the whole area*/
+    if(draw_list_valid != false) lv_refr_draw_list_replay(&start_mask);
+    else lv_refr_area_objs(&start_mask);
+#else
+    lv_refr_area_objs(&start_mask);
+#endif
+
+#if LV_REFR_STAT
+    lv_refr_stat_band_end(stat_start);
+#endif
+}
+
+/**
+ * Refresh the objects of the screen and the layers on an area
+ * @param mask_p pointer to an area, the objects will be drawn only here
+ */
+static void lv_refr_area_objs(const lv_area_t * mask_p)
+{
+    lv_obj_t * top_p;
+
     /*Get the most top object which is not covered by others*/
-    top_p = lv_refr_get_top_obj(&start_mask, lv_scr_act());
+    top_p = lv_refr_get_top_obj(mask_p, lv_scr_act());
 
     /*Do the refreshing from the top object*/
-    lv_refr_obj_and_children(top_p, &start_mask);
+    lv_refr_obj_and_children(top_p, mask_p);
 
     /*Also refresh top and sys layer unconditionally*/
-    lv_refr_obj_and_children(lv_layer_top(), &start_mask);
-    lv_refr_obj_and_children(lv_layer_sys(), &start_mask);
+    lv_refr_obj_and_children(lv_layer_top(), mask_p);
+    lv_refr_obj_and_children(lv_layer_sys(), mask_p);
+}
+
+#if LV_REFR_DRAW_LIST
+/**
+ * Walk the objects on an area and collect their drawings into 'draw_list'
+ * @param area_p pointer to an area to refresh
+ * @return true: the drawings are collected, false: 'draw_list' is too small (walk in every band)
+ */
+static bool lv_refr_draw_list_build(const lv_area_t * area_p)
+{
+    draw_list_cnt = 0;
+    draw_list_ovf = false;
+    draw_list_rec = true;
+    lv_refr_area_objs(area_p);
+    draw_list_rec = false;
+
+    return draw_list_ovf == false ? true : false;
+}
+
+/**
+ * Draw the collected drawings which are on a mask
+ * @param mask_p pointer to an area (a part of the area of 'draw_list')
+ */
+static void lv_refr_draw_list_replay(const lv_area_t * mask_p)
+{
+    lv_area_t mask;
+    uint16_t i;
+    for(i = 0; i < draw_list_cnt; i++) {
+        if(lv_area_union(&mask, mask_p, &draw_list[i].mask) != false) {
+#if LV_REFR_CACHE
+            if(draw_list[i].cache != 0) {
+                lv_refr_cache_draw(draw_list[i].obj, &mask);
+                continue;
+            }
+#endif
+            lv_refr_design_call(draw_list[i].obj, &mask, draw_list[i].mode);
+        }
+    }
+}
+
+/**
+ * Save a drawing into 'draw_list'
+ * @param obj pointer to an object to draw
+ * @param mask_p pointer to an area, the object will be drawn only here
+ * @param mode LV_DESIGN_DRAW_MAIN or LV_DESIGN_DRAW_POST
+ * @param cache true: copy the object and its children from the cache ('mode' is not used)
+ */
+static void lv_refr_draw_list_add(lv_obj_t * obj, const lv_area_t * mask_p, lv_design_mode_t mode, bool cache)
+{
+    if(draw_list_cnt >= LV_REFR_DRAW_LIST_SIZE) {
+        draw_list_ovf = true;
+        return;
+    }
+    draw_list[draw_list_cnt].obj = obj;
+    lv_area_copy(&draw_list[draw_list_cnt].mask, mask_p);
+    draw_list[draw_list_cnt].mode = mode;
+    draw_list[draw_list_cnt].cache = cache == false ? 0 : 1;
+    draw_list_cnt++;
+}
+#endif
 
-    /*Flush the content of the VDB*/ 
-    lv_vdb_flush();
+#if LV_REFR_THREAD_CNT != 0
+/**
+ * Refresh an area band by band on the worker threads.
+ * Every worker draws a band into its own VDB then the bands are flushed in order.
+ * @param area_p pointer to an area to refresh
+ * @param max_row max. number of rows in a band
+ * @param y2 the last row to refresh
+ */
+static void lv_refr_area_with_workers(const lv_area_t * area_p, lv_coord_t max_row, lv_coord_t y2)
+{
+    lv_coord_t row = area_p->y1;
+    while(row <= y2) {
+        /*Give a band to every worker*/
+        uint8_t worker_cnt = 0;
+        while(worker_cnt < worker_num && row <= y2) {
+            /*It waits until the previous band of this worker is flushed*/
+            lv_vdb_t * vdb_p = lv_vdb_get_worker(worker_cnt);
+            vdb_p->area.x1 = area_p->x1;
+            vdb_p->area.x2 = area_p->x2;
+            vdb_p->area.y1 = row;
+            vdb_p->area.y2 = row + max_row - 1;
+            if(vdb_p->area.y2 > y2) vdb_p->area.y2 = y2;
+
+            lv_area_copy(&workers[worker_cnt].area, area_p);
+            row += max_row;
+            worker_cnt++;
+        }
+
+        /*Start the workers and wait until all of them are ready*/
+        pthread_mutex_lock(&worker_mutex);
+        uint8_t i;
+        for(i = 0; i < worker_cnt; i++) workers[i].busy = 1;
+        worker_busy_cnt = worker_cnt;
+        pthread_cond_broadcast(&worker_start_cond);
+        while(worker_busy_cnt != 0) pthread_cond_wait(&worker_ready_cond, &worker_mutex);
+        pthread_mutex_unlock(&worker_mutex);
+
+        /*Flush the bands in order*/
+        for(i = 0; i < worker_cnt; i++) lv_vdb_flush_worker(i);
+    }
 }
 
+/**
+ * The thread function of a rendering worker. Draw the bands given by 'lv_refr_area_with_workers'
+ * @param param pointer to the 'lv_refr_worker_t' of the worker
+ * @return never returns
+ */
+static void * lv_refr_worker_task(void * param)
+{
+    lv_refr_worker_t * worker = param;
+
+    /*Draw into the VDB of this worker*/
+    lv_vdb_set_worker(worker->id);
+
+    pthread_mutex_lock(&worker_mutex);
+    while(1) {
+        while(worker->busy == 0) pthread_cond_wait(&worker_start_cond, &worker_mutex);
+        pthread_mutex_unlock(&worker_mutex);
+
+        lv_refr_area_part_vdb(&worker->area);
+
+        pthread_mutex_lock(&worker_mutex);
+        worker->busy = 0;
+        worker_busy_cnt--;
+        if(worker_busy_cnt == 0) pthread_cond_signal(&worker_ready_cond);
+    }
+
+    return NULL;
+}
+#endif
+
 #endif /*LV_VDB_SIZE == 0*/
 
 /**
@@ -414,7 +1178,7 @@ static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p)
     /*Call the post draw design function of the parents of the to object*/
     par = lv_obj_get_parent(top_p);
     while(par != NULL) {
-        par->design_func(par, mask_p, LV_DESIGN_DRAW_POST);
+        lv_refr_obj_design(par, mask_p, LV_DESIGN_DRAW_POST);
         par = lv_obj_get_parent(par);
     }
 }
@@ -428,7 +1192,40 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
 {
     /*Do not refresh hidden objects*/
     if(obj->hidden != 0) return;
-    
+
+#if LV_REFR_CACHE
+    /*Copy the object and its children from the cache if possible*/
+    if(obj->cache != 0 && lv_refr_cache_usable(obj) != false) {
+        lv_area_t obj_ext_mask;
+        lv_area_t obj_area;
+        lv_obj_get_coords(obj, &obj_area);
+        obj_area.x1 -= obj->ext_size;
+        obj_area.y1 -= obj->ext_size;
+        obj_area.x2 += obj->ext_size;
+        obj_area.y2 += obj->ext_size;
+        if(lv_area_union(&obj_ext_mask, mask_ori_p, &obj_area) == false) return;
+
+#if LV_REFR_DRAW_LIST
+        if(draw_list_rec != false) {
+            lv_refr_draw_list_add(obj, &obj_ext_mask, LV_DESIGN_DRAW_MAIN, true);
+            return;
+        }
+#endif
+        lv_refr_cache_draw(obj, &obj_ext_mask);
+        return;
+    }
+#endif
+
+    lv_refr_obj_draw(obj, mask_ori_p);
+}
+
+/**
+ * Draw an object an all of its children without using its cache
+ * @param obj pointer to an object to draw
+ * @param mask_ori_p pointer to an area, the objects will be drawn only here
+ */
+static void lv_refr_obj_draw(lv_obj_t * obj, const lv_area_t * mask_ori_p)
+{
     bool union_ok;  /* Store the return value of area_union */
     /* Truncate the original mask to the coordinates of the parent
      * because the parent and its children are visible only here */
@@ -449,7 +1246,7 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
         /* Redraw the object */
         lv_style_t * style = lv_obj_get_style(obj);
         if(style->body.opa != LV_OPA_TRANSP) {
-            obj->design_func(obj, &obj_ext_mask, LV_DESIGN_DRAW_MAIN);
+            lv_refr_obj_design(obj, &obj_ext_mask, LV_DESIGN_DRAW_MAIN);
             //tick_wait_ms(100);  /*DEBUG: Wait after every object draw to see the order of drawing*/
         }
 
@@ -472,6 +1269,9 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
 				 * and its child */
 				union_ok = lv_area_union(&mask_child, &obj_mask, &child_area);
 
+				/*Skip the child or reduce its mask if the younger siblings cover it*/
+				if(union_ok) union_ok = lv_refr_obj_clip_covered(child_p, &mask_child);
+
 				/*If the parent and the child has common area then refresh the child */
 				if(union_ok) {
 					/*Refresh the next children*/
@@ -482,7 +1282,352 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
 
         /* If all the children are redrawn make 'post draw' design */
         if(style->body.opa != LV_OPA_TRANSP) {
-		  obj->design_func(obj, &obj_ext_mask, LV_DESIGN_DRAW_POST);
+		  lv_refr_obj_design(obj, &obj_ext_mask, LV_DESIGN_DRAW_POST);
 		}
     }
 }
+
+/**
+ * Check the younger siblings of an object (which are drawn later) whether they cover its mask.
+ * A sibling is used only if it covers the full width or height of the mask from an edge.
+ * The covered part is removed from the mask (it would be overdrawn anyway).
+ * @param obj pointer to an object
+ * @param mask_p pointer to the mask of the object. It will be reduced to the not covered part.
+ * @return true: there is a not covered part to draw, false: the object is fully covered
+ */
+static bool lv_refr_obj_clip_covered(lv_obj_t * obj, lv_area_t * mask_p)
+{
+    lv_obj_t * par = lv_obj_get_parent(obj);
+    if(par == NULL) return true;
+
+    lv_area_t cover;
+    lv_obj_t * i = lv_ll_get_prev(&(par->child_ll), obj);
+    while(i != NULL) {
+        if(i->hidden == 0 && lv_area_union(&cover, mask_p, &i->coords) != false) {
+            bool full_hor = cover.x1 == mask_p->x1 && cover.x2 == mask_p->x2 ? true : false;
+            bool full_ver = cover.y1 == mask_p->y1 && cover.y2 == mask_p->y2 ? true : false;
+
+            /*Ask the design function only if the covered part could reduce the mask*/
+            if(full_hor != false || full_ver != false) {
+                lv_style_t * style = lv_obj_get_style(i);
+                if(style->body.opa == LV_OPA_COVER &&
+                   i->design_func(i, &cover, LV_DESIGN_COVER_CHK) != false) {
+                    if(full_hor != false && full_ver != false) return false;
+
+                    if(full_hor != false) {
+                        if(cover.y1 == mask_p->y1) mask_p->y1 = cover.y2 + 1;
+                        else if(cover.y2 == mask_p->y2) mask_p->y2 = cover.y1 - 1;
+                    } else {
+                        if(cover.x1 == mask_p->x1) mask_p->x1 = cover.x2 + 1;
+                        else if(cover.x2 == mask_p->x2) mask_p->x2 = cover.x1 - 1;
+                    }
+                }
+            }
+        }
+        i = lv_ll_get_prev(&(par->child_ll), i);
+    }
+
+    return true;
+}
+
+/**
+ * Draw an object or save the drawing into 'draw_list' if the drawings are collected
+ * @param obj pointer to an object to draw
+ * @param mask_p pointer to an area, the object will be drawn only here
+ * @param mode LV_DESIGN_DRAW_MAIN or LV_DESIGN_DRAW_POST
+ */
+static void lv_refr_obj_design(lv_obj_t * obj, const lv_area_t * mask_p, lv_design_mode_t mode)
+{
+#if LV_REFR_DRAW_LIST
+    if(draw_list_rec != false) {
+        lv_refr_draw_list_add(obj, mask_p, mode, false);
+        return;
+    }
+#endif
+
+    lv_refr_design_call(obj, mask_p, mode);
+}
+
+/**
+ * Call the design function of an object to draw it and count the drawing in the statistics
+ * @param obj pointer to an object to draw
+ * @param mask_p pointer to an area, the object will be drawn only here
+ * @param mode LV_DESIGN_DRAW_MAIN or LV_DESIGN_DRAW_POST
+ */
+static void lv_refr_design_call(lv_obj_t * obj, const lv_area_t * mask_p, lv_design_mode_t mode)
+{
+#if LV_REFR_STAT
+    uint32_t start = LV_REFR_STAT_TIME();
+    obj->design_func(obj, mask_p, mode);
+    stat_band.time_draw += LV_REFR_STAT_TIME() - start;
+
+    /*Count the drawing at the object type*/
+    uint8_t i;
+    for(i = 0; i < LV_REFR_STAT_DESIGN_NUM; i++) {
+        if(stat_band.design[i].design_func == obj->design_func || stat_band.design[i].design_func == NULL) {
+            stat_band.design[i].design_func = obj->design_func;
+            stat_band.design[i].cnt++;
+            return;
+        }
+    }
+    stat_band.design_other_cnt++;
+#else
+    obj->design_func(obj, mask_p, mode);
+#endif
+}
+
+#if LV_REFR_STAT
+/**
+ * Add the statistics of the calling thread's band to the frame's statistics
+ * @param start 'LV_REFR_STAT_TIME()' when the band was started
+ */
+static void lv_refr_stat_band_end(uint32_t start)
+{
+    uint32_t band_time = LV_REFR_STAT_TIME() - start;
+
+    LV_REFR_STAT_LOCK();
+    stat_act.band_cnt++;
+    stat_act.draw_px += stat_band.draw_px;
+    stat_act.time_draw += stat_band.time_draw;
+    /*The drawing of the cached objects can be nested into an other drawing so limit it*/
+    stat_act.time_traverse += band_time > stat_band.time_draw ? band_time - stat_band.time_draw : 0;
+
+    uint8_t b;
+    uint8_t a;
+    for(b = 0; b < LV_REFR_STAT_DESIGN_NUM && stat_band.design[b].design_func != NULL; b++) {
+        for(a = 0; a < LV_REFR_STAT_DESIGN_NUM; a++) {
+            if(stat_act.design[a].design_func == stat_band.design[b].design_func ||
+               stat_act.design[a].design_func == NULL) {
+                stat_act.design[a].design_func = stat_band.design[b].design_func;
+                stat_act.design[a].cnt += stat_band.design[b].cnt;
+                break;
+            }
+        }
+        if(a == LV_REFR_STAT_DESIGN_NUM) stat_act.design_other_cnt += stat_band.design[b].cnt;
+    }
+    stat_act.design_other_cnt += stat_band.design_other_cnt;
+    LV_REFR_STAT_UNLOCK();
+
+    memset(&stat_band, 0, sizeof(stat_band));
+}
+#endif
+
+#if LV_REFR_CACHE
+/**
+ * Check whether an object can be drawn from a cache.
+ * It has to fully cover its area and has to fit into the cache memory.
+ * @param obj pointer to an object with 'cache' attribute
+ * @return true: the object can be cached
+ */
+static bool lv_refr_cache_usable(lv_obj_t * obj)
+{
+    uint32_t size = (lv_area_get_size(&obj->coords) << (LV_AA * 2)) * sizeof(lv_color_t);
+    if(size > LV_OBJ_CACHE_SIZE) return false;
+
+    lv_style_t * style = lv_obj_get_style(obj);
+    if(style->body.opa != LV_OPA_COVER) return false;
+
+    return obj->design_func(obj, &obj->coords, LV_DESIGN_COVER_CHK);
+}
+
+/**
+ * Copy the drawing of an object from its cache. Draw it into the cache before if required.
+ * The cache is locked only to find and pin it, the drawing and copying run parallel on more threads.
+ * @param obj pointer to an object with 'cache' attribute
+ * @param mask_p pointer to an area, the object will be drawn only here
+ */
+static void lv_refr_cache_draw(lv_obj_t * obj, const lv_area_t * mask_p)
+{
+    LV_REFR_CACHE_LOCK();
+
+    lv_refr_cache_t * cache = lv_refr_cache_find(obj);
+    if(cache == NULL) {
+        cache = lv_ll_ins_head(&cache_ll);
+        lv_mem_assert(cache);
+        cache->obj = obj;
+        cache->buf = NULL;
+        cache->buf_size = 0;
+        cache->ref_cnt = 0;
+        cache->valid = 0;
+        cache->drawing = 0;
+    }
+
+    cache_tick++;
+    cache->last_use = cache_tick;
+
+    /*Redraw the cache if the object is invalidated or moved since it was drawn*/
+    bool render = false;
+    if(cache->buf == NULL || cache->valid == 0 || cache->drawing != 0 ||
+       cache->area.x1 != obj->coords.x1 || cache->area.y1 != obj->coords.y1 ||
+       cache->area.x2 != obj->coords.x2 || cache->area.y2 != obj->coords.y2) {
+        cache_miss_cnt++;
+
+        /*An other thread uses the buffer or there is not enough memory: draw the object as usual*/
+        if(cache->ref_cnt != 0 || lv_refr_cache_alloc(cache) == false) {
+            LV_REFR_CACHE_UNLOCK();
+            lv_refr_obj_draw(obj, mask_p);
+            return;
+        }
+
+        lv_area_copy(&cache->area, &obj->coords);
+        cache->valid = 1;           /*Cleared if the object is invalidated while it's drawn*/
+        cache->drawing = 1;
+        render = true;
+    } else {
+        cache_hit_cnt++;
+    }
+
+    /*Pin the buffer while it's used without the lock*/
+    cache->ref_cnt++;
+
+    LV_REFR_CACHE_UNLOCK();
+
+    if(render) {
+        lv_refr_cache_render(cache);
+
+        LV_REFR_CACHE_LOCK();
+        cache->drawing = 0;
+        LV_REFR_CACHE_UNLOCK();
+    }
+
+    lv_area_t copy_mask;
+    if(lv_area_union(&copy_mask, mask_p, &obj->coords) != false) {
+        lv_draw_map(&obj->coords, &copy_mask, cache->buf, LV_OPA_COVER);
+    }
+
+    /*The extended area (e.g. shadow) is not cached*/
+    if(obj->ext_size != 0) lv_refr_cache_draw_ext(obj, mask_p);
+
+    LV_REFR_CACHE_LOCK();
+    cache->ref_cnt--;
+    LV_REFR_CACHE_UNLOCK();
+}
+
+/**
+ * Allocate the buffer of a cache for the current size of its object. Call it with the cache locked.
+ * @param cache pointer to the cache of an object (not used by other drawings)
+ * @return true: the buffer is ready, false: there is not enough memory for the cache
+ */
+static bool lv_refr_cache_alloc(lv_refr_cache_t * cache)
+{
+    lv_obj_t * obj = cache->obj;
+    uint32_t size = (lv_area_get_size(&obj->coords) << (LV_AA * 2)) * sizeof(lv_color_t);
+
+    if(cache->buf != NULL && cache->buf_size != size) {
+        lv_mem_free(cache->buf);
+        cache_used -= cache->buf_size;
+        cache->buf = NULL;
+    }
+
+    if(cache->buf == NULL) {
+        /*Free the least recently used caches to keep the memory budget*/
+        while(cache_used + size > LV_OBJ_CACHE_SIZE) {
+            if(lv_refr_cache_evict() == false) break;
+        }
+        if(cache_used + size > LV_OBJ_CACHE_SIZE) return false;
+
+        cache->buf = lv_mem_alloc(size);
+        if(cache->buf == NULL) return false;
+        cache->buf_size = size;
+        cache_used += size;
+    }
+
+    return true;
+}
+
+/**
+ * Draw an object and its children into its cache buffer. Called without the lock, the cache has to be pinned.
+ * @param cache pointer to the cache of an object
+ */
+static void lv_refr_cache_render(lv_refr_cache_t * cache)
+{
+    lv_obj_t * obj = cache->obj;
+
+    /*Use the cache buffer as VDB while the object is drawn*/
+    lv_vdb_t * vdb_p = lv_vdb_get();
+    lv_area_t vdb_area_ori;
+    lv_color_t * vdb_buf_ori = vdb_p->buf;
+    lv_area_copy(&vdb_area_ori, &vdb_p->area);
+
+    vdb_p->buf = cache->buf;
+#if LV_ANTIALIAS
+    vdb_p->area.x1 = obj->coords.x1 << LV_AA;
+    vdb_p->area.y1 = obj->coords.y1 << LV_AA;
+    vdb_p->area.x2 = (obj->coords.x2 << LV_AA) + 1;
+    vdb_p->area.y2 = (obj->coords.y2 << LV_AA) + 1;
+#else
+    lv_area_copy(&vdb_p->area, &obj->coords);
+#endif
+
+    lv_refr_obj_draw(obj, &obj->coords);
+
+    vdb_p->buf = vdb_buf_ori;
+    lv_area_copy(&vdb_p->area, &vdb_area_ori);
+}
+
+/**
+ * Draw the extended area of a cached object (e.g. its shadow) around its coordinates
+ * @param obj pointer to an object with 'cache' attribute
+ * @param mask_p pointer to an area, the object will be drawn only here
+ */
+static void lv_refr_cache_draw_ext(lv_obj_t * obj, const lv_area_t * mask_p)
+{
+    lv_area_t parts[4];
+    const lv_area_t * coords = &obj->coords;
+
+    /*Top, bottom, left and right parts of the mask out of the coordinates*/
+    lv_area_set(&parts[0], mask_p->x1, mask_p->y1, mask_p->x2, LV_MATH_MIN(mask_p->y2, coords->y1 - 1));
+    lv_area_set(&parts[1], mask_p->x1, LV_MATH_MAX(mask_p->y1, coords->y2 + 1), mask_p->x2, mask_p->y2);
+    lv_area_set(&parts[2], mask_p->x1, LV_MATH_MAX(mask_p->y1, coords->y1),
+                           LV_MATH_MIN(mask_p->x2, coords->x1 - 1), LV_MATH_MIN(mask_p->y2, coords->y2));
+    lv_area_set(&parts[3], LV_MATH_MAX(mask_p->x1, coords->x2 + 1), LV_MATH_MAX(mask_p->y1, coords->y1),
+                           mask_p->x2, LV_MATH_MIN(mask_p->y2, coords->y2));
+
+    uint8_t i;
+    for(i = 0; i < 4; i++) {
+        if(parts[i].x1 > parts[i].x2 || parts[i].y1 > parts[i].y2) continue;
+
+        lv_refr_design_call(obj, &parts[i], LV_DESIGN_DRAW_MAIN);
+        lv_refr_design_call(obj, &parts[i], LV_DESIGN_DRAW_POST);
+    }
+}
+
+/**
+ * Find the cache of an object
+ * @param obj pointer to an object
+ * @return pointer to the cache of the object or NULL if not found
+ */
+static lv_refr_cache_t * lv_refr_cache_find(lv_obj_t * obj)
+{
+    lv_refr_cache_t * cache;
+    LL_READ(cache_ll, cache) {
+        if(cache->obj == obj) return cache;
+    }
+
+    return NULL;
+}
+
+/**
+ * Free the buffer of the least recently used cache
+ * @return true: a buffer is freed, false: there is no buffer to free
+ */
+static bool lv_refr_cache_evict(void)
+{
+    lv_refr_cache_t * cache;
+    lv_refr_cache_t * lru = NULL;
+    LL_READ(cache_ll, cache) {
+        if(cache->buf == NULL || cache->ref_cnt != 0) continue;
+        if(lru == NULL || cache_tick - cache->last_use > cache_tick - lru->last_use) lru = cache;
+    }
+
+    if(lru == NULL) return false;
+
+    lv_mem_free(lru->buf);
+    cache_used -= lru->buf_size;
+    lru->buf = NULL;
+    lru->valid = 0;
+    cache_evict_cnt++;
+
+    return true;
+}
+#endif
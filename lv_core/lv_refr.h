@@ -14,16 +14,70 @@ extern "C" {
  *      INCLUDES
  *********************/
 #include "lv_obj.h"
+#include "../lv_hal/lv_hal_tick.h"
 #include <stdbool.h>
 
 
 /*********************
  *      DEFINES
  *********************/
+/*Time source of the frame statistics. Should be a free running counter (e.g. in us)*/
+#ifndef LV_REFR_STAT_TIME
+#define LV_REFR_STAT_TIME()         lv_tick_get()
+#endif
+
+/*Called if a rendering worker thread can't be started (e.g. to log the 'pthread_create' error code).
+ *The started workers are used (or the caller thread if there is none)*/
+#ifndef LV_REFR_THREAD_ERROR
+#define LV_REFR_THREAD_ERROR(id, err)
+#endif
+
+#define LV_REFR_STAT_DESIGN_NUM     16      /*Max. number of object types (design functions) counted in a frame*/
 
 /**********************
  *      TYPEDEFS
  **********************/
+typedef struct
+{
+    uint32_t hit_cnt;           /*Number of drawings copied from the cache*/
+    uint32_t miss_cnt;          /*Number of drawings redrawn into the cache*/
+    uint32_t evict_cnt;         /*Number of cache buffers freed to keep the memory budget*/
+    uint32_t used_size;         /*Size of the cache buffers in bytes*/
+    uint16_t buf_cnt;           /*Number of cache buffers*/
+}lv_refr_cache_monitor_t;
+
+typedef struct
+{
+    lv_design_func_t design_func;   /*Design function of an object type (compare to 'lv_obj_get_design_func()')*/
+    uint32_t cnt;                   /*Number of drawings (calls with LV_DESIGN_DRAW_MAIN/POST)*/
+}lv_refr_stat_design_t;
+
+/*Statistics of a refreshed frame. The times are in the unit of 'LV_REFR_STAT_TIME()'*/
+typedef struct
+{
+    uint32_t frame_id;          /*Incremented on every refreshed frame*/
+    uint32_t time_start;        /*'LV_REFR_STAT_TIME()' when the refresh started*/
+    uint32_t time_total;        /*Duration of the whole refresh*/
+    uint32_t time_traverse;     /*Time of walking the objects (refresh time of the bands without the drawing)*/
+    uint32_t time_draw;         /*Time spent in the design functions (rasterization)*/
+    uint32_t time_aa;           /*Time of the anti-aliasing downscale of the VDBs*/
+    uint32_t time_flush_wait;   /*Time of waiting for free VDBs (including the flushes started meanwhile)*/
+    uint32_t area_px;           /*Number of pixels in the refreshed areas*/
+    uint32_t draw_px;           /*Number of pixels processed by the drawing functions (area_px * 4 if no overdraw with LV_ANTIALIAS)*/
+    uint16_t inv_cnt;           /*Number of invalidated areas*/
+    uint16_t area_cnt;          /*Number of refreshed areas (after joining the invalidated areas)*/
+    uint16_t band_cnt;          /*Number of rendered VDB bands*/
+    uint16_t design_other_cnt;  /*Drawings of object types which didn't fit into 'design'*/
+    lv_refr_stat_design_t design[LV_REFR_STAT_DESIGN_NUM];  /*Drawings per object type (unused items are zeroed)*/
+}lv_refr_stat_t;
+
+/*Statistics measured out of 'lv_refr.c'*/
+typedef enum
+{
+    LV_REFR_STAT_DRAW_PX,
+    LV_REFR_STAT_TIME_AA,
+    LV_REFR_STAT_TIME_FLUSH_WAIT
+}lv_refr_stat_id_t;
 
 /**********************
  *  STATIC PROTOTYPES
@@ -52,12 +106,60 @@ void lv_refr_init(void);
  */
 void lv_inv_area(const lv_area_t * area_p);
 
+/**
+ * Move the drawn content of an area at the next refresh instead of redrawing it (e.g. to scroll).
+ * Only the parts of the area not covered by the moved content are invalidated.
+ * Every pixel of the area should belong to the moved content before and after the move.
+ * @param area_p pointer to an area. The content is moved inside this area.
+ * @param dx horizontal offset of the content
+ * @param dy vertical offset of the content
+ * @return true: the area is handled; false: moving is not possible, the area should be invalidated
+ */
+bool lv_inv_scroll(const lv_area_t * area_p, lv_coord_t dx, lv_coord_t dy);
+
 /**
  * Set a function to call after every refresh to announce the refresh time and the number of refreshed pixels
+ * (Kept for compatibility. 'lv_refr_get_stat' gives more detailed statistics)
  * @param cb pointer to a callback function (void my_refr_cb(uint32_t time_ms, uint32_t px_num))
  */
 void lv_refr_set_monitor_cb(void (*cb)(uint32_t, uint32_t));
 
+/**
+ * Get the statistics of a recently refreshed frame (see 'LV_REFR_STAT_NUM')
+ * @param stat_p pointer to a lv_refr_stat_t variable, the statistics will be copied here
+ * @param back 0: the last refreshed frame, 1: the frame before it ... (< LV_REFR_STAT_NUM)
+ * @return false: there are no statistics about the frame (not refreshed yet or the statistics are disabled)
+ */
+bool lv_refr_get_stat(lv_refr_stat_t * stat_p, uint16_t back);
+
+/**
+ * Add a measured value to the statistics of the actual frame.
+ * Used by the VDB handling and the drawing functions.
+ * @param id the type of the value
+ * @param value number of pixels or time
+ */
+void lv_refr_stat_add(lv_refr_stat_id_t id, uint32_t value);
+
+/**
+ * Mark the cached drawing of an object as invalid. It will be redrawn when it's refreshed next time.
+ * Called by 'lv_obj_invalidate' for the invalidated object and its parents.
+ * @param obj pointer to an object with 'cache' attribute
+ */
+void lv_refr_cache_invalidate(lv_obj_t * obj);
+
+/**
+ * Free the cached drawing of an object
+ * @param obj pointer to an object
+ */
+void lv_refr_cache_del(lv_obj_t * obj);
+
+/**
+ * Give information about the cached drawings of the objects
+ * @param mon_p pointer to a lv_refr_cache_monitor_t variable,
+ *              the result of the analysis will be stored here
+ */
+void lv_refr_cache_monitor(lv_refr_cache_monitor_t * mon_p);
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -3,11 +3,17 @@
  * 
  */
 #include "../../lv_conf.h"
-#if LV_VDB_SIZE != 0
+#if LV_VDB_SIZE != 0 && LV_VDB_DIRECT == 0
 
 #include "../lv_hal/lv_hal_disp.h"
 #include <stddef.h>
 #include "lv_vdb.h"
+#include "lv_refr.h"
+#include "../lv_draw/lv_draw_simd.h"
+
+#if LV_VDB_FLUSH_COND != 0
+#include <pthread.h>
+#endif
 
 /*********************
  *      INCLUDES
@@ -16,6 +22,16 @@
 /*********************
  *      DEFINES
  *********************/
+/*The VDBs of the ring and after them the VDBs of the rendering workers*/
+#define LV_VDB_CNT      (LV_VDB_NUM + LV_REFR_THREAD_CNT)
+
+#if LV_VDB_CNT > 127
+#error "Too many VDBs (LV_VDB_NUM + LV_REFR_THREAD_CNT > 127)"
+#endif
+
+#if LV_VDB_ADR != 0 && LV_VDB_NUM > 2
+#error "Only 2 VDBs can be placed to a specific address (LV_VDB_ADR, LV_VDB2_ADR)"
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -23,104 +39,337 @@
 typedef enum {
     LV_VDB_STATE_FREE = 0,
     LV_VDB_STATE_ACTIVE,
+    LV_VDB_STATE_QUEUED,        /*Waits in the flush queue*/
     LV_VDB_STATE_FLUSH,
 } lv_vdb_state_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void lv_vdb_queue_add(uint8_t id);
+static void lv_vdb_queue_start(void);
+static void lv_vdb_wait_free(uint8_t id);
+static void lv_vdb_flush_buf(lv_vdb_t * vdb_p);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 
-
-#if LV_VDB_DOUBLE == 0
-   /*Simple VDB*/
-   static volatile lv_vdb_state_t vdb_state = LV_VDB_STATE_ACTIVE;
-#  if LV_VDB_ADR == 0
-     /*If the buffer address is not specified  simply allocate it*/
-     static lv_color_t vdb_buf[LV_VDB_SIZE];
-     static lv_vdb_t vdb = {.buf = vdb_buf};
-#  else
-     /*If the buffer address is specified use that address*/
-     static lv_vdb_t vdb = {.buf = (lv_color_t *)LV_VDB_ADR};
-#  endif
-#else
-   /*Double VDB*/
-   static volatile lv_vdb_state_t vdb_state[2] = {LV_VDB_STATE_FREE, LV_VDB_STATE_FREE};
-#  if LV_VDB_ADR == 0
+#if LV_VDB_ADR == 0
    /*If the buffer address is not specified  simply allocate it*/
-   static lv_color_t vdb_buf1[LV_VDB_SIZE];
-   static lv_color_t vdb_buf2[LV_VDB_SIZE];
-   static lv_vdb_t vdb[2] = {{.buf = vdb_buf1}, {.buf = vdb_buf2}};
-#  else
-   /*If the buffer address is specified use that address*/
-   static lv_vdb_t vdb[2] = {{.buf = (lv_color_t *)LV_VDB_ADR}, {.buf = (lv_color_t *)LV_VDB2_ADR}};
-#  endif
+   static lv_color_t vdb_buf[LV_VDB_NUM][LV_VDB_SIZE];
+#endif
+#if LV_REFR_THREAD_CNT != 0
+   /*Every rendering worker has its own VDB*/
+   static lv_color_t vdb_worker_buf[LV_REFR_THREAD_CNT][LV_VDB_SIZE];
+   static __thread lv_vdb_t * vdb_worker_act;    /*VDB of the calling worker thread (NULL if not a worker)*/
+#endif
+
+static lv_vdb_t vdb[LV_VDB_CNT];
+static volatile lv_vdb_state_t vdb_state[LV_VDB_CNT];
+static uint8_t vdb_act;                         /*The next VDB of the ring to render into*/
+
+/* Queue of the VDBs to flush (in order).
+ * Only the first can be under flushing, 'lv_flush_ready()' removes it.
+ * 'flush_queue_in' is changed only by the rendering thread and 'flush_queue_out' only by 'lv_flush_ready()'
+ * so they need no lock if 'lv_flush_ready()' is called from an interrupt or an other thread.
+ * They count in 0..(2 * LV_VDB_CNT - 1) to tell the full queue from the empty one*/
+static volatile uint8_t flush_queue[LV_VDB_CNT];
+static volatile uint8_t flush_queue_in;         /*Number of added VDBs (modulo 2 * LV_VDB_CNT)*/
+static volatile uint8_t flush_queue_out;        /*Number of flushed VDBs (modulo 2 * LV_VDB_CNT)*/
+
+#if LV_VDB_FLUSH_COND != 0
+static pthread_mutex_t flush_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t flush_ready_cond = PTHREAD_COND_INITIALIZER;
 #endif
 
 /**********************
  *      MACROS
  **********************/
+#if LV_VDB_FLUSH_COND != 0
+#define LV_VDB_LOCK()       pthread_mutex_lock(&flush_mutex)
+#define LV_VDB_UNLOCK()     pthread_mutex_unlock(&flush_mutex)
+#else
+#define LV_VDB_LOCK()
+#define LV_VDB_UNLOCK()
+#endif
+
+/*Number of VDBs in the flush queue and the first of them*/
+#define LV_VDB_QUEUE_CNT()      ((flush_queue_in + 2 * LV_VDB_CNT - flush_queue_out) % (2 * LV_VDB_CNT))
+#define LV_VDB_QUEUE_FIRST()    (flush_queue[flush_queue_out % LV_VDB_CNT])
+
+/*Order the writes of the queue and the states (if 'lv_flush_ready()' runs on an other CPU)*/
+#if defined(__GNUC__)
+#define LV_VDB_BARRIER()        __sync_synchronize()
+#else
+#define LV_VDB_BARRIER()
+#endif
 
 /**********************
  *   GLOBAL FUNCTIONS
  **********************/
 
 /**
- * Get the 'vdb' variable or allocate one in LV_VDB_DOUBLE mode
+ * Get the 'vdb' variable to render into. Wait until the next VDB of the ring is flushed if required.
  * @return pointer to a 'vdb' variable
  */
 lv_vdb_t * lv_vdb_get(void)
 {
-#if LV_VDB_DOUBLE == 0
-    /* Wait until VDB become ACTIVE from FLUSH by the
+#if LV_REFR_THREAD_CNT != 0
+    /*The worker threads always draw into their own VDB*/
+    if(vdb_worker_act != NULL) return vdb_worker_act;
+#endif
+
+    /*If already there is an active do nothing*/
+    if(vdb_state[vdb_act] == LV_VDB_STATE_ACTIVE) return &vdb[vdb_act];
+
+    /* Wait until the VDB become FREE by the
      * user call of 'lv_flush_ready()' in display drivers's flush function*/
-    while(vdb_state != LV_VDB_STATE_ACTIVE);
-    return &vdb;
+    lv_vdb_wait_free(vdb_act);
+
+#if LV_VDB_ADR == 0
+    vdb[vdb_act].buf = vdb_buf[vdb_act];
 #else
-    /*If already there is an active do nothing*/
-    if(vdb_state[0] == LV_VDB_STATE_ACTIVE) return &vdb[0];
-    if(vdb_state[1] == LV_VDB_STATE_ACTIVE) return &vdb[1];
+    /*If the buffer address is specified use that address*/
+    vdb[vdb_act].buf = vdb_act == 0 ? (lv_color_t *)LV_VDB_ADR : (lv_color_t *)LV_VDB2_ADR;
+#endif
+    vdb_state[vdb_act] = LV_VDB_STATE_ACTIVE;
+    return &vdb[vdb_act];
+}
+
+/**
+ * Flush the content of the VDB.
+ * The flushing is queued so the next VDB of the ring can be rendered while it's flushed.
+ */
+void lv_vdb_flush(void)
+{
+    lv_vdb_get();   /*Be sure there is an active VDB*/
+
+    uint8_t id = vdb_act;
+    vdb_act++;
+    if(vdb_act >= LV_VDB_NUM) vdb_act = 0;
+
+    lv_vdb_queue_add(id);
+}
+
+/**
+ * Start the flushing of the queued VDBs.
+ * Wait the pending flushes if required but not the last one.
+ * Should be called when the rendering is finished (e.g. at the end of a refresh).
+ */
+void lv_vdb_flush_queued(void)
+{
+#if LV_REFR_STAT_NUM != 0
+    uint32_t stat_start = LV_REFR_STAT_TIME();
+#endif
+
+    while(1) {
+        lv_vdb_queue_start();
 
-    /*Try to allocate a free VDB*/
-    if(vdb_state[0] == LV_VDB_STATE_FREE) {
-        vdb_state[0] = LV_VDB_STATE_ACTIVE;
-        return &vdb[0];
+        LV_VDB_LOCK();
+        uint8_t cnt = LV_VDB_QUEUE_CNT();
+        lv_vdb_state_t state = vdb_state[LV_VDB_QUEUE_FIRST()];
+        if(cnt == 0 || (cnt == 1 && state == LV_VDB_STATE_FLUSH)) {
+            LV_VDB_UNLOCK();
+            break;
+        }
+#if LV_VDB_FLUSH_COND != 0
+        if(state == LV_VDB_STATE_FLUSH) pthread_cond_wait(&flush_ready_cond, &flush_mutex);
+#endif
+        LV_VDB_UNLOCK();
     }
 
-    if(vdb_state[1] == LV_VDB_STATE_FREE) {
-        vdb_state[1] = LV_VDB_STATE_ACTIVE;
-        return &vdb[1];
+#if LV_REFR_STAT_NUM != 0
+    lv_refr_stat_add(LV_REFR_STAT_TIME_FLUSH_WAIT, LV_REFR_STAT_TIME() - stat_start);
+#endif
+}
+
+/**
+ * Wait until every queued VDB is flushed (e.g. before the content of the display is read or copied)
+ */
+void lv_vdb_flush_wait(void)
+{
+#if LV_REFR_STAT_NUM != 0
+    uint32_t stat_start = LV_REFR_STAT_TIME();
+#endif
+
+    while(1) {
+        lv_vdb_queue_start();
+
+        LV_VDB_LOCK();
+        if(LV_VDB_QUEUE_CNT() == 0) {
+            LV_VDB_UNLOCK();
+            break;
+        }
+#if LV_VDB_FLUSH_COND != 0
+        if(vdb_state[LV_VDB_QUEUE_FIRST()] == LV_VDB_STATE_FLUSH) {
+            pthread_cond_wait(&flush_ready_cond, &flush_mutex);
+        }
+#endif
+        LV_VDB_UNLOCK();
     }
 
-    return NULL;   /*There wasn't free VDB (never happen)*/
+#if LV_REFR_STAT_NUM != 0
+    lv_refr_stat_add(LV_REFR_STAT_TIME_FLUSH_WAIT, LV_REFR_STAT_TIME() - stat_start);
 #endif
 }
 
+#if LV_REFR_THREAD_CNT != 0
 /**
- * Flush the content of the VDB
+ * Get the VDB of a rendering worker. Wait until its last flush is finished.
+ * @param id index of the worker (< LV_REFR_THREAD_CNT)
+ * @return pointer to the worker's 'vdb' variable
  */
-void lv_vdb_flush(void)
+lv_vdb_t * lv_vdb_get_worker(uint8_t id)
 {
-    lv_vdb_t * vdb_act = lv_vdb_get();
-    if(vdb_act == NULL) return;
+    uint8_t vdb_id = LV_VDB_NUM + id;
 
-#if LV_VDB_DOUBLE == 0
-    vdb_state = LV_VDB_STATE_FLUSH;     /*User call to 'lv_flush_ready()' will set to ACTIVE 'disp_flush'*/
-#else
-    /* Wait the pending flush before starting this one
-     * (Don't forget: 'lv_flush_ready()' has to be called when flushing is ready)*/
-    while(vdb_state[0] == LV_VDB_STATE_FLUSH || vdb_state[1] == LV_VDB_STATE_FLUSH);
+    lv_vdb_wait_free(vdb_id);
 
-    /*Turn the active VDB to flushing*/
-    if(vdb_state[0] == LV_VDB_STATE_ACTIVE) vdb_state[0] = LV_VDB_STATE_FLUSH;
-    if(vdb_state[1] == LV_VDB_STATE_ACTIVE) vdb_state[1] = LV_VDB_STATE_FLUSH;
+    vdb[vdb_id].buf = vdb_worker_buf[id];
+    vdb_state[vdb_id] = LV_VDB_STATE_ACTIVE;
+    return &vdb[vdb_id];
+}
+
+/**
+ * Assign a worker's VDB to the calling thread.
+ * After it 'lv_vdb_get()' returns this VDB in the calling thread.
+ * @param id index of the worker (< LV_REFR_THREAD_CNT)
+ */
+void lv_vdb_set_worker(uint8_t id)
+{
+    vdb_worker_act = &vdb[LV_VDB_NUM + id];
+}
+
+/**
+ * Get the index of the worker whose VDB is assigned to the calling thread
+ * @return index of the worker or -1 if the calling thread is not a rendering worker
+ */
+int16_t lv_vdb_get_worker_id(void)
+{
+    if(vdb_worker_act == NULL) return -1;
+
+    return vdb_worker_act - &vdb[LV_VDB_NUM];
+}
+
+/**
+ * Flush the content of a worker's VDB.
+ * The flushing is queued after the previously flushed VDBs.
+ * @param id index of the worker (< LV_REFR_THREAD_CNT)
+ */
+void lv_vdb_flush_worker(uint8_t id)
+{
+    lv_vdb_queue_add(LV_VDB_NUM + id);
+}
 #endif
 
+/**
+ * Call in the display driver's 'disp_flush' function when the flushing is finished.
+ * It can be called from an other thread or from an interrupt
+ * (but not from an interrupt if 'LV_VDB_FLUSH_COND' is enabled)
+ */
+void lv_flush_ready(void)
+{
+    LV_VDB_LOCK();
+
+    /*The flushed VDB is always the first in the queue*/
+    if(LV_VDB_QUEUE_CNT() != 0) {
+        uint8_t id = LV_VDB_QUEUE_FIRST();
+        if(vdb_state[id] == LV_VDB_STATE_FLUSH) {
+            /*Remove it from the queue before it can be reused*/
+            flush_queue_out = (flush_queue_out + 1) % (2 * LV_VDB_CNT);
+            LV_VDB_BARRIER();
+            vdb_state[id] = LV_VDB_STATE_FREE;
+        }
+    }
+
+#if LV_VDB_FLUSH_COND != 0
+    pthread_cond_broadcast(&flush_ready_cond);
+#endif
+    LV_VDB_UNLOCK();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Add a rendered VDB to the end of the flush queue and start flushing if possible
+ * @param id index of the VDB
+ */
+static void lv_vdb_queue_add(uint8_t id)
+{
+    LV_VDB_LOCK();
+    flush_queue[flush_queue_in % LV_VDB_CNT] = id;
+    vdb_state[id] = LV_VDB_STATE_QUEUED;
+    LV_VDB_BARRIER();
+    flush_queue_in = (flush_queue_in + 1) % (2 * LV_VDB_CNT);
+    LV_VDB_UNLOCK();
+
+    lv_vdb_queue_start();
+}
+
+/**
+ * Start to flush the first VDB of the queue if no other flush is pending.
+ * If 'lv_flush_ready()' is called from 'disp_flush' the next VDBs are flushed too.
+ */
+static void lv_vdb_queue_start(void)
+{
+    while(1) {
+        LV_VDB_LOCK();
+        if(LV_VDB_QUEUE_CNT() == 0 || vdb_state[LV_VDB_QUEUE_FIRST()] != LV_VDB_STATE_QUEUED) {
+            LV_VDB_UNLOCK();
+            return;
+        }
+        uint8_t id = LV_VDB_QUEUE_FIRST();
+        vdb_state[id] = LV_VDB_STATE_FLUSH;     /*User call to 'lv_flush_ready()' will set to FREE*/
+        LV_VDB_UNLOCK();
+
+        lv_vdb_flush_buf(&vdb[id]);
+    }
+}
+
+/**
+ * Wait until a VDB is flushed. Meanwhile start the flushing of the queued VDBs.
+ * With 'LV_VDB_FLUSH_COND' sleep until 'lv_flush_ready()' instead of busy-waiting.
+ * @param id index of the VDB
+ */
+static void lv_vdb_wait_free(uint8_t id)
+{
+#if LV_REFR_STAT_NUM != 0
+    uint32_t stat_start = LV_REFR_STAT_TIME();
+#endif
+
+    while(1) {
+        lv_vdb_queue_start();
+
+        LV_VDB_LOCK();
+        if(vdb_state[id] == LV_VDB_STATE_FREE) {
+            LV_VDB_UNLOCK();
+            break;
+        }
+#if LV_VDB_FLUSH_COND != 0
+        /*Sleep only if there is a pending flush which will call 'lv_flush_ready()'*/
+        if(LV_VDB_QUEUE_CNT() != 0 && vdb_state[LV_VDB_QUEUE_FIRST()] == LV_VDB_STATE_FLUSH) {
+            pthread_cond_wait(&flush_ready_cond, &flush_mutex);
+        }
+#endif
+        LV_VDB_UNLOCK();
+    }
+
+#if LV_REFR_STAT_NUM != 0
+    lv_refr_stat_add(LV_REFR_STAT_TIME_FLUSH_WAIT, LV_REFR_STAT_TIME() - stat_start);
+#endif
+}
+
+/**
+ * Write the content of a VDB to the display (filter it first if anti-aliasing is enabled)
+ * @param vdb_p pointer to the VDB to flush
+ */
+static void lv_vdb_flush_buf(lv_vdb_t * vdb_p)
+{
 #if LV_ANTIALIAS == 0
-	lv_disp_flush(vdb_act->area.x1, vdb_act->area.y1, vdb_act->area.x2, vdb_act->area.y2, vdb_act->buf);
+	lv_disp_flush(vdb_p->area.x1, vdb_p->area.y1, vdb_p->area.x2, vdb_p->area.y2, vdb_p->buf);
 #else
 	/* Get the average of 2x2 pixels and put the result back to the VDB
 	 * The reading goes much faster then the write back
@@ -133,63 +382,73 @@ void lv_vdb_flush(void)
 	 * in1_buf  |1,1|1,3|
 	 * in2_buf  |1,1|1,3|
 	 * */
-	lv_coord_t x;
+#if LV_REFR_STAT_NUM != 0
+    uint32_t stat_start = LV_REFR_STAT_TIME();
+#endif
 	lv_coord_t y;
-	lv_coord_t w = lv_area_get_width(&vdb_act->area);
-	lv_color_t * in1_buf = vdb_act->buf;      /*Pointer to the first row*/
-    lv_color_t * in2_buf = vdb_act->buf + w;  /*Pointer to the second row*/
-    lv_color_t * out_buf = vdb_act->buf;      /*Store the result here*/
-	for(y = vdb_act->area.y1; y < vdb_act->area.y2; y += 2) {
-        for(x = vdb_act->area.x1; x < vdb_act->area.x2; x += 2) {
-        
-            /*If the pixels are the same do not calculate the average */
-            if(in1_buf->full == (in1_buf + 1)->full &&
-               in1_buf->full == in2_buf->full &&
-               in1_buf->full == (in2_buf + 1)->full) {
-                out_buf->full = in1_buf->full;
-            } else {
-                /*Get the average of 2x2 red*/
-                out_buf->red = (in1_buf->red + (in1_buf + 1)->red +
-                                in2_buf->red + (in2_buf+ 1)->red) >> 2;
-                /*Get the average of 2x2 green*/
-                out_buf->green = (in1_buf->green + (in1_buf + 1)->green +
-                                  in2_buf->green + (in2_buf + 1)->green) >> 2;
-                /*Get the average of 2x2 blue*/
-                out_buf->blue = (in1_buf->blue + (in1_buf + 1)->blue +
-                                 in2_buf->blue + (in2_buf + 1)->blue) >> 2;
-            }
-            
-			in1_buf += 2; /*Skip the next pixel because it is already used above*/
-            in2_buf += 2;
-			out_buf ++;
-		}
+	lv_coord_t w = lv_area_get_width(&vdb_p->area);
+	lv_color_t * in1_buf = vdb_p->buf;      /*Pointer to the first row*/
+    lv_color_t * out_buf = vdb_p->buf;      /*Store the result here*/
+	for(y = vdb_p->area.y1; y < vdb_p->area.y2; y += 2) {
+        /*The row pair is filtered by the fastest kernel of the CPU (see 'lv_draw_simd.c')*/
+        lv_simd_aa_row(out_buf, in1_buf, in1_buf + w, w >> 1);
+
 		/*2 row is ready so go the next 2*/
-		in1_buf += w; /*Skip the next row because it is processed from in2_buf*/
-        in2_buf += w;
+		in1_buf += w << 1;
+        out_buf += w >> 1;
 	}
 
+#if LV_REFR_STAT_NUM != 0
+    lv_refr_stat_add(LV_REFR_STAT_TIME_AA, LV_REFR_STAT_TIME() - stat_start);
+#endif
+
 	/* Now the full the VDB is filtered and the result is stored in the first quarter of it
 	 * Write out the filtered map to the display*/
-	lv_disp_flush(vdb_act->area.x1 >> 1, vdb_act->area.y1 >> 1, vdb_act->area.x2 >> 1, vdb_act->area.y2 >> 1, vdb_act->buf);
+	lv_disp_flush(vdb_p->area.x1 >> 1, vdb_p->area.y1 >> 1, vdb_p->area.x2 >> 1, vdb_p->area.y2 >> 1, vdb_p->buf);
 #endif
 }
 
+#elif LV_VDB_SIZE != 0   /*LV_VDB_DIRECT*/
+
+#include <stddef.h>
+#include "lv_vdb.h"
+
+#if LV_ANTIALIAS != 0
+#error "LV_VDB_DIRECT can't be used with LV_ANTIALIAS"
+#endif
+
+#if LV_REFR_THREAD_CNT != 0
+#error "LV_VDB_DIRECT can't be used with LV_REFR_THREAD_CNT"
+#endif
+
+/*The 'VDB' is the full screen frame buffer of the display driver*/
+static lv_vdb_t vdb = {.area = {.x1 = 0, .y1 = 0, .x2 = LV_HOR_RES - 1, .y2 = LV_VER_RES - 1}};
+
 /**
- * Call in the display driver's  'disp_flush' function when the flushing is finished
+ * Get the 'vdb' variable. It covers the frame buffer set by 'lv_vdb_set_fb'
+ * @return pointer to a 'vdb' variable
  */
-void lv_flush_ready(void)
+lv_vdb_t * lv_vdb_get(void)
 {
-#if LV_VDB_DOUBLE == 0
-    vdb_state = LV_VDB_STATE_ACTIVE;
-#else
-    if(vdb_state[0] == LV_VDB_STATE_FLUSH)  vdb_state[0] = LV_VDB_STATE_FREE;
-    if(vdb_state[1] == LV_VDB_STATE_FLUSH)  vdb_state[1] = LV_VDB_STATE_FREE;
-#endif
+    return &vdb;
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
+/**
+ * Set the frame buffer to render into
+ * @param fb pointer to a full screen frame buffer
+ */
+void lv_vdb_set_fb(lv_color_t * fb)
+{
+    vdb.buf = fb;
+}
+
+/**
+ * Just for compatibility
+ */
+void lv_flush_ready(void)
+{
+    /*Do nothing. The frame buffers are shown with 'disp_flip'*/
+}
 
 #else
 
@@ -15,6 +15,11 @@ extern "C" {
  *********************/
 #include "../../lv_conf.h"
 
+/*Render on the caller thread if not set in lv_conf.h*/
+#ifndef LV_REFR_THREAD_CNT
+#define LV_REFR_THREAD_CNT  0
+#endif
+
 #if LV_VDB_SIZE != 0
 
 #include "../lv_misc/lv_color.h"
@@ -23,6 +28,22 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+/*Compatibility with the former 'LV_VDB_DOUBLE' setting*/
+#ifndef LV_VDB_NUM
+#  if defined(LV_VDB_DOUBLE) && LV_VDB_DOUBLE != 0
+#    define LV_VDB_NUM      2
+#  else
+#    define LV_VDB_NUM      1
+#  endif
+#endif
+
+#ifndef LV_VDB_FLUSH_COND
+#define LV_VDB_FLUSH_COND   0
+#endif
+
+#ifndef LV_VDB_DIRECT
+#define LV_VDB_DIRECT       0
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -38,23 +59,85 @@ typedef struct
  * GLOBAL PROTOTYPES
  **********************/
 
+#if LV_VDB_DIRECT == 0
 /**
- * Get the 'vdb' variable or allocate one in LV_VDB_DOUBLE mode
+ * Get the 'vdb' variable to render into. Wait until the next VDB of the ring is flushed if required.
  * @return pointer to a 'vdb' variable
  */
 lv_vdb_t * lv_vdb_get(void);
 
 /**
- * Flush the content of the vdb
+ * Flush the content of the VDB.
+ * The flushing is queued so the next VDB of the ring can be rendered while it's flushed.
  */
 void lv_vdb_flush(void);
 
+/**
+ * Start the flushing of the queued VDBs.
+ * Wait the pending flushes if required but not the last one.
+ * Should be called when the rendering is finished (e.g. at the end of a refresh).
+ */
+void lv_vdb_flush_queued(void);
+
+/**
+ * Wait until every queued VDB is flushed (e.g. before the content of the display is read or copied)
+ */
+void lv_vdb_flush_wait(void);
+
+/**
+ * Call in the display driver's 'disp_flush' function when the flushing is finished.
+ * It can be called from an other thread or from an interrupt
+ * (but not from an interrupt if 'LV_VDB_FLUSH_COND' is enabled)
+ */
+void lv_flush_ready(void);
+
+#else   /*LV_VDB_DIRECT*/
+/**
+ * Get the 'vdb' variable. It covers the frame buffer set by 'lv_vdb_set_fb'
+ * @return pointer to a 'vdb' variable
+ */
+lv_vdb_t * lv_vdb_get(void);
+
+/**
+ * Set the frame buffer to render into
+ * @param fb pointer to a full screen frame buffer
+ */
+void lv_vdb_set_fb(lv_color_t * fb);
 
 /**
- * In 'LV_VDB_DOUBLE' mode  has to be called when 'disp_map()'
- * is ready with copying the map to a frame buffer.
+ * Just for compatibility
  */
 void lv_flush_ready(void);
+#endif
+
+#if LV_REFR_THREAD_CNT != 0
+/**
+ * Get the VDB of a rendering worker. Wait until its last flush is finished.
+ * @param id index of the worker (< LV_REFR_THREAD_CNT)
+ * @return pointer to the worker's 'vdb' variable
+ */
+lv_vdb_t * lv_vdb_get_worker(uint8_t id);
+
+/**
+ * Assign a worker's VDB to the calling thread.
+ * After it 'lv_vdb_get()' returns this VDB in the calling thread.
+ * @param id index of the worker (< LV_REFR_THREAD_CNT)
+ */
+void lv_vdb_set_worker(uint8_t id);
+
+/**
+ * Get the index of the worker whose VDB is assigned to the calling thread
+ * @return index of the worker or -1 if the calling thread is not a rendering worker
+ */
+int16_t lv_vdb_get_worker_id(void);
+
+/**
+ * Flush the content of a worker's VDB.
+ * The flushing is queued after the previously flushed VDBs.
+ * @param id index of the worker (< LV_REFR_THREAD_CNT)
+ */
+void lv_vdb_flush_worker(uint8_t id);
+#endif
 
 /**********************
  *      MACROS
@@ -13,17 +13,29 @@
 #include "lv_draw.h"
 #include "lv_draw_rbasic.h"
 #include "lv_draw_vbasic.h"
+#include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_circ.h"
 #include "../lv_misc/lv_fs.h"
 #include "../lv_misc/lv_math.h"
-#include "../lv_misc/lv_ufs.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_trigo.h"
 #include "../lv_objx/lv_img.h"
+#include "../lv_hal/lv_hal_disp.h"
+#include "lv_draw_corner.h"
+#include "lv_draw_grad.h"
+#include "lv_draw_img_cache.h"
+#include "lv_draw_img_dec.h"
+#include "lv_draw_img_trans.h"
+#include "lv_draw_scan.h"
 
 /*********************
  *      DEFINES
  *********************/
-#define LINE_WIDTH_CORR_BASE 64
-#define LINE_WIDTH_CORR_SHIFT 6
+/*Max. length of a miter joint relative to the half width of a line*/
+#define LINE_MITER_LIMIT        4
+
+/*Max. number of shapes of an arc: 3 pieces in the left or right half and 2 caps*/
+#define ARC_SHAPE_MAX           5
 
 #define LABEL_RELV_COLOR_PAR_LENGTH    6
 
@@ -37,15 +49,73 @@ typedef enum
     CMD_STATE_IN,
 }cmd_state_t;
 
+#if USE_LV_IMG
+/*The pixels of the rows of an image (e.g. to transform it)*/
+typedef struct
+{
+    lv_img_raw_header_t header;
+    const lv_color_t * data;                    /*The pixels from 'row_first' (NULL: not read yet)*/
+    const lv_opa_t * alpha;                     /*Opacity of the pixels or NULL*/
+    lv_coord_t row_first;                       /*The image row of the first pixel of 'data'*/
+    const lv_draw_img_cache_entry_t * cached;   /*The image from the cache or NULL*/
+    lv_color_t * buf;                           /*The decoded pixels or NULL*/
+    const void * f_data;                        /*The driver's pointer to the file or NULL*/
+    uint32_t f_size;
+    lv_fs_file_t file;                          /*Kept opened while the driver's pointer is used*/
+    uint8_t file_opened :1;
+}img_px_t;
+#endif
+
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static void lv_draw_rect_main_mid(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style);
-static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style);
+#if USE_LV_SHADOW && LV_VDB_SIZE
+static void draw_px(lv_coord_t x, lv_coord_t y, const lv_area_t * mask, lv_color_t color, lv_opa_t opa);
+#endif
+static void draw_fill(const lv_area_t * coords, const lv_area_t * mask, lv_color_t color, lv_opa_t opa);
+static void draw_letter(const lv_point_t * pos_p, const lv_area_t * mask, const lv_font_t * font_p, uint32_t letter, const lv_font_glyph_dsc_t * glyph_p, lv_color_t color, lv_opa_t opa);
+static void draw_map(const lv_area_t * coords, const lv_area_t * mask, const lv_color_t * map_p, const lv_opa_t * alpha_p, lv_opa_t opa, bool transp, bool upscale, lv_color_t recolor, lv_opa_t recolor_opa);
+static bool sw_px(lv_coord_t x, lv_coord_t y, const lv_area_t * mask, lv_color_t color, lv_opa_t opa);
+static bool sw_fill(const lv_area_t * coords, const lv_area_t * mask, lv_color_t color, lv_opa_t opa);
+static bool sw_letter(const lv_point_t * pos_p, const lv_area_t * mask, const lv_font_t * font_p, uint32_t letter, lv_color_t color, lv_opa_t opa);
+static void sw_glyph(const lv_point_t * pos_p, const lv_area_t * mask, const lv_font_glyph_dsc_t * glyph_p, lv_color_t color, lv_opa_t opa);
+static bool sw_map(const lv_area_t * coords, const lv_area_t * mask, const lv_color_t * map_p, const lv_opa_t * alpha_p, lv_opa_t opa, bool transp, bool upscale, lv_color_t recolor, lv_opa_t recolor_opa);
+static bool sw_line(const lv_point_t * p1, const lv_point_t * p2, const lv_area_t * mask, const lv_style_t * style);
+static bool sw_polyline(const lv_point_t * points, uint16_t point_num, const lv_area_t * mask, const lv_style_t * style,
+                        lv_draw_line_cap_t cap, lv_draw_line_join_t join);
+static uint16_t line_build(const lv_point_t * points, uint16_t point_num, uint16_t seg_start, uint16_t seg_end, const lv_area_t * mask,
+                           int32_t hw, lv_draw_line_cap_t cap, lv_draw_line_join_t join, lv_draw_scan_shape_t * shapes);
+static void line_cap(const lv_point_t * p, const lv_point_t * from, int32_t hw, lv_draw_line_cap_t cap, lv_draw_scan_shape_t * shape);
+static void line_join(const lv_point_t * prev, const lv_point_t * p, const lv_point_t * next, int32_t hw,
+                      lv_draw_line_join_t join, lv_draw_scan_shape_t * shape);
+static void line_point(const lv_point_t * p, lv_draw_scan_point_t * res);
+static void line_dir(const lv_point_t * p1, const lv_point_t * p2, lv_draw_scan_point_t * dir);
+static bool sw_polygon(const lv_point_t * points, uint16_t point_num, const lv_area_t * mask, const lv_style_t * style,
+                       lv_draw_fill_rule_t rule);
+static bool sw_arc(const lv_point_t * center, lv_coord_t radius, int32_t start, int32_t end, const lv_area_t * mask,
+                   const lv_style_t * style, lv_draw_line_cap_t cap);
+static void arc_cap(const lv_draw_scan_point_t * center, int32_t r_mid, int32_t hw, int32_t angle, int8_t dir,
+                    lv_draw_line_cap_t cap, lv_draw_scan_shape_t * shape);
+#if USE_LV_IMG
+static bool img_get_upscale(const lv_area_t * coords, lv_area_t * coord_aa, const lv_img_raw_header_t * header);
+static lv_fs_res_t img_draw_dec(const lv_area_t * coord_aa, const lv_area_t * mask_com, const lv_style_t * style,
+                                const lv_img_raw_header_t * header, bool upscale, lv_fs_file_t * file, const void * src, uint32_t src_size);
+static lv_fs_res_t img_px_open(img_px_t * px, const char * fn);
+static lv_fs_res_t img_px_read_rows(img_px_t * px, lv_coord_t y1, lv_coord_t y2);
+static void img_px_close(img_px_t * px);
+#endif
+static bool sw_rect(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style);
+static void lv_draw_rect_main_mid(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style, const lv_draw_grad_t * grad);
+static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style, const lv_draw_grad_t * grad);
+static lv_color_t lv_draw_rect_row_color(const lv_area_t * coords, const lv_style_t * style, const lv_draw_grad_t * grad, lv_coord_t y);
 static void lv_draw_rect_border_straight(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style);
 static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style);
-#if USE_LV_SHADOW
+#if LV_DRAW_RECT_AA
+static void draw_cover_row(lv_coord_t x, lv_coord_t y, int8_t dir, const lv_opa_t * cover, lv_coord_t len,
+                           const lv_area_t * mask, lv_color_t color, lv_opa_t opa);
+#endif
+#if USE_LV_SHADOW && LV_VDB_SIZE
 static void lv_draw_rect_shadow(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style);
 static void lv_draw_cont_shadow_full(const lv_area_t * coords, const lv_area_t * mask, const  lv_style_t * style);
 static void lv_draw_cont_shadow_bottom(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style);
@@ -54,36 +124,45 @@ static void lv_draw_cont_shadow_full_straight(const lv_area_t * coords, const lv
 static uint16_t lv_draw_cont_radius_corr(uint16_t r, lv_coord_t w, lv_coord_t h);
 
 
-#if USE_LV_TRIANGLE != 0
-static void point_swap(lv_point_t * p1, lv_point_t * p2);
-#endif
-
 /**********************
  *  STATIC VARIABLES
  **********************/
-#if LV_VDB_SIZE != 0
-static void (*px_fp)(lv_coord_t x, lv_coord_t y, const lv_area_t * mask, lv_color_t color, lv_opa_t opa) = lv_vpx;
-static void (*fill_fp)(const lv_area_t * coords, const lv_area_t * mask, lv_color_t color, lv_opa_t opa) =  lv_vfill;
-static void (*letter_fp)(const lv_point_t * pos_p, const lv_area_t * mask, const lv_font_t * font_p, uint32_t letter, lv_color_t color, lv_opa_t opa) = lv_vletter;
-static void (*map_fp)(const lv_area_t * coords, const lv_area_t * mask, const lv_color_t * map_p, lv_opa_t opa, bool transp, bool upscale, lv_color_t recolor, lv_opa_t recolor_opa) = lv_vmap;
-#else
-static void (*px_fp)(lv_coord_t x, lv_coord_t y, const lv_area_t * mask, lv_color_t color, lv_opa_t opa) = lv_rpx;
-static void (*fill_fp)(const lv_area_t * coords, const lv_area_t * mask, lv_color_t color, lv_opa_t opa) =  lv_rfill;
-static void (*letter_fp)(const lv_point_t * pos_p, const lv_area_t * mask, const lv_font_t * font_p, uint32_t letter, lv_color_t color, lv_opa_t opa) = lv_rletter;
-#if USE_LV_IMG
-static void (*map_fp)(const lv_area_t * coords, const lv_area_t * mask, const lv_color_t * map_p, lv_opa_t opa, bool transp, bool upscale, lv_color_t recolor, lv_opa_t recolor_opa) = lv_rmap;
-#endif
-#endif
+/*The software drawing. It draws the operations which the display's draw backend doesn't handle*/
+static const lv_draw_backend_t sw_backend = {
+    .caps = LV_DRAW_CAP_PX | LV_DRAW_CAP_FILL | LV_DRAW_CAP_LETTER | LV_DRAW_CAP_MAP | LV_DRAW_CAP_LINE | LV_DRAW_CAP_RECT |
+            LV_DRAW_CAP_POLYLINE | LV_DRAW_CAP_POLYGON | LV_DRAW_CAP_ARC,
+    .px = sw_px,
+    .fill = sw_fill,
+    .letter = sw_letter,
+    .map = sw_map,
+    .line = sw_line,
+    .rect = sw_rect,
+    .polyline = sw_polyline,
+    .polygon = sw_polygon,
+    .arc = sw_arc,
+};
 
 
 /**********************
  *      MACROS
  **********************/
+/*True if the draw backend has the hook of a capability*/
+#define DRAW_BACKEND_HAS(backend, cap)  ((backend) != NULL && ((backend)->caps & (cap)) != 0)
 
 /**********************
  *   GLOBAL FUNCTIONS
  **********************/
 
+/**
+ * Get the software drawing as a draw backend (it has every capability).
+ * Useful for backends which forward the operations (e.g. to trace them).
+ * @return pointer to the software draw backend
+ */
+const lv_draw_backend_t * lv_draw_get_sw_backend(void)
+{
+    return &sw_backend;
+}
+
 /**
  * Draw a rectangle 
  * @param coords the coordinates of the rectangle
@@ -94,152 +173,51 @@ void lv_draw_rect(const lv_area_t * coords, const lv_area_t * mask, const lv_sty
 {
     if(lv_area_get_height(coords) < 1 || lv_area_get_width(coords) < 1) return;
 
-    lv_area_t coord_aa;
-    lv_area_t mask_aa;
-#if LV_ANTIALIAS == 0
-    lv_area_copy(&coord_aa, coords);
-    lv_area_copy(&mask_aa, mask);
-#else
-    coord_aa.x1 = coords->x1 << LV_AA;
-    coord_aa.y1 = coords->y1 << LV_AA;
-    coord_aa.x2 = (coords->x2 << LV_AA) + 1;
-    coord_aa.y2 = (coords->y2 << LV_AA) + 1;
-
-    mask_aa.x1 = mask->x1 << LV_AA;
-    mask_aa.y1 = mask->y1 << LV_AA;
-    mask_aa.x2 = (mask->x2 << LV_AA) + 1;
-    mask_aa.y2 = (mask->y2 << LV_AA) + 1;
-#endif
-
-#if USE_LV_SHADOW && LV_VDB_SIZE
-    if(style->body.shadow.width != 0) {
-        lv_draw_rect_shadow(&coord_aa, &mask_aa, style);
+    const lv_draw_backend_t * backend = lv_disp_get_draw_backend();
+    if(DRAW_BACKEND_HAS(backend, LV_DRAW_CAP_RECT)) {
+        if(backend->rect(coords, mask, style) != false) return;
     }
-#endif
-    if(style->body.empty == 0){
-        lv_draw_rect_main_mid(&coord_aa, &mask_aa, style);
 
-        if(style->body.radius != 0) {
-            lv_draw_rect_main_corner(&coord_aa, &mask_aa, style);
-        }
-    } 
-    
-    if(style->body.border.width != 0 && style->body.border.part != LV_BORDER_NONE) {
-        lv_draw_rect_border_straight(&coord_aa, &mask_aa, style);
+    sw_rect(coords, mask, style);
+}
 
-        if(style->body.radius != 0) {
-            lv_draw_rect_border_corner(&coord_aa, &mask_aa, style);
-        }
+/**
+ * Fill a polygon (also concave or self-intersecting) with 'body.main_color' and 'body.opa' of a style
+ * @param points array of the vertices (the last vertex is connected to the first one)
+ * @param point_num number of vertices
+ * @param mask the polygon will be drawn only in this mask
+ * @param style pointer to a style
+ * @param rule the fill rule of the self-intersecting parts
+ */
+void lv_draw_polygon(const lv_point_t * points, uint16_t point_num, const lv_area_t * mask, const lv_style_t * style,
+                     lv_draw_fill_rule_t rule)
+{
+    if(point_num < 3) return;
+
+    const lv_draw_backend_t * backend = lv_disp_get_draw_backend();
+    if(DRAW_BACKEND_HAS(backend, LV_DRAW_CAP_POLYGON)) {
+        if(backend->polygon(points, point_num, mask, style, rule) != false) return;
     }
+
+    sw_polygon(points, point_num, mask, style, rule);
 }
 
-#if USE_LV_TRIANGLE != 0
 /**
- *
+ * Fill a triangle
  * @param points pointer to an array with 3 points
  * @param mask the triangle will be drawn only in this mask
  * @param color color of the triangle
  */
 void lv_draw_triangle(const lv_point_t * points, const lv_area_t * mask, lv_color_t color)
 {
-    lv_point_t tri[3];
-
-    memcpy(tri, points, sizeof(tri));
-
-    /*Sort the vertices according to their y coordinate (0: y max, 1: y mid, 2:y min)*/
-    if(tri[1].y < tri[0].y) point_swap(&tri[1], &tri[0]);
-    if(tri[2].y < tri[1].y) point_swap(&tri[2], &tri[1]);
-    if(tri[1].y < tri[0].y) point_swap(&tri[1], &tri[0]);
-
-    /*Return is the triangle is degenerated*/
-    if(tri[0].x == tri[1].x && tri[0].y == tri[1].y) return;
-    if(tri[1].x == tri[2].x && tri[1].y == tri[2].y) return;
-    if(tri[0].x == tri[2].x && tri[0].y == tri[2].y) return;
-
-    if(tri[0].x == tri[1].x && tri[1].x == tri[2].x) return;
-    if(tri[0].y == tri[1].y && tri[1].y == tri[2].y) return;
-
-    /*Draw the triangle*/
-    lv_point_t edge1;
-    lv_coord_t dx1 = LV_MATH_ABS(tri[0].x - tri[1].x);
-    lv_coord_t sx1 = tri[0].x < tri[1].x ? 1 : -1;
-    lv_coord_t dy1 = LV_MATH_ABS(tri[0].y - tri[1].y);
-    lv_coord_t sy1 = tri[0].y < tri[1].y ? 1 : -1;
-    lv_coord_t err1 = (dx1 > dy1 ? dx1 : -dy1) / 2;
-    lv_coord_t err_tmp1;
-
-    lv_point_t edge2;
-    lv_coord_t dx2 = LV_MATH_ABS(tri[0].x - tri[2].x);
-    lv_coord_t sx2 = tri[0].x < tri[2].x ? 1 : -1;
-    lv_coord_t dy2 = LV_MATH_ABS(tri[0].y - tri[2].y);
-    lv_coord_t sy2 = tri[0].y < tri[2].y ? 1 : -1;
-    lv_coord_t err2 = (dx1 > dy2 ? dx2 : -dy2) / 2;
-    lv_coord_t err_tmp2;
-
-    lv_coord_t y1_tmp;
-    lv_coord_t y2_tmp;
-
-    edge1.x = tri[0].x;
-    edge1.y = tri[0].y;
-    edge2.x = tri[0].x;
-    edge2.y = tri[0].y;
-    lv_area_t act_area;
-    lv_area_t draw_area;
-
-    while(1) {
-        act_area.x1 = edge1.x;
-        act_area.x2 = edge2.x ;
-        act_area.y1 = edge1.y;
-        act_area.y2 = edge2.y ;
-
-
-        draw_area.x1 = LV_MATH_MIN(act_area.x1, act_area.x2);
-        draw_area.x2 = LV_MATH_MAX(act_area.x1, act_area.x2);
-        draw_area.y1 = LV_MATH_MIN(act_area.y1, act_area.y2);
-        draw_area.y2 = LV_MATH_MAX(act_area.y1, act_area.y2);
-        draw_area.x2--; /*Do not draw most right pixel because it will be drawn by the adjacent triangle*/
-        fill_fp(&draw_area, mask, color, LV_OPA_50);
-
-        /*Calc. the next point of edge1*/
-        y1_tmp = edge1.y;
-        do {
-            if (edge1.x == tri[1].x && edge1.y == tri[1].y) {
-
-                dx1 = LV_MATH_ABS(tri[1].x - tri[2].x);
-                sx1 = tri[1].x < tri[2].x ? 1 : -1;
-                dy1 = LV_MATH_ABS(tri[1].y - tri[2].y);
-                sy1 = tri[1].y < tri[2].y ? 1 : -1;
-                err1 = (dx1 > dy1 ? dx1 : -dy1) / 2;
-            }
-            else if (edge1.x == tri[2].x && edge1.y == tri[2].y) return;
-            err_tmp1 = err1;
-            if (err_tmp1 >-dx1) {
-                err1 -= dy1;
-                edge1.x += sx1;
-            }
-            if (err_tmp1 < dy1) {
-                err1 += dx1;
-                edge1.y += sy1;
-            }
-        } while(edge1.y == y1_tmp);
-
-        /*Calc. the next point of edge2*/
-        y2_tmp = edge2.y;
-        do {
-            if (edge2.x == tri[2].x && edge2.y == tri[2].y) return;
-            err_tmp2 = err2;
-            if (err_tmp2 > -dx2) {
-                err2 -= dy2;
-                edge2.x += sx2;
-            }
-            if (err_tmp2 < dy2) {
-                err2 += dx2;
-                edge2.y += sy2;
-            }
-        } while(edge2.y == y2_tmp);
-    }
+    lv_style_t style;
+    lv_style_copy(&style, &lv_style_plain);
+    style.body.main_color = color;
+    style.body.grad_color = color;
+    style.body.opa = LV_OPA_COVER;
+
+    lv_draw_polygon(points, 3, mask, &style, LV_DRAW_FILL_RULE_NONZERO);
 }
-#endif
 
 /**
  * Write a text
@@ -357,8 +335,13 @@ void lv_draw_label(const lv_area_t * coords,const lv_area_t * mask, const lv_sty
             lv_color_t color = style->text.color;
 
             if(cmd_state == CMD_STATE_IN) color = recolor;
-            letter_fp(&pos, &mask_aa, font, letter, color, style->text.opa);
-            letter_w = lv_font_get_width(font, letter) >> LV_FONT_ANTIALIAS;
+
+            /*Get the bitmap and the width of the letter with one lookup*/
+            lv_font_glyph_dsc_t glyph;
+            if(lv_font_get_glyph_dsc(font, letter, &glyph) != false) {
+                draw_letter(&pos, &mask_aa, font, letter, &glyph, color, style->text.opa);
+            }
+            letter_w = glyph.w >> LV_FONT_ANTIALIAS;
 
             pos.x += letter_w + (style->text.letter_space << LV_AA);
             /* Round error occurs in x position
@@ -385,294 +368,1154 @@ void lv_draw_label(const lv_area_t * coords,const lv_area_t * mask, const lv_sty
 
 #if USE_LV_IMG
 /**
- * Draw an image
+ * Draw an image
+ * @param coords the coordinates of the image
+ * @param mask the image will be drawn only in this area
+ * @param map_p pointer to a lv_color_t array which contains the pixels of the image
+ * @param opa opacity of the image (0..255)
+ */
+void lv_draw_img(const lv_area_t * coords, const lv_area_t * mask,
+             const lv_style_t * style, const char * fn)
+{
+    if(fn == NULL) {
+        lv_draw_rect(coords, mask, &lv_style_plain);
+        lv_draw_label(coords, mask, &lv_style_plain, "No data", LV_TXT_FLAG_NONE, NULL);
+    } else {
+        lv_area_t coord_aa;
+        lv_area_t mask_aa;
+
+#if LV_ANTIALIAS == 0
+        lv_area_copy(&coord_aa, coords);
+        lv_area_copy(&mask_aa, mask);
+#else
+        coord_aa.x1 = coords->x1 << LV_AA;
+        coord_aa.y1 = coords->y1 << LV_AA;
+        coord_aa.x2 = (coords->x2 << LV_AA) + 1;
+        coord_aa.y2 = (coords->y2 << LV_AA) + 1;
+
+        mask_aa.x1 = mask->x1 << LV_AA;
+        mask_aa.y1 = mask->y1 << LV_AA;
+        mask_aa.x2 = (mask->x2 << LV_AA) + 1;
+        mask_aa.y2 = (mask->y2 << LV_AA) + 1;
+#endif
+
+        lv_area_t mask_com;    /*Common area of mask and cords*/
+        bool union_ok;
+        union_ok = lv_area_union(&mask_com, &mask_aa, &coord_aa);
+        if(union_ok == false) return;
+
+        /*Draw the decoded pixels from the cache without touching the file*/
+        const lv_draw_img_cache_entry_t * cached = lv_draw_img_cache_open(fn);
+        if(cached != NULL) {
+            bool upscale = img_get_upscale(coords, &coord_aa, &cached->header);
+            draw_map(&coord_aa, &mask_com, cached->data, cached->alpha, style->image.opa, cached->header.transp, upscale,
+                     style->image.color, style->image.intense);
+            lv_draw_img_cache_close(cached);
+            return;
+        }
+
+        lv_fs_file_t file;
+        lv_img_raw_header_t header;
+        lv_fs_res_t res = lv_fs_open(&file, fn, LV_FS_MODE_RD);
+        if(res == LV_FS_RES_OK) {
+            uint32_t br;
+            res = lv_fs_read(&file, &header, sizeof(lv_img_raw_header_t), &br);
+            if(res == LV_FS_RES_OK && br != sizeof(lv_img_raw_header_t)) res = LV_FS_RES_UNKNOWN;
+        }
+
+        if(res == LV_FS_RES_OK) {
+            /*If the width is greater then real img. width then it is upscaled */
+            bool upscale = img_get_upscale(coords, &coord_aa, &header);
+
+            /*If the driver keeps the file in the memory (e.g. RAM or mapped file)
+             * then do not use FS reading just a pointer*/
+            const void * f_data;
+            uint32_t f_size;
+            if(lv_fs_get_ptr(&file, &f_data) != LV_FS_RES_OK ||
+               lv_fs_size(&file, &f_size) != LV_FS_RES_OK) {
+                f_data = NULL;
+                f_size = 0;
+            }
+
+            uint32_t px_num = (uint32_t)header.w * header.h;
+            uint32_t map_size = px_num * sizeof(lv_color_t) + sizeof(lv_img_raw_header_t);
+            if(header.format == LV_IMG_FORMAT_ALPHA) map_size += px_num * sizeof(lv_opa_t);
+
+            if(f_data != NULL && f_size >= map_size &&
+               (header.format == LV_IMG_FORMAT_RAW || header.format == LV_IMG_FORMAT_ALPHA)) {
+                const uint8_t * map_p = f_data;
+                map_p += sizeof(lv_img_raw_header_t);
+                const lv_opa_t * alpha_p = NULL;
+                if(header.format == LV_IMG_FORMAT_ALPHA) alpha_p = map_p + px_num * sizeof(lv_color_t);  /*After the colors*/
+                draw_map(&coord_aa, &mask_com, (const lv_color_t *)map_p, alpha_p, style->image.opa, header.transp, upscale, style->image.color, style->image.intense);
+            }
+            /*Decode only the rows and columns in the mask (read with the FS interface if there is no pointer)*/
+            else {
+                res = img_draw_dec(&coord_aa, &mask_com, style, &header, upscale, &file, f_data, f_size);
+            }
+        }
+
+        lv_fs_close(&file);
+
+        if(res != LV_FS_RES_OK) {
+            lv_draw_rect(coords, mask, &lv_style_plain);
+            lv_draw_label(coords, mask, &lv_style_plain, "No data", LV_TXT_FLAG_NONE, NULL);
+        }
+    }
+}
+
+/**
+ * Draw a scaled and rotated image.
+ * The image rows sampled in the mask are decoded into a temporary buffer on every call
+ * unless the image is raw in the memory of its driver or it's in the image cache (LV_IMG_CACHE_SIZE).
+ * @param coords the coordinates of the image without transformation
+ * @param mask the image will be drawn only in this area
+ * @param style pointer to a style
+ * @param fn path of the image file
+ * @param zoom scale in 1 / LV_IMG_ZOOM_NONE units (LV_IMG_ZOOM_NONE: 'coords' size)
+ * @param angle clockwise rotation in 1 / (1 << TRIGO_ANGLE_SHIFT) degrees
+ * @param pivot scale and rotate around this point (relative to the top left corner of 'coords')
+ * @param antialias true: bilinear filtering, false: nearest pixel (faster)
+ */
+void lv_draw_img_transformed(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
+                             const char * fn, uint16_t zoom, int32_t angle, const lv_point_t * pivot, bool antialias)
+{
+    /*Nothing to transform: draw it with the faster way*/
+    if(zoom == LV_IMG_ZOOM_NONE && angle % ((int32_t)360 << TRIGO_ANGLE_SHIFT) == 0) {
+        lv_draw_img(coords, mask, style, fn);
+        return;
+    }
+
+    if(fn == NULL) {
+        lv_draw_img(coords, mask, style, fn);       /*Draws "No data"*/
+        return;
+    }
+
+    lv_area_t coord_aa;
+    lv_area_t mask_aa;
+    lv_point_t pivot_aa;
+
+#if LV_ANTIALIAS == 0
+    lv_area_copy(&coord_aa, coords);
+    lv_area_copy(&mask_aa, mask);
+#else
+    coord_aa.x1 = coords->x1 << LV_AA;
+    coord_aa.y1 = coords->y1 << LV_AA;
+    coord_aa.x2 = (coords->x2 << LV_AA) + 1;
+    coord_aa.y2 = (coords->y2 << LV_AA) + 1;
+
+    mask_aa.x1 = mask->x1 << LV_AA;
+    mask_aa.y1 = mask->y1 << LV_AA;
+    mask_aa.x2 = (mask->x2 << LV_AA) + 1;
+    mask_aa.y2 = (mask->y2 << LV_AA) + 1;
+#endif
+    pivot_aa.x = (coords->x1 + pivot->x) << LV_AA;
+    pivot_aa.y = (coords->y1 + pivot->y) << LV_AA;
+
+    img_px_t px;
+    lv_fs_res_t res = img_px_open(&px, fn);
+    if(res != LV_FS_RES_OK) {
+        lv_draw_rect(coords, mask, &lv_style_plain);
+        lv_draw_label(coords, mask, &lv_style_plain, "No data", LV_TXT_FLAG_NONE, NULL);
+        return;
+    }
+
+    /*The doubled coordinates cover the image in double size (upscaled) or in original size (large image)*/
+    lv_draw_img_trans_t trans;
+    lv_draw_img_trans_init(&trans, &px.header, &coord_aa, &pivot_aa, zoom, angle, antialias);
+
+    /*Get only the image rows which are sampled in the mask*/
+    lv_area_t trans_area;
+    lv_area_t mask_com;
+    lv_coord_t row1;
+    lv_coord_t row2;
+    lv_draw_img_trans_get_area(&trans, &trans_area);
+    bool visible = lv_area_union(&mask_com, &mask_aa, &trans_area);
+    if(visible != false) visible = lv_draw_img_trans_get_rows(&trans, &mask_com, &row1, &row2);
+    if(visible != false) res = img_px_read_rows(&px, row1, row2);
+
+    if(res != LV_FS_RES_OK) {
+        img_px_close(&px);
+        lv_draw_rect(coords, mask, &lv_style_plain);
+        lv_draw_label(coords, mask, &lv_style_plain, "No data", LV_TXT_FLAG_NONE, NULL);
+        return;
+    }
+
+    if(visible != false) {
+        lv_draw_img_trans_set_data(&trans, px.data, px.alpha, px.row_first);
+
+        lv_coord_t buf_len = lv_area_get_width(&mask_com);
+        lv_color_t buf[buf_len];
+        lv_opa_t alpha[buf_len];
+
+        /*Sample only the pixels of the rows which are on the image and in the mask*/
+        lv_area_t line;
+        lv_coord_t y;
+        for(y = mask_com.y1; y <= mask_com.y2; y++) {
+            if(lv_draw_img_trans_get_span(&trans, y, &line.x1, &line.x2) == false) continue;
+            if(line.x1 < mask_com.x1) line.x1 = mask_com.x1;
+            if(line.x2 > mask_com.x2) line.x2 = mask_com.x2;
+            if(line.x1 > line.x2) continue;
+
+            line.y1 = y;
+            line.y2 = y;
+            lv_draw_img_trans_row(&trans, line.x1, y, lv_area_get_width(&line), buf, alpha);
+            draw_map(&line, &mask_com, buf, alpha, style->image.opa, false, false,
+                     style->image.color, style->image.intense);
+        }
+    }
+
+    img_px_close(&px);
+}
+#endif
+
+/**
+ * Copy a color map (e.g. a previously drawn area) to the display
+ * @param coords the coordinates of the map
+ * @param mask the map will be drawn only in this area
+ * @param map_p pointer to a lv_color_t array which contains the pixels of 'coords'
+ *              (in double size if LV_ANTIALIAS is enabled)
+ * @param opa opacity of the map (0..255)
+ */
+void lv_draw_map(const lv_area_t * coords, const lv_area_t * mask, const lv_color_t * map_p, lv_opa_t opa)
+{
+    lv_area_t coord_aa;
+    lv_area_t mask_aa;
+
+#if LV_ANTIALIAS == 0
+    lv_area_copy(&coord_aa, coords);
+    lv_area_copy(&mask_aa, mask);
+#else
+    coord_aa.x1 = coords->x1 << LV_AA;
+    coord_aa.y1 = coords->y1 << LV_AA;
+    coord_aa.x2 = (coords->x2 << LV_AA) + 1;
+    coord_aa.y2 = (coords->y2 << LV_AA) + 1;
+
+    mask_aa.x1 = mask->x1 << LV_AA;
+    mask_aa.y1 = mask->y1 << LV_AA;
+    mask_aa.x2 = (mask->x2 << LV_AA) + 1;
+    mask_aa.y2 = (mask->y2 << LV_AA) + 1;
+#endif
+
+    draw_map(&coord_aa, &mask_aa, map_p, NULL, opa, false, false, LV_COLOR_BLACK, LV_OPA_TRANSP);
+}
+
+
+/**
+ * Draw a line
+ * @param p1 first point of the line
+ * @param p2 second point of the line
+ * @param maskthe line will be drawn only on this area
+ * @param lines_p pointer to a line style
+ */
+void lv_draw_line(const lv_point_t * p1, const lv_point_t * p2, const lv_area_t * mask,
+                  const lv_style_t * style)
+{
+
+	if(style->line.width == 0) return;
+	if(p1->x == p2->x && p1->y == p2->y) return;
+
+    const lv_draw_backend_t * backend = lv_disp_get_draw_backend();
+    if(DRAW_BACKEND_HAS(backend, LV_DRAW_CAP_LINE)) {
+        if(backend->line(p1, p2, mask, style) != false) return;
+    }
+
+    sw_line(p1, p2, mask, style);
+}
+
+/**
+ * Draw connected lines. The joints are drawn once so a transparent polyline has uniform opacity.
+ * @param points array of points
+ * @param point_num number of points in 'points'
+ * @param mask the polyline will be drawn only on this area
+ * @param style pointer to a style (the 'line' part is used)
+ * @param cap shape of the ends of the polyline
+ * @param join shape of the joints of the segments
+ */
+void lv_draw_polyline(const lv_point_t * points, uint16_t point_num, const lv_area_t * mask,
+                      const lv_style_t * style, lv_draw_line_cap_t cap, lv_draw_line_join_t join)
+{
+    if(style->line.width == 0) return;
+    if(point_num < 2) return;
+
+    const lv_draw_backend_t * backend = lv_disp_get_draw_backend();
+    if(DRAW_BACKEND_HAS(backend, LV_DRAW_CAP_POLYLINE)) {
+        if(backend->polyline(points, point_num, mask, style, cap, join) != false) return;
+    }
+
+    sw_polyline(points, point_num, mask, style, cap, join);
+}
+
+/**
+ * Draw an arc (a part of a ring) with the 'line' part of a style. The ring is 'line.width' thick inside 'radius'.
+ * @param center center of the circle
+ * @param radius outer radius of the ring
+ * @param start_angle start angle in 1 / (1 << TRIGO_ANGLE_SHIFT) degrees (0 is on the right, it grows clockwise)
+ * @param end_angle end angle in 1 / (1 << TRIGO_ANGLE_SHIFT) degrees (a full ring if it's 360 degrees after 'start_angle')
+ * @param mask the arc will be drawn only in this mask
+ * @param style pointer to a style
+ * @param cap shape of the ends of the arc
+ */
+void lv_draw_arc(const lv_point_t * center, lv_coord_t radius, int32_t start_angle, int32_t end_angle,
+                 const lv_area_t * mask, const lv_style_t * style, lv_draw_line_cap_t cap)
+{
+    if(style->line.width == 0 || radius <= 0) return;
+    if(start_angle == end_angle) return;
+
+    const lv_draw_backend_t * backend = lv_disp_get_draw_backend();
+    if(DRAW_BACKEND_HAS(backend, LV_DRAW_CAP_ARC)) {
+        if(backend->arc(center, radius, start_angle, end_angle, mask, style, cap) != false) return;
+    }
+
+    sw_arc(center, radius, start_angle, end_angle, mask, style, cap);
+}
+
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if USE_LV_SHADOW && LV_VDB_SIZE
+/**
+ * Draw a pixel with the draw backend of the active display or with the software
+ * @param x pixel x coordinate
+ * @param y pixel y coordinate
+ * @param mask the pixel will be drawn only in this area
+ * @param color pixel color
+ * @param opa opacity of the pixel (0..255)
+ */
+static void draw_px(lv_coord_t x, lv_coord_t y, const lv_area_t * mask, lv_color_t color, lv_opa_t opa)
+{
+    const lv_draw_backend_t * backend = lv_disp_get_draw_backend();
+    if(DRAW_BACKEND_HAS(backend, LV_DRAW_CAP_PX)) {
+        if(backend->px(x, y, mask, color, opa) != false) return;
+    }
+
+    sw_px(x, y, mask, color, opa);
+}
+#endif
+
+/**
+ * Fill an area with the draw backend of the active display or with the software
+ * @param coords coordinates of the area to fill
+ * @param mask fill only on this area
+ * @param color fill color
+ * @param opa opacity of the area (0..255)
+ */
+static void draw_fill(const lv_area_t * coords, const lv_area_t * mask, lv_color_t color, lv_opa_t opa)
+{
+    const lv_draw_backend_t * backend = lv_disp_get_draw_backend();
+    if(DRAW_BACKEND_HAS(backend, LV_DRAW_CAP_FILL)) {
+        if(backend->fill(coords, mask, color, opa) != false) return;
+    }
+
+    sw_fill(coords, mask, color, opa);
+}
+
+/**
+ * Draw a letter with the draw backend of the active display or with the software
+ * @param pos_p left-top coordinate of the letter
+ * @param mask the letter will be drawn only on this area
+ * @param font_p pointer to font
+ * @param letter a letter to draw
+ * @param glyph_p the description of the letter in the font (the software draws it without a new lookup)
+ * @param color color of letter
+ * @param opa opacity of letter (0..255)
+ */
+static void draw_letter(const lv_point_t * pos_p, const lv_area_t * mask, const lv_font_t * font_p, uint32_t letter, const lv_font_glyph_dsc_t * glyph_p, lv_color_t color, lv_opa_t opa)
+{
+    const lv_draw_backend_t * backend = lv_disp_get_draw_backend();
+    if(DRAW_BACKEND_HAS(backend, LV_DRAW_CAP_LETTER)) {
+        if(backend->letter(pos_p, mask, font_p, letter, color, opa) != false) return;
+    }
+
+    sw_glyph(pos_p, mask, glyph_p, color, opa);
+}
+
+/**
+ * Draw a color map with the draw backend of the active display or with the software
+ * @param coords coordinates the color map
+ * @param mask the map will drawn only on this area
+ * @param map_p pointer to a lv_color_t array
+ * @param alpha_p pointer to the opacity of the pixels of 'map_p' or NULL
+ * @param opa opacity of the map
+ * @param transp true: enable transparency of LV_IMG_LV_COLOR_TRANSP color pixels
+ * @param upscale true: upscale to double size
+ * @param recolor mix the pixels with this color
+ * @param recolor_opa the intense of recoloring
+ */
+static void draw_map(const lv_area_t * coords, const lv_area_t * mask, const lv_color_t * map_p, const lv_opa_t * alpha_p, lv_opa_t opa, bool transp, bool upscale, lv_color_t recolor, lv_opa_t recolor_opa)
+{
+    const lv_draw_backend_t * backend = lv_disp_get_draw_backend();
+    if(DRAW_BACKEND_HAS(backend, LV_DRAW_CAP_MAP)) {
+        if(backend->map(coords, mask, map_p, alpha_p, opa, transp, upscale, recolor, recolor_opa) != false) return;
+    }
+
+    sw_map(coords, mask, map_p, alpha_p, opa, transp, upscale, recolor, recolor_opa);
+}
+
+/*The basic software operations draw into the VDB or directly to the display if there is no VDB*/
+static bool sw_px(lv_coord_t x, lv_coord_t y, const lv_area_t * mask, lv_color_t color, lv_opa_t opa)
+{
+#if LV_VDB_SIZE != 0
+    lv_vpx(x, y, mask, color, opa);
+#else
+    lv_rpx(x, y, mask, color, opa);
+#endif
+    return true;
+}
+
+static bool sw_fill(const lv_area_t * coords, const lv_area_t * mask, lv_color_t color, lv_opa_t opa)
+{
+#if LV_VDB_SIZE != 0
+    lv_vfill(coords, mask, color, opa);
+#else
+    lv_rfill(coords, mask, color, opa);
+#endif
+    return true;
+}
+
+static bool sw_letter(const lv_point_t * pos_p, const lv_area_t * mask, const lv_font_t * font_p, uint32_t letter, lv_color_t color, lv_opa_t opa)
+{
+    if(font_p == NULL) return true;
+
+    lv_font_glyph_dsc_t glyph;
+    if(lv_font_get_glyph_dsc(font_p, letter, &glyph) != false) {
+        sw_glyph(pos_p, mask, &glyph, color, opa);
+    }
+    return true;
+}
+
+/*Draw a letter which is already looked up in its font*/
+static void sw_glyph(const lv_point_t * pos_p, const lv_area_t * mask, const lv_font_glyph_dsc_t * glyph_p, lv_color_t color, lv_opa_t opa)
+{
+#if LV_VDB_SIZE != 0
+    lv_vletter(pos_p, mask, glyph_p, color, opa);
+#else
+    lv_rletter(pos_p, mask, glyph_p, color, opa);
+#endif
+}
+
+static bool sw_map(const lv_area_t * coords, const lv_area_t * mask, const lv_color_t * map_p, const lv_opa_t * alpha_p, lv_opa_t opa, bool transp, bool upscale, lv_color_t recolor, lv_opa_t recolor_opa)
+{
+#if LV_VDB_SIZE != 0
+    lv_vmap(coords, mask, map_p, alpha_p, opa, transp, upscale, recolor, recolor_opa);
+#else
+    lv_rmap(coords, mask, map_p, alpha_p, opa, transp, upscale, recolor, recolor_opa);
+#endif
+    return true;
+}
+
+/**
+ * Draw a rectangle with the software
+ * @param coords the coordinates of the rectangle
+ * @param mask the rectangle will be drawn only in this mask
+ * @param style pointer to a style
+ * @return true (always handled)
+ */
+static bool sw_rect(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style)
+{
+    lv_area_t coord_aa;
+    lv_area_t mask_aa;
+#if LV_ANTIALIAS == 0
+    lv_area_copy(&coord_aa, coords);
+    lv_area_copy(&mask_aa, mask);
+#else
+    coord_aa.x1 = coords->x1 << LV_AA;
+    coord_aa.y1 = coords->y1 << LV_AA;
+    coord_aa.x2 = (coords->x2 << LV_AA) + 1;
+    coord_aa.y2 = (coords->y2 << LV_AA) + 1;
+
+    mask_aa.x1 = mask->x1 << LV_AA;
+    mask_aa.y1 = mask->y1 << LV_AA;
+    mask_aa.x2 = (mask->x2 << LV_AA) + 1;
+    mask_aa.y2 = (mask->y2 << LV_AA) + 1;
+#endif
+
+#if USE_LV_SHADOW && LV_VDB_SIZE
+    if(style->body.shadow.width != 0) {
+        lv_draw_rect_shadow(&coord_aa, &mask_aa, style);
+    }
+#endif
+    if(style->body.empty == 0){
+        /*Mix the colors of the gradient's rows only once for the whole body*/
+        const lv_draw_grad_t * grad = NULL;
+        if(style->body.main_color.full != style->body.grad_color.full) {
+            grad = lv_draw_grad_get(style->body.main_color, style->body.grad_color, lv_area_get_height(&coord_aa));
+        }
+
+        lv_draw_rect_main_mid(&coord_aa, &mask_aa, style, grad);
+
+        if(style->body.radius != 0) {
+            lv_draw_rect_main_corner(&coord_aa, &mask_aa, style, grad);
+        }
+
+        if(grad != NULL) lv_draw_grad_release(grad);
+    } 
+    
+    if(style->body.border.width != 0 && style->body.border.part != LV_BORDER_NONE) {
+        lv_draw_rect_border_straight(&coord_aa, &mask_aa, style);
+
+        if(style->body.radius != 0) {
+            lv_draw_rect_border_corner(&coord_aa, &mask_aa, style);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Draw a line with the software
+ * @param p1 first point of the line
+ * @param p2 second point of the line
+ * @param mask the line will be drawn only on this area
+ * @param style pointer to a line style
+ * @return true (always handled)
+ */
+static bool sw_line(const lv_point_t * p1, const lv_point_t * p2, const lv_area_t * mask, const lv_style_t * style)
+{
+    lv_point_t points[2];
+    points[0] = *p1;
+    points[1] = *p2;
+
+    return sw_polyline(points, 2, mask, style, LV_DRAW_LINE_CAP_BUTT, LV_DRAW_LINE_JOIN_MITER);
+}
+
+/**
+ * Draw a polyline with the software. The segments, joints and caps are rasterized together as spans.
+ * @param points array of points
+ * @param point_num number of points in 'points'
+ * @param mask the polyline will be drawn only on this area
+ * @param style pointer to a line style
+ * @param cap shape of the ends of the polyline
+ * @param join shape of the joints of the segments
+ * @return true (always handled)
+ */
+static bool sw_polyline(const lv_point_t * points, uint16_t point_num, const lv_area_t * mask, const lv_style_t * style,
+                        lv_draw_line_cap_t cap, lv_draw_line_join_t join)
+{
+    lv_area_t mask_aa;
+#if LV_ANTIALIAS == 0
+    lv_area_copy(&mask_aa, mask);
+#else
+    mask_aa.x1 = mask->x1 << LV_AA;
+    mask_aa.y1 = mask->y1 << LV_AA;
+    mask_aa.x2 = (mask->x2 << LV_AA) + 1;
+    mask_aa.y2 = (mask->y2 << LV_AA) + 1;
+#endif
+
+    /*Half width in 1/256 pixels*/
+    int32_t hw = ((int32_t)style->line.width << LV_AA) << (LV_DRAW_SCAN_SHIFT - 1);
+
+    /*Draw all segments at once. If there is not enough memory draw the polyline in parts.*/
+    uint16_t seg_num = point_num - 1;
+    uint16_t part_len = seg_num;
+    uint16_t seg_start = 0;
+    while(seg_start < seg_num) {
+        uint16_t seg_end = seg_start + LV_MATH_MIN(part_len, seg_num - seg_start);
+
+        /*A segment and a joint per point, plus the two caps*/
+        lv_draw_scan_shape_t * shapes = lv_mem_alloc((2 * (seg_end - seg_start) + 2) * sizeof(lv_draw_scan_shape_t));
+        if(shapes == NULL) {
+            if(part_len == 1) break;
+            part_len = (part_len + 1) / 2;
+            continue;
+        }
+
+        uint16_t shape_num = line_build(points, point_num, seg_start, seg_end, &mask_aa, hw, cap, join, shapes);
+        lv_draw_scan_fill(shapes, shape_num, &mask_aa, style->line.color, style->line.opa, LV_DRAW_LINE_AA, draw_fill);
+        lv_mem_free(shapes);
+
+        seg_start = seg_end;
+    }
+
+    return true;
+}
+
+/**
+ * Create the shapes of some segments of a polyline. The segments fully out of the mask are skipped.
+ * @param points array of points
+ * @param point_num number of points in 'points'
+ * @param seg_start index of the first segment (the segment 'i' is from 'points[i]' to 'points[i + 1]')
+ * @param seg_end index after the last segment
+ * @param mask the shapes out of this area are skipped (in the drawing's resolution)
+ * @param hw half width of the line in 1/256 pixels (in the drawing's resolution)
+ * @param cap shape of the ends of the polyline
+ * @param join shape of the joints of the segments
+ * @param shapes store the shapes here (space for '2 * (seg_end - seg_start) + 2' shapes)
+ * @return number of stored shapes
+ */
+static uint16_t line_build(const lv_point_t * points, uint16_t point_num, uint16_t seg_start, uint16_t seg_end, const lv_area_t * mask,
+                           int32_t hw, lv_draw_line_cap_t cap, lv_draw_line_join_t join, lv_draw_scan_shape_t * shapes)
+{
+    uint16_t shape_num = 0;
+    lv_coord_t ext = (hw >> LV_DRAW_SCAN_SHIFT) + 2;   /*The segments' pixels are so far from their end points*/
+    lv_area_t tmp;
+    uint16_t i;
+
+    for(i = seg_start; i < seg_end; i++) {
+        const lv_point_t * p1 = &points[i];
+        const lv_point_t * p2 = &points[i + 1];
+        if(p1->x == p2->x && p1->y == p2->y) continue;
+
+        /*The joint at the end of the segment with the next not zero length segment*/
+        uint16_t next = i + 2;
+        while(next < point_num && points[next].x == p2->x && points[next].y == p2->y) next++;
+        bool has_next = next < point_num;
+        if(has_next) {
+            line_join(p1, p2, &points[next], hw, join, &shapes[shape_num]);
+            if(lv_area_union(&tmp, &shapes[shape_num].box, mask)) shape_num++;
+        }
+
+        /*Reject the segment up front if it's out of the mask*/
+        lv_area_t seg_area;
+        seg_area.x1 = (LV_MATH_MIN(p1->x, p2->x) << LV_AA) - ext;
+        seg_area.y1 = (LV_MATH_MIN(p1->y, p2->y) << LV_AA) - ext;
+        seg_area.x2 = (LV_MATH_MAX(p1->x, p2->x) << LV_AA) + ext;
+        seg_area.y2 = (LV_MATH_MAX(p1->y, p2->y) << LV_AA) + ext;
+        if(lv_area_union(&tmp, &seg_area, mask) == false) continue;
+
+        /*The rectangle of the segment*/
+        lv_draw_scan_point_t c1;
+        lv_draw_scan_point_t c2;
+        lv_draw_scan_point_t dir;
+        line_point(p1, &c1);
+        line_point(p2, &c2);
+        line_dir(p1, p2, &dir);
+        int32_t ox = -((int64_t)hw * dir.y) >> LV_DRAW_SCAN_NORM_SHIFT;
+        int32_t oy = ((int64_t)hw * dir.x) >> LV_DRAW_SCAN_NORM_SHIFT;
+
+        lv_draw_scan_point_t quad[4];
+        quad[0].x = c1.x + ox;
+        quad[0].y = c1.y + oy;
+        quad[1].x = c2.x + ox;
+        quad[1].y = c2.y + oy;
+        quad[2].x = c2.x - ox;
+        quad[2].y = c2.y - oy;
+        quad[3].x = c1.x - ox;
+        quad[3].y = c1.y - oy;
+
+        /*The ends are not anti-aliased where a joint, a segment or a cap continues the line*/
+        uint16_t prev = i;
+        while(prev > 0 && points[prev - 1].x == p1->x && points[prev - 1].y == p1->y) prev--;
+        uint8_t hard = 0;
+        if(has_next || cap != LV_DRAW_LINE_CAP_BUTT) hard |= 0x02;
+        if(prev > 0 || cap != LV_DRAW_LINE_CAP_BUTT) hard |= 0x08;
+        lv_draw_scan_polygon(&shapes[shape_num], quad, 4, hard);
+        if(lv_area_union(&tmp, &shapes[shape_num].box, mask)) shape_num++;
+    }
+
+    /*The caps on the two ends (with the direction of the first and last not zero length segments)*/
+    if(cap != LV_DRAW_LINE_CAP_BUTT) {
+        uint16_t other;
+        if(seg_start == 0) {
+            other = 1;
+            while(other < point_num && points[other].x == points[0].x && points[other].y == points[0].y) other++;
+            if(other < point_num) {
+                line_cap(&points[0], &points[other], hw, cap, &shapes[shape_num]);
+                if(lv_area_union(&tmp, &shapes[shape_num].box, mask)) shape_num++;
+            }
+        }
+
+        if(seg_end == point_num - 1) {
+            other = point_num - 1;
+            while(other > 0 && points[other - 1].x == points[point_num - 1].x && points[other - 1].y == points[point_num - 1].y) other--;
+            if(other > 0) {
+                line_cap(&points[point_num - 1], &points[other - 1], hw, cap, &shapes[shape_num]);
+                if(lv_area_union(&tmp, &shapes[shape_num].box, mask)) shape_num++;
+            }
+        }
+    }
+
+    return shape_num;
+}
+
+/**
+ * Create the shape of a cap of a polyline
+ * @param p the end point
+ * @param from the previous point of the line (the cap is on the opposite side)
+ * @param hw half width of the line in 1/256 pixels
+ * @param cap shape of the cap (not LV_DRAW_LINE_CAP_BUTT)
+ * @param shape store the shape here
+ */
+static void line_cap(const lv_point_t * p, const lv_point_t * from, int32_t hw, lv_draw_line_cap_t cap, lv_draw_scan_shape_t * shape)
+{
+    lv_draw_scan_point_t c;
+    line_point(p, &c);
+
+    if(cap == LV_DRAW_LINE_CAP_ROUND) {
+        lv_draw_scan_circle(shape, &c, hw);
+        return;
+    }
+
+    /*Square: a half width long rectangle after the end point*/
+    lv_draw_scan_point_t dir;
+    line_dir(from, p, &dir);
+    int32_t dx = ((int64_t)hw * dir.x) >> LV_DRAW_SCAN_NORM_SHIFT;
+    int32_t dy = ((int64_t)hw * dir.y) >> LV_DRAW_SCAN_NORM_SHIFT;
+
+    lv_draw_scan_point_t quad[4];
+    quad[0].x = c.x - dy;
+    quad[0].y = c.y + dx;
+    quad[1].x = c.x - dy + dx;
+    quad[1].y = c.y + dx + dy;
+    quad[2].x = c.x + dy + dx;
+    quad[2].y = c.y - dx + dy;
+    quad[3].x = c.x + dy;
+    quad[3].y = c.y - dx;
+    lv_draw_scan_polygon(shape, quad, 4, 0x08);     /*The edge on the end of the segment is inside*/
+}
+
+/**
+ * Create the shape which fills the gap on the outer side of a joint
+ * @param prev the point before the joint
+ * @param p the point of the joint
+ * @param next the point after the joint
+ * @param hw half width of the line in 1/256 pixels
+ * @param join shape of the joint
+ * @param shape store the shape here (an empty polygon if the segments are straight)
+ */
+static void line_join(const lv_point_t * prev, const lv_point_t * p, const lv_point_t * next, int32_t hw,
+                      lv_draw_line_join_t join, lv_draw_scan_shape_t * shape)
+{
+    lv_draw_scan_point_t c;
+    line_point(p, &c);
+
+    if(join == LV_DRAW_LINE_JOIN_ROUND) {
+        lv_draw_scan_circle(shape, &c, hw);
+        return;
+    }
+
+    lv_draw_scan_point_t d1;
+    lv_draw_scan_point_t d2;
+    line_dir(prev, p, &d1);
+    line_dir(p, next, &d2);
+
+    /*The normals on the outer side of the turn*/
+    int64_t cross = (int64_t)d1.x * d2.y - (int64_t)d1.y * d2.x;
+    int32_t side = cross > 0 ? -1 : 1;
+    lv_draw_scan_point_t n1;
+    lv_draw_scan_point_t n2;
+    n1.x = -d1.y * side;
+    n1.y = d1.x * side;
+    n2.x = -d2.y * side;
+    n2.y = d2.x * side;
+
+    lv_draw_scan_point_t poly[4];
+    uint8_t poly_num;
+    poly[0] = c;
+    poly[1].x = c.x + (((int64_t)hw * n1.x) >> LV_DRAW_SCAN_NORM_SHIFT);
+    poly[1].y = c.y + (((int64_t)hw * n1.y) >> LV_DRAW_SCAN_NORM_SHIFT);
+    poly[2].x = c.x + (((int64_t)hw * n2.x) >> LV_DRAW_SCAN_NORM_SHIFT);
+    poly[2].y = c.y + (((int64_t)hw * n2.y) >> LV_DRAW_SCAN_NORM_SHIFT);
+    poly_num = 3;
+
+    /*Miter: the tip is where the outer edges meet. Its distance is 'hw / cos(angle / 2)' which is limited.
+     * 1 + cos(angle) = 2 * cos(angle / 2)^2 */
+    int64_t one = (int64_t)1 << (2 * LV_DRAW_SCAN_NORM_SHIFT);
+    int64_t cos_1 = one + (int64_t)n1.x * n2.x + (int64_t)n1.y * n2.y;
+    if(join == LV_DRAW_LINE_JOIN_MITER && cos_1 * LINE_MITER_LIMIT * LINE_MITER_LIMIT >= 2 * one) {
+        poly[3] = poly[2];
+        poly[2].x = c.x + ((int64_t)hw * (n1.x + n2.x) << LV_DRAW_SCAN_NORM_SHIFT) / cos_1;
+        poly[2].y = c.y + ((int64_t)hw * (n1.y + n2.y) << LV_DRAW_SCAN_NORM_SHIFT) / cos_1;
+        poly_num = 4;
+    }
+
+    /*The edges from the joint's point are inside the segments.
+     *Straight or turning back: the polygon has no area*/
+    lv_draw_scan_polygon(shape, poly, poly_num, 0x01 | (1 << (poly_num - 1)));
+}
+
+/**
+ * Convert a point of a line to 1/256 pixels in the drawing's resolution (to the center of the pixel)
+ * @param p pointer to a point
+ * @param res store the result here
+ */
+static void line_point(const lv_point_t * p, lv_draw_scan_point_t * res)
+{
+    res->x = ((int32_t)p->x << (LV_AA + LV_DRAW_SCAN_SHIFT)) + ((LV_DRAW_SCAN_UNIT / 2) << LV_AA);
+    res->y = ((int32_t)p->y << (LV_AA + LV_DRAW_SCAN_SHIFT)) + ((LV_DRAW_SCAN_UNIT / 2) << LV_AA);
+}
+
+/**
+ * Get the direction of a segment as unit vector
+ * @param p1 start point of the segment
+ * @param p2 end point of the segment (not 'p1')
+ * @param dir store the direction here (with 1 << LV_DRAW_SCAN_NORM_SHIFT length)
+ */
+static void line_dir(const lv_point_t * p1, const lv_point_t * p2, lv_draw_scan_point_t * dir)
+{
+    int64_t dx = p2->x - p1->x;
+    int64_t dy = p2->y - p1->y;
+    int64_t len = lv_trigo_sqrt((dx * dx + dy * dy) << (2 * LV_DRAW_SCAN_SHIFT));  /*In 1/256 pixels*/
+
+    dir->x = (dx << (LV_DRAW_SCAN_SHIFT + LV_DRAW_SCAN_NORM_SHIFT)) / len;
+    dir->y = (dy << (LV_DRAW_SCAN_SHIFT + LV_DRAW_SCAN_NORM_SHIFT)) / len;
+}
+
+/**
+ * Fill a polygon with the software
+ * @param points array of the vertices
+ * @param point_num number of vertices
+ * @param mask the polygon will be drawn only in this mask
+ * @param style pointer to a style
+ * @param rule the fill rule of the self-intersecting parts
+ * @return true (it's always drawn)
+ */
+static bool sw_polygon(const lv_point_t * points, uint16_t point_num, const lv_area_t * mask, const lv_style_t * style,
+                       lv_draw_fill_rule_t rule)
+{
+    lv_area_t mask_aa;
+#if LV_ANTIALIAS == 0
+    lv_area_copy(&mask_aa, mask);
+#else
+    mask_aa.x1 = mask->x1 << LV_AA;
+    mask_aa.y1 = mask->y1 << LV_AA;
+    mask_aa.x2 = (mask->x2 << LV_AA) + 1;
+    mask_aa.y2 = (mask->y2 << LV_AA) + 1;
+#endif
+
+    /*The vertices are on the center of the pixels like the points of the lines*/
+    lv_draw_scan_point_t * scan_points = lv_mem_alloc(point_num * sizeof(lv_draw_scan_point_t));
+    if(scan_points == NULL) return true;
+
+    uint16_t i;
+    for(i = 0; i < point_num; i++) {
+        line_point(&points[i], &scan_points[i]);
+    }
+
+    lv_draw_scan_fill_polygon(scan_points, point_num, rule == LV_DRAW_FILL_RULE_EVENODD, &mask_aa,
+                              style->body.main_color, style->body.opa, LV_DRAW_POLYGON_AA, draw_fill);
+
+    lv_mem_free(scan_points);
+
+    return true;
+}
+
+/**
+ * Draw an arc with the software. The pieces of the ring and the caps are rasterized together as spans.
+ * @param center center of the circle
+ * @param radius outer radius of the ring
+ * @param start start angle in 1 / (1 << TRIGO_ANGLE_SHIFT) degrees
+ * @param end end angle in 1 / (1 << TRIGO_ANGLE_SHIFT) degrees
+ * @param mask the arc will be drawn only in this mask
+ * @param style pointer to a style
+ * @param cap shape of the ends of the arc
+ * @return true (it's always drawn)
+ */
+static bool sw_arc(const lv_point_t * center, lv_coord_t radius, int32_t start, int32_t end, const lv_area_t * mask,
+                   const lv_style_t * style, lv_draw_line_cap_t cap)
+{
+    lv_area_t mask_aa;
+#if LV_ANTIALIAS == 0
+    lv_area_copy(&mask_aa, mask);
+#else
+    mask_aa.x1 = mask->x1 << LV_AA;
+    mask_aa.y1 = mask->y1 << LV_AA;
+    mask_aa.x2 = (mask->x2 << LV_AA) + 1;
+    mask_aa.y2 = (mask->y2 << LV_AA) + 1;
+#endif
+
+    int32_t full = (int32_t)360 << TRIGO_ANGLE_SHIFT;
+    int32_t half = (int32_t)180 << TRIGO_ANGLE_SHIFT;
+    int32_t quarter = (int32_t)90 << TRIGO_ANGLE_SHIFT;
+
+    /*'start' in 0..360 degrees and 'end' after it*/
+    bool ring = LV_MATH_ABS(end - start) >= full;
+    start = start % full;
+    if(start < 0) start += full;
+    if(ring) {
+        end = start + full;
+    } else {
+        end = end % full;
+        if(end < 0) end += full;
+        if(end <= start) end += full;
+    }
+
+    /*Radii in 1/256 pixels (in the drawing's resolution)*/
+    lv_draw_scan_point_t c;
+    line_point(center, &c);
+    int32_t r_out = ((int32_t)radius << LV_AA) << LV_DRAW_SCAN_SHIFT;
+    int32_t r_in = r_out - (((int32_t)style->line.width << LV_AA) << LV_DRAW_SCAN_SHIFT);
+    if(r_in < 0) r_in = 0;
+
+    lv_draw_scan_shape_t shapes[ARC_SHAPE_MAX];
+    uint16_t shape_num = 0;
+    lv_area_t tmp;
+
+    /*Split the arc on the vertical axis (90 and 270 degrees). The ends inside the arc are not anti-aliased.*/
+    int32_t a = start;
+    while(a < end) {
+        int32_t b = ((a + quarter) / half + 1) * half - quarter;
+        if(b > end) b = end;
+
+        uint8_t hard = 0;
+        if(a != start || ring || cap != LV_DRAW_LINE_CAP_BUTT) hard |= 0x1;
+        if(b != end || ring || cap != LV_DRAW_LINE_CAP_BUTT) hard |= 0x2;
+        lv_draw_scan_arc(&shapes[shape_num], &c, r_in, r_out, a, b, hard);
+        if(lv_area_union(&tmp, &shapes[shape_num].box, &mask_aa)) shape_num++;
+
+        a = b;
+    }
+
+    if(ring == false && cap != LV_DRAW_LINE_CAP_BUTT) {
+        arc_cap(&c, (r_in + r_out) / 2, (r_out - r_in) / 2, start, -1, cap, &shapes[shape_num]);
+        if(lv_area_union(&tmp, &shapes[shape_num].box, &mask_aa)) shape_num++;
+        arc_cap(&c, (r_in + r_out) / 2, (r_out - r_in) / 2, end, 1, cap, &shapes[shape_num]);
+        if(lv_area_union(&tmp, &shapes[shape_num].box, &mask_aa)) shape_num++;
+    }
+
+    if(shape_num != 0) {
+        lv_draw_scan_fill(shapes, shape_num, &mask_aa, style->line.color, style->line.opa, LV_DRAW_LINE_AA, draw_fill);
+    }
+
+    return true;
+}
+
+/**
+ * Create the shape of a cap of an arc
+ * @param center center of the circle in 1/256 pixels
+ * @param r_mid radius of the middle of the ring in 1/256 pixels
+ * @param hw half width of the ring in 1/256 pixels
+ * @param angle angle of the end in 1 / (1 << TRIGO_ANGLE_SHIFT) degrees
+ * @param dir -1: start of the arc (the cap is counter-clockwise), 1: end of the arc (the cap is clockwise)
+ * @param cap LV_DRAW_LINE_CAP_ROUND or LV_DRAW_LINE_CAP_SQUARE
+ * @param shape store the shape here
+ */
+static void arc_cap(const lv_draw_scan_point_t * center, int32_t r_mid, int32_t hw, int32_t angle, int8_t dir,
+                    lv_draw_line_cap_t cap, lv_draw_scan_shape_t * shape)
+{
+    lv_draw_scan_point_t p;
+    int32_t x;
+    int32_t y;
+    lv_trigo_polar(angle, r_mid, &x, &y);
+    p.x = center->x + x;
+    p.y = center->y + y;
+
+    if(cap == LV_DRAW_LINE_CAP_ROUND) {
+        lv_draw_scan_circle(shape, &p, hw);
+        return;
+    }
+
+    /*Square: half width long out of the end along the tangent*/
+    int32_t rx;
+    int32_t ry;
+    int32_t tx;
+    int32_t ty;
+    lv_trigo_polar(angle, hw, &rx, &ry);
+    lv_trigo_polar(angle + dir * ((int32_t)90 << TRIGO_ANGLE_SHIFT), hw, &tx, &ty);
+
+    lv_draw_scan_point_t quad[4];
+    quad[0].x = p.x + rx;
+    quad[0].y = p.y + ry;
+    quad[1].x = p.x + rx + tx;
+    quad[1].y = p.y + ry + ty;
+    quad[2].x = p.x - rx + tx;
+    quad[2].y = p.y - ry + ty;
+    quad[3].x = p.x - rx;
+    quad[3].y = p.y - ry;
+    lv_draw_scan_polygon(shape, quad, 4, 0x08);     /*The edge on the end of the arc is inside*/
+}
+
+#if USE_LV_IMG
+/**
+ * Decide whether an image has to be upscaled (if it's smaller than its area with LV_ANTIALIAS)
  * @param coords the coordinates of the image
- * @param mask the image will be drawn only in this area
- * @param map_p pointer to a lv_color_t array which contains the pixels of the image
- * @param opa opacity of the image (0..255)
+ * @param coord_aa the coordinates of the image in the drawing's resolution.
+ *                 Its width is set to the image's width if it's not upscaled.
+ * @param header the header of the image
+ * @return true: upscale the image
  */
-void lv_draw_img(const lv_area_t * coords, const lv_area_t * mask,
-             const lv_style_t * style, const char * fn)
+static bool img_get_upscale(const lv_area_t * coords, lv_area_t * coord_aa, const lv_img_raw_header_t * header)
 {
-    if(fn == NULL) {
-        lv_draw_rect(coords, mask, &lv_style_plain);
-        lv_draw_label(coords, mask, &lv_style_plain, "No data", LV_TXT_FLAG_NONE, NULL);
-    } else {
-        lv_area_t coord_aa;
-        lv_area_t mask_aa;
-
-#if LV_ANTIALIAS == 0
-        lv_area_copy(&coord_aa, coords);
-        lv_area_copy(&mask_aa, mask);
+    bool upscale = false;
+#if LV_ANTIALIAS
+    if(lv_area_get_width(coords) < header->w) {
+        upscale = false;
+        lv_area_set_width(coord_aa,  header->w);
+    }
+    else upscale = true;
 #else
-        coord_aa.x1 = coords->x1 << LV_AA;
-        coord_aa.y1 = coords->y1 << LV_AA;
-        coord_aa.x2 = (coords->x2 << LV_AA) + 1;
-        coord_aa.y2 = (coords->y2 << LV_AA) + 1;
-
-        mask_aa.x1 = mask->x1 << LV_AA;
-        mask_aa.y1 = mask->y1 << LV_AA;
-        mask_aa.x2 = (mask->x2 << LV_AA) + 1;
-        mask_aa.y2 = (mask->y2 << LV_AA) + 1;
+    (void) coords;      /*Unused*/
+    (void) coord_aa;    /*Unused*/
+    (void) header;      /*Unused*/
 #endif
 
-        lv_fs_file_t file;
-        lv_fs_res_t res = lv_fs_open(&file, fn, LV_FS_MODE_RD);
-        if(res == LV_FS_RES_OK) {
-            lv_img_raw_header_t header;
-            uint32_t br;
-            res = lv_fs_read(&file, &header, sizeof(lv_img_raw_header_t), &br);
-
-            lv_area_t mask_com;    /*Common area of mask and cords*/
-            bool union_ok;
-            union_ok = lv_area_union(&mask_com, &mask_aa, &coord_aa);
-            if(union_ok == false) {
-                lv_fs_close(&file);
-                return;
-            }
-
+    return upscale;
+}
 
-            /*If the width is greater then real img. width then it is upscaled */
-            bool upscale = false;
-#if LV_ANTIALIAS
-            if(lv_area_get_width(coords) < header.w) {
-                upscale = false;
-                lv_area_set_width(&coord_aa,  header.w);
-            }
-            else upscale = true;
+/**
+ * Decode the rows of an image which are in the mask and draw them
+ * @param coord_aa the coordinates of the image (anti-aliased)
+ * @param mask_com the common area of the mask and the image
+ * @param style style of the image
+ * @param header the header of the image
+ * @param upscale true: the image is drawn in double size
+ * @param file the opened image file
+ * @param src pointer to the whole file if the driver gives it, else NULL
+ * @param src_size size of 'src' in bytes
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t
+ */
+static lv_fs_res_t img_draw_dec(const lv_area_t * coord_aa, const lv_area_t * mask_com, const lv_style_t * style,
+                                const lv_img_raw_header_t * header, bool upscale, lv_fs_file_t * file, const void * src, uint32_t src_size)
+{
+    lv_draw_img_dec_t dec;
+    lv_fs_res_t res = lv_draw_img_dec_open(&dec, header, file, src, src_size);
+    if(res != LV_FS_RES_OK) return res;
+
+    uint8_t us_shift = 0;
+    uint8_t us_val = 1;
+    if(upscale != false) {
+        us_shift = 1;
+        us_val = 2;
+    }
 
-#endif
+    /*The first column and the number of pixels in the mask. But take care, the upscaled maps look greater*/
+    lv_coord_t x = (mask_com->x1 - coord_aa->x1) >> us_shift;
+    lv_coord_t len = lv_area_get_width(mask_com) >> us_shift;
 
-            bool const_data = false;
+    lv_area_t line;
+    lv_area_copy(&line, mask_com);
+    lv_area_set_height(&line, us_val); /*Create a line area. Hold 2 pixels if upscaled*/
 
-            /*If the img. data is inside the MCU then do not use FS reading just a pointer*/
-            if(fn[0] == UFS_LETTER) {
-                const_data = true;
-                uint8_t * f_data = ((lv_ufs_file_t*)file.file_d)->ent->data_d;
-                f_data += sizeof(lv_img_raw_header_t);
-                map_fp(&coord_aa, &mask_com, (void*)f_data , style->image.opa, header.transp, upscale, style->image.color, style->image.intense);
-            }
+    lv_coord_t row;
+    lv_color_t buf[len];
+    lv_opa_t alpha_buf[header->format == LV_IMG_FORMAT_ALPHA ? len : 1];
+    lv_opa_t * alpha = header->format == LV_IMG_FORMAT_ALPHA ? alpha_buf : NULL;
+    for(row = mask_com->y1; row <= mask_com->y2; row += us_val) {
+        res = lv_draw_img_dec_read_row(&dec, (row - coord_aa->y1) >> us_shift, x, len, buf, alpha);
+        if(res != LV_FS_RES_OK) break;
 
-            /*Read the img. with the FS interface*/
-            if(const_data == false) {
-                uint8_t us_shift = 0;
-                uint8_t us_val = 1;
-                if(upscale != false) {
-                    us_shift = 1;
-                    us_val = 2;
-                }
+        draw_map(&line, mask_com, buf, alpha, style->image.opa, header->transp, upscale,
+                 style->image.color, style->image.intense);
 
-                /* Move the file pointer to the start address according to mask
-                 * But take care, the upscaled maps look greater*/
-                uint32_t start_offset = sizeof(lv_img_raw_header_t);
-                start_offset += (lv_area_get_width(&coord_aa) >> us_shift) *
-                               ((mask_com.y1 - coord_aa.y1) >> us_shift) * sizeof(lv_color_t); /*First row*/
-                start_offset += ((mask_com.x1 - coord_aa.x1) >> us_shift) * sizeof(lv_color_t); /*First col*/
-                lv_fs_seek(&file, start_offset);
-
-                uint32_t useful_data = (lv_area_get_width(&mask_com) >> us_shift) * sizeof(lv_color_t);
-                uint32_t next_row = (lv_area_get_width(&coord_aa) >> us_shift) * sizeof(lv_color_t) - useful_data;
-
-                lv_area_t line;
-                lv_area_copy(&line, &mask_com);
-                lv_area_set_height(&line, us_val); /*Create a line area. Hold 2 pixels if upscaled*/
-
-                lv_coord_t row;
-                uint32_t act_pos;
-                lv_color_t buf[useful_data];
-                for(row = mask_com.y1; row <= mask_com.y2; row += us_val) {
-                    res = lv_fs_read(&file, buf, useful_data, &br);
-
-                    map_fp(&line, &mask_com, buf, style->image.opa, header.transp, upscale,
-                                          style->image.color, style->image.intense);
-
-                    lv_fs_tell(&file, &act_pos);
-                    lv_fs_seek(&file, act_pos + next_row);
-                    line.y1 += us_val;    /*Go down a line*/
-                    line.y2 += us_val;
-                }
-            }
-        }
+        line.y1 += us_val;    /*Go down a line*/
+        line.y2 += us_val;
+    }
 
-        lv_fs_close(&file);
+    lv_draw_img_dec_close(&dec);
 
-        if(res != LV_FS_RES_OK) {
-            lv_draw_rect(coords, mask, &lv_style_plain);
-            lv_draw_label(coords, mask, &lv_style_plain, "No data", LV_TXT_FLAG_NONE, NULL);
-        }
-    }
+    return res;
 }
-#endif
-
 
 /**
- * Draw a line
- * @param p1 first point of the line
- * @param p2 second point of the line
- * @param maskthe line will be drawn only on this area
- * @param lines_p pointer to a line style
+ * Open an image to get the pixels of its rows. The raw images from the cache or
+ * from the driver's pointer have their pixels right away.
+ * @param px pointer to an image to initialize
+ * @param fn path of the image file
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t
  */
-void lv_draw_line(const lv_point_t * p1, const lv_point_t * p2, const lv_area_t * mask,
-                  const lv_style_t * style)
+static lv_fs_res_t img_px_open(img_px_t * px, const char * fn)
 {
+    memset(px, 0, sizeof(img_px_t));
+
+    px->cached = lv_draw_img_cache_open(fn);
+    if(px->cached != NULL) {
+        px->header = px->cached->header;
+        px->data = px->cached->data;
+        px->alpha = px->cached->alpha;
+        return LV_FS_RES_OK;
+    }
 
-	if(style->line.width == 0) return;
-	if(p1->x == p2->x && p1->y == p2->y) return;
-
+    lv_fs_res_t res = lv_fs_open(&px->file, fn, LV_FS_MODE_RD);
+    if(res != LV_FS_RES_OK) return res;
+    px->file_opened = 1;
 
-	lv_point_t p1_aa;
-    lv_point_t p2_aa;
+    uint32_t br;
+    res = lv_fs_read(&px->file, &px->header, sizeof(lv_img_raw_header_t), &br);
+    if(res == LV_FS_RES_OK && br != sizeof(lv_img_raw_header_t)) res = LV_FS_RES_UNKNOWN;
+    if(res != LV_FS_RES_OK) {
+        img_px_close(px);
+        return res;
+    }
 
-    p1_aa.x = p1->x << LV_AA;
-    p1_aa.y = p1->y << LV_AA;
+    if(lv_fs_get_ptr(&px->file, &px->f_data) != LV_FS_RES_OK ||
+       lv_fs_size(&px->file, &px->f_size) != LV_FS_RES_OK) {
+        px->f_data = NULL;
+        px->f_size = 0;
+    }
 
-    p2_aa.x = p2->x << LV_AA;
-    p2_aa.y = p2->y << LV_AA;
+    /*Use the raw pixels in the memory of the driver*/
+    uint32_t px_num = (uint32_t)px->header.w * px->header.h;
+    bool alpha = px->header.format == LV_IMG_FORMAT_ALPHA ? true : false;
+    uint32_t data_size = px_num * sizeof(lv_color_t) + (alpha ? px_num * sizeof(lv_opa_t) : 0);
+    if(px->f_data != NULL && px->f_size >= data_size + sizeof(lv_img_raw_header_t) &&
+       (px->header.format == LV_IMG_FORMAT_RAW || alpha)) {
+        const uint8_t * data = px->f_data;
+        data += sizeof(lv_img_raw_header_t);
+        px->data = (const lv_color_t *) data;
+        if(alpha) px->alpha = data + px_num * sizeof(lv_color_t);
+    }
 
+    return LV_FS_RES_OK;
+}
 
-    lv_area_t mask_aa;
-#if LV_ANTIALIAS == 0
-    lv_area_copy(&mask_aa, mask);
-#else
-    mask_aa.x1 = mask->x1 << LV_AA;
-    mask_aa.y1 = mask->y1 << LV_AA;
-    mask_aa.x2 = (mask->x2 << LV_AA) + 1;
-    mask_aa.y2 = (mask->y2 << LV_AA) + 1;
-#endif
+/**
+ * Decode the rows of an image into a buffer (the alpha plane after the colors).
+ * Nothing to do if the pixels of the whole image are available.
+ * @param px pointer to an image opened with 'img_px_open()'
+ * @param y1 the first row
+ * @param y2 the last row
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t
+ */
+static lv_fs_res_t img_px_read_rows(img_px_t * px, lv_coord_t y1, lv_coord_t y2)
+{
+    if(px->data != NULL) return LV_FS_RES_OK;
+
+    uint32_t px_num = (uint32_t)px->header.w * (y2 - y1 + 1);
+    bool alpha = px->header.format == LV_IMG_FORMAT_ALPHA ? true : false;
+    px->buf = lv_mem_alloc(px_num * sizeof(lv_color_t) + (alpha ? px_num * sizeof(lv_opa_t) : 0));
+    if(px->buf == NULL) return LV_FS_RES_OUT_OF_MEM;
+    lv_opa_t * alpha_buf = alpha ? (lv_opa_t *) &px->buf[px_num] : NULL;
+
+    lv_draw_img_dec_t dec;
+    lv_fs_res_t res = lv_draw_img_dec_open(&dec, &px->header, &px->file, px->f_data, px->f_size);
+    lv_coord_t y;
+    for(y = y1; res == LV_FS_RES_OK && y <= y2; y++) {
+        uint32_t ofs = (uint32_t)(y - y1) * px->header.w;
+        res = lv_draw_img_dec_read_row(&dec, y, 0, px->header.w, &px->buf[ofs], alpha ? &alpha_buf[ofs] : NULL);
+    }
+    lv_draw_img_dec_close(&dec);
 
+    if(res != LV_FS_RES_OK) return res;
 
-	lv_coord_t dx = LV_MATH_ABS(p2_aa.x - p1_aa.x);
-	lv_coord_t sx = p1_aa.x < p2_aa.x ? 1 : -1;
-	lv_coord_t dy = LV_MATH_ABS(p2_aa.y - p1_aa.y);
-	lv_coord_t sy = p1_aa.y < p2_aa.y ? 1 : -1;
-	lv_coord_t err = (dx > dy ? dx : -dy) / 2;
-	lv_coord_t e2;
-	bool hor = dx > dy ? true : false;	/*Rather horizontal or vertical*/
-	lv_coord_t last_x = p1_aa.x;
-	lv_coord_t last_y = p1_aa.y;
-	lv_point_t act_point;
-	act_point.x = p1_aa.x;
-	act_point.y = p1_aa.y;
-
-
-	uint16_t width;
-	uint16_t wcor;
-	uint16_t width_half;
-	uint16_t width_1;
-    static const uint8_t width_corr_array[] = {
-            64, 64, 64, 64, 64, 64, 64, 64, 64, 65, 65, 65, 65, 65, 66, 66, 66, 66, 66,
-            67, 67, 67, 68, 68, 68, 69, 69, 69, 70, 70, 71, 71, 72, 72, 72, 73, 73, 74,
-            74, 75, 75, 76, 77, 77, 78, 78, 79, 79, 80, 81, 81, 82, 82, 83, 84, 84, 85,
-            86, 86, 87, 88, 88, 89, 90, 91,
-    };
-
-	if(hor == false) {
-		wcor = (dx * LINE_WIDTH_CORR_BASE) / dy;
-	} else  {
-		wcor = (dy * LINE_WIDTH_CORR_BASE) / dx;
-	}
+    px->data = px->buf;
+    px->alpha = alpha_buf;
+    px->row_first = y1;
 
-    /*Make the correction on lie width*/
-	width = ((style->line.width - 1) * width_corr_array[wcor]) >> LINE_WIDTH_CORR_SHIFT;
-	width = width << LV_ANTIALIAS;
-	width_half = width >> 1;
-	width_1 = width & 0x1 ? 1 : 0;
-
-	while(1){
-	  if(hor == true && last_y != act_point.y) {
-		  lv_area_t act_area;
-		  lv_area_t draw_area;
-		  act_area.x1 = last_x;
-		  act_area.x2 = act_point.x - sx;
-		  act_area.y1 = last_y - width_half ;
-		  act_area.y2 = act_point.y - sy  + width_half + width_1;
-		  last_y = act_point.y;
-		  last_x = act_point.x;
-
-		  draw_area.x1 = LV_MATH_MIN(act_area.x1, act_area.x2);
-		  draw_area.x2 = LV_MATH_MAX(act_area.x1, act_area.x2);
-		  draw_area.y1 = LV_MATH_MIN(act_area.y1, act_area.y2);
-		  draw_area.y2 = LV_MATH_MAX(act_area.y1, act_area.y2);
-		  fill_fp(&draw_area, &mask_aa, style->line.color, style->line.opa);
-	  }
-	  if (hor == false && last_x != act_point.x) {
-		  lv_area_t act_area;
-		  lv_area_t draw_area;
-		  act_area.x1 = last_x - width_half;
-		  act_area.x2 = act_point.x  - sx + width_half + width_1;
-		  act_area.y1 = last_y ;
-		  act_area.y2 = act_point.y - sy;
-		  last_y = act_point.y;
-		  last_x = act_point.x;
-
-		  draw_area.x1 = LV_MATH_MIN(act_area.x1, act_area.x2);
-		  draw_area.x2 = LV_MATH_MAX(act_area.x1, act_area.x2);
-		  draw_area.y1 = LV_MATH_MIN(act_area.y1, act_area.y2);
-		  draw_area.y2 = LV_MATH_MAX(act_area.y1, act_area.y2);
-		  fill_fp(&draw_area, &mask_aa, style->line.color, style->line.opa);
-	  }
-
-		/*Calc. the next point of the line*/
-		if (act_point.x == p2_aa.x && act_point.y == p2_aa.y) break;
-		e2 = err;
-		if (e2 >-dx) {
-			err -= dy;
-			act_point.x += sx;
-		}
-		if (e2 < dy) {
-			err += dx;
-			act_point.y += sy;
-		}
-	}
-	/*Draw the last part of the line*/
-	if(hor == true) {
-		lv_area_t act_area;
-		lv_area_t draw_area;
-		act_area.x1 = last_x;
-		act_area.x2 = act_point.x;
-		act_area.y1 = last_y - width_half ;
-		act_area.y2 = act_point.y + width_half + width_1;
-
-		draw_area.x1 = LV_MATH_MIN(act_area.x1, act_area.x2);
-		draw_area.x2 = LV_MATH_MAX(act_area.x1, act_area.x2);
-		draw_area.y1 = LV_MATH_MIN(act_area.y1, act_area.y2);
-		draw_area.y2 = LV_MATH_MAX(act_area.y1, act_area.y2);
-		fill_fp(&draw_area, &mask_aa, style->line.color, style->line.opa);
-	}
-	if (hor == false) {
-		lv_area_t act_area;
-		lv_area_t draw_area;
-		act_area.x1 = last_x - width_half;
-		act_area.x2 = act_point.x + width_half + width_1;
-		act_area.y1 = last_y;
-		act_area.y2 = act_point.y;
-
-		draw_area.x1 = LV_MATH_MIN(act_area.x1, act_area.x2);
-		draw_area.x2 = LV_MATH_MAX(act_area.x1, act_area.x2);
-		draw_area.y1 = LV_MATH_MIN(act_area.y1, act_area.y2);
-		draw_area.y2 = LV_MATH_MAX(act_area.y1, act_area.y2);
-		fill_fp(&draw_area, &mask_aa, style->line.color, style->line.opa);
-	}
+    return LV_FS_RES_OK;
 }
 
+/**
+ * Release the pixels of an image got with 'img_px_open()'
+ * @param px pointer to an image
+ */
+static void img_px_close(img_px_t * px)
+{
+    if(px->cached != NULL) lv_draw_img_cache_close(px->cached);
+    if(px->buf != NULL) lv_mem_free(px->buf);
+    if(px->file_opened) lv_fs_close(&px->file);
+
+    px->cached = NULL;
+    px->buf = NULL;
+    px->file_opened = 0;
+}
+#endif
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
 
 /**
  * Draw the middle part (rectangular) of a rectangle
  * @param coords the coordinates of the original rectangle
  * @param mask the rectangle will be drawn only  on this area
  * @param rects_p pointer to a rectangle style
+ * @param grad colors of the gradient's rows (NULL: mix them here)
  */
-static void lv_draw_rect_main_mid(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style)
+static void lv_draw_rect_main_mid(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style, const lv_draw_grad_t * grad)
 {
     uint16_t radius = style->body.radius << LV_AA;
 
     lv_color_t mcolor = style->body.main_color;
     lv_color_t gcolor = style->body.grad_color;
-    uint8_t mix;
     lv_opa_t opa = style->body.opa;
     lv_coord_t height = lv_area_get_height(coords);
     lv_coord_t width = lv_area_get_width(coords);
@@ -689,42 +1532,42 @@ static void lv_draw_rect_main_mid(const lv_area_t * coords, const lv_area_t * ma
     if(mcolor.full == gcolor.full) {
     	work_area.y1 = coords->y1 + radius;
     	work_area.y2 = coords->y2 - radius;
-		fill_fp(&work_area, mask, mcolor, opa);
+		draw_fill(&work_area, mask, mcolor, opa);
     } else {
 
 		lv_coord_t row;
 		lv_coord_t row_start = coords->y1 + radius;
 		lv_coord_t row_end = coords->y2 - radius;
 		lv_color_t act_color;
-        if(row_start < 0) row_start = 0;
+        /*Only the rows on the mask are drawn*/
+        if(row_start < mask->y1) row_start = mask->y1;
+        if(row_end > mask->y2) row_end = mask->y2;
 		for(row = row_start ;
 			row <= row_end;
 			row ++)
 		{
 			work_area.y1 = row;
 			work_area.y2 = row;
-			mix = (uint32_t)((uint32_t)(coords->y2 - work_area.y1) * 255) / height;
-			act_color = lv_color_mix(mcolor, gcolor, mix);
+			act_color = lv_draw_rect_row_color(coords, style, grad, row);
 
-			fill_fp(&work_area, mask, act_color, opa);
+			draw_fill(&work_area, mask, act_color, opa);
 		}
     }
 }
+#if LV_DRAW_RECT_AA == 0
 /**
  * Draw the top and bottom parts (corners) of a rectangle
  * @param coords the coordinates of the original rectangle
  * @param mask the rectangle will be drawn only  on this area
  * @param rects_p pointer to a rectangle style
+ * @param grad colors of the gradient's rows (NULL: mix them here)
  */
-static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style)
+static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style, const lv_draw_grad_t * grad)
 {
     uint16_t radius = style->body.radius << LV_AA;
 
-    lv_color_t mcolor = style->body.main_color;
-    lv_color_t gcolor = style->body.grad_color;
     lv_color_t act_color;
     lv_opa_t opa = style->body.opa;
-    uint8_t mix;
     lv_coord_t height = lv_area_get_height(coords);
     lv_coord_t width = lv_area_get_width(coords);
 
@@ -748,167 +1591,109 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
     rb_origo.y = coords->y2 - radius;
 
 
-    lv_area_t edge_top_area;
-    lv_area_t mid_top_area;
-    lv_area_t mid_bot_area;
-    lv_area_t edge_bot_area;
-
-
-    lv_point_t cir;
-    lv_coord_t cir_tmp;
-    lv_circ_init(&cir, &cir_tmp, radius);
-
-    /*Init the areas*/
-    lv_area_set(&mid_bot_area,  lb_origo.x + LV_CIRC_OCT4_X(cir),
-                             lb_origo.y + LV_CIRC_OCT4_Y(cir),
-                             rb_origo.x + LV_CIRC_OCT1_X(cir),
-                             rb_origo.y + LV_CIRC_OCT1_Y(cir));
-
-    lv_area_set(&edge_bot_area, lb_origo.x + LV_CIRC_OCT3_X(cir),
-                             lb_origo.y + LV_CIRC_OCT3_Y(cir),
-                             rb_origo.x + LV_CIRC_OCT2_X(cir),
-                             rb_origo.y + LV_CIRC_OCT2_Y(cir));
-
-    lv_area_set(&mid_top_area,  lt_origo.x + LV_CIRC_OCT5_X(cir),
-                             lt_origo.y + LV_CIRC_OCT5_Y(cir),
-                             rt_origo.x + LV_CIRC_OCT8_X(cir),
-                             rt_origo.y + LV_CIRC_OCT8_Y(cir));
-
-    lv_area_set(&edge_top_area, lt_origo.x + LV_CIRC_OCT6_X(cir),
-                             lt_origo.y + LV_CIRC_OCT6_Y(cir),
-                             rt_origo.x + LV_CIRC_OCT7_X(cir),
-                             rt_origo.y + LV_CIRC_OCT7_Y(cir));
-
-    while(lv_circ_cont(&cir)) {
-        uint8_t edge_top_refr = 0;
-        uint8_t mid_top_refr = 0;
-        uint8_t mid_bot_refr = 0;
-        uint8_t edge_bot_refr = 0;
-
-        /*If a new row coming draw the previous
-         * The x coordinate can grow on the same y so wait for the last x*/
-        if(mid_bot_area.y1 != LV_CIRC_OCT4_Y(cir) + lb_origo.y ) {
-            mid_bot_refr = 1;
-        }
-
-        if(edge_bot_area.y1 != LV_CIRC_OCT2_Y(cir) + lb_origo.y) {
-            edge_bot_refr = 1;
-        }
-
-        if(mid_top_area.y1 != LV_CIRC_OCT8_Y(cir) + lt_origo.y) {
-            mid_top_refr = 1;
-        }
-
-        if(edge_top_area.y1 != LV_CIRC_OCT7_Y(cir) + lt_origo.y) {
-            edge_top_refr = 1;
-        }
-
-        /* Do not refresh the first row in the middle
-         * because the body drawer makes it*/
-        if(mid_bot_area.y1 == coords->y2 - radius){
-            mid_bot_refr = 0;
-        }
-
-        if(mid_top_area.y1 == coords->y1 + radius){
-            mid_top_refr = 0;
-        }
-
-        /*Draw the areas which are not disabled*/
-        if(edge_top_refr != 0){
-            if(mcolor.full == gcolor.full) act_color = mcolor;
-            else {
-                mix = (uint32_t)((uint32_t)(coords->y2 - edge_top_area.y1)  * 255) / height;
-                act_color = lv_color_mix(mcolor, gcolor, mix);
-            }
-            fill_fp(&edge_top_area, mask, act_color, opa);
-        }
-
-        if(mid_top_refr != 0) {
-            if(mcolor.full == gcolor.full) act_color = mcolor;
-            else {
-                mix = (uint32_t)((uint32_t)(coords->y2 - mid_top_area.y1) * 255) / height;
-                act_color = lv_color_mix(mcolor, gcolor, mix);
-            }
-            fill_fp(&mid_top_area, mask, act_color, opa);
-        }
-
-        if(mid_bot_refr != 0) {
-            if(mcolor.full == gcolor.full) act_color = mcolor;
-            else {
-                mix = (uint32_t)((uint32_t)(coords->y2 - mid_bot_area.y1) * 255) / height;
-                act_color = lv_color_mix(mcolor, gcolor, mix);
+    lv_draw_corner_key_t key;
+    memset(&key, 0, sizeof(key));
+    key.type = LV_DRAW_CORNER_BODY;
+    key.radius = radius;
+    const lv_draw_corner_t * corner = lv_draw_corner_get(&key);
+    if(corner == NULL) return;
+
+    /*Draw the spans of the corners on the top and on the bottom*/
+    lv_area_t span_area;
+    uint16_t i;
+    for(i = 0; i < corner->cnt; i++) {
+        const lv_draw_corner_span_t * span = &corner->spans[i];
+        uint8_t part;
+        for(part = LV_DRAW_CORNER_TOP; part <= LV_DRAW_CORNER_BOTTOM; part = part << 1) {
+            if((span->part & part) == 0) continue;
+
+            if(part == LV_DRAW_CORNER_TOP) {
+                lv_area_set(&span_area, lt_origo.x - span->w, lt_origo.y - span->dy,
+                                        rt_origo.x + span->w, rt_origo.y - span->dy);
+            } else {
+                lv_area_set(&span_area, lb_origo.x - span->w, lb_origo.y + span->dy,
+                                        rb_origo.x + span->w, rb_origo.y + span->dy);
             }
-            fill_fp(&mid_bot_area, mask, act_color, opa);
-        }
-
-        if(edge_bot_refr != 0) {
 
-            if(mcolor.full == gcolor.full) act_color = mcolor;
-            else {
-                mix = (uint32_t)((uint32_t)(coords->y2 - edge_bot_area.y1) * 255) / height;
-                act_color = lv_color_mix(mcolor, gcolor, mix);
-            }
-            fill_fp(&edge_bot_area, mask, act_color, opa);
+            act_color = lv_draw_rect_row_color(coords, style, grad, span_area.y1);
+            draw_fill(&span_area, mask, act_color, opa);
         }
-         /*Save the current coordinates*/
-        lv_area_set(&mid_bot_area,  lb_origo.x + LV_CIRC_OCT4_X(cir),
-                                 lb_origo.y + LV_CIRC_OCT4_Y(cir),
-                                 rb_origo.x + LV_CIRC_OCT1_X(cir),
-                                 rb_origo.y + LV_CIRC_OCT1_Y(cir));
-
-        lv_area_set(&edge_bot_area, lb_origo.x + LV_CIRC_OCT3_X(cir),
-                                 lb_origo.y + LV_CIRC_OCT3_Y(cir),
-                                 rb_origo.x + LV_CIRC_OCT2_X(cir),
-                                 rb_origo.y + LV_CIRC_OCT2_Y(cir));
-
-        lv_area_set(&mid_top_area,  lt_origo.x + LV_CIRC_OCT5_X(cir),
-                                 lt_origo.y + LV_CIRC_OCT5_Y(cir),
-                                 rt_origo.x + LV_CIRC_OCT8_X(cir),
-                                 rt_origo.y + LV_CIRC_OCT8_Y(cir));
-
-        lv_area_set(&edge_top_area, lt_origo.x + LV_CIRC_OCT6_X(cir),
-                                 lt_origo.y + LV_CIRC_OCT6_Y(cir),
-                                 rt_origo.x + LV_CIRC_OCT7_X(cir),
-                                 rt_origo.y + LV_CIRC_OCT7_Y(cir));
-
-        lv_circ_next(&cir, &cir_tmp);
     }
 
+    lv_draw_corner_release(corner);
+}
 
-    if(mcolor.full == gcolor.full) act_color = mcolor;
-    else {
-        mix = (uint32_t)((uint32_t)(coords->y2 - edge_top_area.y1)  * 255) / height;
-        act_color = lv_color_mix(mcolor, gcolor, mix);
-    }
-	fill_fp(&edge_top_area, mask, act_color, opa);
+#else
+/**
+ * Draw the top and bottom parts (corners) of a rectangle with anti-aliased edges.
+ * The rows of the corners are drawn as spans, only the partially covered pixels are drawn one by one.
+ * @param coords the coordinates of the original rectangle
+ * @param mask the rectangle will be drawn only  on this area
+ * @param rects_p pointer to a rectangle style
+ * @param grad colors of the gradient's rows (NULL: mix them here)
+ */
+static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style, const lv_draw_grad_t * grad)
+{
+    uint16_t radius = style->body.radius;
 
-	if(edge_top_area.y1 != mid_top_area.y1) {
+    lv_color_t act_color;
+    lv_opa_t opa = style->body.opa;
+    lv_coord_t height = lv_area_get_height(coords);
+    lv_coord_t width = lv_area_get_width(coords);
 
-        if(mcolor.full == gcolor.full) act_color = mcolor;
-        else {
-            mix = (uint32_t)((uint32_t)(coords->y2 - mid_top_area.y1) * 255) / height;
-            act_color = lv_color_mix(mcolor, gcolor, mix);
-	    }
-		fill_fp(&mid_top_area, mask, act_color, opa);
-	}
+    radius = lv_draw_cont_radius_corr(radius, width, height);
 
-    if(mcolor.full == gcolor.full) act_color = mcolor;
-    else {
-        mix = (uint32_t)((uint32_t)(coords->y2 - mid_bot_area.y1) * 255) / height;
-        act_color = lv_color_mix(mcolor, gcolor, mix);
+    lv_draw_corner_key_t key;
+    memset(&key, 0, sizeof(key));
+    key.type = LV_DRAW_CORNER_COVER;
+    key.radius = radius;
+    const lv_draw_corner_t * corner = lv_draw_corner_get(&key);
+    if(corner == NULL) return;
+
+    lv_area_t span_area;
+    lv_coord_t row;
+    for(row = 0; row < corner->cnt; row++) {
+        const lv_draw_corner_row_t * cover_row = &corner->rows[row];
+        const lv_opa_t * cover = &corner->opa[cover_row->ofs];
+        lv_coord_t edge_len = cover_row->full - cover_row->first;
+
+        /*Draw the row on the top and on the bottom*/
+        lv_coord_t y;
+        for(y = coords->y1 + row; ; y = coords->y2 - row) {
+            act_color = lv_draw_rect_row_color(coords, style, grad, y);
+
+            /*The fully covered middle*/
+            lv_area_set(&span_area, coords->x1 + cover_row->full, y, coords->x2 - cover_row->full, y);
+            draw_fill(&span_area, mask, act_color, opa);
+
+            /*The anti-aliased edges*/
+            draw_cover_row(coords->x1 + cover_row->first, y, 1, cover, edge_len, mask, act_color, opa);
+            draw_cover_row(coords->x2 - cover_row->first, y, -1, cover, edge_len, mask, act_color, opa);
+
+            if(y != coords->y1 + row) break;
+        }
     }
-	fill_fp(&mid_bot_area, mask, act_color, opa);
 
-	if(edge_bot_area.y1 != mid_bot_area.y1) {
+    lv_draw_corner_release(corner);
+}
+#endif
 
-        if(mcolor.full == gcolor.full) act_color = mcolor;
-        else {
-            mix = (uint32_t)((uint32_t)(coords->y2 - edge_bot_area.y1) * 255) / height;
-            act_color = lv_color_mix(mcolor, gcolor, mix);
-        }
-		fill_fp(&edge_bot_area, mask, act_color, opa);
-	}
+/**
+ * Get the color of a row of a rectangle's body
+ * @param coords the coordinates of the original rectangle
+ * @param style pointer to a rectangle style
+ * @param grad colors of the gradient's rows (NULL: mix the color of the row)
+ * @param y the row
+ * @return the color of the row
+ */
+static lv_color_t lv_draw_rect_row_color(const lv_area_t * coords, const lv_style_t * style, const lv_draw_grad_t * grad, lv_coord_t y)
+{
+    if(style->body.main_color.full == style->body.grad_color.full) return style->body.main_color;
+    if(grad != NULL) return grad->colors[y - coords->y1];
 
+    /*Out of memory for the gradient*/
+    uint8_t mix = (uint32_t)((uint32_t)(coords->y2 - y) * 255) / lv_area_get_height(coords);
+    return lv_color_mix(style->body.main_color, style->body.grad_color, mix);
 }
 
 /**
@@ -936,16 +1721,21 @@ static void lv_draw_rect_border_straight(const lv_area_t * coords, const lv_area
 
     radius = lv_draw_cont_radius_corr(radius, width, height);
 
-    if(radius < bwidth) {
-        length_corr = bwidth - radius;
-        corner_size = bwidth;
+    /*Size of the corners drawn by 'lv_draw_rect_border_corner'.
+     * The circle drawing draws the row and column of the origo too*/
+#if LV_DRAW_RECT_AA == 0
+    lv_coord_t corner_r = radius + 1;
+#else
+    lv_coord_t corner_r = radius;
+#endif
+
+    if(corner_r < bwidth + 1) {
+        length_corr = bwidth + 1 - corner_r;
+        corner_size = bwidth + 1;
     } else {
-        corner_size = radius;
+        corner_size = corner_r;
     }
 
-    /* Modify the corner_size if corner is drawn */
-    corner_size ++;
-
 
     /*Depending one which part's are drawn modify the area lengths */
     if(part & LV_BORDER_TOP) work_area.y1 = coords->y1 + corner_size;
@@ -958,14 +1748,14 @@ static void lv_draw_rect_border_straight(const lv_area_t * coords, const lv_area
     if(part & LV_BORDER_LEFT) {
         work_area.x1 = coords->x1;
         work_area.x2 = work_area.x1 + bwidth;
-        fill_fp(&work_area, mask, color, opa);
+        draw_fill(&work_area, mask, color, opa);
     }
 
     /*Right border*/
     if(part & LV_BORDER_RIGHT) {
         work_area.x2 = coords->x2;
         work_area.x1 = work_area.x2 - bwidth;
-        fill_fp(&work_area, mask, color, opa);
+        draw_fill(&work_area, mask, color, opa);
     }
 
     work_area.x1 = coords->x1 + corner_size - length_corr;
@@ -975,14 +1765,14 @@ static void lv_draw_rect_border_straight(const lv_area_t * coords, const lv_area
     if(part & LV_BORDER_TOP) {
         work_area.y1 = coords->y1;
         work_area.y2 = coords->y1 + bwidth;
-        fill_fp(&work_area, mask, color, opa);
+        draw_fill(&work_area, mask, color, opa);
     }
 
     /*Lower border*/
     if(part & LV_BORDER_BOTTOM) {
         work_area.y2 = coords->y2;
         work_area.y1 = work_area.y2 - bwidth;
-        fill_fp(&work_area, mask, color, opa);
+        draw_fill(&work_area, mask, color, opa);
     }
 
     /*Draw the a remaining rectangles if the radius is smaller then b_width */
@@ -990,40 +1780,41 @@ static void lv_draw_rect_border_straight(const lv_area_t * coords, const lv_area
         /*Left top correction*/
         if((part & LV_BORDER_TOP) && (part & LV_BORDER_LEFT)) {
             work_area.x1 = coords->x1;
-            work_area.x2 = coords->x1 + radius;
-            work_area.y1 = coords->y1 + radius + 1;
+            work_area.x2 = coords->x1 + corner_r - 1;
+            work_area.y1 = coords->y1 + corner_r;
             work_area.y2 = coords->y1 + bwidth;
-            fill_fp(&work_area, mask, color, opa);
+            draw_fill(&work_area, mask, color, opa);
         }
 
         /*Right top correction*/
         if((part & LV_BORDER_TOP) && (part & LV_BORDER_RIGHT)) {
-            work_area.x1 = coords->x2 - radius;
+            work_area.x1 = coords->x2 - corner_r + 1;
             work_area.x2 = coords->x2;
-            work_area.y1 = coords->y1 + radius + 1;
+            work_area.y1 = coords->y1 + corner_r;
             work_area.y2 = coords->y1 + bwidth;
-            fill_fp(&work_area, mask, color, opa);
+            draw_fill(&work_area, mask, color, opa);
         }
 
         /*Left bottom correction*/
         if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_LEFT)) {
             work_area.x1 = coords->x1;
-            work_area.x2 = coords->x1 + radius;
+            work_area.x2 = coords->x1 + corner_r - 1;
             work_area.y1 = coords->y2 - bwidth;
-            work_area.y2 = coords->y2 - radius - 1;
-            fill_fp(&work_area, mask, color, opa);
+            work_area.y2 = coords->y2 - corner_r;
+            draw_fill(&work_area, mask, color, opa);
         }
 
         /*Right bottom correction*/
         if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_RIGHT)) {
-            work_area.x1 = coords->x2 - radius;
+            work_area.x1 = coords->x2 - corner_r + 1;
             work_area.x2 = coords->x2;
             work_area.y1 = coords->y2 - bwidth;
-            work_area.y2 = coords->y2 - radius - 1;
-            fill_fp(&work_area, mask, color, opa);
+            work_area.y2 = coords->y2 - corner_r;
+            draw_fill(&work_area, mask, color, opa);
         }
     }
 
+#if LV_DRAW_RECT_AA == 0
     /*If radius == 0 one px on the corners are not drawn*/
     if(radius == 0) {
 
@@ -1033,7 +1824,7 @@ static void lv_draw_rect_border_straight(const lv_area_t * coords, const lv_area
             work_area.x2 = coords->x1;
             work_area.y1 = coords->y1;
             work_area.y2 = coords->y1;
-            fill_fp(&work_area, mask, color, opa);
+            draw_fill(&work_area, mask, color, opa);
         }
 
         /*Right top corner*/
@@ -1042,7 +1833,7 @@ static void lv_draw_rect_border_straight(const lv_area_t * coords, const lv_area
             work_area.x2 = coords->x2;
             work_area.y1 = coords->y1;
             work_area.y2 = coords->y1;
-            fill_fp(&work_area, mask, color, opa);
+            draw_fill(&work_area, mask, color, opa);
         }
 
         /*Left bottom corner*/
@@ -1051,7 +1842,7 @@ static void lv_draw_rect_border_straight(const lv_area_t * coords, const lv_area
             work_area.x2 = coords->x1;
             work_area.y1 = coords->y2;
             work_area.y2 = coords->y2;
-            fill_fp(&work_area, mask, color, opa);
+            draw_fill(&work_area, mask, color, opa);
         }
 
         /*Right bottom corner*/
@@ -1060,12 +1851,14 @@ static void lv_draw_rect_border_straight(const lv_area_t * coords, const lv_area
             work_area.x2 = coords->x2;
             work_area.y1 = coords->y2;
             work_area.y2 = coords->y2;
-            fill_fp(&work_area, mask, color, opa);
+            draw_fill(&work_area, mask, color, opa);
         }
     }
+#endif
 }
 
 
+#if LV_DRAW_RECT_AA == 0
 /**
  * Draw the corners of a rectangle border
  * @param coords the coordinates of the original rectangle
@@ -1106,34 +1899,25 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
     rb_origo.x = coords->x2 - radius;
     rb_origo.y = coords->y2 - radius;
 
-    lv_point_t cir_out;
-    lv_coord_t tmp_out;
-    lv_circ_init(&cir_out, &tmp_out, radius);
-
-    lv_point_t cir_in;
-    lv_coord_t tmp_in;
-    lv_coord_t radius_in = radius - bwidth;
-
-    if(radius_in < 0){
-        radius_in = 0;
-    }
-
-    lv_circ_init(&cir_in, &tmp_in, radius_in);
+    lv_draw_corner_key_t key;
+    memset(&key, 0, sizeof(key));
+    key.type = LV_DRAW_CORNER_BORDER;
+    key.radius = radius;
+    key.bwidth = bwidth;
+    const lv_draw_corner_t * corner = lv_draw_corner_get(&key);
+    if(corner == NULL) return;
 
     lv_area_t circ_area;
+    lv_point_t cir_out;
     lv_coord_t act_w1;
     lv_coord_t act_w2;
+    uint16_t i;
 
-    while( cir_out.y <= cir_out.x) {
-
-        /*Calculate the actual width to avoid overwriting pixels*/
-        if(cir_in.y < cir_in.x) {
-            act_w1 = cir_out.x - cir_in.x;
-            act_w2 = act_w1;
-        } else {
-            act_w1 = cir_out.x - cir_out.y;
-            act_w2 = act_w1 - 1;
-        }
+    for(i = 0; i < corner->cnt; i++) {
+        /*The point of the outer circle and the actual width which doesn't overwrite pixels*/
+        cir_out = corner->steps[i].out;
+        act_w1 = corner->steps[i].w1;
+        act_w2 = corner->steps[i].w2;
 
         /*Draw the octets to the right bottom corner*/
         if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_RIGHT)) {
@@ -1141,13 +1925,13 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
             circ_area.x2 = rb_origo.x + LV_CIRC_OCT1_X(cir_out);
             circ_area.y1 = rb_origo.y + LV_CIRC_OCT1_Y(cir_out);
             circ_area.y2 = rb_origo.y + LV_CIRC_OCT1_Y(cir_out);
-            fill_fp(&circ_area, mask, color, opa);
+            draw_fill(&circ_area, mask, color, opa);
 
             circ_area.x1 = rb_origo.x + LV_CIRC_OCT2_X(cir_out);
             circ_area.x2 = rb_origo.x + LV_CIRC_OCT2_X(cir_out);
             circ_area.y1 = rb_origo.y + LV_CIRC_OCT2_Y(cir_out)- act_w1;
             circ_area.y2 = rb_origo.y + LV_CIRC_OCT2_Y(cir_out);
-            fill_fp(&circ_area, mask, color, opa);
+            draw_fill(&circ_area, mask, color, opa);
         }
 
         /*Draw the octets to the left bottom corner*/
@@ -1156,13 +1940,13 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
             circ_area.x2 = lb_origo.x + LV_CIRC_OCT3_X(cir_out);
             circ_area.y1 = lb_origo.y + LV_CIRC_OCT3_Y(cir_out) - act_w2;
             circ_area.y2 = lb_origo.y + LV_CIRC_OCT3_Y(cir_out);
-            fill_fp(&circ_area, mask, color, opa);
+            draw_fill(&circ_area, mask, color, opa);
 
             circ_area.x1 = lb_origo.x + LV_CIRC_OCT4_X(cir_out);
             circ_area.x2 = lb_origo.x + LV_CIRC_OCT4_X(cir_out) + act_w1;
             circ_area.y1 = lb_origo.y + LV_CIRC_OCT4_Y(cir_out);
             circ_area.y2 = lb_origo.y + LV_CIRC_OCT4_Y(cir_out);
-            fill_fp(&circ_area, mask, color, opa);
+            draw_fill(&circ_area, mask, color, opa);
         }
         
         /*Draw the octets to the left top corner*/
@@ -1173,14 +1957,14 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
                 circ_area.x2 = lt_origo.x + LV_CIRC_OCT5_X(cir_out) + act_w2;
                 circ_area.y1 = lt_origo.y + LV_CIRC_OCT5_Y(cir_out);
                 circ_area.y2 = lt_origo.y + LV_CIRC_OCT5_Y(cir_out);
-                fill_fp(&circ_area, mask, color, opa);
+                draw_fill(&circ_area, mask, color, opa);
             }
 
             circ_area.x1 = lt_origo.x + LV_CIRC_OCT6_X(cir_out);
             circ_area.x2 = lt_origo.x + LV_CIRC_OCT6_X(cir_out);
             circ_area.y1 = lt_origo.y + LV_CIRC_OCT6_Y(cir_out);
             circ_area.y2 = lt_origo.y + LV_CIRC_OCT6_Y(cir_out) + act_w1;
-            fill_fp(&circ_area, mask, color, opa);
+            draw_fill(&circ_area, mask, color, opa);
         }
         
         /*Draw the octets to the right top corner*/
@@ -1189,7 +1973,7 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
             circ_area.x2 = rt_origo.x + LV_CIRC_OCT7_X(cir_out);
             circ_area.y1 = rt_origo.y + LV_CIRC_OCT7_Y(cir_out);
             circ_area.y2 = rt_origo.y + LV_CIRC_OCT7_Y(cir_out) + act_w2;
-            fill_fp(&circ_area, mask, color, opa);
+            draw_fill(&circ_area, mask, color, opa);
 
             /*Don't draw if the lines are common in the middle*/
             if(rb_origo.y + LV_CIRC_OCT1_Y(cir_out) > rt_origo.y + LV_CIRC_OCT8_Y(cir_out)) {
@@ -1197,18 +1981,124 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
                 circ_area.x2 = rt_origo.x + LV_CIRC_OCT8_X(cir_out);
                 circ_area.y1 = rt_origo.y + LV_CIRC_OCT8_Y(cir_out);
                 circ_area.y2 = rt_origo.y + LV_CIRC_OCT8_Y(cir_out);
-                fill_fp(&circ_area, mask, color, opa);
+                draw_fill(&circ_area, mask, color, opa);
             }
         }
-        lv_circ_next(&cir_out, &tmp_out);
+    }
+
+    lv_draw_corner_release(corner);
+}
+
+#else
+/**
+ * Draw the corners of a rectangle border with anti-aliased edges.
+ * The coverage of the border is the coverage of the outer corner minus the inner corner's.
+ * @param coords the coordinates of the original rectangle
+ * @param mask the rectangle will be drawn only  on this area
+ * @param rects_p pointer to a rectangle style
+ */
+static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t * mask, const  lv_style_t * style)
+{
+    uint16_t radius = style->body.radius;
+    lv_coord_t bwidth = style->body.border.width;
+    lv_color_t color = style->body.border.color;
+    lv_opa_t opa = style->body.border.opa;
+    lv_border_part_t part = style->body.border.part;
+
+    lv_coord_t width = lv_area_get_width(coords);
+    lv_coord_t height = lv_area_get_height(coords);
+
+    radius = lv_draw_cont_radius_corr(radius, width, height);
+    if(radius == 0) return;
+
+    lv_draw_corner_key_t key;
+    memset(&key, 0, sizeof(key));
+    key.type = LV_DRAW_CORNER_COVER;
+    key.radius = radius;
+    const lv_draw_corner_t * corner_out = lv_draw_corner_get(&key);
+    if(corner_out == NULL) return;
+
+    key.radius = radius > bwidth ? radius - bwidth : 0;
+    const lv_draw_corner_t * corner_in = lv_draw_corner_get(&key);
+    if(corner_in == NULL) {
+        lv_draw_corner_release(corner_out);
+        return;
+    }
+
+    lv_opa_t cover[radius];
+    lv_coord_t row;
+    for(row = 0; row < corner_out->cnt; row++) {
+        const lv_draw_corner_row_t * cover_row = &corner_out->rows[row];
+        lv_coord_t len = radius - cover_row->first;
+
+        /*The inner corner is 'bwidth' pixels inside*/
+        lv_coord_t x;
+        for(x = cover_row->first; x < radius; x++) {
+            lv_opa_t cover_out = lv_draw_corner_get_cover(corner_out, x, row);
+            lv_opa_t cover_in = lv_draw_corner_get_cover(corner_in, x - bwidth, row - bwidth);
+            cover[x - cover_row->first] = cover_out > cover_in ? cover_out - cover_in : LV_OPA_TRANSP;
+        }
+
+        if((part & LV_BORDER_TOP) && (part & LV_BORDER_LEFT)) {
+            draw_cover_row(coords->x1 + cover_row->first, coords->y1 + row, 1, cover, len, mask, color, opa);
+        }
+
+        if((part & LV_BORDER_TOP) && (part & LV_BORDER_RIGHT)) {
+            draw_cover_row(coords->x2 - cover_row->first, coords->y1 + row, -1, cover, len, mask, color, opa);
+        }
+
+        if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_LEFT)) {
+            draw_cover_row(coords->x1 + cover_row->first, coords->y2 - row, 1, cover, len, mask, color, opa);
+        }
+
+        if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_RIGHT)) {
+            draw_cover_row(coords->x2 - cover_row->first, coords->y2 - row, -1, cover, len, mask, color, opa);
+        }
+    }
+
+    lv_draw_corner_release(corner_in);
+    lv_draw_corner_release(corner_out);
+}
 
-        /*The internal circle will be ready faster
-         * so check it! */
-        if(cir_in.y < cir_in.x) {
-            lv_circ_next(&cir_in, &tmp_in);
+/**
+ * Draw a row of anti-aliased pixels. The neighboring pixels with the same coverage are drawn as one span.
+ * @param x x coordinate of the first pixel
+ * @param y y coordinate of the row
+ * @param dir 1: draw to the right from 'x', -1: draw to the left from 'x'
+ * @param cover coverage of the pixels
+ * @param len number of pixels
+ * @param mask the row will be drawn only on this area
+ * @param color color of the pixels
+ * @param opa opacity of the fully covered pixels
+ */
+static void draw_cover_row(lv_coord_t x, lv_coord_t y, int8_t dir, const lv_opa_t * cover, lv_coord_t len,
+                           const lv_area_t * mask, lv_color_t color, lv_opa_t opa)
+{
+    lv_area_t span_area;
+    span_area.y1 = y;
+    span_area.y2 = y;
+
+    lv_coord_t i = 0;
+    while(i < len) {
+        lv_coord_t i_end = i;
+        while(i_end + 1 < len && cover[i_end + 1] == cover[i]) i_end++;
+
+        lv_opa_t px_opa = cover[i] == LV_OPA_COVER ? opa : (uint16_t)((uint16_t)opa * cover[i]) >> 8;
+        if(px_opa != LV_OPA_TRANSP) {
+            if(dir > 0) {
+                span_area.x1 = x + i;
+                span_area.x2 = x + i_end;
+            } else {
+                span_area.x1 = x - i_end;
+                span_area.x2 = x - i;
+            }
+            draw_fill(&span_area, mask, color, px_opa);
         }
+
+        i = i_end + 1;
     }
 }
+#endif
 
 #if USE_LV_SHADOW && LV_VDB_SIZE
 
@@ -1256,28 +2146,20 @@ static void lv_draw_cont_shadow_full(const lv_area_t * coords, const lv_area_t *
 
     radius = lv_draw_cont_radius_corr(radius, width, height);
 
-    lv_coord_t cruve_x[radius + swidth];     /*Stores the 'x' coordinates of a quarter circle.*/
-    memset(cruve_x, 0, sizeof(cruve_x));
-    lv_point_t circ;
-    lv_coord_t circ_tmp;
-    lv_circ_init(&circ, &circ_tmp, radius);
-    while(lv_circ_cont(&circ)) {
-        cruve_x[LV_CIRC_OCT1_Y(circ)] = LV_CIRC_OCT1_X(circ);
-        cruve_x[LV_CIRC_OCT2_Y(circ)] = LV_CIRC_OCT2_X(circ);
-        lv_circ_next(&circ, &circ_tmp);
-    }
+    /*Get the filtered opacity rows of the corners*/
+    lv_draw_corner_key_t key;
+    memset(&key, 0, sizeof(key));
+    key.type = LV_DRAW_CORNER_SHADOW_FULL;
+    key.opa = style->body.opa;
+    key.radius = radius;
+    key.swidth = swidth;
+    const lv_draw_corner_t * corner = lv_draw_corner_get(&key);
+    if(corner == NULL) return;
+
+    const lv_coord_t * cruve_x = corner->curve;
+    const lv_opa_t * opa_v_result = corner->opa;
     int16_t row;
 
-    int16_t filter_size = 2 * swidth + 1;
-    uint16_t opa_h_result[filter_size];
-
-    for(row = 0; row < filter_size; row++) {
-        opa_h_result[row] = (uint32_t)((uint32_t)(filter_size - row) * style->body.opa * 2) / (filter_size);
-    }
-
-    uint16_t p;
-    lv_opa_t opa_v_result[radius + swidth];
-
     lv_point_t point_rt;
     lv_point_t point_rb;
     lv_point_t point_lt;
@@ -1298,47 +2180,9 @@ static void lv_draw_cont_shadow_full(const lv_area_t * coords, const lv_area_t *
     ofs_lt.x = coords->x1 + radius;
     ofs_lt.y = coords->y1 + radius;
 
-    for(row = 0; row < radius + swidth; row++) {
-        for(p = 0; p < radius + swidth; p++) {
-           int16_t v;
-           uint32_t opa_tmp = 0;
-           int16_t row_v;
-           bool swidth_out = false;
-           for(v = -swidth; v < swidth; v++) {
-               row_v = row + v;
-               if(row_v < 0) row_v = 0; /*Rows above the corner*/
-
-               /*Rows below the bottom are empty so they won't modify the filter*/
-               if(row_v > radius) {
-                   break;
-               }
-               else
-               {
-                   int16_t p_tmp = p - (cruve_x[row_v] - cruve_x[row]);
-                   if(p_tmp < -swidth) { /*Cols before the filtered shadow (still not blurred)*/
-                       opa_tmp += style->body.opa * 2;
-                   }
-                   /*Cols after the filtered shadow (already no effect) */
-                   else if (p_tmp > swidth) {
-                       /* If on the current point the  filter top point is already out of swidth then
-                        * the remaining part will not do not anything on this point*/
-                       if(v == -swidth) { /*Is the first point?*/
-                           swidth_out = true;
-                       }
-                       break;
-                   } else {
-                       opa_tmp += opa_h_result[p_tmp + swidth];
-                   }
-               }
-           }
-           if(swidth_out == false) {
-               opa_tmp = opa_tmp / (filter_size);
-               opa_v_result[p] = opa_tmp > LV_OPA_COVER ? LV_OPA_COVER : opa_tmp;
-           }
-           else {
-               break;
-           }
-        }
+    lv_area_t run_area;
+    for(row = 0; row < corner->cnt; row++) {
+        uint16_t p = corner->opa_cnt[row];
 
         point_rt.x = cruve_x[row] + ofs_rt.x;
         point_rt.y = ofs_rt.y - row;
@@ -1352,37 +2196,46 @@ static void lv_draw_cont_shadow_full(const lv_area_t * coords, const lv_area_t *
         point_lb.x = ofs_lb.x - cruve_x[row];
         point_lb.y = ofs_lb.y + row;
 
-        uint16_t d;
-        for(d = 0; d < p; d++) {
+        /*Draw the runs of the same opacity as horizontal spans to the four corners*/
+        uint16_t d = 0;
+        while(d < p) {
+            uint16_t d_end = d;
+            while(d_end + 1 < p && opa_v_result[d_end + 1] == opa_v_result[d]) d_end++;
 
-            if(point_rt.x != point_lt.x) {
-                px_fp(point_lt.x,point_lt.y , mask, style->body.shadow.color, opa_v_result[d]);
-            }
+            /*The first left pixel is not drawn if it's the same as the first right pixel*/
+            uint16_t d_left = d;
+            if(d_left == 0 && point_rt.x == point_lt.x) d_left = 1;
 
-            if(point_rb.x != point_lb.x && point_lt.y != point_lb.y) {
-                px_fp(point_lb.x,point_lb.y , mask, style->body.shadow.color, opa_v_result[d]);
+            if(d_left <= d_end) {
+                lv_area_set(&run_area, point_lt.x - d_end, point_lt.y, point_lt.x - d_left, point_lt.y);
+                draw_fill(&run_area, mask, style->body.shadow.color, opa_v_result[d]);
+
+                if(point_lt.y != point_lb.y) {
+                    lv_area_set(&run_area, point_lb.x - d_end, point_lb.y, point_lb.x - d_left, point_lb.y);
+                    draw_fill(&run_area, mask, style->body.shadow.color, opa_v_result[d]);
+                }
             }
 
             if(point_lt.y != point_lb.y) {
-                px_fp(point_rb.x,point_rb.y , mask, style->body.shadow.color, opa_v_result[d]);
+                lv_area_set(&run_area, point_rb.x + d, point_rb.y, point_rb.x + d_end, point_rb.y);
+                draw_fill(&run_area, mask, style->body.shadow.color, opa_v_result[d]);
             }
 
+            lv_area_set(&run_area, point_rt.x + d, point_rt.y, point_rt.x + d_end, point_rt.y);
+            draw_fill(&run_area, mask, style->body.shadow.color, opa_v_result[d]);
 
-            px_fp(point_rt.x,point_rt.y , mask, style->body.shadow.color, opa_v_result[d]);
-
-
-            point_rb.x++;
-            point_lb.x--;
-
-            point_rt.x++;
-            point_lt.x--;
+            d = d_end + 1;
         }
 
         /*When the first row is known draw the straight pars with same opa. map*/
         if(row == 0) {
            lv_draw_cont_shadow_full_straight(coords, mask, style, opa_v_result);
         }
+
+        opa_v_result += p;
     }
+
+    lv_draw_corner_release(corner);
 }
 
 
@@ -1395,24 +2248,20 @@ static void lv_draw_cont_shadow_bottom(const lv_area_t * coords, const lv_area_t
 
     radius = lv_draw_cont_radius_corr(radius, width, height);
 
-    lv_coord_t cruve_x[radius + swidth];     /*Stores the 'x' coordinates of a quarter circle.*/
-    memset(cruve_x, 0, sizeof(cruve_x));
-    lv_point_t circ;
-    lv_coord_t circ_tmp;
-    lv_circ_init(&circ, &circ_tmp, radius);
-    while(lv_circ_cont(&circ)) {
-        cruve_x[LV_CIRC_OCT1_Y(circ)] = LV_CIRC_OCT1_X(circ);
-        cruve_x[LV_CIRC_OCT2_Y(circ)] = LV_CIRC_OCT2_X(circ);
-        lv_circ_next(&circ, &circ_tmp);
-    }
+    /*Get the quarter circle and the filter*/
+    lv_draw_corner_key_t key;
+    memset(&key, 0, sizeof(key));
+    key.type = LV_DRAW_CORNER_SHADOW_BOTTOM;
+    key.opa = style->body.opa;
+    key.radius = radius;
+    key.swidth = swidth;
+    const lv_draw_corner_t * corner = lv_draw_corner_get(&key);
+    if(corner == NULL) return;
+
+    const lv_coord_t * cruve_x = corner->curve;
+    const lv_opa_t * opa_h_result = corner->opa;
     int16_t row;
-
     int16_t filter_size = 2 * swidth + 1;
-    lv_opa_t opa_h_result[filter_size];
-
-    for(row = 0; row < filter_size; row++) {
-        opa_h_result[row] = (uint32_t)((uint32_t)(filter_size - row) * style->body.opa) / (filter_size);
-    }
 
     lv_point_t point_l;
     lv_point_t point_r;
@@ -1426,6 +2275,11 @@ static void lv_draw_cont_shadow_bottom(const lv_area_t * coords, const lv_area_t
     ofs2.x = coords->x2 - radius;
     ofs2.y = coords->y2 - radius;
 
+#if LV_REFR_STAT_NUM != 0
+    uint32_t px_cnt = 0;        /*'lv_vpx' doesn't count the pixels so count them once for the whole shadow*/
+    lv_area_t col_a;
+#endif
+
     for(row = 0; row < radius; row++) {
         point_l.x = ofs1.x + radius - row - radius;
         point_l.y = ofs1.y + cruve_x[row];
@@ -1433,17 +2287,29 @@ static void lv_draw_cont_shadow_bottom(const lv_area_t * coords, const lv_area_t
         point_r.x = ofs2.x + row;
         point_r.y = ofs2.y + cruve_x[row];
 
+#if LV_REFR_STAT_NUM != 0
+        /*The pixels of the two columns below which are on the mask*/
+        lv_area_set(&col_a, point_l.x, point_l.y, point_l.x, point_l.y + filter_size - swidth - 1);
+        if(lv_area_union(&col_a, &col_a, mask)) px_cnt += lv_area_get_size(&col_a);
+        lv_area_set(&col_a, point_r.x, point_r.y, point_r.x, point_r.y + filter_size - swidth - 1);
+        if(lv_area_union(&col_a, &col_a, mask)) px_cnt += lv_area_get_size(&col_a);
+#endif
+
         uint16_t d;
         for(d = swidth; d < filter_size; d++) {
-            px_fp(point_l.x, point_l.y, mask, style->body.shadow.color, opa_h_result[d]);
+            draw_px(point_l.x, point_l.y, mask, style->body.shadow.color, opa_h_result[d]);
             point_l.y ++;
 
-            px_fp(point_r.x, point_r.y, mask, style->body.shadow.color, opa_h_result[d]);
+            draw_px(point_r.x, point_r.y, mask, style->body.shadow.color, opa_h_result[d]);
             point_r.y ++;
         }
 
     }
 
+#if LV_REFR_STAT_NUM != 0
+    lv_refr_stat_add(LV_REFR_STAT_DRAW_PX, px_cnt);
+#endif
+
     area_mid.x1 = ofs1.x + 1;
     area_mid.y1 = ofs1.y + radius;
     area_mid.x2 = ofs2.x - 1;
@@ -1451,10 +2317,12 @@ static void lv_draw_cont_shadow_bottom(const lv_area_t * coords, const lv_area_t
 
     uint16_t d;
     for(d = swidth; d < filter_size; d++) {
-        fill_fp(&area_mid, mask, style->body.shadow.color, opa_h_result[d]);
+        draw_fill(&area_mid, mask, style->body.shadow.color, opa_h_result[d]);
         area_mid.y1 ++;
         area_mid.y2 ++;
     }
+
+    lv_draw_corner_release(corner);
 }
 
 static void lv_draw_cont_shadow_full_straight(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style, const lv_opa_t * map)
@@ -1493,19 +2361,19 @@ static void lv_draw_cont_shadow_full_straight(const lv_area_t * coords, const lv
 
     int16_t d;
     for(d = 0; d < swidth; d++) {
-        fill_fp(&sider_area, mask, style->body.shadow.color, map[d]);
+        draw_fill(&sider_area, mask, style->body.shadow.color, map[d]);
         sider_area.x1++;
         sider_area.x2++;
 
-        fill_fp(&sidel_area, mask, style->body.shadow.color, map[d]);
+        draw_fill(&sidel_area, mask, style->body.shadow.color, map[d]);
         sidel_area.x1--;
         sidel_area.x2--;
 
-        fill_fp(&sidet_area, mask, style->body.shadow.color, map[d]);
+        draw_fill(&sidet_area, mask, style->body.shadow.color, map[d]);
         sidet_area.y1--;
         sidet_area.y2--;
 
-        fill_fp(&sideb_area, mask, style->body.shadow.color, map[d]);
+        draw_fill(&sideb_area, mask, style->body.shadow.color, map[d]);
         sideb_area.y1++;
         sideb_area.y2++;
     }
@@ -1528,25 +2396,3 @@ static uint16_t lv_draw_cont_radius_corr(uint16_t r, lv_coord_t w, lv_coord_t h)
 	return r;
 }
 
-
-#if USE_LV_TRIANGLE != 0
-/**
- * Swap two points
- * p1 pointer to the first point
- * p2 pointer to the second point
- */
-static void point_swap(lv_point_t * p1, lv_point_t * p2)
-{
-    lv_point_t tmp;
-    tmp.x = p1->x;
-    tmp.y = p1->y;
-
-    p1->x = p2->x;
-    p1->y = p2->y;
-
-    p2->x = tmp.x;
-    p2->y = tmp.y;
-
-}
-
-#endif
@@ -19,6 +19,7 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+#define LV_IMG_ZOOM_NONE    256     /*Zoom of the original size (the zoom is in 1/256 units)*/
 
 /**********************
  *      TYPEDEFS
@@ -30,15 +31,102 @@ typedef struct
 {
     uint32_t w:12;        /*Width of the image map*/
     uint32_t h:12;        /*Height of the image map*/
-    uint32_t transp:1;    /*1: The image contains transparent pixels with LV_COLOR_TRANSP color*/
+    uint32_t transp:1;    /*1: The image contains transparent pixels with LV_COLOR_TRANSP color
+                                (LV_IMG_FORMAT_ALPHA: not fully opaque pixels)*/
     uint32_t cd:3;        /*Color depth (0: reserved, 1: 8 bit, 2: 16 bit or 3: 24 bit, 4-7: reserved)*/
-    uint32_t res :4;      /*Reserved*/
+    uint32_t format :4;   /*Encoding of the pixels from 'lv_img_format_t' (0: 'lv_color_t' map)*/
 }lv_img_raw_header_t;
 
+/*Encodings of the pixels after the image header (see 'lv_draw_img_dec.h' for the layouts)*/
+typedef enum
+{
+    LV_IMG_FORMAT_RAW = 0,      /*'lv_color_t' map*/
+    LV_IMG_FORMAT_INDEXED_1,    /*Palette of 2 colors and 1 bit indices*/
+    LV_IMG_FORMAT_INDEXED_2,    /*Palette of 4 colors and 2 bit indices*/
+    LV_IMG_FORMAT_INDEXED_4,    /*Palette of 16 colors and 4 bit indices*/
+    LV_IMG_FORMAT_INDEXED_8,    /*Palette of 256 colors and 8 bit indices*/
+    LV_IMG_FORMAT_RLE,          /*Run length encoded pixels in blocks of rows*/
+    LV_IMG_FORMAT_LZ,           /*LZ77 compressed pixels in blocks of rows*/
+    LV_IMG_FORMAT_ALPHA,        /*'lv_color_t' map and an opacity for every pixel*/
+}lv_img_format_t;
+
+/*Capabilities of a draw backend: the hooks it has*/
+typedef enum
+{
+    LV_DRAW_CAP_PX      = 0x01,
+    LV_DRAW_CAP_FILL    = 0x02,
+    LV_DRAW_CAP_LETTER  = 0x04,
+    LV_DRAW_CAP_MAP     = 0x08,
+    LV_DRAW_CAP_LINE    = 0x10,
+    LV_DRAW_CAP_RECT    = 0x20,
+    LV_DRAW_CAP_POLYLINE = 0x40,
+    LV_DRAW_CAP_POLYGON = 0x80,
+    LV_DRAW_CAP_ARC     = 0x100,
+}lv_draw_cap_t;
+
+/*Shape of the ends of a polyline*/
+typedef enum
+{
+    LV_DRAW_LINE_CAP_BUTT,      /*Cut at the end points*/
+    LV_DRAW_LINE_CAP_SQUARE,    /*Cut at half width after the end points*/
+    LV_DRAW_LINE_CAP_ROUND,     /*Half circle around the end points*/
+}lv_draw_line_cap_t;
+
+/*Shape of the joints of the segments of a polyline*/
+typedef enum
+{
+    LV_DRAW_LINE_JOIN_MITER,    /*Sharp corner (bevel if it would be too long)*/
+    LV_DRAW_LINE_JOIN_BEVEL,    /*Cut corner*/
+    LV_DRAW_LINE_JOIN_ROUND,    /*Round corner*/
+}lv_draw_line_join_t;
+
+/*Rules to decide which parts of a self-intersecting polygon are filled*/
+typedef enum
+{
+    LV_DRAW_FILL_RULE_NONZERO,  /*Filled where the edges wind around not zero times*/
+    LV_DRAW_FILL_RULE_EVENODD,  /*Filled where a ray crosses the edges odd times (the overlaps are holes)*/
+}lv_draw_fill_rule_t;
+
+/* Drawing operations of a display (see 'draw_backend' in 'lv_disp_drv_t')
+ * Only the hooks with capability flag are called. They return false if they can't handle
+ * an operation (e.g. a not supported style) and then the software draws it.*/
+typedef struct _lv_draw_backend_t
+{
+    uint16_t caps;  /*OR-ed 'lv_draw_cap_t' values*/
+
+    /*Basic operations. The coordinates are on the VDB (doubled if LV_ANTIALIAS is enabled)*/
+    bool (*px)(lv_coord_t x, lv_coord_t y, const lv_area_t * mask_p, lv_color_t color, lv_opa_t opa);
+    bool (*fill)(const lv_area_t * cords_p, const lv_area_t * mask_p, lv_color_t color, lv_opa_t opa);
+    /*The glyphs can have 1, 2, 4 or 8 bpp ('lv_font_get_glyph_dsc()'), return false for the not supported ones*/
+    bool (*letter)(const lv_point_t * pos_p, const lv_area_t * mask_p, const lv_font_t * font_p,
+                   uint32_t letter, lv_color_t color, lv_opa_t opa);
+    /*Blend a color map (images, previously drawn areas)*/
+    bool (*map)(const lv_area_t * cords_p, const lv_area_t * mask_p, const lv_color_t * map_p, const lv_opa_t * alpha_p,
+                lv_opa_t opa, bool transp, bool upscale, lv_color_t recolor, lv_opa_t recolor_opa);
+
+    /*Complex operations with the parameters of 'lv_draw_line', 'lv_draw_rect', 'lv_draw_polyline', 'lv_draw_polygon'
+     * and 'lv_draw_arc' (not doubled with LV_ANTIALIAS)*/
+    bool (*line)(const lv_point_t * p1, const lv_point_t * p2, const lv_area_t * mask_p, const lv_style_t * style_p);
+    bool (*rect)(const lv_area_t * cords_p, const lv_area_t * mask_p, const lv_style_t * style_p);
+    bool (*polyline)(const lv_point_t * points, uint16_t point_num, const lv_area_t * mask_p, const lv_style_t * style_p,
+                     lv_draw_line_cap_t cap, lv_draw_line_join_t join);
+    bool (*polygon)(const lv_point_t * points, uint16_t point_num, const lv_area_t * mask_p, const lv_style_t * style_p,
+                    lv_draw_fill_rule_t rule);
+    bool (*arc)(const lv_point_t * center, lv_coord_t radius, int32_t start_angle, int32_t end_angle,
+                const lv_area_t * mask_p, const lv_style_t * style_p, lv_draw_line_cap_t cap);
+}lv_draw_backend_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
+/**
+ * Get the software drawing as a draw backend (it has every capability).
+ * Useful for backends which forward the operations (e.g. to trace them).
+ * @return pointer to the software draw backend
+ */
+const lv_draw_backend_t * lv_draw_get_sw_backend(void);
+
 /**
  * Draw a rectangle
  * @param cords_p the coordinates of the rectangle
@@ -47,18 +135,24 @@ typedef struct
  */
 void lv_draw_rect(const lv_area_t * cords_p, const lv_area_t * mask_p, const lv_style_t * style_p);
 
+/**
+ * Fill a polygon (also concave or self-intersecting) with 'body.main_color' and 'body.opa' of a style
+ * @param points array of the vertices (the last vertex is connected to the first one)
+ * @param point_num number of vertices
+ * @param mask_p the polygon will be drawn only in this mask
+ * @param style_p pointer to a style
+ * @param rule the fill rule of the self-intersecting parts
+ */
+void lv_draw_polygon(const lv_point_t * points, uint16_t point_num, const lv_area_t * mask_p, const lv_style_t * style_p,
+                     lv_draw_fill_rule_t rule);
 
-/*Experimental use for 3D modeling*/
-#define USE_LV_TRIANGLE 0
-#if USE_LV_TRIANGLE != 0
 /**
- *
+ * Fill a triangle
  * @param points pointer to an array with 3 points
  * @param mask_p the triangle will be drawn only in this mask
  * @param color color of the triangle
  */
 void lv_draw_triangle(const lv_point_t * points, const lv_area_t * mask_p, lv_color_t color);
-#endif
 
 /**
  * Write a text
@@ -81,8 +175,34 @@ void lv_draw_label(const lv_area_t * cords_p,const lv_area_t * mask_p, const lv_
  */
 void lv_draw_img(const lv_area_t * cords_p, const lv_area_t * mask_p,
                  const lv_style_t * style_p, const char * fn);
+
+/**
+ * Draw a scaled and rotated image.
+ * The image rows sampled in the mask are decoded into a temporary buffer on every call
+ * unless the image is raw in the memory of its driver or it's in the image cache (LV_IMG_CACHE_SIZE).
+ * @param cords_p the coordinates of the image without transformation
+ * @param mask_p the image will be drawn only in this area
+ * @param style_p pointer to a style
+ * @param fn path of the image file
+ * @param zoom scale in 1 / LV_IMG_ZOOM_NONE units (LV_IMG_ZOOM_NONE: 'cords_p' size)
+ * @param angle clockwise rotation in 1 / (1 << TRIGO_ANGLE_SHIFT) degrees
+ * @param pivot scale and rotate around this point (relative to the top left corner of 'cords_p')
+ * @param antialias true: bilinear filtering, false: nearest pixel (faster)
+ */
+void lv_draw_img_transformed(const lv_area_t * cords_p, const lv_area_t * mask_p, const lv_style_t * style_p,
+                             const char * fn, uint16_t zoom, int32_t angle, const lv_point_t * pivot, bool antialias);
 #endif
 
+/**
+ * Copy a color map (e.g. a previously drawn area) to the display
+ * @param cords_p the coordinates of the map
+ * @param mask_p the map will be drawn only in this area
+ * @param map_p pointer to a lv_color_t array which contains the pixels of 'cords_p'
+ *              (in double size if LV_ANTIALIAS is enabled)
+ * @param opa opacity of the map (0..255)
+ */
+void lv_draw_map(const lv_area_t * cords_p, const lv_area_t * mask_p, const lv_color_t * map_p, lv_opa_t opa);
+
 /**
  * Draw a line
  * @param p1 first point of the line
@@ -93,6 +213,31 @@ void lv_draw_img(const lv_area_t * cords_p, const lv_area_t * mask_p,
 void lv_draw_line(const lv_point_t * p1, const lv_point_t * p2, const lv_area_t * mask_p,
                   const lv_style_t * style_p);
 
+/**
+ * Draw connected lines. The joints are drawn once so a transparent polyline has uniform opacity.
+ * @param points array of points
+ * @param point_num number of points in 'points'
+ * @param mask_p the polyline will be drawn only on this area
+ * @param style_p pointer to a style (the 'line' part is used)
+ * @param cap shape of the ends of the polyline
+ * @param join shape of the joints of the segments
+ */
+void lv_draw_polyline(const lv_point_t * points, uint16_t point_num, const lv_area_t * mask_p,
+                      const lv_style_t * style_p, lv_draw_line_cap_t cap, lv_draw_line_join_t join);
+
+/**
+ * Draw an arc (a part of a ring) with the 'line' part of a style. The ring is 'line.width' thick inside 'radius'.
+ * @param center center of the circle
+ * @param radius outer radius of the ring
+ * @param start_angle start angle in 1 / (1 << TRIGO_ANGLE_SHIFT) degrees (0 is on the right, it grows clockwise)
+ * @param end_angle end angle in 1 / (1 << TRIGO_ANGLE_SHIFT) degrees (a full ring if it's 360 degrees after 'start_angle')
+ * @param mask_p the arc will be drawn only in this mask
+ * @param style_p pointer to a style
+ * @param cap shape of the ends of the arc
+ */
+void lv_draw_arc(const lv_point_t * center, lv_coord_t radius, int32_t start_angle, int32_t end_angle,
+                 const lv_area_t * mask_p, const lv_style_t * style_p, lv_draw_line_cap_t cap);
+
 /**********************
  *      MACROS
  **********************/
@@ -1,6 +1,13 @@
 CSRCS += lv_draw_vbasic.c
 CSRCS += lv_draw.c
 CSRCS += lv_draw_rbasic.c
+CSRCS += lv_draw_simd.c
+CSRCS += lv_draw_corner.c
+CSRCS += lv_draw_grad.c
+CSRCS += lv_draw_scan.c
+CSRCS += lv_draw_img_cache.c
+CSRCS += lv_draw_img_dec.c
+CSRCS += lv_draw_img_trans.c
 
 DEPPATH += --dep-path lvgl/lv_draw
 VPATH += :lvgl/lv_draw
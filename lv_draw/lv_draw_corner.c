@@ -0,0 +1,617 @@
+/**
+ * @file lv_draw_corner.c
+ * Precomputed masks of the rounded corners and shadows of the rectangles with an LRU cache
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_corner.h"
+#include "../lv_misc/lv_circ.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_ll.h"
+#include "../lv_misc/lv_trigo.h"
+#include <string.h>
+
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_CNT != 0
+#include <pthread.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool corner_build(lv_draw_corner_t * corner, const lv_draw_corner_key_t * key);
+static uint16_t corner_build_body(const lv_draw_corner_key_t * key, lv_draw_corner_span_t * spans);
+static uint16_t corner_build_border(const lv_draw_corner_key_t * key, lv_draw_corner_step_t * steps);
+static uint32_t corner_build_shadow_full(const lv_draw_corner_key_t * key, lv_coord_t * curve, uint16_t * opa_cnt, lv_opa_t * opa);
+static void corner_build_shadow_bottom(const lv_draw_corner_key_t * key, lv_coord_t * curve, lv_opa_t * opa);
+static uint16_t corner_build_cover(const lv_draw_corner_key_t * key, lv_draw_corner_row_t * rows, lv_opa_t * opa);
+static void corner_build_curve(lv_coord_t radius, lv_coord_t * curve, uint16_t len);
+static void corner_set_arrays(lv_draw_corner_t * corner);
+#if LV_CORNER_CACHE_SIZE != 0
+static lv_draw_corner_t * corner_find(const lv_draw_corner_key_t * key);
+static bool corner_evict(void);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_CORNER_CACHE_SIZE != 0
+static lv_ll_t corner_ll;               /*Linked list of the cached 'lv_draw_corner_t'*/
+static uint32_t corner_used;            /*Size of the cached masks in bytes*/
+static uint32_t corner_tick;            /*Incremented on every use of a mask*/
+static uint32_t corner_hit_cnt;
+static uint32_t corner_evict_cnt;
+#endif
+static uint32_t corner_miss_cnt;
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_CNT != 0
+static pthread_mutex_t corner_mutex = PTHREAD_MUTEX_INITIALIZER;    /*The rendering workers draw rectangles in parallel*/
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_CNT != 0
+#define LV_DRAW_CORNER_LOCK()       pthread_mutex_lock(&corner_mutex)
+#define LV_DRAW_CORNER_UNLOCK()     pthread_mutex_unlock(&corner_mutex)
+#else
+#define LV_DRAW_CORNER_LOCK()
+#define LV_DRAW_CORNER_UNLOCK()
+#endif
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the cache of the rectangle masks. Called by 'lv_init()'.
+ */
+void lv_draw_corner_init(void)
+{
+#if LV_CORNER_CACHE_SIZE != 0
+    lv_ll_init(&corner_ll, sizeof(lv_draw_corner_t));
+#endif
+}
+
+/**
+ * Get a precomputed rectangle mask. It's computed if it's not in the cache.
+ * Release it with 'lv_draw_corner_release()' when the drawing is ready.
+ * @param key the type and the parameters of the mask
+ * @return pointer to the mask or NULL if out of memory
+ */
+const lv_draw_corner_t * lv_draw_corner_get(const lv_draw_corner_key_t * key)
+{
+    lv_draw_corner_t * corner;
+    lv_draw_corner_t new_corner;
+
+    LV_DRAW_CORNER_LOCK();
+
+#if LV_CORNER_CACHE_SIZE != 0
+    corner_tick++;
+    corner = corner_find(key);
+    if(corner != NULL) {
+        corner->last_use = corner_tick;
+        corner->ref_cnt++;
+        corner_hit_cnt++;
+        LV_DRAW_CORNER_UNLOCK();
+        return corner;
+    }
+#endif
+
+    corner_miss_cnt++;
+    if(corner_build(&new_corner, key) == false) {
+        LV_DRAW_CORNER_UNLOCK();
+        return NULL;
+    }
+    new_corner.ref_cnt = 1;
+
+#if LV_CORNER_CACHE_SIZE != 0
+    /*Free the least recently used masks if the new one doesn't fit into the budget*/
+    if(new_corner.buf_size <= LV_CORNER_CACHE_SIZE) {
+        while(corner_used + new_corner.buf_size > LV_CORNER_CACHE_SIZE) {
+            if(corner_evict() == false) break;
+        }
+
+        if(corner_used + new_corner.buf_size <= LV_CORNER_CACHE_SIZE) {
+            corner = lv_ll_ins_head(&corner_ll);
+            if(corner != NULL) {
+                memcpy(corner, &new_corner, sizeof(lv_draw_corner_t));
+                corner->cached = 1;
+                corner->last_use = corner_tick;
+                corner_set_arrays(corner);
+                corner_used += corner->buf_size;
+                LV_DRAW_CORNER_UNLOCK();
+                return corner;
+            }
+        }
+    }
+#endif
+
+    /*Not cached: it's freed when released*/
+    corner = lv_mem_alloc(sizeof(lv_draw_corner_t));
+    if(corner == NULL) {
+        lv_mem_free(new_corner.buf);
+        LV_DRAW_CORNER_UNLOCK();
+        return NULL;
+    }
+    memcpy(corner, &new_corner, sizeof(lv_draw_corner_t));
+    corner->cached = 0;
+    corner_set_arrays(corner);
+
+    LV_DRAW_CORNER_UNLOCK();
+
+    return corner;
+}
+
+/**
+ * Release a mask got with 'lv_draw_corner_get()'
+ * @param corner pointer to the mask
+ */
+void lv_draw_corner_release(const lv_draw_corner_t * corner)
+{
+    lv_draw_corner_t * c = (lv_draw_corner_t *) corner;
+
+    LV_DRAW_CORNER_LOCK();
+    if(c->ref_cnt != 0) c->ref_cnt--;
+    if(c->cached == 0 && c->ref_cnt == 0) {
+        lv_mem_free(c->buf);
+        lv_mem_free(c);
+    }
+    LV_DRAW_CORNER_UNLOCK();
+}
+
+/**
+ * Get the coverage of a pixel of an anti-aliased corner
+ * @param corner pointer to a LV_DRAW_CORNER_COVER mask
+ * @param x x coordinate of the pixel relative to the corner's left-top pixel
+ * @param y y coordinate of the pixel relative to the corner's left-top pixel
+ * @return coverage of the pixel (LV_OPA_TRANSP: not covered, LV_OPA_COVER: fully covered)
+ */
+lv_opa_t lv_draw_corner_get_cover(const lv_draw_corner_t * corner, lv_coord_t x, lv_coord_t y)
+{
+    /*Out of the corner's square the inside of the rectangle is covered*/
+    if(x < 0 || y < 0) return LV_OPA_TRANSP;
+    if(x >= corner->cnt || y >= corner->cnt) return LV_OPA_COVER;
+
+    const lv_draw_corner_row_t * row = &corner->rows[y];
+    if(x < row->first) return LV_OPA_TRANSP;
+    if(x >= row->full) return LV_OPA_COVER;
+
+    return corner->opa[row->ofs + x - row->first];
+}
+
+/**
+ * Give information about the cache of the rectangle masks
+ * @param mon_p pointer to a lv_draw_corner_monitor_t variable,
+ *              the result of the analysis will be stored here
+ */
+void lv_draw_corner_monitor(lv_draw_corner_monitor_t * mon_p)
+{
+    memset(mon_p, 0, sizeof(lv_draw_corner_monitor_t));
+
+    LV_DRAW_CORNER_LOCK();
+    mon_p->miss_cnt = corner_miss_cnt;
+#if LV_CORNER_CACHE_SIZE != 0
+    mon_p->hit_cnt = corner_hit_cnt;
+    mon_p->evict_cnt = corner_evict_cnt;
+    mon_p->used_size = corner_used;
+
+    lv_draw_corner_t * corner;
+    LL_READ(corner_ll, corner) {
+        mon_p->mask_cnt++;
+    }
+#endif
+    LV_DRAW_CORNER_UNLOCK();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Compute a mask into a new buffer
+ * @param corner the buffer and the number of elements are stored here
+ * @param key the type and the parameters of the mask
+ * @return false: out of memory
+ */
+static bool corner_build(lv_draw_corner_t * corner, const lv_draw_corner_key_t * key)
+{
+    memset(corner, 0, sizeof(lv_draw_corner_t));
+    memcpy(&corner->key, key, sizeof(lv_draw_corner_key_t));
+
+    /*Allocate for the worst case and shrink when the real size is known*/
+    lv_coord_t radius = key->radius;
+    uint32_t rows = radius + key->swidth;
+    uint32_t max_size;
+    switch(key->type) {
+        case LV_DRAW_CORNER_BODY:
+            max_size = (2 * radius + 4) * sizeof(lv_draw_corner_span_t);
+            break;
+        case LV_DRAW_CORNER_BORDER:
+            max_size = (radius + 1) * sizeof(lv_draw_corner_step_t);
+            break;
+        case LV_DRAW_CORNER_SHADOW_FULL:
+            max_size = rows * (sizeof(lv_coord_t) + sizeof(uint16_t) + rows);
+            break;
+        case LV_DRAW_CORNER_SHADOW_BOTTOM:
+            max_size = rows * sizeof(lv_coord_t) + 2 * key->swidth + 1;
+            break;
+        case LV_DRAW_CORNER_COVER:
+            max_size = radius * (sizeof(lv_draw_corner_row_t) + radius);
+            break;
+        default:
+            return false;
+    }
+
+    corner->buf = lv_mem_alloc(max_size);
+    if(corner->buf == NULL) return false;
+
+    uint32_t opa_num;
+    switch(key->type) {
+        case LV_DRAW_CORNER_BODY:
+            corner->cnt = corner_build_body(key, (lv_draw_corner_span_t *) corner->buf);
+            corner->buf_size = corner->cnt * sizeof(lv_draw_corner_span_t);
+            break;
+        case LV_DRAW_CORNER_BORDER:
+            corner->cnt = corner_build_border(key, (lv_draw_corner_step_t *) corner->buf);
+            corner->buf_size = corner->cnt * sizeof(lv_draw_corner_step_t);
+            break;
+        case LV_DRAW_CORNER_SHADOW_FULL:
+            corner->cnt = rows;
+            corner_set_arrays(corner);
+            opa_num = corner_build_shadow_full(key, (lv_coord_t *) corner->curve, (uint16_t *) corner->opa_cnt, (lv_opa_t *) corner->opa);
+            corner->buf_size = rows * (sizeof(lv_coord_t) + sizeof(uint16_t)) + opa_num;
+            break;
+        case LV_DRAW_CORNER_SHADOW_BOTTOM:
+            corner->cnt = rows;
+            corner_set_arrays(corner);
+            corner_build_shadow_bottom(key, (lv_coord_t *) corner->curve, (lv_opa_t *) corner->opa);
+            corner->buf_size = max_size;
+            break;
+        case LV_DRAW_CORNER_COVER:
+            corner->cnt = radius;
+            corner_set_arrays(corner);
+            opa_num = corner_build_cover(key, (lv_draw_corner_row_t *) corner->rows, (lv_opa_t *) corner->opa);
+            corner->buf_size = radius * sizeof(lv_draw_corner_row_t) + opa_num;
+            break;
+    }
+
+    if(corner->buf_size < max_size) {
+        uint8_t * buf_new = lv_mem_realloc(corner->buf, corner->buf_size);
+        if(buf_new != NULL) corner->buf = buf_new;
+    }
+
+    return true;
+}
+
+/**
+ * Compute the spans of the body's corners. The spans are the same which
+ * a circle drawing gives row by row from the middle to the top and bottom.
+ * @param key key of a LV_DRAW_CORNER_BODY mask
+ * @param spans store the spans here (max. '2 * radius + 4')
+ * @return number of spans
+ */
+static uint16_t corner_build_body(const lv_draw_corner_key_t * key, lv_draw_corner_span_t * spans)
+{
+    uint16_t cnt = 0;
+    lv_point_t cir;
+    lv_coord_t cir_tmp;
+    lv_circ_init(&cir, &cir_tmp, key->radius);
+
+    lv_draw_corner_span_t mid;      /*Rows of the octets around the middle*/
+    lv_draw_corner_span_t edge;     /*Rows of the octets at the top and bottom edges*/
+    mid.dy = cir.y;
+    mid.w = cir.x;
+    mid.part = LV_DRAW_CORNER_TOP | LV_DRAW_CORNER_BOTTOM;
+    edge.dy = cir.x;
+    edge.w = cir.y;
+    edge.part = LV_DRAW_CORNER_TOP | LV_DRAW_CORNER_BOTTOM;
+
+    while(lv_circ_cont(&cir)) {
+        /*If a new row is coming save the previous
+         * The x coordinate can grow on the same y so wait for the last x*/
+        if(edge.dy != cir.x) spans[cnt++] = edge;
+
+        /*The first row in the middle is drawn by the body drawer*/
+        if(mid.dy != cir.y && mid.dy != 0) spans[cnt++] = mid;
+
+        mid.dy = cir.y;
+        mid.w = cir.x;
+        edge.dy = cir.x;
+        edge.w = cir.y;
+
+        lv_circ_next(&cir, &cir_tmp);
+    }
+
+    /*The last rows. If they are the same, the top is drawn as an edge and the bottom as a middle row*/
+    if(edge.dy == mid.dy) {
+        edge.part = LV_DRAW_CORNER_TOP;
+        mid.part = LV_DRAW_CORNER_BOTTOM;
+    }
+    spans[cnt++] = edge;
+    spans[cnt++] = mid;
+
+    return cnt;
+}
+
+/**
+ * Compute the steps of the border's corners
+ * @param key key of a LV_DRAW_CORNER_BORDER mask
+ * @param steps store the steps here (max. 'radius + 1')
+ * @return number of steps
+ */
+static uint16_t corner_build_border(const lv_draw_corner_key_t * key, lv_draw_corner_step_t * steps)
+{
+    uint16_t cnt = 0;
+    lv_point_t cir_out;
+    lv_coord_t tmp_out;
+    lv_circ_init(&cir_out, &tmp_out, key->radius);
+
+    lv_point_t cir_in;
+    lv_coord_t tmp_in;
+    lv_coord_t radius_in = key->radius - key->bwidth;
+
+    if(radius_in < 0){
+        radius_in = 0;
+    }
+
+    lv_circ_init(&cir_in, &tmp_in, radius_in);
+
+    while(cir_out.y <= cir_out.x) {
+        /*Calculate the actual width to avoid overwriting pixels*/
+        steps[cnt].out = cir_out;
+        if(cir_in.y < cir_in.x) {
+            steps[cnt].w1 = cir_out.x - cir_in.x;
+            steps[cnt].w2 = steps[cnt].w1;
+        } else {
+            steps[cnt].w1 = cir_out.x - cir_out.y;
+            steps[cnt].w2 = steps[cnt].w1 - 1;
+        }
+        cnt++;
+
+        lv_circ_next(&cir_out, &tmp_out);
+
+        /*The internal circle will be ready faster
+         * so check it! */
+        if(cir_in.y < cir_in.x) {
+            lv_circ_next(&cir_in, &tmp_in);
+        }
+    }
+
+    return cnt;
+}
+
+/**
+ * Compute the opacity rows of a full shadow's corners by filtering the quarter circle
+ * @param key key of a LV_DRAW_CORNER_SHADOW_FULL mask
+ * @param curve store the 'x' of the quarter circle here ('radius + swidth' values)
+ * @param opa_cnt store the number of opacity values of the rows here ('radius + swidth' values)
+ * @param opa store the opacity rows here after each other (max. '(radius + swidth)^2' values)
+ * @return number of opacity values
+ */
+static uint32_t corner_build_shadow_full(const lv_draw_corner_key_t * key, lv_coord_t * curve, uint16_t * opa_cnt, lv_opa_t * opa)
+{
+    lv_coord_t radius = key->radius;
+    lv_coord_t swidth = key->swidth;
+    uint32_t opa_num = 0;
+
+    corner_build_curve(radius, curve, radius + swidth);
+
+    int16_t row;
+    int16_t filter_size = 2 * swidth + 1;
+    uint16_t opa_h_result[filter_size];
+
+    for(row = 0; row < filter_size; row++) {
+        opa_h_result[row] = (uint32_t)((uint32_t)(filter_size - row) * key->opa * 2) / (filter_size);
+    }
+
+    for(row = 0; row < radius + swidth; row++) {
+        lv_opa_t * opa_v_result = &opa[opa_num];
+        uint16_t p;
+        for(p = 0; p < radius + swidth; p++) {
+           int16_t v;
+           uint32_t opa_tmp = 0;
+           int16_t row_v;
+           bool swidth_out = false;
+           for(v = -swidth; v < swidth; v++) {
+               row_v = row + v;
+               if(row_v < 0) row_v = 0; /*Rows above the corner*/
+
+               /*Rows below the bottom are empty so they won't modify the filter*/
+               if(row_v > radius) {
+                   break;
+               }
+               else
+               {
+                   int16_t p_tmp = p - (curve[row_v] - curve[row]);
+                   if(p_tmp < -swidth) { /*Cols before the filtered shadow (still not blurred)*/
+                       opa_tmp += key->opa * 2;
+                   }
+                   /*Cols after the filtered shadow (already no effect) */
+                   else if (p_tmp > swidth) {
+                       /* If on the current point the  filter top point is already out of swidth then
+                        * the remaining part will not do not anything on this point*/
+                       if(v == -swidth) { /*Is the first point?*/
+                           swidth_out = true;
+                       }
+                       break;
+                   } else {
+                       opa_tmp += opa_h_result[p_tmp + swidth];
+                   }
+               }
+           }
+           if(swidth_out == false) {
+               opa_tmp = opa_tmp / (filter_size);
+               opa_v_result[p] = opa_tmp > LV_OPA_COVER ? LV_OPA_COVER : opa_tmp;
+           }
+           else {
+               break;
+           }
+        }
+
+        opa_cnt[row] = p;
+        opa_num += p;
+    }
+
+    return opa_num;
+}
+
+/**
+ * Compute the quarter circle and the opacity filter of a bottom shadow
+ * @param key key of a LV_DRAW_CORNER_SHADOW_BOTTOM mask
+ * @param curve store the 'x' of the quarter circle here ('radius + swidth' values)
+ * @param opa store the filter here ('2 * swidth + 1' values)
+ */
+static void corner_build_shadow_bottom(const lv_draw_corner_key_t * key, lv_coord_t * curve, lv_opa_t * opa)
+{
+    corner_build_curve(key->radius, curve, key->radius + key->swidth);
+
+    int16_t row;
+    int16_t filter_size = 2 * key->swidth + 1;
+    for(row = 0; row < filter_size; row++) {
+        opa[row] = (uint32_t)((uint32_t)(filter_size - row) * key->opa) / (filter_size);
+    }
+}
+
+/**
+ * Compute the coverage of the pixels of an anti-aliased corner.
+ * The corner is a quarter circle in a 'radius' x 'radius' square. The coverage of a pixel
+ * is estimated from the distance of its center from the circle: 'radius - distance + 0.5'
+ * @param key key of a LV_DRAW_CORNER_COVER mask
+ * @param rows store the rows here ('radius' rows)
+ * @param opa store the coverage of the partially covered pixels here (max. 'radius^2' values)
+ * @return number of coverage values
+ */
+static uint16_t corner_build_cover(const lv_draw_corner_key_t * key, lv_draw_corner_row_t * rows, lv_opa_t * opa)
+{
+    lv_coord_t radius = key->radius;
+    uint16_t opa_num = 0;
+    lv_coord_t x;
+    lv_coord_t y;
+
+    for(y = 0; y < radius; y++) {
+        rows[y].first = radius;
+        rows[y].full = radius;
+        rows[y].ofs = opa_num;
+
+        /*Distances in half pixels from the center of the circle to the center of the pixels*/
+        int32_t dy = 2 * (radius - y) - 1;
+        for(x = 0; x < radius; x++) {
+            int32_t dx = 2 * (radius - x) - 1;
+            uint32_t dist = lv_trigo_sqrt((uint64_t)(dx * dx + dy * dy) << 16);      /*In 1/256 half pixels*/
+            int32_t cover = ((int32_t)((2 * radius + 1) << 8) - (int32_t)dist) * LV_OPA_COVER / 512;
+
+            if(cover <= LV_OPA_TRANSP) continue;
+
+            if(rows[y].first == radius) rows[y].first = x;
+
+            if(cover >= LV_OPA_COVER) {
+                rows[y].full = x;
+                break;
+            }
+
+            opa[opa_num] = cover;
+            opa_num++;
+        }
+    }
+
+    return opa_num;
+}
+
+/**
+ * Store the 'x' coordinates of a quarter circle row by row
+ * @param radius radius of the circle
+ * @param curve store the coordinates here
+ * @param len number of rows to store (the rows after the radius are 0)
+ */
+static void corner_build_curve(lv_coord_t radius, lv_coord_t * curve, uint16_t len)
+{
+    memset(curve, 0, len * sizeof(lv_coord_t));
+    lv_point_t circ;
+    lv_coord_t circ_tmp;
+    lv_circ_init(&circ, &circ_tmp, radius);
+    while(lv_circ_cont(&circ)) {
+        curve[LV_CIRC_OCT1_Y(circ)] = LV_CIRC_OCT1_X(circ);
+        curve[LV_CIRC_OCT2_Y(circ)] = LV_CIRC_OCT2_X(circ);
+        lv_circ_next(&circ, &circ_tmp);
+    }
+}
+
+/**
+ * Set the array pointers of a mask according to its buffer, type and number of elements
+ * @param corner pointer to a mask
+ */
+static void corner_set_arrays(lv_draw_corner_t * corner)
+{
+    switch(corner->key.type) {
+        case LV_DRAW_CORNER_BODY:
+            corner->spans = (const lv_draw_corner_span_t *) corner->buf;
+            break;
+        case LV_DRAW_CORNER_BORDER:
+            corner->steps = (const lv_draw_corner_step_t *) corner->buf;
+            break;
+        case LV_DRAW_CORNER_SHADOW_FULL:
+            corner->curve = (const lv_coord_t *) corner->buf;
+            corner->opa_cnt = (const uint16_t *) &corner->buf[corner->cnt * sizeof(lv_coord_t)];
+            corner->opa = &corner->buf[corner->cnt * (sizeof(lv_coord_t) + sizeof(uint16_t))];
+            break;
+        case LV_DRAW_CORNER_SHADOW_BOTTOM:
+            corner->curve = (const lv_coord_t *) corner->buf;
+            corner->opa = &corner->buf[corner->cnt * sizeof(lv_coord_t)];
+            break;
+        case LV_DRAW_CORNER_COVER:
+            corner->rows = (const lv_draw_corner_row_t *) corner->buf;
+            corner->opa = &corner->buf[corner->cnt * sizeof(lv_draw_corner_row_t)];
+            break;
+    }
+}
+
+#if LV_CORNER_CACHE_SIZE != 0
+static lv_draw_corner_t * corner_find(const lv_draw_corner_key_t * key)
+{
+    lv_draw_corner_t * corner;
+    LL_READ(corner_ll, corner) {
+        if(corner->key.type == key->type &&
+           corner->key.opa == key->opa &&
+           corner->key.radius == key->radius &&
+           corner->key.bwidth == key->bwidth &&
+           corner->key.swidth == key->swidth) {
+            return corner;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Free the least recently used mask which is not used by a drawing
+ * @return true: a mask is freed, false: there is no mask to free
+ */
+static bool corner_evict(void)
+{
+    lv_draw_corner_t * corner;
+    lv_draw_corner_t * lru = NULL;
+    LL_READ(corner_ll, corner) {
+        if(corner->ref_cnt != 0) continue;
+        if(lru == NULL || corner_tick - corner->last_use > corner_tick - lru->last_use) lru = corner;
+    }
+
+    if(lru == NULL) return false;
+
+    corner_used -= lru->buf_size;
+    lv_mem_free(lru->buf);
+    lv_ll_rem(&corner_ll, lru);
+    lv_mem_free(lru);
+    corner_evict_cnt++;
+
+    return true;
+}
+#endif
@@ -0,0 +1,166 @@
+/**
+ * @file lv_draw_corner.h
+ *
+ */
+
+#ifndef LV_DRAW_CORNER_H
+#define LV_DRAW_CORNER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include "../lv_misc/lv_area.h"
+#include "../lv_misc/lv_color.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef LV_CORNER_CACHE_SIZE
+#define LV_CORNER_CACHE_SIZE    0
+#endif
+
+#ifndef LV_RECT_AA
+#define LV_RECT_AA              0
+#endif
+
+/*Anti-alias the rounded corners analytically (without LV_ANTIALIAS the corners would be jagged)*/
+#define LV_DRAW_RECT_AA         (LV_ANTIALIAS == 0 && LV_RECT_AA != 0)
+
+/*Parts of a corner span*/
+#define LV_DRAW_CORNER_TOP      0x01
+#define LV_DRAW_CORNER_BOTTOM   0x02
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Types of the precomputed rectangle masks*/
+typedef enum
+{
+    LV_DRAW_CORNER_BODY,            /*Spans of the rounded corners of the body*/
+    LV_DRAW_CORNER_BORDER,          /*Steps of the rounded corners of the border*/
+    LV_DRAW_CORNER_SHADOW_FULL,     /*Opacity rows of the corners of a full shadow*/
+    LV_DRAW_CORNER_SHADOW_BOTTOM,   /*Opacity filter of a bottom shadow*/
+    LV_DRAW_CORNER_COVER,           /*Coverage of the pixels of an anti-aliased corner*/
+}lv_draw_corner_type_t;
+
+/*The parameters which a mask depends on. The sizes are in the drawing's resolution (scaled with LV_AA)*/
+typedef struct
+{
+    uint8_t type;               /*From 'lv_draw_corner_type_t'*/
+    lv_opa_t opa;               /*Opacity of the body (shadows only)*/
+    lv_coord_t radius;          /*Corrected radius (see 'lv_draw_rect')*/
+    lv_coord_t bwidth;          /*Border width - 1 (LV_DRAW_CORNER_BORDER only)*/
+    lv_coord_t swidth;          /*Shadow width (shadows only)*/
+}lv_draw_corner_key_t;
+
+/*A horizontal span of the body's corners. It is 'dy' rows above the top origos or below the bottom origos
+ * and 'w' pixels wider than the origos on both sides*/
+typedef struct
+{
+    lv_coord_t dy;
+    lv_coord_t w;
+    uint8_t part;               /*LV_DRAW_CORNER_TOP and/or LV_DRAW_CORNER_BOTTOM*/
+}lv_draw_corner_span_t;
+
+/*A step on the outer circle of the border's corners*/
+typedef struct
+{
+    lv_point_t out;             /*Point of the outer circle (like 'lv_circ_next()' gives)*/
+    lv_coord_t w1;              /*Length of the border on this point*/
+    lv_coord_t w2;              /*Length of the border on the mirrored point*/
+}lv_draw_corner_step_t;
+
+/*A row of an anti-aliased corner. The corner is a 'radius' x 'radius' square
+ * whose left-top pixel is the left-top pixel of the rectangle*/
+typedef struct
+{
+    lv_coord_t first;           /*The pixels before it are not covered*/
+    lv_coord_t full;            /*The pixels from it are fully covered*/
+    uint16_t ofs;               /*Index of the coverage of the pixel 'first' in 'opa'*/
+}lv_draw_corner_row_t;
+
+typedef struct
+{
+    lv_draw_corner_key_t key;
+    uint16_t cnt;                           /*Number of 'spans' or 'steps' or the rows of the shadows*/
+    const lv_draw_corner_span_t * spans;    /*LV_DRAW_CORNER_BODY: spans in drawing order*/
+    const lv_draw_corner_step_t * steps;    /*LV_DRAW_CORNER_BORDER: steps in drawing order*/
+    const lv_draw_corner_row_t * rows;      /*LV_DRAW_CORNER_COVER: the rows from the top*/
+    const lv_coord_t * curve;               /*Shadows: 'x' of the quarter circle in every row*/
+    const uint16_t * opa_cnt;               /*LV_DRAW_CORNER_SHADOW_FULL: number of opacity values in every row*/
+    const lv_opa_t * opa;                   /*LV_DRAW_CORNER_SHADOW_FULL: the opacity rows after each other,
+                                              LV_DRAW_CORNER_SHADOW_BOTTOM: the filter (2 * swidth + 1 values)
+                                              LV_DRAW_CORNER_COVER: coverage of the partially covered pixels*/
+    /*Internal*/
+    uint8_t * buf;                          /*The arrays above are in this buffer*/
+    uint32_t buf_size;
+    uint32_t last_use;                      /*Value of the cache's tick when it was used last time (for LRU eviction)*/
+    uint16_t ref_cnt;                       /*Number of drawings using it. Can't be freed meanwhile*/
+    uint8_t cached :1;                      /*1: in the cache, 0: freed on release*/
+}lv_draw_corner_t;
+
+typedef struct
+{
+    uint32_t hit_cnt;           /*Number of masks found in the cache*/
+    uint32_t miss_cnt;          /*Number of masks computed*/
+    uint32_t evict_cnt;         /*Number of masks freed to keep the memory budget*/
+    uint32_t used_size;         /*Size of the cached masks in bytes*/
+    uint16_t mask_cnt;          /*Number of cached masks*/
+}lv_draw_corner_monitor_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the cache of the rectangle masks. Called by 'lv_init()'.
+ */
+void lv_draw_corner_init(void);
+
+/**
+ * Get a precomputed rectangle mask. It's computed if it's not in the cache.
+ * Release it with 'lv_draw_corner_release()' when the drawing is ready.
+ * @param key the type and the parameters of the mask
+ * @return pointer to the mask or NULL if out of memory
+ */
+const lv_draw_corner_t * lv_draw_corner_get(const lv_draw_corner_key_t * key);
+
+/**
+ * Release a mask got with 'lv_draw_corner_get()'
+ * @param corner pointer to the mask
+ */
+void lv_draw_corner_release(const lv_draw_corner_t * corner);
+
+/**
+ * Get the coverage of a pixel of an anti-aliased corner
+ * @param corner pointer to a LV_DRAW_CORNER_COVER mask
+ * @param x x coordinate of the pixel relative to the corner's left-top pixel
+ * @param y y coordinate of the pixel relative to the corner's left-top pixel
+ * @return coverage of the pixel (LV_OPA_TRANSP: not covered, LV_OPA_COVER: fully covered)
+ */
+lv_opa_t lv_draw_corner_get_cover(const lv_draw_corner_t * corner, lv_coord_t x, lv_coord_t y);
+
+/**
+ * Give information about the cache of the rectangle masks
+ * @param mon_p pointer to a lv_draw_corner_monitor_t variable,
+ *              the result of the analysis will be stored here
+ */
+void lv_draw_corner_monitor(lv_draw_corner_monitor_t * mon_p);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  /*LV_DRAW_CORNER_H*/
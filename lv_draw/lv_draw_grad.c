@@ -0,0 +1,223 @@
+/**
+ * @file lv_draw_grad.c
+ * Precomputed colors of the rows of the gradients with an LRU cache
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_grad.h"
+#include "../lv_misc/lv_mem.h"
+#include <stdbool.h>
+
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_CNT != 0
+#include <pthread.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Dithering is useful only if the mixed colors are rounded to a few bits*/
+#define LV_DRAW_GRAD_DITHER     (LV_GRAD_DITHER != 0 && LV_COLOR_DEPTH == 16)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool grad_build(lv_draw_grad_t * grad, lv_color_t main_color, lv_color_t grad_color, lv_coord_t height);
+#if LV_GRAD_CACHE_NUM != 0
+static lv_draw_grad_t * grad_find(lv_color_t main_color, lv_color_t grad_color, lv_coord_t height);
+static lv_draw_grad_t * grad_get_free_slot(void);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_GRAD_CACHE_NUM != 0
+static lv_draw_grad_t grad_cache[LV_GRAD_CACHE_NUM];   /*Unused if 'colors == NULL'*/
+static uint32_t grad_tick;                              /*Incremented on every use of a gradient*/
+#endif
+#if LV_DRAW_GRAD_DITHER
+/*Ordered dither thresholds of the rows (1D Bayer matrix, in 1/256 units of a color step)*/
+static const uint8_t grad_dither[4] = {32, 160, 96, 224};
+#endif
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_CNT != 0
+static pthread_mutex_t grad_mutex = PTHREAD_MUTEX_INITIALIZER;  /*The rendering workers draw rectangles in parallel*/
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_CNT != 0
+#define LV_DRAW_GRAD_LOCK()         pthread_mutex_lock(&grad_mutex)
+#define LV_DRAW_GRAD_UNLOCK()       pthread_mutex_unlock(&grad_mutex)
+#else
+#define LV_DRAW_GRAD_LOCK()
+#define LV_DRAW_GRAD_UNLOCK()
+#endif
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Get the colors of the rows of a gradient. They are computed if they are not in the cache.
+ * Release it with 'lv_draw_grad_release()' when the drawing is ready.
+ * @param main_color color of the top row
+ * @param grad_color color of the bottom row
+ * @param height number of rows
+ * @return pointer to the gradient or NULL if out of memory
+ */
+const lv_draw_grad_t * lv_draw_grad_get(lv_color_t main_color, lv_color_t grad_color, lv_coord_t height)
+{
+    lv_draw_grad_t * grad;
+
+    if(height <= 0) return NULL;
+
+    LV_DRAW_GRAD_LOCK();
+
+#if LV_GRAD_CACHE_NUM != 0
+    grad_tick++;
+    grad = grad_find(main_color, grad_color, height);
+    if(grad != NULL) {
+        grad->last_use = grad_tick;
+        grad->ref_cnt++;
+        LV_DRAW_GRAD_UNLOCK();
+        return grad;
+    }
+
+    grad = grad_get_free_slot();
+    if(grad != NULL) {
+        if(grad_build(grad, main_color, grad_color, height) == false) {
+            LV_DRAW_GRAD_UNLOCK();
+            return NULL;
+        }
+        grad->cached = 1;
+        grad->ref_cnt = 1;
+        grad->last_use = grad_tick;
+        LV_DRAW_GRAD_UNLOCK();
+        return grad;
+    }
+#endif
+
+    /*Not cached (every slot is used by a drawing): it's freed when released*/
+    grad = lv_mem_alloc(sizeof(lv_draw_grad_t));
+    if(grad == NULL) {
+        LV_DRAW_GRAD_UNLOCK();
+        return NULL;
+    }
+
+    if(grad_build(grad, main_color, grad_color, height) == false) {
+        lv_mem_free(grad);
+        LV_DRAW_GRAD_UNLOCK();
+        return NULL;
+    }
+    grad->cached = 0;
+    grad->ref_cnt = 1;
+    grad->last_use = 0;
+
+    LV_DRAW_GRAD_UNLOCK();
+    return grad;
+}
+
+/**
+ * Release a gradient got with 'lv_draw_grad_get()'
+ * @param grad pointer to the gradient
+ */
+void lv_draw_grad_release(const lv_draw_grad_t * grad)
+{
+    lv_draw_grad_t * g = (lv_draw_grad_t *) grad;
+
+    LV_DRAW_GRAD_LOCK();
+    if(g->ref_cnt != 0) g->ref_cnt--;
+    if(g->cached == 0 && g->ref_cnt == 0) {
+        lv_mem_free(g->colors);
+        lv_mem_free(g);
+    }
+    LV_DRAW_GRAD_UNLOCK();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Compute the colors of the rows of a gradient into a new buffer.
+ * The rows are mixed like 'lv_color_mix()' and dithered in the same pass if 'LV_GRAD_DITHER' is enabled.
+ * @param grad store the colors here
+ * @param main_color color of the top row
+ * @param grad_color color of the bottom row
+ * @param height number of rows
+ * @return false: out of memory
+ */
+static bool grad_build(lv_draw_grad_t * grad, lv_color_t main_color, lv_color_t grad_color, lv_coord_t height)
+{
+    grad->colors = lv_mem_alloc(height * sizeof(lv_color_t));
+    if(grad->colors == NULL) return false;
+
+    grad->main_color = main_color;
+    grad->grad_color = grad_color;
+    grad->height = height;
+
+    lv_coord_t i;
+    uint8_t mix;
+    for(i = 0; i < height; i++) {
+        mix = (uint32_t)((uint32_t)(height - 1 - i) * 255) / height;
+#if LV_DRAW_GRAD_DITHER
+        /*Round the mixed channels with a different threshold in the neighbor rows
+         * to spread the rounding error of the 5/6 bit channels (no visible bands)*/
+        uint16_t th = grad_dither[i & 0x3];
+        grad->colors[i].red =   (uint16_t)((uint16_t) main_color.red * mix + (grad_color.red * (255 - mix)) + th) >> 8;
+        grad->colors[i].green = (uint16_t)((uint16_t) main_color.green * mix + (grad_color.green * (255 - mix)) + th) >> 8;
+        grad->colors[i].blue =  (uint16_t)((uint16_t) main_color.blue * mix + (grad_color.blue * (255 - mix)) + th) >> 8;
+#else
+        grad->colors[i] = lv_color_mix(main_color, grad_color, mix);
+#endif
+    }
+
+    return true;
+}
+
+#if LV_GRAD_CACHE_NUM != 0
+static lv_draw_grad_t * grad_find(lv_color_t main_color, lv_color_t grad_color, lv_coord_t height)
+{
+    uint16_t i;
+    for(i = 0; i < LV_GRAD_CACHE_NUM; i++) {
+        lv_draw_grad_t * grad = &grad_cache[i];
+        if(grad->colors != NULL &&
+           grad->height == height &&
+           grad->main_color.full == main_color.full &&
+           grad->grad_color.full == grad_color.full) {
+            return grad;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Get an unused slot of the cache. The least recently used gradient is freed if there is no empty slot.
+ * @return pointer to an empty slot or NULL if every slot is used by a drawing
+ */
+static lv_draw_grad_t * grad_get_free_slot(void)
+{
+    lv_draw_grad_t * lru = NULL;
+    uint16_t i;
+    for(i = 0; i < LV_GRAD_CACHE_NUM; i++) {
+        lv_draw_grad_t * grad = &grad_cache[i];
+        if(grad->colors == NULL) return grad;
+        if(grad->ref_cnt != 0) continue;
+        if(lru == NULL || grad_tick - grad->last_use > grad_tick - lru->last_use) lru = grad;
+    }
+
+    if(lru == NULL) return NULL;
+
+    lv_mem_free(lru->colors);
+    lru->colors = NULL;
+
+    return lru;
+}
+#endif
@@ -0,0 +1,77 @@
+/**
+ * @file lv_draw_grad.h
+ *
+ */
+
+#ifndef LV_DRAW_GRAD_H
+#define LV_DRAW_GRAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf.h"
+#include <stdint.h>
+#include "../lv_misc/lv_area.h"
+#include "../lv_misc/lv_color.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef LV_GRAD_CACHE_NUM
+#define LV_GRAD_CACHE_NUM   0
+#endif
+
+#ifndef LV_GRAD_DITHER
+#define LV_GRAD_DITHER      0
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*The colors of the rows of a vertical gradient*/
+typedef struct
+{
+    lv_color_t main_color;      /*Color of the top row*/
+    lv_color_t grad_color;      /*Color of the bottom row*/
+    lv_coord_t height;          /*Number of rows (in the drawing's resolution)*/
+    lv_color_t * colors;        /*'height' colors from the top*/
+    /*Internal*/
+    uint32_t last_use;          /*Value of the cache's tick when it was used last time (for LRU eviction)*/
+    uint16_t ref_cnt;           /*Number of drawings using it. Can't be freed meanwhile*/
+    uint8_t cached :1;          /*1: in the cache, 0: freed on release*/
+}lv_draw_grad_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get the colors of the rows of a gradient. They are computed if they are not in the cache.
+ * Release it with 'lv_draw_grad_release()' when the drawing is ready.
+ * @param main_color color of the top row
+ * @param grad_color color of the bottom row
+ * @param height number of rows
+ * @return pointer to the gradient or NULL if out of memory
+ */
+const lv_draw_grad_t * lv_draw_grad_get(lv_color_t main_color, lv_color_t grad_color, lv_coord_t height);
+
+/**
+ * Release a gradient got with 'lv_draw_grad_get()'
+ * @param grad pointer to the gradient
+ */
+void lv_draw_grad_release(const lv_draw_grad_t * grad);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  /*LV_DRAW_GRAD_H*/
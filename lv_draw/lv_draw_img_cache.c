@@ -0,0 +1,511 @@
+/**
+ * @file lv_draw_img_cache.c
+ * The headers and the pixels of the image files in the memory with an LRU cache
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_img_cache.h"
+#if USE_LV_FILESYSTEM
+
+#include "lv_draw_img_dec.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_ll.h"
+#include <string.h>
+
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_CNT != 0
+#include <pthread.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_fs_res_t img_cache_read_header(lv_fs_file_t * file, const char * fn, lv_img_raw_header_t * header);
+#if LV_IMG_CACHE_SIZE != 0
+static uint32_t img_cache_hash(const char * fn);
+static lv_draw_img_cache_entry_t * img_cache_find(const char * fn, uint32_t hash);
+static lv_draw_img_cache_entry_t * img_cache_add(const char * fn, uint32_t hash, const lv_img_raw_header_t * header);
+static bool img_cache_is_direct(lv_fs_file_t * file, const lv_img_raw_header_t * header);
+static uint32_t img_cache_get_data_size(const lv_img_raw_header_t * header);
+static bool img_cache_load(lv_draw_img_cache_entry_t * entry, lv_fs_file_t * file);
+static bool img_cache_evict(void);
+static void img_cache_remove(lv_draw_img_cache_entry_t * entry);
+static void img_cache_free(lv_draw_img_cache_entry_t * entry);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_IMG_CACHE_SIZE != 0
+static lv_ll_t img_cache_ll;            /*Linked list of the cached 'lv_draw_img_cache_entry_t'*/
+static uint32_t img_cache_used;         /*Size of the cached images in bytes*/
+static uint32_t img_cache_tick;         /*Incremented on every use of an image*/
+static uint32_t img_cache_hit_cnt;
+static uint32_t img_cache_evict_cnt;
+#endif
+static uint32_t img_cache_miss_cnt;
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_CNT != 0
+static pthread_mutex_t img_cache_mutex = PTHREAD_MUTEX_INITIALIZER; /*The rendering workers draw images in parallel*/
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+#if LV_VDB_SIZE != 0 && LV_REFR_THREAD_CNT != 0
+#define LV_DRAW_IMG_CACHE_LOCK()    pthread_mutex_lock(&img_cache_mutex)
+#define LV_DRAW_IMG_CACHE_UNLOCK()  pthread_mutex_unlock(&img_cache_mutex)
+#else
+#define LV_DRAW_IMG_CACHE_LOCK()
+#define LV_DRAW_IMG_CACHE_UNLOCK()
+#endif
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the cache of the images. Called by 'lv_init()'.
+ */
+void lv_draw_img_cache_init(void)
+{
+#if LV_IMG_CACHE_SIZE != 0
+    lv_ll_init(&img_cache_ll, sizeof(lv_draw_img_cache_entry_t));
+#endif
+}
+
+/**
+ * Get the pixels of an image file from the cache. The file is read into the cache if it's not there.
+ * Release it with 'lv_draw_img_cache_close()' when the drawing is ready.
+ * @param fn path of the image file
+ * @return pointer to the image with not NULL 'data' or NULL if it's not cached
+ *         (the cache is disabled, the image is larger than the budget, it's raw and its driver gives a pointer to it
+ *         or read error)
+ */
+const lv_draw_img_cache_entry_t * lv_draw_img_cache_open(const char * fn)
+{
+#if LV_IMG_CACHE_SIZE == 0
+    (void) fn;      /*Unused*/
+    return NULL;
+#else
+    if(fn == NULL) return NULL;
+
+    LV_DRAW_IMG_CACHE_LOCK();
+
+    img_cache_tick++;
+    uint32_t hash = img_cache_hash(fn);
+    lv_draw_img_cache_entry_t * entry = img_cache_find(fn, hash);
+    if(entry != NULL) {
+        entry->last_use = img_cache_tick;
+
+        /*The image is drawn directly from the memory of the driver*/
+        if(entry->direct != 0) {
+            LV_DRAW_IMG_CACHE_UNLOCK();
+            return NULL;
+        }
+
+        if(entry->data != NULL) {
+            entry->ref_cnt++;
+            img_cache_hit_cnt++;
+            LV_DRAW_IMG_CACHE_UNLOCK();
+            return entry;
+        }
+
+        /*Don't touch the file if the pixels will never fit into the budget*/
+        uint32_t data_size = img_cache_get_data_size(&entry->header);
+        if(entry->size + data_size > LV_IMG_CACHE_SIZE) {
+            LV_DRAW_IMG_CACHE_UNLOCK();
+            return NULL;
+        }
+    }
+
+    img_cache_miss_cnt++;
+
+    lv_fs_file_t file;
+    lv_img_raw_header_t header;
+    if(img_cache_read_header(&file, fn, &header) != LV_FS_RES_OK) {
+        LV_DRAW_IMG_CACHE_UNLOCK();
+        return NULL;
+    }
+
+    if(entry == NULL) {
+        entry = img_cache_add(fn, hash, &header);
+        if(entry == NULL) {
+            lv_fs_close(&file);
+            LV_DRAW_IMG_CACHE_UNLOCK();
+            return NULL;
+        }
+    }
+
+    /*Don't copy the pixels if the driver gives a pointer to them (zero copy)*/
+    entry->direct = img_cache_is_direct(&file, &header);
+    if(entry->direct != 0) {
+        lv_fs_close(&file);
+        LV_DRAW_IMG_CACHE_UNLOCK();
+        return NULL;
+    }
+
+    bool load_ok = img_cache_load(entry, &file);
+    lv_fs_close(&file);
+
+    if(load_ok == false) {
+        LV_DRAW_IMG_CACHE_UNLOCK();
+        return NULL;
+    }
+
+    entry->ref_cnt++;
+    LV_DRAW_IMG_CACHE_UNLOCK();
+
+    return entry;
+#endif
+}
+
+/**
+ * Release an image got with 'lv_draw_img_cache_open()'
+ * @param entry pointer to the image
+ */
+void lv_draw_img_cache_close(const lv_draw_img_cache_entry_t * entry)
+{
+#if LV_IMG_CACHE_SIZE != 0
+    lv_draw_img_cache_entry_t * e = (lv_draw_img_cache_entry_t *) entry;
+
+    LV_DRAW_IMG_CACHE_LOCK();
+    if(e->ref_cnt != 0) e->ref_cnt--;
+    if(e->cached == 0 && e->ref_cnt == 0) img_cache_free(e);
+    LV_DRAW_IMG_CACHE_UNLOCK();
+#else
+    (void) entry;   /*Unused*/
+#endif
+}
+
+/**
+ * Get the header of an image file. It's read from the file only if it's not in the cache.
+ * @param fn path of the image file
+ * @param header store the header here
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t
+ */
+lv_fs_res_t lv_draw_img_cache_get_header(const char * fn, lv_img_raw_header_t * header)
+{
+    lv_fs_file_t file;
+    lv_fs_res_t res;
+
+    if(fn == NULL) return LV_FS_RES_INV_PARAM;
+
+    LV_DRAW_IMG_CACHE_LOCK();
+
+#if LV_IMG_CACHE_SIZE != 0
+    img_cache_tick++;
+    uint32_t hash = img_cache_hash(fn);
+    lv_draw_img_cache_entry_t * entry = img_cache_find(fn, hash);
+    if(entry != NULL) {
+        entry->last_use = img_cache_tick;
+        memcpy(header, &entry->header, sizeof(lv_img_raw_header_t));
+        img_cache_hit_cnt++;
+        LV_DRAW_IMG_CACHE_UNLOCK();
+        return LV_FS_RES_OK;
+    }
+#endif
+
+    img_cache_miss_cnt++;
+    res = img_cache_read_header(&file, fn, header);
+    if(res == LV_FS_RES_OK) {
+#if LV_IMG_CACHE_SIZE != 0
+        /*Keep only the header. The pixels are read when the image is drawn*/
+        entry = img_cache_add(fn, hash, header);
+        if(entry != NULL) entry->direct = img_cache_is_direct(&file, header);
+#endif
+        lv_fs_close(&file);
+    }
+
+    LV_DRAW_IMG_CACHE_UNLOCK();
+
+    return res;
+}
+
+/**
+ * Remove an image from the cache. Call it if the file of a cached image is changed.
+ * @param fn path of the image file or NULL to remove every image
+ */
+void lv_draw_img_cache_invalidate(const char * fn)
+{
+#if LV_IMG_CACHE_SIZE != 0
+    LV_DRAW_IMG_CACHE_LOCK();
+
+    uint32_t hash = fn != NULL ? img_cache_hash(fn) : 0;
+    lv_draw_img_cache_entry_t * entry = lv_ll_get_head(&img_cache_ll);
+    while(entry != NULL) {
+        lv_draw_img_cache_entry_t * next = lv_ll_get_next(&img_cache_ll, entry);
+        if(fn == NULL || (entry->hash == hash && strcmp(entry->fn, fn) == 0)) {
+            img_cache_remove(entry);
+        }
+        entry = next;
+    }
+
+    LV_DRAW_IMG_CACHE_UNLOCK();
+#else
+    (void) fn;      /*Unused*/
+#endif
+}
+
+/**
+ * Give information about the cache of the images
+ * @param mon_p pointer to a lv_draw_img_cache_monitor_t variable,
+ *              the result of the analysis will be stored here
+ */
+void lv_draw_img_cache_monitor(lv_draw_img_cache_monitor_t * mon_p)
+{
+    memset(mon_p, 0, sizeof(lv_draw_img_cache_monitor_t));
+
+    LV_DRAW_IMG_CACHE_LOCK();
+    mon_p->miss_cnt = img_cache_miss_cnt;
+#if LV_IMG_CACHE_SIZE != 0
+    mon_p->hit_cnt = img_cache_hit_cnt;
+    mon_p->evict_cnt = img_cache_evict_cnt;
+    mon_p->used_size = img_cache_used;
+
+    lv_draw_img_cache_entry_t * entry;
+    LL_READ(img_cache_ll, entry) {
+        mon_p->img_cnt++;
+    }
+#endif
+    LV_DRAW_IMG_CACHE_UNLOCK();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Open an image file and read its header
+ * @param file pointer to a file variable. It's opened and positioned to the pixels on success.
+ * @param fn path of the image file
+ * @param header store the header here
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t (the file is closed on error)
+ */
+static lv_fs_res_t img_cache_read_header(lv_fs_file_t * file, const char * fn, lv_img_raw_header_t * header)
+{
+    uint32_t br;
+    lv_fs_res_t res = lv_fs_open(file, fn, LV_FS_MODE_RD);
+    if(res != LV_FS_RES_OK) return res;
+
+    res = lv_fs_read(file, header, sizeof(lv_img_raw_header_t), &br);
+    if(res == LV_FS_RES_OK && br != sizeof(lv_img_raw_header_t)) res = LV_FS_RES_UNKNOWN;
+    if(res != LV_FS_RES_OK) lv_fs_close(file);
+
+    return res;
+}
+
+#if LV_IMG_CACHE_SIZE != 0
+/**
+ * Hash a path (FNV-1a) to compare the keys of the cache quickly
+ * @param fn path of an image file
+ * @return the hash of 'fn'
+ */
+static uint32_t img_cache_hash(const char * fn)
+{
+    uint32_t hash = 2166136261u;
+    while(*fn != '\0') {
+        hash ^= (uint8_t) *fn;
+        hash *= 16777619u;
+        fn++;
+    }
+
+    return hash;
+}
+
+static lv_draw_img_cache_entry_t * img_cache_find(const char * fn, uint32_t hash)
+{
+    lv_draw_img_cache_entry_t * entry;
+    LL_READ(img_cache_ll, entry) {
+        if(entry->hash == hash && strcmp(entry->fn, fn) == 0) return entry;
+    }
+
+    return NULL;
+}
+
+/**
+ * Add the header of an image to the cache
+ * @param fn path of the image file
+ * @param hash hash of 'fn'
+ * @param header the header of the image
+ * @return pointer to the new image or NULL if it doesn't fit into the budget or out of memory
+ */
+static lv_draw_img_cache_entry_t * img_cache_add(const char * fn, uint32_t hash, const lv_img_raw_header_t * header)
+{
+    uint32_t fn_size = strlen(fn) + 1;
+    uint32_t size = sizeof(lv_draw_img_cache_entry_t) + fn_size;
+
+    /*Free the least recently used images if the new one doesn't fit into the budget*/
+    if(size > LV_IMG_CACHE_SIZE) return NULL;
+    while(img_cache_used + size > LV_IMG_CACHE_SIZE) {
+        if(img_cache_evict() == false) return NULL;
+    }
+
+    char * fn_copy = lv_mem_alloc(fn_size);
+    if(fn_copy == NULL) return NULL;
+    memcpy(fn_copy, fn, fn_size);
+
+    lv_draw_img_cache_entry_t * entry = lv_ll_ins_head(&img_cache_ll);
+    if(entry == NULL) {
+        lv_mem_free(fn_copy);
+        return NULL;
+    }
+
+    entry->fn = fn_copy;
+    entry->hash = hash;
+    memcpy(&entry->header, header, sizeof(lv_img_raw_header_t));
+    entry->data = NULL;
+    entry->alpha = NULL;
+    entry->size = size;
+    entry->last_use = img_cache_tick;
+    entry->ref_cnt = 0;
+    entry->cached = 1;
+    entry->direct = 0;
+    img_cache_used += size;
+
+    return entry;
+}
+
+/**
+ * Check whether the pixels of an image can be drawn from the driver's pointer to the file's content
+ * @param file an opened file
+ * @param header the header of the image
+ * @return true: the file can be used without reading (raw or alpha image and the driver gives a pointer)
+ */
+static bool img_cache_is_direct(lv_fs_file_t * file, const lv_img_raw_header_t * header)
+{
+    const void * ptr;
+    if(header->format != LV_IMG_FORMAT_RAW &&
+       header->format != LV_IMG_FORMAT_ALPHA) return false;  /*Decoding on every drawing is slow*/
+
+    return lv_fs_get_ptr(file, &ptr) == LV_FS_RES_OK ? true : false;
+}
+
+/**
+ * Get the memory needed for the decoded pixels of an image
+ * @param header the header of the image
+ * @return size of the colors (and the alpha plane) in bytes
+ */
+static uint32_t img_cache_get_data_size(const lv_img_raw_header_t * header)
+{
+    uint32_t px_num = (uint32_t)header->w * header->h;
+    if(header->format == LV_IMG_FORMAT_ALPHA) return px_num * (sizeof(lv_color_t) + sizeof(lv_opa_t));
+    else return px_num * sizeof(lv_color_t);
+}
+
+/**
+ * Read the pixels of a cached image with one read (or decode them if the image is not raw or alpha)
+ * @param entry pointer to an image without pixels
+ * @param file the opened image file positioned to the pixels
+ * @return true: the pixels are in 'entry->data'; false: they don't fit into the budget, read or decode error
+ */
+static bool img_cache_load(lv_draw_img_cache_entry_t * entry, lv_fs_file_t * file)
+{
+    uint32_t data_size = img_cache_get_data_size(&entry->header);
+    if(entry->size + data_size > LV_IMG_CACHE_SIZE) return false;
+
+    /*Free the least recently used images (but not this one) to make room for the pixels*/
+    entry->ref_cnt++;
+    while(img_cache_used + data_size > LV_IMG_CACHE_SIZE) {
+        if(img_cache_evict() == false) break;
+    }
+    entry->ref_cnt--;
+
+    if(img_cache_used + data_size > LV_IMG_CACHE_SIZE) return false;
+
+    lv_color_t * data = lv_mem_alloc(data_size);
+    if(data == NULL) return false;
+
+    lv_fs_res_t res;
+    if(entry->header.format == LV_IMG_FORMAT_RAW || entry->header.format == LV_IMG_FORMAT_ALPHA) {
+        /*The alpha plane is stored after the colors as in the file*/
+        uint32_t br;
+        res = lv_fs_read(file, data, data_size, &br);
+        if(res == LV_FS_RES_OK && br != data_size) res = LV_FS_RES_UNKNOWN;
+    } else {
+        /*Decode the whole image once and keep it as a raw map*/
+        const void * src;
+        uint32_t src_size;
+        if(lv_fs_get_ptr(file, &src) != LV_FS_RES_OK || lv_fs_size(file, &src_size) != LV_FS_RES_OK) {
+            src = NULL;
+            src_size = 0;
+        }
+
+        lv_draw_img_dec_t dec;
+        res = lv_draw_img_dec_open(&dec, &entry->header, file, src, src_size);
+        lv_coord_t y;
+        for(y = 0; res == LV_FS_RES_OK && y < entry->header.h; y++) {
+            res = lv_draw_img_dec_read_row(&dec, y, 0, entry->header.w, &data[(uint32_t)y * entry->header.w], NULL);
+        }
+        lv_draw_img_dec_close(&dec);
+    }
+
+    if(res != LV_FS_RES_OK) {
+        lv_mem_free(data);
+        return false;
+    }
+
+    entry->data = data;
+    if(entry->header.format == LV_IMG_FORMAT_ALPHA) {
+        entry->alpha = (const lv_opa_t *) &data[(uint32_t)entry->header.w * entry->header.h];
+    }
+    entry->size += data_size;
+    img_cache_used += data_size;
+
+    return true;
+}
+
+/**
+ * Free the least recently used image which is not used by a drawing
+ * @return true: an image is freed, false: there is no image to free
+ */
+static bool img_cache_evict(void)
+{
+    lv_draw_img_cache_entry_t * entry;
+    lv_draw_img_cache_entry_t * lru = NULL;
+    LL_READ(img_cache_ll, entry) {
+        if(entry->ref_cnt != 0) continue;
+        if(lru == NULL || img_cache_tick - entry->last_use > img_cache_tick - lru->last_use) lru = entry;
+    }
+
+    if(lru == NULL) return false;
+
+    img_cache_remove(lru);
+    img_cache_evict_cnt++;
+
+    return true;
+}
+
+/**
+ * Remove an image from the cache. It's freed when the last drawing releases it.
+ * @param entry pointer to a cached image
+ */
+static void img_cache_remove(lv_draw_img_cache_entry_t * entry)
+{
+    img_cache_used -= entry->size;
+    lv_ll_rem(&img_cache_ll, entry);
+    entry->cached = 0;
+    if(entry->ref_cnt == 0) img_cache_free(entry);
+}
+
+/**
+ * Free an image removed from the cache
+ * @param entry pointer to an image
+ */
+static void img_cache_free(lv_draw_img_cache_entry_t * entry)
+{
+    lv_mem_free(entry->data);
+    lv_mem_free(entry->fn);
+    lv_mem_free(entry);
+}
+#endif
+
+#endif /*USE_LV_FILESYSTEM*/
@@ -0,0 +1,115 @@
+/**
+ * @file lv_draw_img_cache.h
+ *
+ */
+
+#ifndef LV_DRAW_IMG_CACHE_H
+#define LV_DRAW_IMG_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf.h"
+#include <stdint.h>
+#include "../lv_misc/lv_fs.h"
+#include "lv_draw.h"
+
+#if USE_LV_FILESYSTEM
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef LV_IMG_CACHE_SIZE
+#define LV_IMG_CACHE_SIZE   0
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*An image in the cache*/
+typedef struct
+{
+    char * fn;                      /*Path of the image file (the key)*/
+    uint32_t hash;                  /*Hash of 'fn' to compare the keys quickly*/
+    lv_img_raw_header_t header;
+    const lv_color_t * data;        /*The pixels of the image row by row or NULL if only the header is cached*/
+    const lv_opa_t * alpha;         /*The opacity of the pixels (LV_IMG_FORMAT_ALPHA) or NULL*/
+    /*Internal*/
+    uint32_t size;                  /*Memory used by the image in bytes (counted in the budget)*/
+    uint32_t last_use;              /*Value of the cache's tick when it was used last time (for LRU eviction)*/
+    uint16_t ref_cnt;               /*Number of drawings using it. Can't be freed meanwhile*/
+    uint8_t cached :1;              /*1: in the cache, 0: freed on release (invalidated while it was used)*/
+    uint8_t direct :1;              /*1: the driver gives a pointer to the file, the pixels are not copied*/
+}lv_draw_img_cache_entry_t;
+
+typedef struct
+{
+    uint32_t hit_cnt;           /*Number of headers and pixels found in the cache*/
+    uint32_t miss_cnt;          /*Number of headers and pixels read from the files*/
+    uint32_t evict_cnt;         /*Number of images freed to keep the memory budget*/
+    uint32_t used_size;         /*Size of the cached images in bytes*/
+    uint16_t img_cnt;           /*Number of cached images*/
+}lv_draw_img_cache_monitor_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the cache of the images. Called by 'lv_init()'.
+ */
+void lv_draw_img_cache_init(void);
+
+/**
+ * Get the pixels of an image file from the cache. The file is read into the cache if it's not there.
+ * Release it with 'lv_draw_img_cache_close()' when the drawing is ready.
+ * @param fn path of the image file
+ * @return pointer to the image with not NULL 'data' or NULL if it's not cached
+ *         (the cache is disabled, the image is larger than the budget, it's raw or alpha and its driver gives a pointer to it
+ *         or read error)
+ */
+const lv_draw_img_cache_entry_t * lv_draw_img_cache_open(const char * fn);
+
+/**
+ * Release an image got with 'lv_draw_img_cache_open()'
+ * @param entry pointer to the image
+ */
+void lv_draw_img_cache_close(const lv_draw_img_cache_entry_t * entry);
+
+/**
+ * Get the header of an image file. It's read from the file only if it's not in the cache.
+ * @param fn path of the image file
+ * @param header store the header here
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t
+ */
+lv_fs_res_t lv_draw_img_cache_get_header(const char * fn, lv_img_raw_header_t * header);
+
+/**
+ * Remove an image from the cache. Call it if the file of a cached image is changed.
+ * @param fn path of the image file or NULL to remove every image
+ */
+void lv_draw_img_cache_invalidate(const char * fn);
+
+/**
+ * Give information about the cache of the images
+ * @param mon_p pointer to a lv_draw_img_cache_monitor_t variable,
+ *              the result of the analysis will be stored here
+ */
+void lv_draw_img_cache_monitor(lv_draw_img_cache_monitor_t * mon_p);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*USE_LV_FILESYSTEM*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  /*LV_DRAW_IMG_CACHE_H*/
@@ -0,0 +1,514 @@
+/**
+ * @file lv_draw_img_dec.c
+ * Decode the rows of the indexed and compressed images (see 'lv_img_format_t')
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_img_dec.h"
+#if USE_LV_FILESYSTEM
+
+#include "../lv_misc/lv_mem.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LZ_MIN_MATCH        4       /*The match lengths are stored minus this value*/
+#define LZ_LEN_EXT          15      /*A length of 15 in the token continues in the next bytes*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_fs_res_t img_dec_get(lv_draw_img_dec_t * dec, uint32_t ofs, uint32_t size, uint8_t * buf, const uint8_t ** data_p);
+static lv_fs_res_t img_dec_read_indexed(lv_draw_img_dec_t * dec, lv_coord_t y, lv_coord_t x, lv_coord_t len, lv_color_t * buf);
+static lv_fs_res_t img_dec_load_block(lv_draw_img_dec_t * dec, uint32_t block_id);
+static bool img_dec_rle(const uint8_t * in, uint32_t in_size, lv_color_t * out, uint32_t px_num);
+static bool img_dec_lz(const uint8_t * in, uint32_t in_size, uint8_t * out, uint32_t out_size);
+static uint8_t img_dec_get_bpp(const lv_img_raw_header_t * header);
+static uint32_t img_dec_get_block_cnt(const lv_img_raw_header_t * header, uint32_t block_h);
+static uint32_t img_dec_u32(const uint8_t * p);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Prepare the decoding of an image
+ * @param dec pointer to a decoder state to initialize
+ * @param header the header of the image
+ * @param file the opened image file (used if 'src' is NULL)
+ * @param src pointer to the whole image (with the header) if it's in the memory, else NULL
+ * @param src_size size of 'src' in bytes
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t (LV_FS_RES_NOT_IMP: unknown format)
+ */
+lv_fs_res_t lv_draw_img_dec_open(lv_draw_img_dec_t * dec, const lv_img_raw_header_t * header,
+                                 lv_fs_file_t * file, const void * src, uint32_t src_size)
+{
+    memset(dec, 0, sizeof(lv_draw_img_dec_t));
+    memcpy(&dec->header, header, sizeof(lv_img_raw_header_t));
+    dec->file = file;
+    dec->src = src;
+    dec->src_size = src_size;
+    dec->block_id = -1;
+
+    lv_fs_res_t res;
+    const uint8_t * data;
+
+    switch(header->format) {
+        case LV_IMG_FORMAT_RAW:
+        case LV_IMG_FORMAT_ALPHA:
+            return LV_FS_RES_OK;
+
+        case LV_IMG_FORMAT_INDEXED_1:
+        case LV_IMG_FORMAT_INDEXED_2:
+        case LV_IMG_FORMAT_INDEXED_4:
+        case LV_IMG_FORMAT_INDEXED_8: {
+            uint32_t palette_size = (1 << img_dec_get_bpp(header)) * sizeof(lv_color_t);
+
+            /*Read the palette and a row of indices into one buffer*/
+            if(src == NULL) {
+                dec->buf_size = palette_size + ((header->w * img_dec_get_bpp(header) + 7) >> 3);
+                dec->buf = lv_mem_alloc(dec->buf_size);
+                if(dec->buf == NULL) return LV_FS_RES_OUT_OF_MEM;
+            }
+
+            res = img_dec_get(dec, sizeof(lv_img_raw_header_t), palette_size, dec->buf, &data);
+            if(res != LV_FS_RES_OK) {
+                lv_draw_img_dec_close(dec);
+                return res;
+            }
+            dec->palette = (const lv_color_t *) data;
+            return LV_FS_RES_OK;
+        }
+
+        case LV_IMG_FORMAT_RLE:
+        case LV_IMG_FORMAT_LZ: {
+            uint8_t block_h_buf[LV_IMG_BLOCK_HEADER_SIZE];
+            res = img_dec_get(dec, sizeof(lv_img_raw_header_t), LV_IMG_BLOCK_HEADER_SIZE, block_h_buf, &data);
+            if(res != LV_FS_RES_OK) return res;
+
+            dec->block_h = img_dec_u32(data);
+            if(dec->block_h == 0) return LV_FS_RES_FS_ERR;
+            if(dec->block_h > header->h && header->h != 0) dec->block_h = header->h;
+
+            dec->block_buf = lv_mem_alloc(dec->block_h * header->w * sizeof(lv_color_t));
+            if(dec->block_buf == NULL) return LV_FS_RES_OUT_OF_MEM;
+            return LV_FS_RES_OK;
+        }
+
+        default:
+            return LV_FS_RES_NOT_IMP;
+    }
+}
+
+/**
+ * Decode a part of a row of an image.
+ * The compressed formats decode a whole block so the next rows of the block are ready too.
+ * @param dec pointer to an opened decoder
+ * @param y the row
+ * @param x the first column
+ * @param len number of pixels to decode
+ * @param buf store the pixels here
+ * @param alpha store the opacity of the pixels here (only LV_IMG_FORMAT_ALPHA, can be NULL)
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t (LV_FS_RES_FS_ERR: corrupt image)
+ */
+lv_fs_res_t lv_draw_img_dec_read_row(lv_draw_img_dec_t * dec, lv_coord_t y, lv_coord_t x, lv_coord_t len,
+                                     lv_color_t * buf, lv_opa_t * alpha)
+{
+    if(y < 0 || y >= dec->header.h || x < 0 || len < 0 || x + len > dec->header.w) return LV_FS_RES_INV_PARAM;
+    if(len == 0) return LV_FS_RES_OK;
+
+    lv_fs_res_t res;
+    const uint8_t * data;
+
+    switch(dec->header.format) {
+        case LV_IMG_FORMAT_RAW: {
+            uint32_t ofs = sizeof(lv_img_raw_header_t) + ((uint32_t)y * dec->header.w + x) * sizeof(lv_color_t);
+            res = img_dec_get(dec, ofs, len * sizeof(lv_color_t), (uint8_t *) buf, &data);
+            if(res == LV_FS_RES_OK && data != (const uint8_t *) buf) memcpy(buf, data, len * sizeof(lv_color_t));
+            return res;
+        }
+
+        case LV_IMG_FORMAT_ALPHA: {
+            uint32_t px_num = (uint32_t)dec->header.w * dec->header.h;
+            uint32_t px_ofs = (uint32_t)y * dec->header.w + x;
+            uint32_t ofs = sizeof(lv_img_raw_header_t) + px_ofs * sizeof(lv_color_t);
+            res = img_dec_get(dec, ofs, len * sizeof(lv_color_t), (uint8_t *) buf, &data);
+            if(res != LV_FS_RES_OK) return res;
+            if(data != (const uint8_t *) buf) memcpy(buf, data, len * sizeof(lv_color_t));
+            if(alpha == NULL) return LV_FS_RES_OK;
+
+            /*The alpha plane is after the colors*/
+            ofs = sizeof(lv_img_raw_header_t) + px_num * sizeof(lv_color_t) + px_ofs;
+            res = img_dec_get(dec, ofs, len, alpha, &data);
+            if(res == LV_FS_RES_OK && data != alpha) memcpy(alpha, data, len);
+            return res;
+        }
+
+        case LV_IMG_FORMAT_INDEXED_1:
+        case LV_IMG_FORMAT_INDEXED_2:
+        case LV_IMG_FORMAT_INDEXED_4:
+        case LV_IMG_FORMAT_INDEXED_8:
+            return img_dec_read_indexed(dec, y, x, len, buf);
+
+        case LV_IMG_FORMAT_RLE:
+        case LV_IMG_FORMAT_LZ: {
+            uint32_t block_id = y / dec->block_h;
+            if((int32_t)block_id != dec->block_id) {
+                res = img_dec_load_block(dec, block_id);
+                if(res != LV_FS_RES_OK) return res;
+            }
+
+            uint32_t block_y = y - block_id * dec->block_h;
+            memcpy(buf, &dec->block_buf[block_y * dec->header.w + x], len * sizeof(lv_color_t));
+            return LV_FS_RES_OK;
+        }
+
+        default:
+            return LV_FS_RES_NOT_IMP;
+    }
+}
+
+/**
+ * Free the buffers of a decoder
+ * @param dec pointer to an opened decoder
+ */
+void lv_draw_img_dec_close(lv_draw_img_dec_t * dec)
+{
+    if(dec->buf != NULL) lv_mem_free(dec->buf);
+    if(dec->block_buf != NULL) lv_mem_free(dec->block_buf);
+
+    dec->buf = NULL;
+    dec->buf_size = 0;
+    dec->block_buf = NULL;
+    dec->block_id = -1;
+    dec->palette = NULL;
+}
+
+/**
+ * Get the size of an image in the memory (e.g. to create a file from it)
+ * @param img pointer to an image starting with 'lv_img_raw_header_t'
+ * @return size of the image in bytes (0: unknown format)
+ */
+uint32_t lv_draw_img_dec_get_size(const void * img)
+{
+    const lv_img_raw_header_t * header = img;
+    const uint8_t * data = img;
+    data += sizeof(lv_img_raw_header_t);
+
+    switch(header->format) {
+        case LV_IMG_FORMAT_RAW:
+            return sizeof(lv_img_raw_header_t) + (uint32_t)header->w * header->h * sizeof(lv_color_t);
+
+        case LV_IMG_FORMAT_ALPHA:
+            return sizeof(lv_img_raw_header_t) + (uint32_t)header->w * header->h * (sizeof(lv_color_t) + sizeof(lv_opa_t));
+
+        case LV_IMG_FORMAT_INDEXED_1:
+        case LV_IMG_FORMAT_INDEXED_2:
+        case LV_IMG_FORMAT_INDEXED_4:
+        case LV_IMG_FORMAT_INDEXED_8: {
+            uint8_t bpp = img_dec_get_bpp(header);
+            return sizeof(lv_img_raw_header_t) + (1 << bpp) * sizeof(lv_color_t) +
+                   ((header->w * bpp + 7) >> 3) * header->h;
+        }
+
+        case LV_IMG_FORMAT_RLE:
+        case LV_IMG_FORMAT_LZ: {
+            uint32_t block_h = img_dec_u32(data);
+            if(block_h == 0) return 0;
+
+            /*The last offset of the table is the end of the last block*/
+            uint32_t block_cnt = img_dec_get_block_cnt(header, block_h);
+            const uint8_t * table = data + LV_IMG_BLOCK_HEADER_SIZE;
+            return sizeof(lv_img_raw_header_t) + LV_IMG_BLOCK_HEADER_SIZE + (block_cnt + 1) * sizeof(uint32_t) +
+                   img_dec_u32(&table[block_cnt * sizeof(uint32_t)]);
+        }
+
+        default:
+            return 0;
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get bytes of the image from the memory or from the file
+ * @param dec pointer to an opened decoder
+ * @param ofs offset of the bytes from the beginning of the image
+ * @param size number of bytes
+ * @param buf read the bytes here if the image is not in the memory (at least 'size' bytes)
+ * @param data_p store a pointer to the bytes here ('buf' or into the image)
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t (LV_FS_RES_FS_ERR: the image is too short)
+ */
+static lv_fs_res_t img_dec_get(lv_draw_img_dec_t * dec, uint32_t ofs, uint32_t size, uint8_t * buf, const uint8_t ** data_p)
+{
+    if(dec->src != NULL) {
+        if(ofs > dec->src_size || size > dec->src_size - ofs) return LV_FS_RES_FS_ERR;
+        *data_p = &dec->src[ofs];
+        return LV_FS_RES_OK;
+    }
+
+    uint32_t br;
+    lv_fs_res_t res = lv_fs_seek(dec->file, ofs);
+    if(res == LV_FS_RES_OK) res = lv_fs_read(dec->file, buf, size, &br);
+    if(res == LV_FS_RES_OK && br != size) res = LV_FS_RES_FS_ERR;
+    if(res == LV_FS_RES_OK) *data_p = buf;
+
+    return res;
+}
+
+/**
+ * Look up the colors of a part of a row of an indexed image
+ * @param dec pointer to an opened decoder with indexed format
+ * @param y the row
+ * @param x the first column
+ * @param len number of pixels
+ * @param buf store the pixels here
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t
+ */
+static lv_fs_res_t img_dec_read_indexed(lv_draw_img_dec_t * dec, lv_coord_t y, lv_coord_t x, lv_coord_t len, lv_color_t * buf)
+{
+    uint8_t bpp = img_dec_get_bpp(&dec->header);
+    uint8_t mask = (1 << bpp) - 1;
+    uint32_t stride = (dec->header.w * bpp + 7) >> 3;
+    uint32_t palette_size = (1 << bpp) * sizeof(lv_color_t);
+
+    /*Only the bytes of the needed indices*/
+    uint32_t bit = (uint32_t)x * bpp;
+    uint32_t byte_first = bit >> 3;
+    uint32_t byte_last = ((uint32_t)(x + len) * bpp - 1) >> 3;
+    uint32_t ofs = sizeof(lv_img_raw_header_t) + palette_size + (uint32_t)y * stride + byte_first;
+
+    const uint8_t * row;
+    uint8_t * row_buf = dec->buf != NULL ? dec->buf + palette_size : NULL;     /*Only if the image is read from the file*/
+    lv_fs_res_t res = img_dec_get(dec, ofs, byte_last - byte_first + 1, row_buf, &row);
+    if(res != LV_FS_RES_OK) return res;
+
+    /*The first pixel is in the most significant bits*/
+    bit &= 0x7;
+    lv_coord_t i;
+    for(i = 0; i < len; i++) {
+        uint8_t idx = (row[bit >> 3] >> (8 - bpp - (bit & 0x7))) & mask;
+        buf[i] = dec->palette[idx];
+        bit += bpp;
+    }
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Decode a block of a compressed image into 'dec->block_buf'
+ * @param dec pointer to an opened decoder with compressed format
+ * @param block_id index of the block
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t (LV_FS_RES_FS_ERR: corrupt block)
+ */
+static lv_fs_res_t img_dec_load_block(lv_draw_img_dec_t * dec, uint32_t block_id)
+{
+    uint32_t block_cnt = img_dec_get_block_cnt(&dec->header, dec->block_h);
+    uint32_t table_ofs = sizeof(lv_img_raw_header_t) + LV_IMG_BLOCK_HEADER_SIZE;
+    uint32_t data_ofs = table_ofs + (block_cnt + 1) * sizeof(uint32_t);
+
+    /*The start of this block and the next one*/
+    uint8_t ofs_buf[2 * sizeof(uint32_t)];
+    const uint8_t * ofs_p;
+    lv_fs_res_t res = img_dec_get(dec, table_ofs + block_id * sizeof(uint32_t), sizeof(ofs_buf), ofs_buf, &ofs_p);
+    if(res != LV_FS_RES_OK) return res;
+
+    uint32_t block_start = img_dec_u32(&ofs_p[0]);
+    uint32_t block_end = img_dec_u32(&ofs_p[sizeof(uint32_t)]);
+    if(block_end < block_start || block_end > UINT32_MAX - data_ofs) return LV_FS_RES_FS_ERR;
+
+    uint32_t in_size = block_end - block_start;
+    if(dec->src == NULL && in_size > dec->buf_size) {
+        uint8_t * new_buf = lv_mem_realloc(dec->buf, in_size);
+        if(new_buf == NULL) return LV_FS_RES_OUT_OF_MEM;
+        dec->buf = new_buf;
+        dec->buf_size = in_size;
+    }
+
+    const uint8_t * in;
+    res = img_dec_get(dec, data_ofs + block_start, in_size, dec->buf, &in);
+    if(res != LV_FS_RES_OK) return res;
+
+    /*The last block can be shorter*/
+    uint32_t row_cnt = dec->header.h - block_id * dec->block_h;
+    if(row_cnt > dec->block_h) row_cnt = dec->block_h;
+    uint32_t px_num = row_cnt * dec->header.w;
+
+    bool dec_ok;
+    if(dec->header.format == LV_IMG_FORMAT_RLE) dec_ok = img_dec_rle(in, in_size, dec->block_buf, px_num);
+    else dec_ok = img_dec_lz(in, in_size, (uint8_t *) dec->block_buf, px_num * sizeof(lv_color_t));
+
+    if(dec_ok == false) {
+        dec->block_id = -1;
+        return LV_FS_RES_FS_ERR;
+    }
+
+    dec->block_id = block_id;
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Decode run length encoded pixels
+ * @param in the encoded bytes
+ * @param in_size number of encoded bytes
+ * @param out store the pixels here
+ * @param px_num number of pixels to decode
+ * @return true: decoded; false: corrupt data
+ */
+static bool img_dec_rle(const uint8_t * in, uint32_t in_size, lv_color_t * out, uint32_t px_num)
+{
+    const uint8_t * in_end = in + in_size;
+
+    while(px_num != 0) {
+        if(in >= in_end) return false;
+        uint8_t ctrl = *in;
+        in++;
+
+        uint32_t n = (ctrl & 0x7F) + 1;
+        if(n > px_num) return false;
+
+        if(ctrl & 0x80) {
+            /*Repeated pixel*/
+            if((uint32_t)(in_end - in) < sizeof(lv_color_t)) return false;
+            lv_color_t px;
+            memcpy(&px, in, sizeof(lv_color_t));
+            in += sizeof(lv_color_t);
+
+            uint32_t i;
+            for(i = 0; i < n; i++) out[i] = px;
+        } else {
+            /*Literal pixels*/
+            if((uint32_t)(in_end - in) < n * sizeof(lv_color_t)) return false;
+            memcpy(out, in, n * sizeof(lv_color_t));
+            in += n * sizeof(lv_color_t);
+        }
+
+        out += n;
+        px_num -= n;
+    }
+
+    return true;
+}
+
+/**
+ * Decode LZ compressed bytes (LZ4 block format)
+ * @param in the compressed bytes
+ * @param in_size number of compressed bytes
+ * @param out store the decompressed bytes here
+ * @param out_size number of bytes to decompress (the data has to give exactly this much)
+ * @return true: decoded; false: corrupt data
+ */
+static bool img_dec_lz(const uint8_t * in, uint32_t in_size, uint8_t * out, uint32_t out_size)
+{
+    const uint8_t * in_end = in + in_size;
+    uint8_t * out_start = out;
+    uint8_t * out_end = out + out_size;
+
+    while(1) {
+        if(in >= in_end) return false;
+        uint8_t token = *in;
+        in++;
+
+        /*Literals*/
+        uint32_t lit_len = token >> 4;
+        if(lit_len == LZ_LEN_EXT) {
+            uint8_t b;
+            do {
+                if(in >= in_end) return false;
+                b = *in;
+                in++;
+                lit_len += b;
+            } while(b == 255 && lit_len < in_size);
+        }
+
+        if(lit_len > (uint32_t)(in_end - in) || lit_len > (uint32_t)(out_end - out)) return false;
+        memcpy(out, in, lit_len);
+        in += lit_len;
+        out += lit_len;
+
+        /*The last sequence has only literals*/
+        if(in == in_end) break;
+
+        /*Match*/
+        if(in_end - in < 2) return false;
+        uint32_t match_ofs = in[0] | (in[1] << 8);
+        in += 2;
+        if(match_ofs == 0 || match_ofs > (uint32_t)(out - out_start)) return false;
+
+        uint32_t match_len = token & 0xF;
+        if(match_len == LZ_LEN_EXT) {
+            uint8_t b;
+            do {
+                if(in >= in_end) return false;
+                b = *in;
+                in++;
+                match_len += b;
+            } while(b == 255 && match_len < out_size);
+        }
+        match_len += LZ_MIN_MATCH;
+        if(match_len > (uint32_t)(out_end - out)) return false;
+
+        /*If the match overlaps with the output (repeated pattern) then copy byte by byte*/
+        const uint8_t * match = out - match_ofs;
+        if(match_ofs >= match_len) {
+            memcpy(out, match, match_len);
+        } else {
+            uint32_t i;
+            for(i = 0; i < match_len; i++) out[i] = match[i];
+        }
+        out += match_len;
+    }
+
+    return out == out_end ? true : false;
+}
+
+/**
+ * Get the number of bits of an index in an indexed image
+ * @param header the header of an indexed image
+ * @return 1, 2, 4 or 8
+ */
+static uint8_t img_dec_get_bpp(const lv_img_raw_header_t * header)
+{
+    return 1 << (header->format - LV_IMG_FORMAT_INDEXED_1);
+}
+
+/**
+ * Get the number of blocks of a compressed image
+ * @param header the header of a compressed image
+ * @param block_h number of rows in a block (not 0)
+ * @return number of blocks
+ */
+static uint32_t img_dec_get_block_cnt(const lv_img_raw_header_t * header, uint32_t block_h)
+{
+    return (header->h + block_h - 1) / block_h;
+}
+
+/**
+ * Read a little endian 32 bit value from a not aligned address
+ * @param p pointer to the bytes
+ * @return the value
+ */
+static uint32_t img_dec_u32(const uint8_t * p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+#endif /*USE_LV_FILESYSTEM*/
@@ -0,0 +1,127 @@
+/**
+ * @file lv_draw_img_dec.h
+ *
+ */
+
+#ifndef LV_DRAW_IMG_DEC_H
+#define LV_DRAW_IMG_DEC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf.h"
+#include <stdint.h>
+#include "../lv_misc/lv_fs.h"
+#include "lv_draw.h"
+
+#if USE_LV_FILESYSTEM
+
+/*********************
+ *      DEFINES
+ *********************/
+/* Layouts of the images after 'lv_img_raw_header_t'. The multi-byte fields are little endian.
+ *
+ * LV_IMG_FORMAT_RAW:       'w * h' 'lv_color_t' row by row
+ *
+ * LV_IMG_FORMAT_ALPHA:     'w * h' 'lv_color_t' row by row then 'w * h' 'lv_opa_t' row by row
+ *                          (the alpha plane is separate so the colors are the same as a raw image's)
+ *
+ * LV_IMG_FORMAT_INDEXED_x: palette: '1 << x' 'lv_color_t'
+ *                          'h' rows of 'x' bit indices. The first pixel is in the most significant bits.
+ *                          The rows start on byte boundary.
+ *
+ * LV_IMG_FORMAT_RLE/LZ:    uint32_t block_h: number of rows in a block (the last block can be shorter)
+ *                          uint32_t block_ofs[block_cnt + 1]: start of the blocks relative to the end of this table
+ *                                                             (the last one is the end of the last block)
+ *                          the blocks: the 'lv_color_t' rows of each block are compressed independently
+ *                          so only the blocks of the drawn rows have to be decoded.
+ *
+ * LV_IMG_FORMAT_RLE block: a control byte 'c' then
+ *                          c >= 0x80: one 'lv_color_t' repeated '(c & 0x7F) + 1' times
+ *                          c < 0x80: 'c + 1' 'lv_color_t' literally
+ *
+ * LV_IMG_FORMAT_LZ block:  the bytes of the rows as sequences (LZ4 block format):
+ *                          token: literal length << 4 | (match length - 4),
+ *                          [more literal length bytes], literals, 2 byte offset of the match, [more match length bytes]
+ *                          (a length of 15 in the token continues in the next bytes until a byte < 255).
+ *                          The last sequence has only literals.
+ */
+#define LV_IMG_BLOCK_HEADER_SIZE    4       /*Size of 'block_h'*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*State of the decoding of an image*/
+typedef struct
+{
+    lv_img_raw_header_t header;
+    lv_fs_file_t * file;            /*Read the image from this file if 'src' is NULL*/
+    const uint8_t * src;            /*The whole image (with the header) if it's in the memory*/
+    uint32_t src_size;              /*Size of 'src' in bytes*/
+    const lv_color_t * palette;     /*Indexed formats: the colors*/
+    uint32_t block_h;               /*Compressed formats: number of rows in a block*/
+    int32_t block_id;               /*Compressed formats: index of the block in 'block_buf' (-1: none)*/
+    lv_color_t * block_buf;         /*Compressed formats: the decoded pixels of a block*/
+    uint8_t * buf;                  /*Palette or compressed block read from the file*/
+    uint32_t buf_size;
+}lv_draw_img_dec_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Prepare the decoding of an image
+ * @param dec pointer to a decoder state to initialize
+ * @param header the header of the image
+ * @param file the opened image file (used if 'src' is NULL)
+ * @param src pointer to the whole image (with the header) if it's in the memory, else NULL
+ * @param src_size size of 'src' in bytes
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t (LV_FS_RES_NOT_IMP: unknown format)
+ */
+lv_fs_res_t lv_draw_img_dec_open(lv_draw_img_dec_t * dec, const lv_img_raw_header_t * header,
+                                 lv_fs_file_t * file, const void * src, uint32_t src_size);
+
+/**
+ * Decode a part of a row of an image.
+ * The compressed formats decode a whole block so the next rows of the block are ready too.
+ * @param dec pointer to an opened decoder
+ * @param y the row
+ * @param x the first column
+ * @param len number of pixels to decode
+ * @param buf store the pixels here
+ * @param alpha store the opacity of the pixels here (only LV_IMG_FORMAT_ALPHA, can be NULL)
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t (LV_FS_RES_FS_ERR: corrupt image)
+ */
+lv_fs_res_t lv_draw_img_dec_read_row(lv_draw_img_dec_t * dec, lv_coord_t y, lv_coord_t x, lv_coord_t len,
+                                     lv_color_t * buf, lv_opa_t * alpha);
+
+/**
+ * Free the buffers of a decoder
+ * @param dec pointer to an opened decoder
+ */
+void lv_draw_img_dec_close(lv_draw_img_dec_t * dec);
+
+/**
+ * Get the size of an image in the memory (e.g. to create a file from it)
+ * @param img pointer to an image starting with 'lv_img_raw_header_t'
+ * @return size of the image in bytes (0: unknown format)
+ */
+uint32_t lv_draw_img_dec_get_size(const void * img);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*USE_LV_FILESYSTEM*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  /*LV_DRAW_IMG_DEC_H*/
@@ -0,0 +1,385 @@
+/**
+ * @file lv_draw_img_trans.c
+ * Sample the pixels of scaled and rotated images with fixed point inverse mapping
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_img_trans.h"
+#include "../lv_misc/lv_math.h"
+#include "../lv_misc/lv_trigo.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define TRANS_SHIFT         16                      /*Fractional bits of the image coordinates*/
+#define TRANS_ONE           ((int32_t)1 << TRANS_SHIFT)
+#define TRANS_HALF          ((int32_t)1 << (TRANS_SHIFT - 1))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static inline lv_opa_t trans_get_opa(const lv_draw_img_trans_t * trans, uint32_t id);
+static inline lv_opa_t trans_get_px(const lv_draw_img_trans_t * trans, int32_t x, int32_t y, lv_color_t * color);
+static inline lv_opa_t trans_mix(lv_color_t c1, lv_opa_t a1, lv_color_t c2, lv_opa_t a2, uint8_t mix, lv_color_t * res);
+static bool trans_span(int64_t start, int32_t step, int64_t lo, int64_t hi, int32_t * x1, int32_t * x2);
+static int64_t trans_div_floor(int64_t a, int64_t b);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Prepare the drawing of a transformed image. Set its pixels with 'lv_draw_img_trans_set_data()'.
+ * @param trans pointer to a transformation to initialize
+ * @param header the header of the image
+ * @param coords the area of the image without transformation (on the VDB, doubled if LV_ANTIALIAS is enabled)
+ * @param pivot scale and rotate around this point (on the VDB, the top left corner of a pixel)
+ * @param zoom scale in 1 / LV_IMG_ZOOM_NONE units (LV_IMG_ZOOM_NONE: 'coords' size)
+ * @param angle clockwise rotation in 1 / (1 << TRIGO_ANGLE_SHIFT) degrees
+ * @param antialias true: bilinear filtering, false: nearest pixel
+ */
+void lv_draw_img_trans_init(lv_draw_img_trans_t * trans, const lv_img_raw_header_t * header,
+                            const lv_area_t * coords, const lv_point_t * pivot, uint16_t zoom, int32_t angle, bool antialias)
+{
+    if(zoom == 0) zoom = 1;
+
+    trans->data = NULL;
+    trans->alpha = NULL;
+    trans->row_first = 0;
+    trans->w = header->w;
+    trans->h = header->h;
+    trans->transp = header->transp;
+    trans->antialias = antialias == false ? 0 : 1;
+
+    /*The multiples of 90 degrees have exact sine and cosine so the pixels are not blurred on the edges*/
+    trans->edge_aa = 0;
+    if(antialias != false && angle % ((int32_t)90 << TRIGO_ANGLE_SHIFT) != 0) trans->edge_aa = 1;
+
+    int64_t sin_v = (int64_t)lv_trigo_sin_fine(angle) * TRANS_ONE / TRIGO_SIN_MAX;
+    int64_t cos_v = (int64_t)lv_trigo_sin_fine(angle + ((int32_t)90 << TRIGO_ANGLE_SHIFT)) * TRANS_ONE / TRIGO_SIN_MAX;
+
+    /*Image pixels in a drawn pixel*/
+    lv_coord_t coords_w = lv_area_get_width(coords);
+    lv_coord_t coords_h = lv_area_get_height(coords);
+    int64_t step_x = ((int64_t)header->w << TRANS_SHIFT) * LV_IMG_ZOOM_NONE / ((int64_t)coords_w * zoom);
+    int64_t step_y = ((int64_t)header->h << TRANS_SHIFT) * LV_IMG_ZOOM_NONE / ((int64_t)coords_h * zoom);
+
+    /*Rotate back then scale*/
+    trans->du_dx = (cos_v * step_x) >> TRANS_SHIFT;
+    trans->du_dy = (sin_v * step_x) >> TRANS_SHIFT;
+    trans->dv_dx = -((sin_v * step_y) >> TRANS_SHIFT);
+    trans->dv_dy = (cos_v * step_y) >> TRANS_SHIFT;
+
+    /*The pivot on the image and the image coordinates of the center of the pixel (0;0)*/
+    int64_t pivot_u = ((int64_t)(pivot->x - coords->x1) << TRANS_SHIFT) * header->w / coords_w;
+    int64_t pivot_v = ((int64_t)(pivot->y - coords->y1) << TRANS_SHIFT) * header->h / coords_h;
+    trans->u_ofs = pivot_u + (((int64_t)trans->du_dx + trans->du_dy) >> 1) -
+                   (int64_t)trans->du_dx * pivot->x - (int64_t)trans->du_dy * pivot->y;
+    trans->v_ofs = pivot_v + (((int64_t)trans->dv_dx + trans->dv_dy) >> 1) -
+                   (int64_t)trans->dv_dx * pivot->x - (int64_t)trans->dv_dy * pivot->y;
+
+    /*Bounding box of the scaled and rotated corners (with a pixel for rounding)*/
+    lv_point_t corners[4] = {
+        {coords->x1, coords->y1}, {coords->x2 + 1, coords->y1},
+        {coords->x1, coords->y2 + 1}, {coords->x2 + 1, coords->y2 + 1}
+    };
+    int64_t x_min = INT32_MAX;
+    int64_t x_max = INT32_MIN;
+    int64_t y_min = INT32_MAX;
+    int64_t y_max = INT32_MIN;
+    uint8_t i;
+    for(i = 0; i < 4; i++) {
+        int64_t cx = corners[i].x - pivot->x;
+        int64_t cy = corners[i].y - pivot->y;
+        int64_t x = ((cx * cos_v - cy * sin_v) * zoom / LV_IMG_ZOOM_NONE) >> TRANS_SHIFT;
+        int64_t y = ((cx * sin_v + cy * cos_v) * zoom / LV_IMG_ZOOM_NONE) >> TRANS_SHIFT;
+        if(x < x_min) x_min = x;
+        if(x > x_max) x_max = x;
+        if(y < y_min) y_min = y;
+        if(y > y_max) y_max = y;
+    }
+
+    trans->area.x1 = LV_MATH_MAX(pivot->x + x_min - 1, LV_COORD_MIN);
+    trans->area.y1 = LV_MATH_MAX(pivot->y + y_min - 1, LV_COORD_MIN);
+    trans->area.x2 = LV_MATH_MIN(pivot->x + x_max + 1, LV_COORD_MAX);
+    trans->area.y2 = LV_MATH_MIN(pivot->y + y_max + 1, LV_COORD_MAX);
+}
+
+/**
+ * Get the rows of the image which are sampled to draw an area
+ * @param trans pointer to an initialized transformation
+ * @param area an area on the VDB (in the area of the transformed image)
+ * @param y1 store the first row here
+ * @param y2 store the last row here
+ * @return false: the image is not sampled in the area
+ */
+bool lv_draw_img_trans_get_rows(const lv_draw_img_trans_t * trans, const lv_area_t * area, lv_coord_t * y1, lv_coord_t * y2)
+{
+    /*The image coordinates change linearly so they are the smallest and largest in the corners*/
+    lv_point_t corners[4] = {
+        {area->x1, area->y1}, {area->x2, area->y1},
+        {area->x1, area->y2}, {area->x2, area->y2}
+    };
+    int64_t v_min = INT64_MAX;
+    int64_t v_max = INT64_MIN;
+    uint8_t i;
+    for(i = 0; i < 4; i++) {
+        int64_t v = trans->v_ofs + (int64_t)trans->dv_dx * corners[i].x + (int64_t)trans->dv_dy * corners[i].y;
+        if(v < v_min) v_min = v;
+        if(v > v_max) v_max = v;
+    }
+
+    /*The bilinear filter uses the neighbor rows too*/
+    int64_t first = (v_min >> TRANS_SHIFT) - 1;
+    int64_t last = (v_max >> TRANS_SHIFT) + 1;
+    if(last < 0 || first >= trans->h) return false;
+
+    *y1 = first < 0 ? 0 : first;
+    *y2 = last >= trans->h ? trans->h - 1 : last;
+
+    return true;
+}
+
+/**
+ * Set the pixels of a transformed image. Only the rows got with 'lv_draw_img_trans_get_rows()' are required.
+ * @param trans pointer to an initialized transformation
+ * @param data the pixels of the rows from 'row_first' (the rows are 'header->w' long)
+ * @param alpha the opacity of the pixels or NULL
+ * @param row_first the image row of the first pixel of 'data' and 'alpha'
+ */
+void lv_draw_img_trans_set_data(lv_draw_img_trans_t * trans, const lv_color_t * data, const lv_opa_t * alpha,
+                                lv_coord_t row_first)
+{
+    trans->data = data;
+    trans->alpha = alpha;
+    trans->row_first = row_first;
+}
+
+/**
+ * Get the area covered by a transformed image
+ * @param trans pointer to an initialized transformation
+ * @param coords store the bounding box of the transformed image here
+ */
+void lv_draw_img_trans_get_area(const lv_draw_img_trans_t * trans, lv_area_t * coords)
+{
+    lv_area_copy(coords, &trans->area);
+}
+
+/**
+ * Get the pixels of a row which are on the transformed image
+ * @param trans pointer to an initialized transformation
+ * @param y the row
+ * @param x1 store the first pixel here
+ * @param x2 store the last pixel here
+ * @return false: the image is not on this row
+ */
+bool lv_draw_img_trans_get_span(const lv_draw_img_trans_t * trans, lv_coord_t y, lv_coord_t * x1, lv_coord_t * x2)
+{
+    if(y < trans->area.y1 || y > trans->area.y2) return false;
+
+    /*The centers of the pixels have to be on the image.
+     *With faded edges the half pixel wide border around the image is drawn too.*/
+    int64_t lo_u = 0;
+    int64_t hi_u = (int64_t)trans->w << TRANS_SHIFT;
+    int64_t lo_v = 0;
+    int64_t hi_v = (int64_t)trans->h << TRANS_SHIFT;
+    if(trans->edge_aa) {
+        lo_u -= TRANS_HALF;
+        hi_u += TRANS_HALF;
+        lo_v -= TRANS_HALF;
+        hi_v += TRANS_HALF;
+    }
+
+    int32_t span_x1 = trans->area.x1;
+    int32_t span_x2 = trans->area.x2;
+    int64_t u = trans->u_ofs + (int64_t)trans->du_dy * y;
+    int64_t v = trans->v_ofs + (int64_t)trans->dv_dy * y;
+    if(trans_span(u, trans->du_dx, lo_u, hi_u, &span_x1, &span_x2) == false) return false;
+    if(trans_span(v, trans->dv_dx, lo_v, hi_v, &span_x1, &span_x2) == false) return false;
+
+    *x1 = span_x1;
+    *x2 = span_x2;
+    return true;
+}
+
+/**
+ * Sample the pixels of a part of a row. The pixels have to be in the span of the row.
+ * @param trans pointer to an initialized transformation
+ * @param x the first pixel
+ * @param y the row
+ * @param len number of pixels
+ * @param buf store the colors here
+ * @param alpha store the opacity of the pixels here
+ */
+void lv_draw_img_trans_row(const lv_draw_img_trans_t * trans, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                           lv_color_t * buf, lv_opa_t * alpha)
+{
+    /*In the span the coordinates are on the image (or around it) so they fit into 32 bit*/
+    int32_t u = trans->u_ofs + (int64_t)trans->du_dx * x + (int64_t)trans->du_dy * y;
+    int32_t v = trans->v_ofs + (int64_t)trans->dv_dx * x + (int64_t)trans->dv_dy * y;
+    int32_t du = trans->du_dx;
+    int32_t dv = trans->dv_dx;
+    lv_coord_t i;
+
+    if(trans->antialias == 0) {
+        for(i = 0; i < len; i++) {
+            uint32_t id = (uint32_t)((v >> TRANS_SHIFT) - trans->row_first) * trans->w + (u >> TRANS_SHIFT);
+            buf[i] = trans->data[id];
+            alpha[i] = trans_get_opa(trans, id);
+            u += du;
+            v += dv;
+        }
+        return;
+    }
+
+    /*Bilinear: mix the 4 pixels around the sampling point*/
+    for(i = 0; i < len; i++) {
+        int32_t us = u - TRANS_HALF;
+        int32_t vs = v - TRANS_HALF;
+        int32_t x0 = us >> TRANS_SHIFT;
+        int32_t y0 = vs >> TRANS_SHIFT;
+        int32_t x1 = x0 + 1;
+        int32_t y1 = y0 + 1;
+        uint8_t mix_x = (us >> (TRANS_SHIFT - 8)) & 0xFF;
+        uint8_t mix_y = (vs >> (TRANS_SHIFT - 8)) & 0xFF;
+
+        /*Without faded edges repeat the pixels of the edges*/
+        if(trans->edge_aa == 0) {
+            if(x0 < 0) x0 = 0;
+            if(y0 < 0) y0 = 0;
+            if(x1 >= trans->w) x1 = trans->w - 1;
+            if(y1 >= trans->h) y1 = trans->h - 1;
+        }
+
+        lv_color_t c00, c10, c01, c11;
+        lv_opa_t a00 = trans_get_px(trans, x0, y0, &c00);
+        lv_opa_t a10 = trans_get_px(trans, x1, y0, &c10);
+        lv_opa_t a01 = trans_get_px(trans, x0, y1, &c01);
+        lv_opa_t a11 = trans_get_px(trans, x1, y1, &c11);
+
+        lv_color_t top, bottom;
+        lv_opa_t a_top = trans_mix(c00, a00, c10, a10, mix_x, &top);
+        lv_opa_t a_bottom = trans_mix(c01, a01, c11, a11, mix_x, &bottom);
+        alpha[i] = trans_mix(top, a_top, bottom, a_bottom, mix_y, &buf[i]);
+
+        u += du;
+        v += dv;
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get the opacity of a pixel of the image
+ * @param trans pointer to an initialized transformation
+ * @param id index of the pixel
+ * @return the opacity of the pixel
+ */
+static inline lv_opa_t trans_get_opa(const lv_draw_img_trans_t * trans, uint32_t id)
+{
+    if(trans->alpha != NULL) return trans->alpha[id];
+
+    lv_color_t transp_color = LV_COLOR_TRANSP;
+    if(trans->transp && trans->data[id].full == transp_color.full) return LV_OPA_TRANSP;
+    else return LV_OPA_COVER;
+}
+
+/**
+ * Get a pixel of the image
+ * @param trans pointer to an initialized transformation
+ * @param x x coordinate of the pixel
+ * @param y y coordinate of the pixel
+ * @param color store the color of the pixel here
+ * @return the opacity of the pixel (LV_OPA_TRANSP out of the image)
+ */
+static inline lv_opa_t trans_get_px(const lv_draw_img_trans_t * trans, int32_t x, int32_t y, lv_color_t * color)
+{
+    if(x < 0 || y < 0 || x >= trans->w || y >= trans->h) {
+        *color = LV_COLOR_BLACK;
+        return LV_OPA_TRANSP;
+    }
+
+    uint32_t id = (uint32_t)(y - trans->row_first) * trans->w + x;
+    *color = trans->data[id];
+    return trans_get_opa(trans, id);
+}
+
+/**
+ * Mix two pixels. The transparent pixels don't give color (no dark or LV_COLOR_TRANSP fringes).
+ * @param c1 color of the first pixel
+ * @param a1 opacity of the first pixel
+ * @param c2 color of the second pixel
+ * @param a2 opacity of the second pixel
+ * @param mix weight of the second pixel (0: only the first pixel)
+ * @param res store the mixed color here
+ * @return the mixed opacity
+ */
+static inline lv_opa_t trans_mix(lv_color_t c1, lv_opa_t a1, lv_color_t c2, lv_opa_t a2, uint8_t mix, lv_color_t * res)
+{
+    if(mix == 0 || a2 == LV_OPA_TRANSP) *res = c1;
+    else if(a1 == LV_OPA_TRANSP) *res = c2;
+    else *res = lv_color_mix(c2, c1, mix);
+
+    return ((uint16_t)a1 * (256 - mix) + (uint16_t)a2 * mix) >> 8;
+}
+
+/**
+ * Limit a range of pixels to where a linearly changing coordinate is in a range
+ * @param start value of the coordinate at the pixel 0
+ * @param step change of the coordinate to the next pixel
+ * @param lo the smallest allowed value
+ * @param hi the first not allowed value
+ * @param x1 the first pixel of the range (narrowed)
+ * @param x2 the last pixel of the range (narrowed)
+ * @return false: the range is empty
+ */
+static bool trans_span(int64_t start, int32_t step, int64_t lo, int64_t hi, int32_t * x1, int32_t * x2)
+{
+    int64_t from;
+    int64_t to;
+    if(step > 0) {
+        from = -trans_div_floor(start - lo, step);          /*ceil((lo - start) / step)*/
+        to = -trans_div_floor(start - hi, step) - 1;        /*ceil((hi - start) / step) - 1*/
+    } else if(step < 0) {
+        from = trans_div_floor(start - hi, -step) + 1;
+        to = trans_div_floor(start - lo, -step);
+    } else {
+        return start >= lo && start < hi ? true : false;
+    }
+
+    if(from > *x2 || to < *x1) return false;
+
+    if(from > *x1) *x1 = from;
+    if(to < *x2) *x2 = to;
+
+    return true;
+}
+
+/**
+ * Divide and round towards minus infinity
+ * @param a dividend
+ * @param b divisor (> 0)
+ * @return floor(a / b)
+ */
+static int64_t trans_div_floor(int64_t a, int64_t b)
+{
+    int64_t q = a / b;
+    if(a % b != 0 && a < 0) q--;
+    return q;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file lv_draw_img_trans.h
+ *
+ */
+
+#ifndef LV_DRAW_IMG_TRANS_H
+#define LV_DRAW_IMG_TRANS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include "../lv_misc/lv_area.h"
+#include "../lv_misc/lv_color.h"
+#include "lv_draw.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/* Inverse mapping of a scaled and rotated image: the image coordinates of every drawn pixel.
+ * The image coordinates are 16.16 fixed point numbers and they change linearly along the rows
+ * so the pixels of a row are sampled with additions only.*/
+typedef struct
+{
+    const lv_color_t * data;        /*The pixels of the rows from 'row_first'*/
+    const lv_opa_t * alpha;         /*The opacity of the pixels or NULL*/
+    lv_coord_t row_first;           /*The first image row in 'data' and 'alpha'*/
+    lv_coord_t w;                   /*Size of the image in pixels*/
+    lv_coord_t h;
+    int64_t u_ofs;                  /*Image coordinates of the center of the drawn pixel (0;0)*/
+    int64_t v_ofs;
+    int32_t du_dx;                  /*Change of the image coordinates to the next pixel in a row...*/
+    int32_t dv_dx;
+    int32_t du_dy;                  /*...and to the next row*/
+    int32_t dv_dy;
+    lv_area_t area;                 /*Bounding box of the transformed image*/
+    uint8_t transp :1;              /*1: the pixels with LV_COLOR_TRANSP are transparent (if there is no 'alpha')*/
+    uint8_t antialias :1;           /*1: bilinear filtering, 0: nearest pixel*/
+    uint8_t edge_aa :1;             /*1: fade the edges of the image (rotation not by a multiple of 90 degrees)*/
+}lv_draw_img_trans_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Prepare the drawing of a transformed image. Set its pixels with 'lv_draw_img_trans_set_data()'.
+ * @param trans pointer to a transformation to initialize
+ * @param header the header of the image
+ * @param coords the area of the image without transformation (on the VDB, doubled if LV_ANTIALIAS is enabled)
+ * @param pivot scale and rotate around this point (on the VDB, the top left corner of a pixel)
+ * @param zoom scale in 1 / LV_IMG_ZOOM_NONE units (LV_IMG_ZOOM_NONE: 'coords' size)
+ * @param angle clockwise rotation in 1 / (1 << TRIGO_ANGLE_SHIFT) degrees
+ * @param antialias true: bilinear filtering, false: nearest pixel
+ */
+void lv_draw_img_trans_init(lv_draw_img_trans_t * trans, const lv_img_raw_header_t * header,
+                            const lv_area_t * coords, const lv_point_t * pivot, uint16_t zoom, int32_t angle, bool antialias);
+
+/**
+ * Get the rows of the image which are sampled to draw an area
+ * @param trans pointer to an initialized transformation
+ * @param area an area on the VDB (in the area of the transformed image)
+ * @param y1 store the first row here
+ * @param y2 store the last row here
+ * @return false: the image is not sampled in the area
+ */
+bool lv_draw_img_trans_get_rows(const lv_draw_img_trans_t * trans, const lv_area_t * area, lv_coord_t * y1, lv_coord_t * y2);
+
+/**
+ * Set the pixels of a transformed image. Only the rows got with 'lv_draw_img_trans_get_rows()' are required.
+ * @param trans pointer to an initialized transformation
+ * @param data the pixels of the rows from 'row_first' (the rows are 'header->w' long)
+ * @param alpha the opacity of the pixels or NULL
+ * @param row_first the image row of the first pixel of 'data' and 'alpha'
+ */
+void lv_draw_img_trans_set_data(lv_draw_img_trans_t * trans, const lv_color_t * data, const lv_opa_t * alpha,
+                                lv_coord_t row_first);
+
+/**
+ * Get the area covered by a transformed image
+ * @param trans pointer to an initialized transformation
+ * @param coords store the bounding box of the transformed image here
+ */
+void lv_draw_img_trans_get_area(const lv_draw_img_trans_t * trans, lv_area_t * coords);
+
+/**
+ * Get the pixels of a row which are on the transformed image
+ * @param trans pointer to an initialized transformation
+ * @param y the row
+ * @param x1 store the first pixel here
+ * @param x2 store the last pixel here
+ * @return false: the image is not on this row
+ */
+bool lv_draw_img_trans_get_span(const lv_draw_img_trans_t * trans, lv_coord_t y, lv_coord_t * x1, lv_coord_t * x2);
+
+/**
+ * Sample the pixels of a part of a row. The pixels have to be in the span of the row.
+ * @param trans pointer to an initialized transformation
+ * @param x the first pixel
+ * @param y the row
+ * @param len number of pixels
+ * @param buf store the colors here
+ * @param alpha store the opacity of the pixels here
+ */
+void lv_draw_img_trans_row(const lv_draw_img_trans_t * trans, lv_coord_t x, lv_coord_t y, lv_coord_t len,
+                           lv_color_t * buf, lv_opa_t * alpha);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  /*LV_DRAW_IMG_TRANS_H*/
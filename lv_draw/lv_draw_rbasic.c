@@ -89,28 +89,43 @@ void lv_rfill(const lv_area_t * cords_p, const lv_area_t * mask_p,
  * Draw a letter to the display
  * @param pos_p left-top coordinate of the latter
  * @param mask_p the letter will be drawn only on this area
- * @param font_p pointer to font 
- * @param letter a letter to draw
+ * @param glyph_p pointer to the description of the glyph (from 'lv_font_get_glyph_dsc')
  * @param color color of letter
  * @param opa opacity of letter (ignored, only for compatibility with lv_vletter)
  */
 void lv_rletter(const lv_point_t * pos_p, const lv_area_t * mask_p,
-                     const lv_font_t * font_p, uint32_t letter,
-                     lv_color_t color, lv_opa_t opa)
+                const lv_font_glyph_dsc_t * glyph_p,
+                lv_color_t color, lv_opa_t opa)
 {
     (void)opa;      /*Opa is used only for compatibility with lv_vletter*/
 
-    uint8_t w = lv_font_get_width(font_p, letter);
+    if(glyph_p->bitmap == NULL) return;
 
-    if(letter == 'C') {
-        letter = 'C';
-    }
-
-    const uint8_t * bitmap_p = lv_font_get_bitmap(font_p, letter);
+    uint8_t w = glyph_p->w;
+    const uint8_t * bitmap_p = glyph_p->bitmap;
 
     uint8_t col, col_sub, row;
+
+    /*Anti-aliased fonts: draw the mostly covered pixels*/
+    if(glyph_p->bpp > 1) {
+        for(row = 0; row < (glyph_p->h >> LV_FONT_ANTIALIAS); row ++) {
+            for(col = 0; col < (w >> LV_FONT_ANTIALIAS); col ++) {
+#if LV_FONT_ANTIALIAS == 0
+                uint8_t cov = lv_font_get_glyph_px(glyph_p, col, row);
+#else
+                uint8_t cov = (lv_font_get_glyph_px(glyph_p, col << 1, row << 1) +
+                               lv_font_get_glyph_px(glyph_p, (col << 1) + 1, row << 1) +
+                               lv_font_get_glyph_px(glyph_p, col << 1, (row << 1) + 1) +
+                               lv_font_get_glyph_px(glyph_p, (col << 1) + 1, (row << 1) + 1)) >> 2;
+#endif
+                if(cov >= LV_OPA_50) lv_rpx(pos_p->x + col, pos_p->y + row, mask_p, color, opa);
+            }
+        }
+        return;
+    }
+
 #if LV_FONT_ANTIALIAS == 0
-    for(row = 0; row < font_p->height_row; row ++) {
+    for(row = 0; row < glyph_p->h; row ++) {
         for(col = 0, col_sub = 7; col < w; col ++, col_sub--) {
             if(*bitmap_p & (1 << col_sub)) {
                 lv_rpx(pos_p->x + col, pos_p->y + row, mask_p, color, opa);
@@ -131,7 +146,7 @@ void lv_rletter(const lv_point_t * pos_p, const lv_area_t * mask_p,
        const uint8_t * map2_p = bitmap_p + width_byte;
        uint8_t px_cnt;
        uint8_t col_byte_cnt;
-       for(row = 0; row < (font_p->height_row >> 1); row ++) {
+       for(row = 0; row < (glyph_p->h >> 1); row ++) {
            col_byte_cnt = 0;
            col_sub = 7;
            for(col = 0; col < (w >> 1); col ++) {
@@ -175,6 +190,8 @@ void lv_rletter(const lv_point_t * pos_p, const lv_area_t * mask_p,
  * @param cords_p coordinates the color map
  * @param mask_p the map will drawn only on this area
  * @param map_p pointer to a lv_color_t array
+ * @param alpha_p pointer to the opacity of the pixels of 'map_p' or NULL
+ *                (no blending: only the pixels with at least LV_OPA_50 are drawn)
  * @param opa opacity of the map (ignored, only for compatibility with lv_vmap)
  * @param transp true: enable transparency of LV_IMG_LV_COLOR_TRANSP color pixels
  * @param upscale true: upscale to double size (not supported)
@@ -182,7 +199,7 @@ void lv_rletter(const lv_point_t * pos_p, const lv_area_t * mask_p,
  * @param recolor_opa the intense of recoloring (not supported)
  */
 void lv_rmap(const lv_area_t * cords_p, const lv_area_t * mask_p,
-             const lv_color_t * map_p, lv_opa_t opa, bool transp, bool upscale,
+             const lv_color_t * map_p, const lv_opa_t * alpha_p, lv_opa_t opa, bool transp, bool upscale,
 			 lv_color_t recolor, lv_opa_t recolor_opa)
 {
     (void)opa;              /*opa is used only for compatibility with lv_vmap*/
@@ -200,10 +217,11 @@ void lv_rmap(const lv_area_t * cords_p, const lv_area_t * mask_p,
 
     /*Go to the first pixel*/
     lv_coord_t map_width = lv_area_get_width(cords_p);
-    map_p+= (masked_a.y1 - cords_p->y1) * map_width;
-    map_p += masked_a.x1 - cords_p->x1;
+    uint32_t map_ofs = (masked_a.y1 - cords_p->y1) * map_width + (masked_a.x1 - cords_p->x1);
+    map_p += map_ofs;
+    if(alpha_p != NULL) alpha_p += map_ofs;
 
-    if(transp == false) {
+    if(transp == false && alpha_p == NULL) {
         lv_coord_t row;
         lv_coord_t mask_w = lv_area_get_width(&masked_a) - 1;
         for(row = 0; row < lv_area_get_height(&masked_a); row++) {
@@ -217,11 +235,16 @@ void lv_rmap(const lv_area_t * cords_p, const lv_area_t * mask_p,
         for(row = 0; row < lv_area_get_height(&masked_a); row++) {
             lv_coord_t col;
             for(col = 0; col < lv_area_get_width(&masked_a); col ++) {
-                if(map_p[col].full != transp_color.full) {
-                    lv_rpx(masked_a.x1 + col, masked_a.y1 + row, mask_p, map_p[col], opa);
+                /*The pixels can't be blended with the display so draw the mostly opaque ones*/
+                if(alpha_p != NULL) {
+                    if(alpha_p[col] < LV_OPA_50) continue;
+                } else if(map_p[col].full == transp_color.full) {
+                    continue;
                 }
+                lv_rpx(masked_a.x1 + col, masked_a.y1 + row, mask_p, map_p[col], opa);
             }
             map_p += map_width;
+            if(alpha_p != NULL) alpha_p += map_width;
         }
     }
 }
@@ -45,13 +45,12 @@ void lv_rfill(const lv_area_t * cords_p, const lv_area_t * mask_p,
  * Draw a letter to the display
  * @param pos_p left-top coordinate of the latter
  * @param mask_p the letter will be drawn only on this area
- * @param font_p pointer to font
- * @param letter a letter to draw
+ * @param glyph_p pointer to the description of the glyph (from 'lv_font_get_glyph_dsc')
  * @param color color of letter
  * @param opa opacity of letter (ignored, only for compatibility with lv_vletter)
  */
 void lv_rletter(const lv_point_t * pos_p, const lv_area_t * mask_p,
-                const lv_font_t * font_p, uint32_t letter,
+                const lv_font_glyph_dsc_t * glyph_p,
                 lv_color_t color, lv_opa_t opa);
 
 /**
@@ -59,6 +58,8 @@ void lv_rletter(const lv_point_t * pos_p, const lv_area_t * mask_p,
  * @param cords_p coordinates the color map
  * @param mask_p the map will drawn only on this area
  * @param map_p pointer to a lv_color_t array
+ * @param alpha_p pointer to the opacity of the pixels of 'map_p' or NULL
+ *                (no blending: only the pixels with at least LV_OPA_50 are drawn)
  * @param opa opacity of the map (ignored, only for compatibility with lv_vmap)
  * @param transp true: enable transparency of LV_IMG_LV_COLOR_TRANSP color pixels
  * @param upscale true: upscale to double size (not supported)
@@ -66,7 +67,7 @@ void lv_rletter(const lv_point_t * pos_p, const lv_area_t * mask_p,
  * @param recolor_opa the intense of recoloring (not supported)
  */
 void lv_rmap(const lv_area_t * cords_p, const lv_area_t * mask_p,
-             const lv_color_t * map_p, lv_opa_t opa, bool transp, bool upscale,
+             const lv_color_t * map_p, const lv_opa_t * alpha_p, lv_opa_t opa, bool transp, bool upscale,
 			 lv_color_t recolor, lv_opa_t recolor_opa);
 /**********************
  *      MACROS
@@ -0,0 +1,884 @@
+/**
+ * @file lv_draw_scan.c
+ * Scanline rasterizer of convex polygons, circles, arcs and general polygons with optional coverage anti-aliasing
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_scan.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_math.h"
+#include "../lv_misc/lv_trigo.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define SCAN_HALF               (LV_DRAW_SCAN_UNIT / 2)     /*Half pixel (the anti-aliased edges are 1 pixel wide)*/
+#define SCAN_RUN_MAX            16                          /*Max. number of runs of a row which can be joined with the next rows*/
+#define SCAN_HARD_OVERLAP       16                          /*The hard edges overlap the adjacent shape to hide the rounding of the normals*/
+#define SCAN_SUB_SHIFT          3                           /*The anti-aliased polygons are sampled in 1 << SCAN_SUB_SHIFT rows per pixel*/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct
+{
+    lv_coord_t x1;
+    lv_coord_t x2;
+}scan_iv_t;
+
+/*A not horizontal edge of a general polygon from top to bottom*/
+typedef struct
+{
+    int32_t x1;         /*Top end point*/
+    int32_t y1;
+    int32_t x2;         /*Bottom end point (the edge is not in its row)*/
+    int32_t y2;
+    int8_t dir;         /*1: downwards in the order of the points, -1: upwards*/
+}scan_edge_t;
+
+/*Crossing of a row and an edge*/
+typedef struct
+{
+    int32_t x;
+    int8_t dir;
+}scan_cross_t;
+
+/*Pixels with the same opacity in a row*/
+typedef struct
+{
+    lv_coord_t x1;
+    lv_coord_t x2;
+    lv_opa_t opa;
+}scan_run_t;
+
+/*Runs which are the same in the rows 'y1'..'y2'*/
+typedef struct
+{
+    scan_run_t runs[SCAN_RUN_MAX];
+    uint16_t cnt;
+    lv_coord_t y1;
+    lv_coord_t y2;
+}scan_rows_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool scan_range(const lv_draw_scan_shape_t * shape, int32_t y, int32_t th, lv_coord_t * x1, lv_coord_t * x2);
+static bool scan_range_edges(const lv_draw_scan_shape_t * shape, int32_t y, int32_t th, int64_t * lo, int64_t * hi);
+static void scan_edge_init(lv_draw_scan_edge_t * edge, int64_t nx, int64_t ny, const lv_draw_scan_point_t * p, bool hard);
+static lv_opa_t scan_cover(const lv_draw_scan_shape_t * shape, int32_t x, int32_t y);
+static uint16_t scan_merge(scan_iv_t * ivs, uint16_t iv_cnt);
+static void scan_span(int32_t x1, int32_t x2, const lv_area_t * scan_area, bool aa, lv_opa_t * cover, int16_t * cell, int16_t * delta,
+                      scan_iv_t * ivs, uint16_t * iv_cnt);
+static void scan_row(scan_rows_t * rows, lv_coord_t y, lv_opa_t * cover, lv_coord_t x_ofs, const scan_iv_t * ivs, uint16_t iv_cnt,
+                     const lv_area_t * mask, lv_color_t color, lv_opa_t opa, lv_draw_scan_fill_t fill);
+static void scan_flush(scan_rows_t * rows, const lv_area_t * mask, lv_color_t color, lv_opa_t opa, lv_draw_scan_fill_t fill);
+static int64_t scan_floor_div(int64_t a, int64_t b);
+static int64_t scan_ceil_div(int64_t a, int64_t b);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize a convex polygon shape
+ * @param shape pointer to a shape to initialize
+ * @param points the vertices in 1/256 pixels (clockwise or counter-clockwise order)
+ * @param point_num number of vertices (max. LV_DRAW_SCAN_EDGE_MAX)
+ * @param hard_edges bit 'i' set: the edge from 'points[i]' isn't anti-aliased because an other shape
+ *                   continues the shape there (the adjacent shapes would leave a visible seam)
+ */
+void lv_draw_scan_polygon(lv_draw_scan_shape_t * shape, const lv_draw_scan_point_t * points, uint8_t point_num, uint8_t hard_edges)
+{
+    memset(shape, 0, sizeof(lv_draw_scan_shape_t));
+    shape->type = LV_DRAW_SCAN_POLYGON;
+    lv_area_set(&shape->box, 1, 1, 0, 0);      /*Empty until it's known that it's not degenerated*/
+
+    if(point_num > LV_DRAW_SCAN_EDGE_MAX) point_num = LV_DRAW_SCAN_EDGE_MAX;
+
+    /*The sign of the area tells the order of the vertices*/
+    int64_t area = 0;
+    uint8_t i;
+    for(i = 0; i < point_num; i++) {
+        const lv_draw_scan_point_t * a = &points[i];
+        const lv_draw_scan_point_t * b = &points[(i + 1) % point_num];
+        area += (int64_t)a->x * b->y - (int64_t)b->x * a->y;
+    }
+    if(area == 0) return;
+
+    int32_t x_min = points[0].x;
+    int32_t x_max = points[0].x;
+    int32_t y_min = points[0].y;
+    int32_t y_max = points[0].y;
+
+    for(i = 0; i < point_num; i++) {
+        const lv_draw_scan_point_t * a = &points[i];
+        const lv_draw_scan_point_t * b = &points[(i + 1) % point_num];
+
+        x_min = LV_MATH_MIN(x_min, a->x);
+        x_max = LV_MATH_MAX(x_max, a->x);
+        y_min = LV_MATH_MIN(y_min, a->y);
+        y_max = LV_MATH_MAX(y_max, a->y);
+
+        int64_t nx = b->y - a->y;
+        int64_t ny = a->x - b->x;
+        if(nx == 0 && ny == 0) continue;
+        if(area < 0) {
+            nx = -nx;
+            ny = -ny;
+        }
+
+        uint32_t len = lv_trigo_sqrt(nx * nx + ny * ny);
+        nx = (nx << LV_DRAW_SCAN_NORM_SHIFT) / (int64_t)len;
+        ny = (ny << LV_DRAW_SCAN_NORM_SHIFT) / (int64_t)len;
+        scan_edge_init(&shape->edges[shape->edge_cnt], nx, ny, a, (hard_edges >> i) & 0x1);
+        shape->edge_cnt++;
+    }
+
+    /*One more pixel on every side for the anti-aliased edges*/
+    shape->box.x1 = scan_floor_div(x_min, LV_DRAW_SCAN_UNIT) - 1;
+    shape->box.y1 = scan_floor_div(y_min, LV_DRAW_SCAN_UNIT) - 1;
+    shape->box.x2 = scan_floor_div(x_max, LV_DRAW_SCAN_UNIT) + 1;
+    shape->box.y2 = scan_floor_div(y_max, LV_DRAW_SCAN_UNIT) + 1;
+}
+
+/**
+ * Initialize a circle shape
+ * @param shape pointer to a shape to initialize
+ * @param center the center in 1/256 pixels
+ * @param radius the radius in 1/256 pixels
+ */
+void lv_draw_scan_circle(lv_draw_scan_shape_t * shape, const lv_draw_scan_point_t * center, int32_t radius)
+{
+    memset(shape, 0, sizeof(lv_draw_scan_shape_t));
+    shape->type = LV_DRAW_SCAN_CIRCLE;
+    shape->center = *center;
+    shape->radius = radius;
+
+    shape->box.x1 = scan_floor_div(center->x - radius, LV_DRAW_SCAN_UNIT) - 1;
+    shape->box.y1 = scan_floor_div(center->y - radius, LV_DRAW_SCAN_UNIT) - 1;
+    shape->box.x2 = scan_floor_div(center->x + radius, LV_DRAW_SCAN_UNIT) + 1;
+    shape->box.y2 = scan_floor_div(center->y + radius, LV_DRAW_SCAN_UNIT) + 1;
+}
+
+/**
+ * Initialize a piece of a ring. It has to be in the right (-90..90 degrees) or in the left (90..270 degrees) half.
+ * @param shape pointer to a shape to initialize
+ * @param center the center in 1/256 pixels
+ * @param radius_in the inner radius in 1/256 pixels
+ * @param radius_out the outer radius in 1/256 pixels
+ * @param start start angle in 1 / (1 << TRIGO_ANGLE_SHIFT) degrees (0 is on the right, it grows clockwise)
+ * @param end end angle in 1 / (1 << TRIGO_ANGLE_SHIFT) degrees (at most 180 degrees after 'start')
+ * @param hard_edges bit 0 set: the start isn't anti-aliased, bit 1 set: the end isn't anti-aliased
+ *                   (because an other shape continues the ring there)
+ */
+void lv_draw_scan_arc(lv_draw_scan_shape_t * shape, const lv_draw_scan_point_t * center, int32_t radius_in, int32_t radius_out,
+                      int32_t start, int32_t end, uint8_t hard_edges)
+{
+    memset(shape, 0, sizeof(lv_draw_scan_shape_t));
+    shape->type = LV_DRAW_SCAN_ARC;
+    shape->center = *center;
+    shape->radius = radius_out;
+    shape->radius_in = radius_in;
+    lv_area_set(&shape->box, 1, 1, 0, 0);
+    if(end <= start || radius_out <= radius_in) return;
+
+    /*The side of the vertical axis where the middle of the arc is*/
+    int32_t sx;
+    int32_t sy;
+    lv_trigo_polar((start + end) / 2, LV_DRAW_SCAN_UNIT, &sx, &sy);
+    shape->side = sx >= 0 ? 1 : -1;
+
+    /*The inside is clockwise from the start and counter-clockwise from the end.
+     *The directions are unit vectors with (1 << LV_DRAW_SCAN_NORM_SHIFT) length*/
+    int32_t dx;
+    int32_t dy;
+    lv_trigo_polar(start, 1 << LV_DRAW_SCAN_NORM_SHIFT, &dx, &dy);
+    scan_edge_init(&shape->edges[0], dy, -dx, center, hard_edges & 0x1);
+    lv_trigo_polar(end, 1 << LV_DRAW_SCAN_NORM_SHIFT, &dx, &dy);
+    scan_edge_init(&shape->edges[1], -dy, dx, center, (hard_edges >> 1) & 0x1);
+    shape->edge_cnt = 2;
+
+    /*The bounding box of the ends and the outermost points on the axes between them*/
+    int32_t x_min = INT32_MAX;
+    int32_t x_max = INT32_MIN;
+    int32_t y_min = INT32_MAX;
+    int32_t y_max = INT32_MIN;
+    int32_t angles[2 + 2];
+    uint8_t angle_cnt = 0;
+    angles[angle_cnt++] = start;
+    angles[angle_cnt++] = end;
+    int32_t quarter = (int32_t)90 << TRIGO_ANGLE_SHIFT;
+    int32_t a = (start / quarter) * quarter;
+    while(a <= start) a += quarter;
+    while(a < end && angle_cnt < 4) {
+        angles[angle_cnt++] = a;
+        a += quarter;
+    }
+
+    uint8_t i;
+    for(i = 0; i < angle_cnt; i++) {
+        int32_t x;
+        int32_t y;
+        lv_trigo_polar(angles[i], radius_out, &x, &y);
+        x_min = LV_MATH_MIN(x_min, x);
+        x_max = LV_MATH_MAX(x_max, x);
+        y_min = LV_MATH_MIN(y_min, y);
+        y_max = LV_MATH_MAX(y_max, y);
+        if(i < 2) {
+            lv_trigo_polar(angles[i], radius_in, &x, &y);
+            x_min = LV_MATH_MIN(x_min, x);
+            x_max = LV_MATH_MAX(x_max, x);
+            y_min = LV_MATH_MIN(y_min, y);
+            y_max = LV_MATH_MAX(y_max, y);
+        }
+    }
+
+    shape->box.x1 = scan_floor_div(center->x + x_min, LV_DRAW_SCAN_UNIT) - 1;
+    shape->box.y1 = scan_floor_div(center->y + y_min, LV_DRAW_SCAN_UNIT) - 1;
+    shape->box.x2 = scan_floor_div(center->x + x_max, LV_DRAW_SCAN_UNIT) + 1;
+    shape->box.y2 = scan_floor_div(center->y + y_max, LV_DRAW_SCAN_UNIT) + 1;
+}
+
+/**
+ * Draw the union of shapes row by row. Every pixel is drawn once even if more shapes cover it.
+ * The equal rows are drawn with one 'fill' call.
+ * @param shapes array of shapes
+ * @param shape_num number of shapes
+ * @param mask the shapes will be drawn only on this area
+ * @param color color of the shapes
+ * @param opa opacity of the shapes
+ * @param aa true: draw the partially covered edge pixels with the ratio of their coverage;
+ *           false: draw the pixels whose center is in a shape
+ * @param fill draw the spans with this function
+ */
+void lv_draw_scan_fill(const lv_draw_scan_shape_t * shapes, uint16_t shape_num, const lv_area_t * mask,
+                       lv_color_t color, lv_opa_t opa, bool aa, lv_draw_scan_fill_t fill)
+{
+    /*Scan only the rows and columns where the shapes are on the mask*/
+    lv_area_t scan_area;
+    lv_area_t tmp;
+    bool found = false;
+    uint16_t i;
+    for(i = 0; i < shape_num; i++) {
+        if(lv_area_union(&tmp, &shapes[i].box, mask) == false) continue;     /*Empty for degenerated polygons too*/
+        if(found == false) lv_area_copy(&scan_area, &shapes[i].box);
+        else lv_area_join(&scan_area, &scan_area, &shapes[i].box);
+        found = true;
+    }
+    if(found == false) return;
+    if(lv_area_union(&scan_area, &scan_area, mask) == false) return;
+
+    /*The coverage of the pixels of a row and the ranges of the shapes in the row*/
+    lv_coord_t w = lv_area_get_width(&scan_area);
+    scan_iv_t * ivs = lv_mem_alloc(shape_num * sizeof(scan_iv_t) + w * sizeof(lv_opa_t));
+    if(ivs == NULL) return;
+    lv_opa_t * cover = (lv_opa_t *)&ivs[shape_num];    /*Indexed with 'x - x_ofs'*/
+    lv_coord_t x_ofs = scan_area.x1;
+    memset(cover, LV_OPA_TRANSP, w * sizeof(lv_opa_t));
+
+    scan_rows_t rows;
+    rows.cnt = 0;
+
+    lv_coord_t y;
+    for(y = scan_area.y1; y <= scan_area.y2; y++) {
+        int32_t y_sub = ((int32_t)y << LV_DRAW_SCAN_SHIFT) + SCAN_HALF;
+        uint16_t iv_cnt = 0;
+
+        /*Add the coverage of the shapes in this row*/
+        for(i = 0; i < shape_num; i++) {
+            const lv_draw_scan_shape_t * shape = &shapes[i];
+            if(y < shape->box.y1 || y > shape->box.y2) continue;
+
+            lv_coord_t x1;
+            lv_coord_t x2;
+            if(aa == false) {
+                if(scan_range(shape, y_sub, 0, &x1, &x2) == false) continue;
+                x1 = LV_MATH_MAX(x1, scan_area.x1);
+                x2 = LV_MATH_MIN(x2, scan_area.x2);
+                if(x1 > x2) continue;
+                memset(&cover[x1 - x_ofs], LV_OPA_COVER, x2 - x1 + 1);
+            } else {
+                /*The pixels at most half pixel out of the shape*/
+                if(scan_range(shape, y_sub, SCAN_HALF, &x1, &x2) == false) continue;
+                x1 = LV_MATH_MAX(x1, scan_area.x1);
+                x2 = LV_MATH_MIN(x2, scan_area.x2);
+                if(x1 > x2) continue;
+
+                /*The pixels at least half pixel in the shape are fully covered*/
+                lv_coord_t in1;
+                lv_coord_t in2;
+                if(scan_range(shape, y_sub, -SCAN_HALF, &in1, &in2) == false) {
+                    in1 = x2 + 1;
+                    in2 = x2;
+                }
+                in1 = LV_MATH_MAX(in1, x1);
+                in2 = LV_MATH_MIN(in2, x2);
+                if(in1 <= in2) memset(&cover[in1 - x_ofs], LV_OPA_COVER, in2 - in1 + 1);
+                else in1 = x2 + 1;
+
+                /*The partially covered pixels on the left and on the right*/
+                lv_coord_t x;
+                for(x = x1; x <= x2; x++) {
+                    if(x == in1) x = in2 + 1;
+                    if(x > x2) break;
+                    lv_opa_t c = scan_cover(shape, ((int32_t)x << LV_DRAW_SCAN_SHIFT) + SCAN_HALF, y_sub);
+                    if(c > cover[x - x_ofs]) cover[x - x_ofs] = c;
+                }
+            }
+
+            ivs[iv_cnt].x1 = x1;
+            ivs[iv_cnt].x2 = x2;
+            iv_cnt++;
+        }
+
+        iv_cnt = scan_merge(ivs, iv_cnt);
+        scan_row(&rows, y, cover, x_ofs, ivs, iv_cnt, mask, color, opa, fill);
+    }
+
+    scan_flush(&rows, mask, color, opa, fill);
+
+    lv_mem_free(ivs);
+}
+
+/**
+ * Draw a general (also concave or self-intersecting) polygon row by row.
+ * The crossings of the rows and the edges are got from an edge table sorted by the top of the edges.
+ * The equal rows are drawn with one 'fill' call.
+ * @param points the vertices in 1/256 pixels (the last vertex is connected to the first one)
+ * @param point_num number of vertices
+ * @param even_odd true: a pixel is in the polygon if a ray from it crosses the edges odd times;
+ *                 false: a pixel is in the polygon if the edges wind around it not zero times (nonzero rule)
+ * @param mask the polygon will be drawn only on this area
+ * @param color color of the polygon
+ * @param opa opacity of the polygon
+ * @param aa true: draw the partially covered edge pixels with the ratio of their coverage;
+ *           false: draw the pixels whose center is in the polygon
+ * @param fill draw the spans with this function
+ */
+void lv_draw_scan_fill_polygon(const lv_draw_scan_point_t * points, uint16_t point_num, bool even_odd, const lv_area_t * mask,
+                               lv_color_t color, lv_opa_t opa, bool aa, lv_draw_scan_fill_t fill)
+{
+    if(point_num < 3) return;
+
+    /*Scan only the rows and columns where the polygon is on the mask*/
+    int32_t x_min = points[0].x;
+    int32_t x_max = points[0].x;
+    int32_t y_min = points[0].y;
+    int32_t y_max = points[0].y;
+    uint16_t i;
+    for(i = 1; i < point_num; i++) {
+        x_min = LV_MATH_MIN(x_min, points[i].x);
+        x_max = LV_MATH_MAX(x_max, points[i].x);
+        y_min = LV_MATH_MIN(y_min, points[i].y);
+        y_max = LV_MATH_MAX(y_max, points[i].y);
+    }
+
+    lv_area_t scan_area;
+    scan_area.x1 = scan_floor_div(x_min, LV_DRAW_SCAN_UNIT);
+    scan_area.y1 = scan_floor_div(y_min, LV_DRAW_SCAN_UNIT);
+    scan_area.x2 = scan_floor_div(x_max, LV_DRAW_SCAN_UNIT);
+    scan_area.y2 = scan_floor_div(y_max, LV_DRAW_SCAN_UNIT);
+    if(lv_area_union(&scan_area, &scan_area, mask) == false) return;
+
+    /* The edges, the active edges, the crossings of a row, the ranges of the spans and the coverage of a row.
+     * With anti-aliasing the horizontal coverage of the sub-rows is accumulated in 'cell' and in 'delta'
+     * ('delta' is added to every pixel after it to cover the inner pixels of a span in O(1))*/
+    uint8_t sub_shift = aa ? SCAN_SUB_SHIFT : 0;
+    uint16_t iv_max = (point_num / 2 + 1) << sub_shift;
+    lv_coord_t w = lv_area_get_width(&scan_area);
+    uint32_t size = point_num * (sizeof(scan_edge_t) + sizeof(scan_cross_t) + sizeof(uint16_t)) +
+                    iv_max * sizeof(scan_iv_t) + w * sizeof(lv_opa_t);
+    if(aa) size += (2 * w + 1) * sizeof(int16_t);
+
+    scan_edge_t * edges = lv_mem_alloc(size);
+    if(edges == NULL) return;
+    scan_cross_t * crosses = (scan_cross_t *)&edges[point_num];
+    scan_iv_t * ivs = (scan_iv_t *)&crosses[point_num];
+    int16_t * cell = (int16_t *)&ivs[iv_max];
+    int16_t * delta = aa ? &cell[w] : cell;
+    uint16_t * active = aa ? (uint16_t *)&delta[w + 1] : (uint16_t *)cell;
+    lv_opa_t * cover = (lv_opa_t *)&active[point_num];     /*Indexed with 'x - x_ofs'*/
+    lv_coord_t x_ofs = scan_area.x1;
+    memset(cover, LV_OPA_TRANSP, w * sizeof(lv_opa_t));
+    if(aa) memset(cell, 0, (2 * w + 1) * sizeof(int16_t));
+
+    /*The edge table: the not horizontal edges sorted by their top (insertion sort: the points are usually almost ordered)*/
+    uint16_t edge_num = 0;
+    for(i = 0; i < point_num; i++) {
+        const lv_draw_scan_point_t * a = &points[i];
+        const lv_draw_scan_point_t * b = &points[(i + 1) % point_num];
+        if(a->y == b->y) continue;
+
+        scan_edge_t edge;
+        if(a->y < b->y) {
+            edge.x1 = a->x;
+            edge.y1 = a->y;
+            edge.x2 = b->x;
+            edge.y2 = b->y;
+            edge.dir = 1;
+        } else {
+            edge.x1 = b->x;
+            edge.y1 = b->y;
+            edge.x2 = a->x;
+            edge.y2 = a->y;
+            edge.dir = -1;
+        }
+
+        uint16_t j = edge_num;
+        while(j > 0 && edges[j - 1].y1 > edge.y1) {
+            edges[j] = edges[j - 1];
+            j--;
+        }
+        edges[j] = edge;
+        edge_num++;
+    }
+
+    uint16_t next_edge = 0;
+    uint16_t act_num = 0;
+
+    scan_rows_t rows;
+    rows.cnt = 0;
+
+    lv_coord_t y;
+    for(y = scan_area.y1; y <= scan_area.y2; y++) {
+        uint16_t iv_cnt = 0;
+        uint16_t s;
+        for(s = 0; s < (1 << sub_shift); s++) {
+            /*The center of the sub-row*/
+            int32_t y_sub = ((int32_t)y << LV_DRAW_SCAN_SHIFT) + ((int32_t)(2 * s + 1) << (LV_DRAW_SCAN_SHIFT - 1 - sub_shift));
+
+            /*Activate the edges starting above the sub-row and get the crossings of the active edges in order*/
+            while(next_edge < edge_num && edges[next_edge].y1 <= y_sub) {
+                active[act_num] = next_edge;
+                act_num++;
+                next_edge++;
+            }
+
+            uint16_t cross_num = 0;
+            uint16_t k = 0;
+            for(i = 0; i < act_num; i++) {
+                const scan_edge_t * edge = &edges[active[i]];
+                if(edge->y2 <= y_sub) continue;     /*Ended above: remove it*/
+                active[k] = active[i];
+                k++;
+
+                scan_cross_t cross;
+                cross.x = edge->x1 + scan_floor_div((int64_t)(y_sub - edge->y1) * (edge->x2 - edge->x1), edge->y2 - edge->y1);
+                cross.dir = edge->dir;
+
+                uint16_t j = cross_num;
+                while(j > 0 && crosses[j - 1].x > cross.x) {
+                    crosses[j] = crosses[j - 1];
+                    j--;
+                }
+                crosses[j] = cross;
+                cross_num++;
+            }
+            act_num = k;
+
+            /*Add the spans where the polygon is filled according to the fill rule*/
+            int32_t wind = 0;
+            int32_t span_x1 = 0;
+            for(i = 0; i < cross_num; i++) {
+                bool was_in = even_odd ? (wind & 0x1) != 0 : wind != 0;
+                wind += crosses[i].dir;
+                bool in = even_odd ? (wind & 0x1) != 0 : wind != 0;
+                if(was_in == false && in) span_x1 = crosses[i].x;
+                else if(was_in && in == false) {
+                    scan_span(span_x1, crosses[i].x, &scan_area, aa, cover, cell, delta, ivs, &iv_cnt);
+                }
+            }
+        }
+
+        iv_cnt = scan_merge(ivs, iv_cnt);
+
+        /*Average the coverage of the sub-rows*/
+        if(aa) {
+            uint16_t k;
+            for(k = 0; k < iv_cnt; k++) {
+                int16_t acc = 0;
+                lv_coord_t x;
+                for(x = ivs[k].x1 - x_ofs; x <= ivs[k].x2 - x_ofs; x++) {
+                    acc += delta[x];
+                    int16_t c = (acc + cell[x]) >> sub_shift;
+                    cover[x] = c >= LV_OPA_COVER ? LV_OPA_COVER : c;
+                    cell[x] = 0;
+                    delta[x] = 0;
+                }
+            }
+        }
+
+        scan_row(&rows, y, cover, x_ofs, ivs, iv_cnt, mask, color, opa, fill);
+    }
+
+    scan_flush(&rows, mask, color, opa, fill);
+
+    lv_mem_free(edges);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get the pixels of a row which are in a shape
+ * @param shape pointer to a shape
+ * @param y the center of the row in 1/256 pixels
+ * @param th the pixels whose center is at most 'th' out of the shape are in the range (1/256 pixels).
+ *           With 0 (and on the hard edges) the centers on the right and bottom edges are out of the shape
+ *           (a line of width 'w' is 'w' pixels wide and the adjacent shapes meet without gap)
+ * @param x1 store the first pixel here
+ * @param x2 store the last pixel here
+ * @return false: no pixels in the row
+ */
+static bool scan_range(const lv_draw_scan_shape_t * shape, int32_t y, int32_t th, lv_coord_t * x1, lv_coord_t * x2)
+{
+    int64_t lo = shape->box.x1;
+    int64_t hi = shape->box.x2;
+
+    if(shape->type == LV_DRAW_SCAN_POLYGON) {
+        if(scan_range_edges(shape, y, th, &lo, &hi) == false) return false;
+    } else {
+        /*In the (outer) circle*/
+        int64_t r = shape->radius + th;
+        if(r <= 0) return false;
+        int64_t dy = y - shape->center.y;
+        int64_t rem = r * r - dy * dy;
+        if(th == 0) rem--;          /*Strictly in the circle*/
+        if(rem < 0) return false;
+        int64_t s = lv_trigo_sqrt(rem);
+        lo = LV_MATH_MAX(lo, scan_ceil_div(shape->center.x - s - SCAN_HALF, LV_DRAW_SCAN_UNIT));
+        hi = LV_MATH_MIN(hi, scan_floor_div(shape->center.x + s - SCAN_HALF, LV_DRAW_SCAN_UNIT));
+        if(lo > hi) return false;
+
+        if(shape->type == LV_DRAW_SCAN_ARC) {
+            /*Out of the inner circle on the arc's side (where the row crosses the hole)*/
+            int64_t r_in = shape->radius_in - th;
+            int64_t rem_in = r_in * r_in - dy * dy;
+            if(r_in > 0 && rem_in > 0) {
+                int64_t s_in = lv_trigo_sqrt(rem_in);
+                if(s_in * s_in < rem_in) s_in++;
+                if(shape->side > 0) lo = LV_MATH_MAX(lo, scan_ceil_div(shape->center.x + s_in - SCAN_HALF, LV_DRAW_SCAN_UNIT));
+                else hi = LV_MATH_MIN(hi, scan_floor_div(shape->center.x - s_in - SCAN_HALF, LV_DRAW_SCAN_UNIT));
+            }
+
+            /*Between the start and the end*/
+            if(scan_range_edges(shape, y, th, &lo, &hi) == false) return false;
+        }
+    }
+
+    *x1 = lo;
+    *x2 = hi;
+    return true;
+}
+
+/**
+ * Limit the range of a row to the inner side of the edges of a shape
+ * @param shape pointer to a shape with edges
+ * @param y the center of the row in 1/256 pixels
+ * @param th the pixels whose center is at most 'th' out of the soft edges are in the range (see 'scan_range()')
+ * @param lo the first pixel of the range (updated)
+ * @param hi the last pixel of the range (updated)
+ * @return false: no pixels in the row
+ */
+static bool scan_range_edges(const lv_draw_scan_shape_t * shape, int32_t y, int32_t th, int64_t * lo, int64_t * hi)
+{
+    uint8_t i;
+    for(i = 0; i < shape->edge_cnt; i++) {
+        const lv_draw_scan_edge_t * edge = &shape->edges[i];
+        int32_t edge_th = edge->hard ? SCAN_HARD_OVERLAP : th;
+        /*The condition with the 'x' of the pixels: nx * 256 * x <= k*/
+        int64_t k = ((int64_t)edge_th << LV_DRAW_SCAN_NORM_SHIFT) + edge->c - (int64_t)edge->ny * y - (int64_t)edge->nx * SCAN_HALF;
+        bool incl = edge_th != 0 || edge->ny < 0 || (edge->ny == 0 && edge->nx < 0);
+        int64_t d = (int64_t)edge->nx << LV_DRAW_SCAN_SHIFT;
+
+        if(d > 0) {
+            int64_t lim = incl ? scan_floor_div(k, d) : scan_floor_div(k - 1, d);
+            if(lim < *hi) *hi = lim;
+        } else if(d < 0) {
+            int64_t lim = incl ? scan_ceil_div(-k, -d) : scan_floor_div(-k, -d) + 1;
+            if(lim > *lo) *lo = lim;
+        } else {
+            if(incl ? k < 0 : k <= 0) return false;
+        }
+        if(*lo > *hi) return false;
+    }
+
+    return true;
+}
+
+/**
+ * Get the coverage of a pixel by a shape from the distance of its center to the edge.
+ * The hard edges are ignored (the pixel is in the range of the shape).
+ * @param shape pointer to a shape
+ * @param x the center of the pixel in 1/256 pixels
+ * @param y the center of the pixel in 1/256 pixels
+ * @return the coverage (LV_OPA_TRANSP: not covered, LV_OPA_COVER: fully covered)
+ */
+static lv_opa_t scan_cover(const lv_draw_scan_shape_t * shape, int32_t x, int32_t y)
+{
+    int32_t dist;       /*Signed distance from the edge, negative inside*/
+
+    if(shape->type == LV_DRAW_SCAN_POLYGON) {
+        int64_t max = INT64_MIN;
+        uint8_t i;
+        for(i = 0; i < shape->edge_cnt; i++) {
+            const lv_draw_scan_edge_t * edge = &shape->edges[i];
+            if(edge->hard) continue;
+            int64_t v = (int64_t)edge->nx * x + (int64_t)edge->ny * y - edge->c;
+            if(v > max) max = v;
+        }
+        if(max == INT64_MIN) return LV_OPA_COVER;
+        dist = max >> LV_DRAW_SCAN_NORM_SHIFT;
+    } else {
+        int64_t dx = x - shape->center.x;
+        int64_t dy = y - shape->center.y;
+        int32_t d = lv_trigo_sqrt(dx * dx + dy * dy);
+        dist = d - shape->radius;
+
+        if(shape->type == LV_DRAW_SCAN_ARC) {
+            dist = LV_MATH_MAX(dist, shape->radius_in - d);
+            uint8_t i;
+            for(i = 0; i < shape->edge_cnt; i++) {
+                const lv_draw_scan_edge_t * edge = &shape->edges[i];
+                if(edge->hard) continue;
+                int32_t v = ((int64_t)edge->nx * x + (int64_t)edge->ny * y - edge->c) >> LV_DRAW_SCAN_NORM_SHIFT;
+                dist = LV_MATH_MAX(dist, v);
+            }
+        }
+    }
+
+    int32_t cover = SCAN_HALF - dist;
+    if(cover <= 0) return LV_OPA_TRANSP;
+    if(cover >= LV_OPA_COVER) return LV_OPA_COVER;
+    return cover;
+}
+
+/**
+ * Sort ranges and join the overlapping and adjacent ones
+ * @param ivs array of ranges
+ * @param iv_cnt number of ranges
+ * @return number of the joined ranges (at the beginning of 'ivs')
+ */
+static uint16_t scan_merge(scan_iv_t * ivs, uint16_t iv_cnt)
+{
+    if(iv_cnt < 2) return iv_cnt;
+
+    /*Insertion sort: there are only a few ranges in a row*/
+    uint16_t i;
+    for(i = 1; i < iv_cnt; i++) {
+        scan_iv_t tmp = ivs[i];
+        uint16_t j = i;
+        while(j > 0 && ivs[j - 1].x1 > tmp.x1) {
+            ivs[j] = ivs[j - 1];
+            j--;
+        }
+        ivs[j] = tmp;
+    }
+
+    uint16_t cnt = 1;
+    for(i = 1; i < iv_cnt; i++) {
+        if(ivs[i].x1 <= ivs[cnt - 1].x2 + 1) {
+            if(ivs[i].x2 > ivs[cnt - 1].x2) ivs[cnt - 1].x2 = ivs[i].x2;
+        } else {
+            ivs[cnt] = ivs[i];
+            cnt++;
+        }
+    }
+
+    return cnt;
+}
+
+/**
+ * Add a span of a general polygon to the coverage of a row
+ * @param x1 start of the span in 1/256 pixels
+ * @param x2 end of the span in 1/256 pixels (not included)
+ * @param scan_area the pixels out of this area are skipped
+ * @param aa true: add the horizontal coverage of the pixels to 'cell' and 'delta';
+ *           false: cover the pixels whose center is in the span
+ * @param cover the coverage of the row (indexed with 'x - scan_area->x1')
+ * @param cell the coverage of the partially covered pixels (indexed like 'cover')
+ * @param delta coverage added to every pixel from the index
+ * @param ivs add the range of the span here
+ * @param iv_cnt number of ranges in 'ivs' (incremented)
+ */
+static void scan_span(int32_t x1, int32_t x2, const lv_area_t * scan_area, bool aa, lv_opa_t * cover, int16_t * cell, int16_t * delta,
+                      scan_iv_t * ivs, uint16_t * iv_cnt)
+{
+    lv_coord_t px1;
+    lv_coord_t px2;
+
+    if(aa == false) {
+        px1 = LV_MATH_MAX(scan_ceil_div(x1 - SCAN_HALF, LV_DRAW_SCAN_UNIT), scan_area->x1);
+        px2 = LV_MATH_MIN(scan_ceil_div(x2 - SCAN_HALF, LV_DRAW_SCAN_UNIT) - 1, scan_area->x2);
+        if(px1 > px2) return;
+        memset(&cover[px1 - scan_area->x1], LV_OPA_COVER, px2 - px1 + 1);
+    } else {
+        x1 = LV_MATH_MAX(x1, (int32_t)scan_area->x1 << LV_DRAW_SCAN_SHIFT);
+        x2 = LV_MATH_MIN(x2, ((int32_t)scan_area->x2 + 1) << LV_DRAW_SCAN_SHIFT);
+        if(x1 >= x2) return;
+        px1 = scan_floor_div(x1, LV_DRAW_SCAN_UNIT);
+        px2 = scan_floor_div(x2 - 1, LV_DRAW_SCAN_UNIT);
+        lv_coord_t i1 = px1 - scan_area->x1;
+        lv_coord_t i2 = px2 - scan_area->x1;
+        if(px1 == px2) {
+            cell[i1] += x2 - x1;
+        } else {
+            cell[i1] += (((int32_t)px1 + 1) << LV_DRAW_SCAN_SHIFT) - x1;
+            cell[i2] += x2 - ((int32_t)px2 << LV_DRAW_SCAN_SHIFT);
+            delta[i1 + 1] += LV_DRAW_SCAN_UNIT;
+            delta[i2] -= LV_DRAW_SCAN_UNIT;
+        }
+    }
+
+    ivs[*iv_cnt].x1 = px1;
+    ivs[*iv_cnt].x2 = px2;
+    (*iv_cnt)++;
+}
+
+/**
+ * Collect the runs of a row and draw them, or join them to the previous rows if they are the same.
+ * The coverage of the row is cleared for the next row.
+ * @param rows pointer to the collected rows
+ * @param y the row
+ * @param cover the coverage of the pixels of the row (indexed with 'x - x_ofs')
+ * @param x_ofs the first x coordinate of 'cover'
+ * @param ivs sorted, not overlapping ranges of the row where 'cover' can be not LV_OPA_TRANSP
+ * @param iv_cnt number of ranges
+ * @param mask the runs are drawn only on this area
+ * @param color color of the shapes
+ * @param opa opacity of the shapes
+ * @param fill draw the runs with this function
+ */
+static void scan_row(scan_rows_t * rows, lv_coord_t y, lv_opa_t * cover, lv_coord_t x_ofs, const scan_iv_t * ivs, uint16_t iv_cnt,
+                     const lv_area_t * mask, lv_color_t color, lv_opa_t opa, lv_draw_scan_fill_t fill)
+{
+    scan_run_t cur[SCAN_RUN_MAX];
+    uint16_t cur_cnt = 0;
+    bool direct = false;        /*Too many runs: draw this row on its own*/
+    uint16_t k;
+    for(k = 0; k < iv_cnt; k++) {
+        lv_coord_t x = ivs[k].x1;
+        while(x <= ivs[k].x2) {
+            lv_opa_t c = cover[x - x_ofs];
+            lv_coord_t x_end = x + 1;
+            while(x_end <= ivs[k].x2 && cover[x_end - x_ofs] == c) x_end++;
+
+            if(c != LV_OPA_TRANSP) {
+                if(cur_cnt == SCAN_RUN_MAX) {
+                    if(direct == false) scan_flush(rows, mask, color, opa, fill);
+                    direct = true;
+                    memcpy(rows->runs, cur, sizeof(cur));
+                    rows->cnt = cur_cnt;
+                    rows->y1 = y;
+                    rows->y2 = y;
+                    scan_flush(rows, mask, color, opa, fill);
+                    cur_cnt = 0;
+                }
+                cur[cur_cnt].x1 = x;
+                cur[cur_cnt].x2 = x_end - 1;
+                cur[cur_cnt].opa = c;
+                cur_cnt++;
+            }
+            x = x_end;
+        }
+        memset(&cover[ivs[k].x1 - x_ofs], LV_OPA_TRANSP, ivs[k].x2 - ivs[k].x1 + 1);
+    }
+
+    /*Join the row to the previous rows if their runs are the same*/
+    bool same = false;
+    if(direct == false && rows->cnt == cur_cnt && rows->cnt != 0 && rows->y2 == y - 1) {
+        same = true;
+        for(k = 0; k < cur_cnt; k++) {
+            if(rows->runs[k].x1 != cur[k].x1 || rows->runs[k].x2 != cur[k].x2 || rows->runs[k].opa != cur[k].opa) {
+                same = false;
+                break;
+            }
+        }
+    }
+
+    if(same) {
+        rows->y2 = y;
+    } else {
+        scan_flush(rows, mask, color, opa, fill);
+        memcpy(rows->runs, cur, cur_cnt * sizeof(scan_run_t));
+        rows->cnt = cur_cnt;
+        rows->y1 = y;
+        rows->y2 = y;
+        if(direct) scan_flush(rows, mask, color, opa, fill);
+    }
+}
+
+/**
+ * Draw the collected rows and clear them
+ * @param rows pointer to the collected rows
+ * @param mask the runs are drawn only on this area
+ * @param color color of the shapes
+ * @param opa opacity of the shapes
+ * @param fill draw the runs with this function
+ */
+static void scan_flush(scan_rows_t * rows, const lv_area_t * mask, lv_color_t color, lv_opa_t opa, lv_draw_scan_fill_t fill)
+{
+    uint16_t i;
+    for(i = 0; i < rows->cnt; i++) {
+        const scan_run_t * run = &rows->runs[i];
+        lv_area_t area;
+        lv_area_set(&area, run->x1, rows->y1, run->x2, rows->y2);
+        if(run->opa == LV_OPA_COVER) fill(&area, mask, color, opa);
+        else fill(&area, mask, color, (uint16_t)((uint16_t)opa * run->opa) >> 8);
+    }
+
+    rows->cnt = 0;
+}
+
+/**
+ * Initialize an edge with its normal and a point on it
+ * @param edge pointer to an edge to initialize
+ * @param nx x of the outer normal (with 1 << LV_DRAW_SCAN_NORM_SHIFT length)
+ * @param ny y of the outer normal (with 1 << LV_DRAW_SCAN_NORM_SHIFT length)
+ * @param p a point of the edge in 1/256 pixels
+ * @param hard true: not anti-aliased edge
+ */
+static void scan_edge_init(lv_draw_scan_edge_t * edge, int64_t nx, int64_t ny, const lv_draw_scan_point_t * p, bool hard)
+{
+    edge->nx = nx;
+    edge->ny = ny;
+    edge->c = (int64_t)edge->nx * p->x + (int64_t)edge->ny * p->y;
+    edge->hard = hard ? 1 : 0;
+}
+
+/**
+ * Divide and round down
+ * @param a the dividend
+ * @param b the divisor (positive)
+ * @return the rounded down quotient
+ */
+static int64_t scan_floor_div(int64_t a, int64_t b)
+{
+    int64_t q = a / b;
+    if(a % b != 0 && a < 0) q--;
+    return q;
+}
+
+/**
+ * Divide and round up
+ * @param a the dividend
+ * @param b the divisor (positive)
+ * @return the rounded up quotient
+ */
+static int64_t scan_ceil_div(int64_t a, int64_t b)
+{
+    return -scan_floor_div(-a, b);
+}
@@ -0,0 +1,170 @@
+/**
+ * @file lv_draw_scan.h
+ *
+ */
+
+#ifndef LV_DRAW_SCAN_H
+#define LV_DRAW_SCAN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include "../lv_misc/lv_area.h"
+#include "../lv_misc/lv_color.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef LV_LINE_AA
+#define LV_LINE_AA              0
+#endif
+
+#ifndef LV_POLYGON_AA
+#define LV_POLYGON_AA           0
+#endif
+
+/*Anti-alias the edges of the lines analytically (without LV_ANTIALIAS the lines would be jagged)*/
+#define LV_DRAW_LINE_AA         (LV_ANTIALIAS == 0 && LV_LINE_AA != 0)
+
+/*Anti-alias the edges of the polygons from the coverage of sub-rows*/
+#define LV_DRAW_POLYGON_AA      (LV_ANTIALIAS == 0 && LV_POLYGON_AA != 0)
+
+/*The shapes are given in 1/256 pixels. The center of the pixel 'x' is 'x * 256 + 128'*/
+#define LV_DRAW_SCAN_SHIFT      8
+#define LV_DRAW_SCAN_UNIT       (1 << LV_DRAW_SCAN_SHIFT)
+
+/*Length of the unit normal vectors of the edges*/
+#define LV_DRAW_SCAN_NORM_SHIFT 14
+
+/*Max. number of edges of a convex polygon*/
+#define LV_DRAW_SCAN_EDGE_MAX   4
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Types of the shapes of the rasterizer*/
+typedef enum
+{
+    LV_DRAW_SCAN_POLYGON,       /*Convex polygon*/
+    LV_DRAW_SCAN_CIRCLE,
+    LV_DRAW_SCAN_ARC,           /*Piece of a ring in the left or in the right half of the circle*/
+}lv_draw_scan_type_t;
+
+/*A point in 1/256 pixels*/
+typedef struct
+{
+    int32_t x;
+    int32_t y;
+}lv_draw_scan_point_t;
+
+/*An edge of a convex polygon: the inside is where 'nx * x + ny * y <= c'.
+ * (nx, ny) is the outer normal with 1 << LV_DRAW_SCAN_NORM_SHIFT length*/
+typedef struct
+{
+    int16_t nx;
+    int16_t ny;
+    uint8_t hard :1;        /*1: not anti-aliased (an edge inside the union of the shapes)*/
+    int64_t c;
+}lv_draw_scan_edge_t;
+
+typedef struct
+{
+    uint8_t type;                                       /*From 'lv_draw_scan_type_t'*/
+    uint8_t edge_cnt;                                   /*LV_DRAW_SCAN_POLYGON/ARC: number of edges*/
+    int8_t side;                                        /*LV_DRAW_SCAN_ARC: 1: right half, -1: left half*/
+    lv_area_t box;                                      /*The pixels which might be covered*/
+    lv_draw_scan_edge_t edges[LV_DRAW_SCAN_EDGE_MAX];   /*LV_DRAW_SCAN_POLYGON: the edges, LV_DRAW_SCAN_ARC: the start and end*/
+    lv_draw_scan_point_t center;                        /*LV_DRAW_SCAN_CIRCLE/ARC: the center*/
+    int32_t radius;                                     /*LV_DRAW_SCAN_CIRCLE/ARC: the (outer) radius in 1/256 pixels*/
+    int32_t radius_in;                                  /*LV_DRAW_SCAN_ARC: the inner radius in 1/256 pixels*/
+}lv_draw_scan_shape_t;
+
+/*Draw a horizontal span of the result (like 'fill_fp' of the VDB)*/
+typedef void (*lv_draw_scan_fill_t)(const lv_area_t * coords, const lv_area_t * mask, lv_color_t color, lv_opa_t opa);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize a convex polygon shape
+ * @param shape pointer to a shape to initialize
+ * @param points the vertices in 1/256 pixels (clockwise or counter-clockwise order)
+ * @param point_num number of vertices (max. LV_DRAW_SCAN_EDGE_MAX)
+ * @param hard_edges bit 'i' set: the edge from 'points[i]' isn't anti-aliased because an other shape
+ *                   continues the shape there (the adjacent shapes would leave a visible seam)
+ */
+void lv_draw_scan_polygon(lv_draw_scan_shape_t * shape, const lv_draw_scan_point_t * points, uint8_t point_num, uint8_t hard_edges);
+
+/**
+ * Initialize a circle shape
+ * @param shape pointer to a shape to initialize
+ * @param center the center in 1/256 pixels
+ * @param radius the radius in 1/256 pixels
+ */
+void lv_draw_scan_circle(lv_draw_scan_shape_t * shape, const lv_draw_scan_point_t * center, int32_t radius);
+
+/**
+ * Initialize a piece of a ring. It has to be in the right (-90..90 degrees) or in the left (90..270 degrees) half.
+ * @param shape pointer to a shape to initialize
+ * @param center the center in 1/256 pixels
+ * @param radius_in the inner radius in 1/256 pixels
+ * @param radius_out the outer radius in 1/256 pixels
+ * @param start start angle in 1 / (1 << TRIGO_ANGLE_SHIFT) degrees (0 is on the right, it grows clockwise)
+ * @param end end angle in 1 / (1 << TRIGO_ANGLE_SHIFT) degrees (at most 180 degrees after 'start')
+ * @param hard_edges bit 0 set: the start isn't anti-aliased, bit 1 set: the end isn't anti-aliased
+ *                   (because an other shape continues the ring there)
+ */
+void lv_draw_scan_arc(lv_draw_scan_shape_t * shape, const lv_draw_scan_point_t * center, int32_t radius_in, int32_t radius_out,
+                      int32_t start, int32_t end, uint8_t hard_edges);
+
+/**
+ * Draw the union of shapes row by row. Every pixel is drawn once even if more shapes cover it.
+ * The equal rows are drawn with one 'fill' call.
+ * @param shapes array of shapes
+ * @param shape_num number of shapes
+ * @param mask the shapes will be drawn only on this area
+ * @param color color of the shapes
+ * @param opa opacity of the shapes
+ * @param aa true: draw the partially covered edge pixels with the ratio of their coverage;
+ *           false: draw the pixels whose center is in a shape
+ * @param fill draw the spans with this function
+ */
+void lv_draw_scan_fill(const lv_draw_scan_shape_t * shapes, uint16_t shape_num, const lv_area_t * mask,
+                       lv_color_t color, lv_opa_t opa, bool aa, lv_draw_scan_fill_t fill);
+
+/**
+ * Draw a general (also concave or self-intersecting) polygon row by row.
+ * The crossings of the rows and the edges are got from an edge table sorted by the top of the edges.
+ * The equal rows are drawn with one 'fill' call.
+ * @param points the vertices in 1/256 pixels (the last vertex is connected to the first one)
+ * @param point_num number of vertices
+ * @param even_odd true: a pixel is in the polygon if a ray from it crosses the edges odd times;
+ *                 false: a pixel is in the polygon if the edges wind around it not zero times (nonzero rule)
+ * @param mask the polygon will be drawn only on this area
+ * @param color color of the polygon
+ * @param opa opacity of the polygon
+ * @param aa true: draw the partially covered edge pixels with the ratio of their coverage;
+ *           false: draw the pixels whose center is in the polygon
+ * @param fill draw the spans with this function
+ */
+void lv_draw_scan_fill_polygon(const lv_draw_scan_point_t * points, uint16_t point_num, bool even_odd, const lv_area_t * mask,
+                               lv_color_t color, lv_opa_t opa, bool aa, lv_draw_scan_fill_t fill);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  /*LV_DRAW_SCAN_H*/
@@ -0,0 +1,1278 @@
+/**
+ * @file lv_draw_simd.c
+ * Drawing kernels with SIMD implementations selected at runtime by the CPU features
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_simd.h"
+#include <string.h>
+
+#if USE_LV_SIMD && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LV_SIMD_X86     1
+#include <immintrin.h>
+#else
+#define LV_SIMD_X86     0
+#endif
+
+/*NEON is used if the compiler targets a CPU with NEON (always true on AArch64)*/
+#if USE_LV_SIMD && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define LV_SIMD_ARM     1
+#include <arm_neon.h>
+#else
+#define LV_SIMD_ARM     0
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+/*The kernels are written for 16 bit (RGB565) and 24 bit (stored on 32 bit) colors*/
+#define LV_SIMD_COLOR   (LV_COLOR_DEPTH == 16 || LV_COLOR_DEPTH == 24)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef void (*lv_simd_fill_f)(lv_color_t * dest, uint32_t length, lv_color_t color);
+typedef void (*lv_simd_fill_opa_f)(lv_color_t * dest, uint32_t length, lv_color_t color, lv_opa_t opa);
+typedef void (*lv_simd_blend_f)(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa);
+typedef void (*lv_simd_blend_key_f)(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa, lv_color_t key);
+typedef void (*lv_simd_blend_alpha_f)(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * alpha, uint32_t length,
+                                      lv_opa_t opa, lv_color_t recolor, lv_opa_t recolor_opa);
+typedef void (*lv_simd_aa_row_f)(lv_color_t * out, const lv_color_t * in1, const lv_color_t * in2, uint32_t out_w);
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void fill_c(lv_color_t * dest, uint32_t length, lv_color_t color);
+static void fill_opa_c(lv_color_t * dest, uint32_t length, lv_color_t color, lv_opa_t opa);
+static void blend_c(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa);
+static void blend_key_c(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa, lv_color_t key);
+static void blend_alpha_c(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * alpha, uint32_t length,
+                          lv_opa_t opa, lv_color_t recolor, lv_opa_t recolor_opa);
+#if LV_SIMD_X86 && LV_SIMD_COLOR
+static void fill_sse2(lv_color_t * dest, uint32_t length, lv_color_t color);
+static void fill_opa_sse2(lv_color_t * dest, uint32_t length, lv_color_t color, lv_opa_t opa);
+static void blend_sse2(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa);
+static void blend_key_sse2(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa, lv_color_t key);
+static void blend_alpha_sse2(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * alpha, uint32_t length,
+                             lv_opa_t opa, lv_color_t recolor, lv_opa_t recolor_opa);
+static void fill_avx2(lv_color_t * dest, uint32_t length, lv_color_t color);
+static void fill_opa_avx2(lv_color_t * dest, uint32_t length, lv_color_t color, lv_opa_t opa);
+static void blend_avx2(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa);
+static void blend_key_avx2(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa, lv_color_t key);
+static void blend_alpha_avx2(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * alpha, uint32_t length,
+                             lv_opa_t opa, lv_color_t recolor, lv_opa_t recolor_opa);
+#endif
+#if LV_SIMD_ARM && LV_SIMD_COLOR
+static void fill_neon(lv_color_t * dest, uint32_t length, lv_color_t color);
+static void fill_opa_neon(lv_color_t * dest, uint32_t length, lv_color_t color, lv_opa_t opa);
+static void blend_neon(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa);
+static void blend_key_neon(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa, lv_color_t key);
+static void blend_alpha_neon(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * alpha, uint32_t length,
+                             lv_opa_t opa, lv_color_t recolor, lv_opa_t recolor_opa);
+#endif
+#if LV_ANTIALIAS != 0
+static void aa_row_c(lv_color_t * out, const lv_color_t * in1, const lv_color_t * in2, uint32_t out_w);
+#if LV_SIMD_X86 && LV_SIMD_COLOR
+static void aa_row_sse2(lv_color_t * out, const lv_color_t * in1, const lv_color_t * in2, uint32_t out_w);
+static void aa_row_avx2(lv_color_t * out, const lv_color_t * in1, const lv_color_t * in2, uint32_t out_w);
+#endif
+#if LV_SIMD_ARM && LV_SIMD_COLOR
+static void aa_row_neon(lv_color_t * out, const lv_color_t * in1, const lv_color_t * in2, uint32_t out_w);
+#endif
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static uint8_t features = LV_SIMD_NONE;
+static lv_simd_fill_f fill_fp = fill_c;
+static lv_simd_fill_opa_f fill_opa_fp = fill_opa_c;
+static lv_simd_blend_f blend_fp = blend_c;
+static lv_simd_blend_key_f blend_key_fp = blend_key_c;
+static lv_simd_blend_alpha_f blend_alpha_fp = blend_alpha_c;
+#if LV_ANTIALIAS != 0
+static lv_simd_aa_row_f aa_row_fp = aa_row_c;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Detect the features of the CPU and select the fastest drawing kernels.
+ * Called by 'lv_init()'. Until it the portable C kernels are used.
+ */
+void lv_simd_init(void)
+{
+    features = LV_SIMD_NONE;
+
+#if LV_SIMD_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("sse2")) features |= LV_SIMD_SSE2;
+    if(__builtin_cpu_supports("avx2")) features |= LV_SIMD_AVX2;
+#endif
+
+#if LV_SIMD_ARM
+    features |= LV_SIMD_NEON;
+#endif
+
+    fill_fp = fill_c;
+    fill_opa_fp = fill_opa_c;
+    blend_fp = blend_c;
+    blend_key_fp = blend_key_c;
+    blend_alpha_fp = blend_alpha_c;
+#if LV_SIMD_X86 && LV_SIMD_COLOR
+    if(features & LV_SIMD_AVX2) {
+        fill_fp = fill_avx2;
+        fill_opa_fp = fill_opa_avx2;
+        blend_fp = blend_avx2;
+        blend_key_fp = blend_key_avx2;
+        blend_alpha_fp = blend_alpha_avx2;
+    } else if(features & LV_SIMD_SSE2) {
+        fill_fp = fill_sse2;
+        fill_opa_fp = fill_opa_sse2;
+        blend_fp = blend_sse2;
+        blend_key_fp = blend_key_sse2;
+        blend_alpha_fp = blend_alpha_sse2;
+    }
+#endif
+#if LV_SIMD_ARM && LV_SIMD_COLOR
+    if(features & LV_SIMD_NEON) {
+        fill_fp = fill_neon;
+        fill_opa_fp = fill_opa_neon;
+        blend_fp = blend_neon;
+        blend_key_fp = blend_key_neon;
+        blend_alpha_fp = blend_alpha_neon;
+    }
+#endif
+
+#if LV_ANTIALIAS != 0
+    aa_row_fp = aa_row_c;
+#if LV_SIMD_X86 && LV_SIMD_COLOR
+    if(features & LV_SIMD_AVX2) aa_row_fp = aa_row_avx2;
+    else if(features & LV_SIMD_SSE2) aa_row_fp = aa_row_sse2;
+#endif
+#if LV_SIMD_ARM && LV_SIMD_COLOR
+    if(features & LV_SIMD_NEON) aa_row_fp = aa_row_neon;
+#endif
+#endif
+}
+
+/**
+ * Get the CPU features used by the drawing kernels
+ * @return OR-ed values of 'lv_simd_feature_t' (LV_SIMD_NONE if 'USE_LV_SIMD' is 0)
+ */
+uint8_t lv_simd_get_features(void)
+{
+    return features;
+}
+
+/**
+ * Fill a row of pixels with a color
+ * @param dest pointer to the first pixel
+ * @param length number of pixels
+ * @param color fill color
+ */
+void lv_simd_fill(lv_color_t * dest, uint32_t length, lv_color_t color)
+{
+    fill_fp(dest, length, color);
+}
+
+/**
+ * Mix a color to a row of pixels (like 'lv_color_mix(color, dest[i], opa)')
+ * @param dest pointer to the first pixel
+ * @param length number of pixels
+ * @param color fill color
+ * @param opa opacity of the color
+ */
+void lv_simd_fill_opa(lv_color_t * dest, uint32_t length, lv_color_t color, lv_opa_t opa)
+{
+    fill_opa_fp(dest, length, color, opa);
+}
+
+/**
+ * Copy or blend pixels to a row of pixels (like 'lv_color_mix(src[i], dest[i], opa)')
+ * @param dest pointer to the first destination pixel
+ * @param src pointer to the first source pixel
+ * @param length number of pixels
+ * @param opa opacity of 'src' (LV_OPA_COVER: copy)
+ */
+void lv_simd_blend(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa)
+{
+    /*'memcpy' of the C library is already vectorized*/
+    if(opa == LV_OPA_COVER) memcpy(dest, src, length * sizeof(lv_color_t));
+    else blend_fp(dest, src, length, opa);
+}
+
+/**
+ * Copy or blend pixels to a row of pixels except the pixels with 'key' color (chroma keying)
+ * @param dest pointer to the first destination pixel
+ * @param src pointer to the first source pixel
+ * @param length number of pixels
+ * @param opa opacity of 'src' (LV_OPA_COVER: copy)
+ * @param key the 'src' pixels with this color are not drawn (e.g. LV_COLOR_TRANSP)
+ */
+void lv_simd_blend_key(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa, lv_color_t key)
+{
+    blend_key_fp(dest, src, length, opa, key);
+}
+
+/**
+ * Blend pixels with their own opacity to a row of pixels and recolor them in the same pass
+ * (like 'lv_color_mix(lv_color_mix(recolor, src[i], recolor_opa), dest[i], alpha[i] * opa / 255)'
+ * but the fully opaque pixels are copied and the fully transparent pixels are skipped)
+ * @param dest pointer to the first destination pixel
+ * @param src pointer to the first source pixel
+ * @param alpha pointer to the opacity of the first source pixel
+ * @param length number of pixels
+ * @param opa opacity of the whole 'src' (LV_OPA_COVER: use only 'alpha')
+ * @param recolor mix the source pixels with this color
+ * @param recolor_opa the intense of recoloring (LV_OPA_TRANSP: no recolor)
+ */
+void lv_simd_blend_alpha(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * alpha, uint32_t length,
+                         lv_opa_t opa, lv_color_t recolor, lv_opa_t recolor_opa)
+{
+    blend_alpha_fp(dest, src, alpha, length, opa, recolor, recolor_opa);
+}
+
+#if LV_ANTIALIAS != 0
+/**
+ * Downscale two rows of an anti-aliased VDB to one row: get the average of every 2x2 pixels.
+ * The result is bit-exact with every kernel.
+ * 'out' can be the same as 'in1' or can be before it (the VDB is filtered in place)
+ * @param out store the result here ('out_w' pixels)
+ * @param in1 pointer to the first row ('2 * out_w' pixels)
+ * @param in2 pointer to the second row ('2 * out_w' pixels)
+ * @param out_w number of result pixels
+ */
+void lv_simd_aa_row(lv_color_t * out, const lv_color_t * in1, const lv_color_t * in2, uint32_t out_w)
+{
+    aa_row_fp(out, in1, in2, out_w);
+}
+#endif
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Portable fill. The SIMD kernels use it for the last pixels of the rows.
+ * @param dest pointer to the first pixel
+ * @param length number of pixels
+ * @param color fill color
+ */
+static void fill_c(lv_color_t * dest, uint32_t length, lv_color_t color)
+{
+    uint32_t i;
+    for(i = 0; i < length; i++) {
+        dest[i] = color;
+    }
+}
+
+/**
+ * Portable opacity fill
+ * @param dest pointer to the first pixel
+ * @param length number of pixels
+ * @param color fill color
+ * @param opa opacity of the color
+ */
+static void fill_opa_c(lv_color_t * dest, uint32_t length, lv_color_t color, lv_opa_t opa)
+{
+    lv_color_t bg_tmp = LV_COLOR_BLACK;
+    lv_color_t opa_tmp = lv_color_mix(color, bg_tmp, opa);
+    uint32_t i;
+    for(i = 0; i < length; i++) {
+        /*If the bg color changed recalculate the result color*/
+        if(dest[i].full != bg_tmp.full) {
+            bg_tmp = dest[i];
+            opa_tmp = lv_color_mix(color, bg_tmp, opa);
+        }
+        dest[i] = opa_tmp;
+    }
+}
+
+/**
+ * Portable blend with opacity
+ * @param dest pointer to the first destination pixel
+ * @param src pointer to the first source pixel
+ * @param length number of pixels
+ * @param opa opacity of 'src'
+ */
+static void blend_c(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa)
+{
+    uint32_t i;
+    for(i = 0; i < length; i++) {
+        dest[i] = lv_color_mix(src[i], dest[i], opa);
+    }
+}
+
+/**
+ * Portable chroma keyed copy or blend
+ * @param dest pointer to the first destination pixel
+ * @param src pointer to the first source pixel
+ * @param length number of pixels
+ * @param opa opacity of 'src' (LV_OPA_COVER: copy)
+ * @param key the 'src' pixels with this color are not drawn
+ */
+static void blend_key_c(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa, lv_color_t key)
+{
+    uint32_t i;
+    if(opa == LV_OPA_COVER) {
+        for(i = 0; i < length; i++) {
+            if(src[i].full != key.full) dest[i] = src[i];
+        }
+    } else {
+        for(i = 0; i < length; i++) {
+            if(src[i].full != key.full) dest[i] = lv_color_mix(src[i], dest[i], opa);
+        }
+    }
+}
+
+/**
+ * Portable blend with per-pixel opacity and recoloring
+ * @param dest pointer to the first destination pixel
+ * @param src pointer to the first source pixel
+ * @param alpha pointer to the opacity of the first source pixel
+ * @param length number of pixels
+ * @param opa opacity of the whole 'src'
+ * @param recolor mix the source pixels with this color
+ * @param recolor_opa the intense of recoloring (LV_OPA_TRANSP: no recolor)
+ */
+static void blend_alpha_c(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * alpha, uint32_t length,
+                          lv_opa_t opa, lv_color_t recolor, lv_opa_t recolor_opa)
+{
+    uint32_t i;
+    for(i = 0; i < length; i++) {
+        /*'alpha * opa / 255' without division: exact for 0 and 255*/
+        lv_opa_t a = ((uint16_t)alpha[i] * opa + 255) >> 8;
+        if(a == LV_OPA_TRANSP) continue;
+
+        lv_color_t c = src[i];
+        if(recolor_opa != LV_OPA_TRANSP) c = lv_color_mix(recolor, c, recolor_opa);
+
+        if(a == LV_OPA_COVER) dest[i] = c;
+        else dest[i] = lv_color_mix(c, dest[i], a);
+    }
+}
+
+/* The SIMD versions of 'lv_color_mix' calculate with the same formula on 16 bit lanes:
+ * (fg * mix + bg * (255 - mix)) >> 8 for every channel.
+ * They mix the unused byte of 24 bit colors too ('lv_color_mix' leaves it undefined)*/
+
+#if LV_SIMD_X86 && LV_SIMD_COLOR
+/**
+ * Mix 8 (16 bit) or 4 (24 bit) colors with SSE2
+ * @param fg foreground colors
+ * @param bg background colors
+ * @param mix opacity of 'fg' in every 16 bit lane
+ * @param mix_inv 255 - 'mix' in every 16 bit lane
+ * @return the mixed colors
+ */
+__attribute__((target("sse2")))
+static inline __m128i mix_sse2(__m128i fg, __m128i bg, __m128i mix, __m128i mix_inv)
+{
+#if LV_COLOR_DEPTH == 16
+    const __m128i m5 = _mm_set1_epi16(0x1F);
+    const __m128i m6 = _mm_set1_epi16(0x3F);
+    __m128i r = _mm_add_epi16(_mm_mullo_epi16(_mm_srli_epi16(fg, 11), mix),
+                              _mm_mullo_epi16(_mm_srli_epi16(bg, 11), mix_inv));
+    __m128i g = _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(fg, 5), m6), mix),
+                              _mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(bg, 5), m6), mix_inv));
+    __m128i b = _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(fg, m5), mix),
+                              _mm_mullo_epi16(_mm_and_si128(bg, m5), mix_inv));
+    r = _mm_slli_epi16(_mm_srli_epi16(r, 8), 11);
+    g = _mm_slli_epi16(_mm_srli_epi16(g, 8), 5);
+    b = _mm_srli_epi16(b, 8);
+    return _mm_or_si128(_mm_or_si128(r, g), b);
+#else
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(fg, zero), mix),
+                               _mm_mullo_epi16(_mm_unpacklo_epi8(bg, zero), mix_inv));
+    __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(fg, zero), mix),
+                               _mm_mullo_epi16(_mm_unpackhi_epi8(bg, zero), mix_inv));
+    return _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+#endif
+}
+
+/**
+ * Set every pixel of an SSE2 register to a color
+ * @param color a color
+ * @return the register
+ */
+__attribute__((target("sse2")))
+static inline __m128i color_sse2(lv_color_t color)
+{
+#if LV_COLOR_DEPTH == 16
+    return _mm_set1_epi16((short)color.full);
+#else
+    return _mm_set1_epi32((int)color.full);
+#endif
+}
+
+/*Number of pixels in an SSE2 register*/
+#define PX_SSE2     (16 / sizeof(lv_color_t))
+
+/**
+ * Fill with SSE2
+ * @param dest pointer to the first pixel
+ * @param length number of pixels
+ * @param color fill color
+ */
+__attribute__((target("sse2")))
+static void fill_sse2(lv_color_t * dest, uint32_t length, lv_color_t color)
+{
+    __m128i c = color_sse2(color);
+    uint32_t i;
+    for(i = 0; i + PX_SSE2 <= length; i += PX_SSE2) {
+        _mm_storeu_si128((__m128i *)&dest[i], c);
+    }
+    fill_c(&dest[i], length - i, color);
+}
+
+/**
+ * Opacity fill with SSE2
+ * @param dest pointer to the first pixel
+ * @param length number of pixels
+ * @param color fill color
+ * @param opa opacity of the color
+ */
+__attribute__((target("sse2")))
+static void fill_opa_sse2(lv_color_t * dest, uint32_t length, lv_color_t color, lv_opa_t opa)
+{
+    __m128i c = color_sse2(color);
+    __m128i mix = _mm_set1_epi16(opa);
+    __m128i mix_inv = _mm_set1_epi16(255 - opa);
+    uint32_t i;
+    for(i = 0; i + PX_SSE2 <= length; i += PX_SSE2) {
+        __m128i d = _mm_loadu_si128((const __m128i *)&dest[i]);
+        _mm_storeu_si128((__m128i *)&dest[i], mix_sse2(c, d, mix, mix_inv));
+    }
+    fill_opa_c(&dest[i], length - i, color, opa);
+}
+
+/**
+ * Blend with opacity with SSE2
+ * @param dest pointer to the first destination pixel
+ * @param src pointer to the first source pixel
+ * @param length number of pixels
+ * @param opa opacity of 'src'
+ */
+__attribute__((target("sse2")))
+static void blend_sse2(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa)
+{
+    __m128i mix = _mm_set1_epi16(opa);
+    __m128i mix_inv = _mm_set1_epi16(255 - opa);
+    uint32_t i;
+    for(i = 0; i + PX_SSE2 <= length; i += PX_SSE2) {
+        __m128i s = _mm_loadu_si128((const __m128i *)&src[i]);
+        __m128i d = _mm_loadu_si128((const __m128i *)&dest[i]);
+        _mm_storeu_si128((__m128i *)&dest[i], mix_sse2(s, d, mix, mix_inv));
+    }
+    blend_c(&dest[i], &src[i], length - i, opa);
+}
+
+/**
+ * Chroma keyed copy or blend with SSE2
+ * @param dest pointer to the first destination pixel
+ * @param src pointer to the first source pixel
+ * @param length number of pixels
+ * @param opa opacity of 'src' (LV_OPA_COVER: copy)
+ * @param key the 'src' pixels with this color are not drawn
+ */
+__attribute__((target("sse2")))
+static void blend_key_sse2(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa, lv_color_t key)
+{
+    __m128i k = color_sse2(key);
+    __m128i mix = _mm_set1_epi16(opa);
+    __m128i mix_inv = _mm_set1_epi16(255 - opa);
+    uint32_t i;
+    for(i = 0; i + PX_SSE2 <= length; i += PX_SSE2) {
+        __m128i s = _mm_loadu_si128((const __m128i *)&src[i]);
+        __m128i d = _mm_loadu_si128((const __m128i *)&dest[i]);
+#if LV_COLOR_DEPTH == 16
+        __m128i keep = _mm_cmpeq_epi16(s, k);
+#else
+        __m128i keep = _mm_cmpeq_epi32(s, k);
+#endif
+        __m128i res = opa == LV_OPA_COVER ? s : mix_sse2(s, d, mix, mix_inv);
+        res = _mm_or_si128(_mm_and_si128(keep, d), _mm_andnot_si128(keep, res));
+        _mm_storeu_si128((__m128i *)&dest[i], res);
+    }
+    blend_key_c(&dest[i], &src[i], length - i, opa, key);
+}
+
+/**
+ * Mix 8 (16 bit) or 4 (24 bit) colors with their own opacity with SSE2
+ * @param fg foreground colors
+ * @param bg background colors
+ * @param a opacity of the 'fg' pixels in 16 bit (16 bit colors) or 32 bit (24 bit colors) lanes
+ * @return the mixed colors
+ */
+__attribute__((target("sse2")))
+static inline __m128i mix_alpha_sse2(__m128i fg, __m128i bg, __m128i a)
+{
+#if LV_COLOR_DEPTH == 16
+    return mix_sse2(fg, bg, a, _mm_sub_epi16(_mm_set1_epi16(255), a));
+#else
+    /*The opacity of a pixel for its 4 channels in the 16 bit lanes of the unpacked pixels*/
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(255);
+    __m128i a2 = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+    __m128i mix_lo = _mm_unpacklo_epi32(a2, a2);
+    __m128i mix_hi = _mm_unpackhi_epi32(a2, a2);
+    __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(fg, zero), mix_lo),
+                               _mm_mullo_epi16(_mm_unpacklo_epi8(bg, zero), _mm_sub_epi16(full, mix_lo)));
+    __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(fg, zero), mix_hi),
+                               _mm_mullo_epi16(_mm_unpackhi_epi8(bg, zero), _mm_sub_epi16(full, mix_hi)));
+    return _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+#endif
+}
+
+/**
+ * Blend with per-pixel opacity and recoloring with SSE2
+ * @param dest pointer to the first destination pixel
+ * @param src pointer to the first source pixel
+ * @param alpha pointer to the opacity of the first source pixel
+ * @param length number of pixels
+ * @param opa opacity of the whole 'src'
+ * @param recolor mix the source pixels with this color
+ * @param recolor_opa the intense of recoloring (LV_OPA_TRANSP: no recolor)
+ */
+__attribute__((target("sse2")))
+static void blend_alpha_sse2(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * alpha, uint32_t length,
+                             lv_opa_t opa, lv_color_t recolor, lv_opa_t recolor_opa)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i rc = color_sse2(recolor);
+    __m128i rmix = _mm_set1_epi16(recolor_opa);
+    __m128i rmix_inv = _mm_set1_epi16(255 - recolor_opa);
+#if LV_COLOR_DEPTH == 16
+    __m128i full = _mm_set1_epi16(255);
+#else
+    __m128i full = _mm_set1_epi32(255);
+#endif
+    __m128i opa_v = _mm_set1_epi16(opa);
+    uint32_t i;
+    for(i = 0; i + PX_SSE2 <= length; i += PX_SSE2) {
+        __m128i s = _mm_loadu_si128((const __m128i *)&src[i]);
+        __m128i d = _mm_loadu_si128((const __m128i *)&dest[i]);
+        if(recolor_opa != LV_OPA_TRANSP) s = mix_sse2(rc, s, rmix, rmix_inv);
+
+        /*'alpha * opa / 255' like the portable kernel: (alpha * opa + 255) >> 8*/
+#if LV_COLOR_DEPTH == 16
+        __m128i a = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&alpha[i]), zero);
+        a = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(a, opa_v), full), 8);
+        __m128i cover = _mm_cmpeq_epi16(a, full);
+        __m128i transp = _mm_cmpeq_epi16(a, zero);
+#else
+        int32_t a4;
+        memcpy(&a4, &alpha[i], sizeof(a4));
+        __m128i a = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(a4), zero), zero);
+        a = _mm_srli_epi32(_mm_add_epi32(_mm_mullo_epi16(a, opa_v), full), 8);
+        __m128i cover = _mm_cmpeq_epi32(a, full);
+        __m128i transp = _mm_cmpeq_epi32(a, zero);
+#endif
+        __m128i res = mix_alpha_sse2(s, d, a);
+        res = _mm_or_si128(_mm_and_si128(cover, s), _mm_andnot_si128(cover, res));
+        res = _mm_or_si128(_mm_and_si128(transp, d), _mm_andnot_si128(transp, res));
+        _mm_storeu_si128((__m128i *)&dest[i], res);
+    }
+    blend_alpha_c(&dest[i], &src[i], &alpha[i], length - i, opa, recolor, recolor_opa);
+}
+
+/**
+ * Mix 16 (16 bit) or 8 (24 bit) colors with AVX2
+ * @param fg foreground colors
+ * @param bg background colors
+ * @param mix opacity of 'fg' in every 16 bit lane
+ * @param mix_inv 255 - 'mix' in every 16 bit lane
+ * @return the mixed colors
+ */
+__attribute__((target("avx2")))
+static inline __m256i mix_avx2(__m256i fg, __m256i bg, __m256i mix, __m256i mix_inv)
+{
+#if LV_COLOR_DEPTH == 16
+    const __m256i m5 = _mm256_set1_epi16(0x1F);
+    const __m256i m6 = _mm256_set1_epi16(0x3F);
+    __m256i r = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_srli_epi16(fg, 11), mix),
+                                 _mm256_mullo_epi16(_mm256_srli_epi16(bg, 11), mix_inv));
+    __m256i g = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi16(fg, 5), m6), mix),
+                                 _mm256_mullo_epi16(_mm256_and_si256(_mm256_srli_epi16(bg, 5), m6), mix_inv));
+    __m256i b = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_and_si256(fg, m5), mix),
+                                 _mm256_mullo_epi16(_mm256_and_si256(bg, m5), mix_inv));
+    r = _mm256_slli_epi16(_mm256_srli_epi16(r, 8), 11);
+    g = _mm256_slli_epi16(_mm256_srli_epi16(g, 8), 5);
+    b = _mm256_srli_epi16(b, 8);
+    return _mm256_or_si256(_mm256_or_si256(r, g), b);
+#else
+    /*The unpack and pack instructions work in the same 128 bit lanes so the order is kept*/
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(fg, zero), mix),
+                                  _mm256_mullo_epi16(_mm256_unpacklo_epi8(bg, zero), mix_inv));
+    __m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(fg, zero), mix),
+                                  _mm256_mullo_epi16(_mm256_unpackhi_epi8(bg, zero), mix_inv));
+    return _mm256_packus_epi16(_mm256_srli_epi16(lo, 8), _mm256_srli_epi16(hi, 8));
+#endif
+}
+
+/**
+ * Set every pixel of an AVX2 register to a color
+ * @param color a color
+ * @return the register
+ */
+__attribute__((target("avx2")))
+static inline __m256i color_avx2(lv_color_t color)
+{
+#if LV_COLOR_DEPTH == 16
+    return _mm256_set1_epi16((short)color.full);
+#else
+    return _mm256_set1_epi32((int)color.full);
+#endif
+}
+
+/*Number of pixels in an AVX2 register*/
+#define PX_AVX2     (32 / sizeof(lv_color_t))
+
+/**
+ * Fill with AVX2
+ * @param dest pointer to the first pixel
+ * @param length number of pixels
+ * @param color fill color
+ */
+__attribute__((target("avx2")))
+static void fill_avx2(lv_color_t * dest, uint32_t length, lv_color_t color)
+{
+    __m256i c = color_avx2(color);
+    uint32_t i;
+    for(i = 0; i + PX_AVX2 <= length; i += PX_AVX2) {
+        _mm256_storeu_si256((__m256i *)&dest[i], c);
+    }
+    fill_c(&dest[i], length - i, color);
+}
+
+/**
+ * Opacity fill with AVX2
+ * @param dest pointer to the first pixel
+ * @param length number of pixels
+ * @param color fill color
+ * @param opa opacity of the color
+ */
+__attribute__((target("avx2")))
+static void fill_opa_avx2(lv_color_t * dest, uint32_t length, lv_color_t color, lv_opa_t opa)
+{
+    __m256i c = color_avx2(color);
+    __m256i mix = _mm256_set1_epi16(opa);
+    __m256i mix_inv = _mm256_set1_epi16(255 - opa);
+    uint32_t i;
+    for(i = 0; i + PX_AVX2 <= length; i += PX_AVX2) {
+        __m256i d = _mm256_loadu_si256((const __m256i *)&dest[i]);
+        _mm256_storeu_si256((__m256i *)&dest[i], mix_avx2(c, d, mix, mix_inv));
+    }
+    fill_opa_c(&dest[i], length - i, color, opa);
+}
+
+/**
+ * Blend with opacity with AVX2
+ * @param dest pointer to the first destination pixel
+ * @param src pointer to the first source pixel
+ * @param length number of pixels
+ * @param opa opacity of 'src'
+ */
+__attribute__((target("avx2")))
+static void blend_avx2(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa)
+{
+    __m256i mix = _mm256_set1_epi16(opa);
+    __m256i mix_inv = _mm256_set1_epi16(255 - opa);
+    uint32_t i;
+    for(i = 0; i + PX_AVX2 <= length; i += PX_AVX2) {
+        __m256i s = _mm256_loadu_si256((const __m256i *)&src[i]);
+        __m256i d = _mm256_loadu_si256((const __m256i *)&dest[i]);
+        _mm256_storeu_si256((__m256i *)&dest[i], mix_avx2(s, d, mix, mix_inv));
+    }
+    blend_c(&dest[i], &src[i], length - i, opa);
+}
+
+/**
+ * Chroma keyed copy or blend with AVX2
+ * @param dest pointer to the first destination pixel
+ * @param src pointer to the first source pixel
+ * @param length number of pixels
+ * @param opa opacity of 'src' (LV_OPA_COVER: copy)
+ * @param key the 'src' pixels with this color are not drawn
+ */
+__attribute__((target("avx2")))
+static void blend_key_avx2(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa, lv_color_t key)
+{
+    __m256i k = color_avx2(key);
+    __m256i mix = _mm256_set1_epi16(opa);
+    __m256i mix_inv = _mm256_set1_epi16(255 - opa);
+    uint32_t i;
+    for(i = 0; i + PX_AVX2 <= length; i += PX_AVX2) {
+        __m256i s = _mm256_loadu_si256((const __m256i *)&src[i]);
+        __m256i d = _mm256_loadu_si256((const __m256i *)&dest[i]);
+#if LV_COLOR_DEPTH == 16
+        __m256i keep = _mm256_cmpeq_epi16(s, k);
+#else
+        __m256i keep = _mm256_cmpeq_epi32(s, k);
+#endif
+        __m256i res = opa == LV_OPA_COVER ? s : mix_avx2(s, d, mix, mix_inv);
+        _mm256_storeu_si256((__m256i *)&dest[i], _mm256_blendv_epi8(res, d, keep));
+    }
+    blend_key_c(&dest[i], &src[i], length - i, opa, key);
+}
+
+/**
+ * Mix 16 (16 bit) or 8 (24 bit) colors with their own opacity with AVX2
+ * @param fg foreground colors
+ * @param bg background colors
+ * @param a opacity of the 'fg' pixels in 16 bit (16 bit colors) or 32 bit (24 bit colors) lanes
+ * @return the mixed colors
+ */
+__attribute__((target("avx2")))
+static inline __m256i mix_alpha_avx2(__m256i fg, __m256i bg, __m256i a)
+{
+#if LV_COLOR_DEPTH == 16
+    return mix_avx2(fg, bg, a, _mm256_sub_epi16(_mm256_set1_epi16(255), a));
+#else
+    /*The opacity of a pixel for its 4 channels in the 16 bit lanes of the unpacked pixels.
+     *The unpack instructions work in the same 128 bit lanes so the order is kept*/
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i full = _mm256_set1_epi16(255);
+    __m256i a2 = _mm256_or_si256(a, _mm256_slli_epi32(a, 16));
+    __m256i mix_lo = _mm256_unpacklo_epi32(a2, a2);
+    __m256i mix_hi = _mm256_unpackhi_epi32(a2, a2);
+    __m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(fg, zero), mix_lo),
+                                  _mm256_mullo_epi16(_mm256_unpacklo_epi8(bg, zero), _mm256_sub_epi16(full, mix_lo)));
+    __m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(fg, zero), mix_hi),
+                                  _mm256_mullo_epi16(_mm256_unpackhi_epi8(bg, zero), _mm256_sub_epi16(full, mix_hi)));
+    return _mm256_packus_epi16(_mm256_srli_epi16(lo, 8), _mm256_srli_epi16(hi, 8));
+#endif
+}
+
+/**
+ * Blend with per-pixel opacity and recoloring with AVX2
+ * @param dest pointer to the first destination pixel
+ * @param src pointer to the first source pixel
+ * @param alpha pointer to the opacity of the first source pixel
+ * @param length number of pixels
+ * @param opa opacity of the whole 'src'
+ * @param recolor mix the source pixels with this color
+ * @param recolor_opa the intense of recoloring (LV_OPA_TRANSP: no recolor)
+ */
+__attribute__((target("avx2")))
+static void blend_alpha_avx2(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * alpha, uint32_t length,
+                             lv_opa_t opa, lv_color_t recolor, lv_opa_t recolor_opa)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i rc = color_avx2(recolor);
+    __m256i rmix = _mm256_set1_epi16(recolor_opa);
+    __m256i rmix_inv = _mm256_set1_epi16(255 - recolor_opa);
+#if LV_COLOR_DEPTH == 16
+    __m256i full = _mm256_set1_epi16(255);
+#else
+    __m256i full = _mm256_set1_epi32(255);
+#endif
+    __m256i opa_v = _mm256_set1_epi16(opa);
+    uint32_t i;
+    for(i = 0; i + PX_AVX2 <= length; i += PX_AVX2) {
+        __m256i s = _mm256_loadu_si256((const __m256i *)&src[i]);
+        __m256i d = _mm256_loadu_si256((const __m256i *)&dest[i]);
+        if(recolor_opa != LV_OPA_TRANSP) s = mix_avx2(rc, s, rmix, rmix_inv);
+
+        /*'alpha * opa / 255' like the portable kernel: (alpha * opa + 255) >> 8*/
+#if LV_COLOR_DEPTH == 16
+        __m256i a = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)&alpha[i]));
+        a = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(a, opa_v), full), 8);
+        __m256i cover = _mm256_cmpeq_epi16(a, full);
+        __m256i transp = _mm256_cmpeq_epi16(a, zero);
+#else
+        __m256i a = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)&alpha[i]));
+        a = _mm256_srli_epi32(_mm256_add_epi32(_mm256_mullo_epi16(a, opa_v), full), 8);
+        __m256i cover = _mm256_cmpeq_epi32(a, full);
+        __m256i transp = _mm256_cmpeq_epi32(a, zero);
+#endif
+        __m256i res = mix_alpha_avx2(s, d, a);
+        res = _mm256_blendv_epi8(res, s, cover);
+        res = _mm256_blendv_epi8(res, d, transp);
+        _mm256_storeu_si256((__m256i *)&dest[i], res);
+    }
+    blend_alpha_c(&dest[i], &src[i], &alpha[i], length - i, opa, recolor, recolor_opa);
+}
+#endif /*LV_SIMD_X86 && LV_SIMD_COLOR*/
+
+#if LV_SIMD_ARM && LV_SIMD_COLOR
+#if LV_COLOR_DEPTH == 16
+typedef uint16x8_t lv_simd_neon_t;
+#define PX_NEON     8
+#define neon_load(p)        vld1q_u16((const uint16_t *)(p))
+#define neon_store(p, v)    vst1q_u16((uint16_t *)(p), v)
+#define neon_dup(c)         vdupq_n_u16((c).full)
+#define neon_ceq(a, b)      vceqq_u16(a, b)
+#else
+typedef uint32x4_t lv_simd_neon_t;
+#define PX_NEON     4
+#define neon_load(p)        vld1q_u32((const uint32_t *)(p))
+#define neon_store(p, v)    vst1q_u32((uint32_t *)(p), v)
+#define neon_dup(c)         vdupq_n_u32((c).full)
+#define neon_ceq(a, b)      vceqq_u32(a, b)
+#endif
+
+/**
+ * Mix 8 (16 bit) or 4 (24 bit) colors with NEON
+ * @param fg foreground colors
+ * @param bg background colors
+ * @param mix opacity of 'fg'
+ * @return the mixed colors
+ */
+static inline lv_simd_neon_t mix_neon(lv_simd_neon_t fg, lv_simd_neon_t bg, lv_opa_t mix)
+{
+#if LV_COLOR_DEPTH == 16
+    const uint16x8_t m5 = vdupq_n_u16(0x1F);
+    const uint16x8_t m6 = vdupq_n_u16(0x3F);
+    uint16_t mix_inv = 255 - mix;
+    uint16x8_t r = vmlaq_n_u16(vmulq_n_u16(vshrq_n_u16(fg, 11), mix), vshrq_n_u16(bg, 11), mix_inv);
+    uint16x8_t g = vmlaq_n_u16(vmulq_n_u16(vandq_u16(vshrq_n_u16(fg, 5), m6), mix),
+                               vandq_u16(vshrq_n_u16(bg, 5), m6), mix_inv);
+    uint16x8_t b = vmlaq_n_u16(vmulq_n_u16(vandq_u16(fg, m5), mix), vandq_u16(bg, m5), mix_inv);
+    r = vshlq_n_u16(vshrq_n_u16(r, 8), 11);
+    g = vshlq_n_u16(vshrq_n_u16(g, 8), 5);
+    b = vshrq_n_u16(b, 8);
+    return vorrq_u16(vorrq_u16(r, g), b);
+#else
+    uint8x8_t m = vdup_n_u8(mix);
+    uint8x8_t m_inv = vdup_n_u8(255 - mix);
+    uint8x16_t f = vreinterpretq_u8_u32(fg);
+    uint8x16_t b = vreinterpretq_u8_u32(bg);
+    uint16x8_t lo = vmlal_u8(vmull_u8(vget_low_u8(f), m), vget_low_u8(b), m_inv);
+    uint16x8_t hi = vmlal_u8(vmull_u8(vget_high_u8(f), m), vget_high_u8(b), m_inv);
+    return vreinterpretq_u32_u8(vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8)));
+#endif
+}
+
+/**
+ * Fill with NEON
+ * @param dest pointer to the first pixel
+ * @param length number of pixels
+ * @param color fill color
+ */
+static void fill_neon(lv_color_t * dest, uint32_t length, lv_color_t color)
+{
+    lv_simd_neon_t c = neon_dup(color);
+    uint32_t i;
+    for(i = 0; i + PX_NEON <= length; i += PX_NEON) {
+        neon_store(&dest[i], c);
+    }
+    fill_c(&dest[i], length - i, color);
+}
+
+/**
+ * Opacity fill with NEON
+ * @param dest pointer to the first pixel
+ * @param length number of pixels
+ * @param color fill color
+ * @param opa opacity of the color
+ */
+static void fill_opa_neon(lv_color_t * dest, uint32_t length, lv_color_t color, lv_opa_t opa)
+{
+    lv_simd_neon_t c = neon_dup(color);
+    uint32_t i;
+    for(i = 0; i + PX_NEON <= length; i += PX_NEON) {
+        neon_store(&dest[i], mix_neon(c, neon_load(&dest[i]), opa));
+    }
+    fill_opa_c(&dest[i], length - i, color, opa);
+}
+
+/**
+ * Blend with opacity with NEON
+ * @param dest pointer to the first destination pixel
+ * @param src pointer to the first source pixel
+ * @param length number of pixels
+ * @param opa opacity of 'src'
+ */
+static void blend_neon(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa)
+{
+    uint32_t i;
+    for(i = 0; i + PX_NEON <= length; i += PX_NEON) {
+        neon_store(&dest[i], mix_neon(neon_load(&src[i]), neon_load(&dest[i]), opa));
+    }
+    blend_c(&dest[i], &src[i], length - i, opa);
+}
+
+/**
+ * Chroma keyed copy or blend with NEON
+ * @param dest pointer to the first destination pixel
+ * @param src pointer to the first source pixel
+ * @param length number of pixels
+ * @param opa opacity of 'src' (LV_OPA_COVER: copy)
+ * @param key the 'src' pixels with this color are not drawn
+ */
+static void blend_key_neon(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa, lv_color_t key)
+{
+    lv_simd_neon_t k = neon_dup(key);
+    uint32_t i;
+    for(i = 0; i + PX_NEON <= length; i += PX_NEON) {
+        lv_simd_neon_t s = neon_load(&src[i]);
+        lv_simd_neon_t d = neon_load(&dest[i]);
+        lv_simd_neon_t res = opa == LV_OPA_COVER ? s : mix_neon(s, d, opa);
+#if LV_COLOR_DEPTH == 16
+        neon_store(&dest[i], vbslq_u16(neon_ceq(s, k), d, res));
+#else
+        neon_store(&dest[i], vbslq_u32(neon_ceq(s, k), d, res));
+#endif
+    }
+    blend_key_c(&dest[i], &src[i], length - i, opa, key);
+}
+
+/**
+ * Blend with per-pixel opacity and recoloring with NEON
+ * @param dest pointer to the first destination pixel
+ * @param src pointer to the first source pixel
+ * @param alpha pointer to the opacity of the first source pixel
+ * @param length number of pixels
+ * @param opa opacity of the whole 'src'
+ * @param recolor mix the source pixels with this color
+ * @param recolor_opa the intense of recoloring (LV_OPA_TRANSP: no recolor)
+ */
+static void blend_alpha_neon(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * alpha, uint32_t length,
+                             lv_opa_t opa, lv_color_t recolor, lv_opa_t recolor_opa)
+{
+    lv_simd_neon_t rc = neon_dup(recolor);
+    const uint16x8_t full = vdupq_n_u16(255);
+    uint32_t i;
+    for(i = 0; i + PX_NEON <= length; i += PX_NEON) {
+        lv_simd_neon_t s = neon_load(&src[i]);
+        lv_simd_neon_t d = neon_load(&dest[i]);
+        if(recolor_opa != LV_OPA_TRANSP) s = mix_neon(rc, s, recolor_opa);
+
+#if LV_COLOR_DEPTH == 16
+        /*'alpha * opa / 255' like the portable kernel: (alpha * opa + 255) >> 8*/
+        uint16x8_t a = vshrq_n_u16(vmlaq_n_u16(full, vmovl_u8(vld1_u8(&alpha[i])), opa), 8);
+        uint16x8_t a_inv = vsubq_u16(full, a);
+
+        const uint16x8_t m5 = vdupq_n_u16(0x1F);
+        const uint16x8_t m6 = vdupq_n_u16(0x3F);
+        uint16x8_t r = vmlaq_u16(vmulq_u16(vshrq_n_u16(s, 11), a), vshrq_n_u16(d, 11), a_inv);
+        uint16x8_t g = vmlaq_u16(vmulq_u16(vandq_u16(vshrq_n_u16(s, 5), m6), a),
+                                 vandq_u16(vshrq_n_u16(d, 5), m6), a_inv);
+        uint16x8_t b = vmlaq_u16(vmulq_u16(vandq_u16(s, m5), a), vandq_u16(d, m5), a_inv);
+        uint16x8_t res = vorrq_u16(vorrq_u16(vshlq_n_u16(vshrq_n_u16(r, 8), 11), vshlq_n_u16(vshrq_n_u16(g, 8), 5)),
+                                   vshrq_n_u16(b, 8));
+
+        res = vbslq_u16(vceqq_u16(a, full), s, res);
+        res = vbslq_u16(vceqq_u16(a, vdupq_n_u16(0)), d, res);
+#else
+        /*The 4 opacities (twice) like the portable kernel: (alpha * opa + 255) >> 8*/
+        uint32_t a4;
+        memcpy(&a4, &alpha[i], sizeof(a4));
+        uint8x8_t a = vshrn_n_u16(vmlaq_n_u16(full, vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(a4))), opa), 8);
+
+        /*The opacity of a pixel for its 4 channels*/
+        const uint8x8_t idx_lo = {0, 0, 0, 0, 1, 1, 1, 1};
+        const uint8x8_t idx_hi = {2, 2, 2, 2, 3, 3, 3, 3};
+        uint8x8_t m_lo = vtbl1_u8(a, idx_lo);
+        uint8x8_t m_hi = vtbl1_u8(a, idx_hi);
+        uint8x16_t fg = vreinterpretq_u8_u32(s);
+        uint8x16_t bg = vreinterpretq_u8_u32(d);
+        uint16x8_t lo = vmlal_u8(vmull_u8(vget_low_u8(fg), m_lo), vget_low_u8(bg), vmvn_u8(m_lo));
+        uint16x8_t hi = vmlal_u8(vmull_u8(vget_high_u8(fg), m_hi), vget_high_u8(bg), vmvn_u8(m_hi));
+        uint32x4_t res = vreinterpretq_u32_u8(vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8)));
+
+        uint32x4_t a32 = vmovl_u16(vget_low_u16(vmovl_u8(a)));
+        res = vbslq_u32(vceqq_u32(a32, vdupq_n_u32(255)), s, res);
+        res = vbslq_u32(vceqq_u32(a32, vdupq_n_u32(0)), d, res);
+#endif
+        neon_store(&dest[i], res);
+    }
+    blend_alpha_c(&dest[i], &src[i], &alpha[i], length - i, opa, recolor, recolor_opa);
+}
+#endif /*LV_SIMD_ARM && LV_SIMD_COLOR*/
+
+#if LV_ANTIALIAS != 0
+
+/**
+ * Portable 2x2 downscale. The SIMD kernels use it for the last pixels of the rows.
+ * Only the color channels of 'out' are written if the 4 pixels are different
+ * (other bits, e.g. the unused byte of 24 bit colors, are kept)
+ * @param out store the result here ('out_w' pixels)
+ * @param in1 pointer to the first row ('2 * out_w' pixels)
+ * @param in2 pointer to the second row ('2 * out_w' pixels)
+ * @param out_w number of result pixels
+ */
+static void aa_row_c(lv_color_t * out, const lv_color_t * in1, const lv_color_t * in2, uint32_t out_w)
+{
+    uint32_t i;
+    for(i = 0; i < out_w; i++) {
+        /*If the pixels are the same do not calculate the average */
+        if(in1->full == (in1 + 1)->full &&
+           in1->full == in2->full &&
+           in1->full == (in2 + 1)->full) {
+            out->full = in1->full;
+        } else {
+            /*Get the average of 2x2 red*/
+            out->red = (in1->red + (in1 + 1)->red +
+                        in2->red + (in2 + 1)->red) >> 2;
+            /*Get the average of 2x2 green*/
+            out->green = (in1->green + (in1 + 1)->green +
+                          in2->green + (in2 + 1)->green) >> 2;
+            /*Get the average of 2x2 blue*/
+            out->blue = (in1->blue + (in1 + 1)->blue +
+                         in2->blue + (in2 + 1)->blue) >> 2;
+        }
+
+        in1 += 2;   /*Skip the next pixel because it is already used above*/
+        in2 += 2;
+        out++;
+    }
+}
+
+/* The SIMD kernels read a block of input pixels before writing the results of the block.
+ * The results are always written before the input pixels which are not read yet
+ * so in place filtering works like with 'aa_row_c'*/
+
+#if LV_SIMD_X86 && LV_SIMD_COLOR
+/**
+ * 2x2 downscale with SSE2 (8 result pixels with 16 bit colors, 4 with 24 bit colors in a step)
+ * @param out store the result here ('out_w' pixels)
+ * @param in1 pointer to the first row ('2 * out_w' pixels)
+ * @param in2 pointer to the second row ('2 * out_w' pixels)
+ * @param out_w number of result pixels
+ */
+__attribute__((target("sse2")))
+static void aa_row_sse2(lv_color_t * out, const lv_color_t * in1, const lv_color_t * in2, uint32_t out_w)
+{
+    uint32_t i = 0;
+
+#if LV_COLOR_DEPTH == 16
+    const __m128i ones = _mm_set1_epi16(1);
+    const __m128i m5 = _mm_set1_epi16(0x1F);
+    const __m128i m6 = _mm_set1_epi16(0x3F);
+
+    for(; i + 8 <= out_w; i += 8) {
+        __m128i a0 = _mm_loadu_si128((const __m128i *)&in1[2 * i]);
+        __m128i a1 = _mm_loadu_si128((const __m128i *)&in1[2 * i + 8]);
+        __m128i b0 = _mm_loadu_si128((const __m128i *)&in2[2 * i]);
+        __m128i b1 = _mm_loadu_si128((const __m128i *)&in2[2 * i + 8]);
+
+        /*Add the rows per channel, then the neighbor pixels with 'madd' (32 bit sums)*/
+        __m128i c0, c1, sum;
+        c0 = _mm_add_epi16(_mm_and_si128(a0, m5), _mm_and_si128(b0, m5));
+        c1 = _mm_add_epi16(_mm_and_si128(a1, m5), _mm_and_si128(b1, m5));
+        sum = _mm_packs_epi32(_mm_madd_epi16(c0, ones), _mm_madd_epi16(c1, ones));
+        __m128i res = _mm_srli_epi16(sum, 2);
+
+        c0 = _mm_add_epi16(_mm_and_si128(_mm_srli_epi16(a0, 5), m6), _mm_and_si128(_mm_srli_epi16(b0, 5), m6));
+        c1 = _mm_add_epi16(_mm_and_si128(_mm_srli_epi16(a1, 5), m6), _mm_and_si128(_mm_srli_epi16(b1, 5), m6));
+        sum = _mm_packs_epi32(_mm_madd_epi16(c0, ones), _mm_madd_epi16(c1, ones));
+        res = _mm_or_si128(res, _mm_slli_epi16(_mm_srli_epi16(sum, 2), 5));
+
+        c0 = _mm_add_epi16(_mm_srli_epi16(a0, 11), _mm_srli_epi16(b0, 11));
+        c1 = _mm_add_epi16(_mm_srli_epi16(a1, 11), _mm_srli_epi16(b1, 11));
+        sum = _mm_packs_epi32(_mm_madd_epi16(c0, ones), _mm_madd_epi16(c1, ones));
+        res = _mm_or_si128(res, _mm_slli_epi16(_mm_srli_epi16(sum, 2), 11));
+
+        _mm_storeu_si128((__m128i *)&out[i], res);
+    }
+#else
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i rgb_mask = _mm_set1_epi32(0x00FFFFFF);
+
+    for(; i + 4 <= out_w; i += 4) {
+        __m128i a0 = _mm_loadu_si128((const __m128i *)&in1[2 * i]);
+        __m128i a1 = _mm_loadu_si128((const __m128i *)&in1[2 * i + 4]);
+        __m128i b0 = _mm_loadu_si128((const __m128i *)&in2[2 * i]);
+        __m128i b1 = _mm_loadu_si128((const __m128i *)&in2[2 * i + 4]);
+        __m128i old = _mm_loadu_si128((const __m128i *)&out[i]);
+
+        /*Add the rows on 16 bit (2 pixels in a register) then the neighbor pixels*/
+        __m128i s0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+        __m128i s1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+        __m128i s2 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+        __m128i s3 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+        s0 = _mm_add_epi16(s0, _mm_srli_si128(s0, 8));
+        s1 = _mm_add_epi16(s1, _mm_srli_si128(s1, 8));
+        s2 = _mm_add_epi16(s2, _mm_srli_si128(s2, 8));
+        s3 = _mm_add_epi16(s3, _mm_srli_si128(s3, 8));
+        __m128i lo = _mm_srli_epi16(_mm_unpacklo_epi64(s0, s1), 2);
+        __m128i hi = _mm_srli_epi16(_mm_unpacklo_epi64(s2, s3), 2);
+        __m128i avg = _mm_packus_epi16(lo, hi);
+
+        /*Keep the unused byte of 'out' like 'aa_row_c' or copy the pixel if the 4 are the same*/
+        avg = _mm_or_si128(_mm_and_si128(avg, rgb_mask), _mm_andnot_si128(rgb_mask, old));
+
+        __m128i e1 = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a0), _mm_castsi128_ps(a1), _MM_SHUFFLE(2, 0, 2, 0)));
+        __m128i o1 = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a0), _mm_castsi128_ps(a1), _MM_SHUFFLE(3, 1, 3, 1)));
+        __m128i e2 = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(b0), _mm_castsi128_ps(b1), _MM_SHUFFLE(2, 0, 2, 0)));
+        __m128i o2 = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(b0), _mm_castsi128_ps(b1), _MM_SHUFFLE(3, 1, 3, 1)));
+        __m128i same = _mm_and_si128(_mm_cmpeq_epi32(e1, o1), _mm_and_si128(_mm_cmpeq_epi32(e1, e2), _mm_cmpeq_epi32(e1, o2)));
+        __m128i res = _mm_or_si128(_mm_and_si128(same, e1), _mm_andnot_si128(same, avg));
+
+        _mm_storeu_si128((__m128i *)&out[i], res);
+    }
+#endif
+
+    if(i < out_w) aa_row_c(&out[i], &in1[2 * i], &in2[2 * i], out_w - i);
+}
+
+/**
+ * 2x2 downscale with AVX2 (16 result pixels with 16 bit colors, 8 with 24 bit colors in a step)
+ * @param out store the result here ('out_w' pixels)
+ * @param in1 pointer to the first row ('2 * out_w' pixels)
+ * @param in2 pointer to the second row ('2 * out_w' pixels)
+ * @param out_w number of result pixels
+ */
+__attribute__((target("avx2")))
+static void aa_row_avx2(lv_color_t * out, const lv_color_t * in1, const lv_color_t * in2, uint32_t out_w)
+{
+    uint32_t i = 0;
+
+    /* The pack instructions work in 128 bit lanes
+     * so the 64 bit quarters of their results are reordered with 0xD8 (0, 2, 1, 3)*/
+#if LV_COLOR_DEPTH == 16
+    const __m256i ones = _mm256_set1_epi16(1);
+    const __m256i m5 = _mm256_set1_epi16(0x1F);
+    const __m256i m6 = _mm256_set1_epi16(0x3F);
+
+    for(; i + 16 <= out_w; i += 16) {
+        __m256i a0 = _mm256_loadu_si256((const __m256i *)&in1[2 * i]);
+        __m256i a1 = _mm256_loadu_si256((const __m256i *)&in1[2 * i + 16]);
+        __m256i b0 = _mm256_loadu_si256((const __m256i *)&in2[2 * i]);
+        __m256i b1 = _mm256_loadu_si256((const __m256i *)&in2[2 * i + 16]);
+
+        __m256i c0, c1, sum;
+        c0 = _mm256_add_epi16(_mm256_and_si256(a0, m5), _mm256_and_si256(b0, m5));
+        c1 = _mm256_add_epi16(_mm256_and_si256(a1, m5), _mm256_and_si256(b1, m5));
+        sum = _mm256_packs_epi32(_mm256_madd_epi16(c0, ones), _mm256_madd_epi16(c1, ones));
+        __m256i res = _mm256_srli_epi16(sum, 2);
+
+        c0 = _mm256_add_epi16(_mm256_and_si256(_mm256_srli_epi16(a0, 5), m6), _mm256_and_si256(_mm256_srli_epi16(b0, 5), m6));
+        c1 = _mm256_add_epi16(_mm256_and_si256(_mm256_srli_epi16(a1, 5), m6), _mm256_and_si256(_mm256_srli_epi16(b1, 5), m6));
+        sum = _mm256_packs_epi32(_mm256_madd_epi16(c0, ones), _mm256_madd_epi16(c1, ones));
+        res = _mm256_or_si256(res, _mm256_slli_epi16(_mm256_srli_epi16(sum, 2), 5));
+
+        c0 = _mm256_add_epi16(_mm256_srli_epi16(a0, 11), _mm256_srli_epi16(b0, 11));
+        c1 = _mm256_add_epi16(_mm256_srli_epi16(a1, 11), _mm256_srli_epi16(b1, 11));
+        sum = _mm256_packs_epi32(_mm256_madd_epi16(c0, ones), _mm256_madd_epi16(c1, ones));
+        res = _mm256_or_si256(res, _mm256_slli_epi16(_mm256_srli_epi16(sum, 2), 11));
+
+        res = _mm256_permute4x64_epi64(res, 0xD8);
+        _mm256_storeu_si256((__m256i *)&out[i], res);
+    }
+#else
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i rgb_mask = _mm256_set1_epi32(0x00FFFFFF);
+
+    for(; i + 8 <= out_w; i += 8) {
+        __m256i a0 = _mm256_loadu_si256((const __m256i *)&in1[2 * i]);
+        __m256i a1 = _mm256_loadu_si256((const __m256i *)&in1[2 * i + 8]);
+        __m256i b0 = _mm256_loadu_si256((const __m256i *)&in2[2 * i]);
+        __m256i b1 = _mm256_loadu_si256((const __m256i *)&in2[2 * i + 8]);
+        __m256i old = _mm256_loadu_si256((const __m256i *)&out[i]);
+
+        __m256i s0 = _mm256_add_epi16(_mm256_unpacklo_epi8(a0, zero), _mm256_unpacklo_epi8(b0, zero));
+        __m256i s1 = _mm256_add_epi16(_mm256_unpackhi_epi8(a0, zero), _mm256_unpackhi_epi8(b0, zero));
+        __m256i s2 = _mm256_add_epi16(_mm256_unpacklo_epi8(a1, zero), _mm256_unpacklo_epi8(b1, zero));
+        __m256i s3 = _mm256_add_epi16(_mm256_unpackhi_epi8(a1, zero), _mm256_unpackhi_epi8(b1, zero));
+        s0 = _mm256_add_epi16(s0, _mm256_srli_si256(s0, 8));
+        s1 = _mm256_add_epi16(s1, _mm256_srli_si256(s1, 8));
+        s2 = _mm256_add_epi16(s2, _mm256_srli_si256(s2, 8));
+        s3 = _mm256_add_epi16(s3, _mm256_srli_si256(s3, 8));
+        __m256i lo = _mm256_srli_epi16(_mm256_unpacklo_epi64(s0, s1), 2);
+        __m256i hi = _mm256_srli_epi16(_mm256_unpacklo_epi64(s2, s3), 2);
+        __m256i avg = _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8);
+
+        avg = _mm256_or_si256(_mm256_and_si256(avg, rgb_mask), _mm256_andnot_si256(rgb_mask, old));
+
+        __m256i e1 = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(a0), _mm256_castsi256_ps(a1), _MM_SHUFFLE(2, 0, 2, 0)));
+        __m256i o1 = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(a0), _mm256_castsi256_ps(a1), _MM_SHUFFLE(3, 1, 3, 1)));
+        __m256i e2 = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(b0), _mm256_castsi256_ps(b1), _MM_SHUFFLE(2, 0, 2, 0)));
+        __m256i o2 = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(b0), _mm256_castsi256_ps(b1), _MM_SHUFFLE(3, 1, 3, 1)));
+        e1 = _mm256_permute4x64_epi64(e1, 0xD8);
+        o1 = _mm256_permute4x64_epi64(o1, 0xD8);
+        e2 = _mm256_permute4x64_epi64(e2, 0xD8);
+        o2 = _mm256_permute4x64_epi64(o2, 0xD8);
+        __m256i same = _mm256_and_si256(_mm256_cmpeq_epi32(e1, o1), _mm256_and_si256(_mm256_cmpeq_epi32(e1, e2), _mm256_cmpeq_epi32(e1, o2)));
+        __m256i res = _mm256_blendv_epi8(avg, e1, same);
+
+        _mm256_storeu_si256((__m256i *)&out[i], res);
+    }
+#endif
+
+    if(i < out_w) aa_row_c(&out[i], &in1[2 * i], &in2[2 * i], out_w - i);
+}
+#endif /*LV_SIMD_X86 && LV_SIMD_COLOR*/
+
+#if LV_SIMD_ARM && LV_SIMD_COLOR
+/**
+ * 2x2 downscale with NEON (8 result pixels with 16 bit colors, 4 with 24 bit colors in a step)
+ * @param out store the result here ('out_w' pixels)
+ * @param in1 pointer to the first row ('2 * out_w' pixels)
+ * @param in2 pointer to the second row ('2 * out_w' pixels)
+ * @param out_w number of result pixels
+ */
+static void aa_row_neon(lv_color_t * out, const lv_color_t * in1, const lv_color_t * in2, uint32_t out_w)
+{
+    uint32_t i = 0;
+
+#if LV_COLOR_DEPTH == 16
+    const uint16x8_t m5 = vdupq_n_u16(0x1F);
+    const uint16x8_t m6 = vdupq_n_u16(0x3F);
+
+    for(; i + 8 <= out_w; i += 8) {
+        /*Load the even and odd pixels into separate registers*/
+        uint16x8x2_t a = vld2q_u16((const uint16_t *)&in1[2 * i]);
+        uint16x8x2_t b = vld2q_u16((const uint16_t *)&in2[2 * i]);
+
+        uint16x8_t sum;
+        sum = vaddq_u16(vaddq_u16(vandq_u16(a.val[0], m5), vandq_u16(a.val[1], m5)),
+                        vaddq_u16(vandq_u16(b.val[0], m5), vandq_u16(b.val[1], m5)));
+        uint16x8_t res = vshrq_n_u16(sum, 2);
+
+        sum = vaddq_u16(vaddq_u16(vandq_u16(vshrq_n_u16(a.val[0], 5), m6), vandq_u16(vshrq_n_u16(a.val[1], 5), m6)),
+                        vaddq_u16(vandq_u16(vshrq_n_u16(b.val[0], 5), m6), vandq_u16(vshrq_n_u16(b.val[1], 5), m6)));
+        res = vorrq_u16(res, vshlq_n_u16(vshrq_n_u16(sum, 2), 5));
+
+        sum = vaddq_u16(vaddq_u16(vshrq_n_u16(a.val[0], 11), vshrq_n_u16(a.val[1], 11)),
+                        vaddq_u16(vshrq_n_u16(b.val[0], 11), vshrq_n_u16(b.val[1], 11)));
+        res = vorrq_u16(res, vshlq_n_u16(vshrq_n_u16(sum, 2), 11));
+
+        vst1q_u16((uint16_t *)&out[i], res);
+    }
+#else
+    const uint32x4_t rgb_mask = vdupq_n_u32(0x00FFFFFF);
+
+    for(; i + 4 <= out_w; i += 4) {
+        uint32x4x2_t a = vld2q_u32((const uint32_t *)&in1[2 * i]);
+        uint32x4x2_t b = vld2q_u32((const uint32_t *)&in2[2 * i]);
+        uint32x4_t old = vld1q_u32((const uint32_t *)&out[i]);
+
+        uint8x16_t ae = vreinterpretq_u8_u32(a.val[0]);
+        uint8x16_t ao = vreinterpretq_u8_u32(a.val[1]);
+        uint8x16_t be = vreinterpretq_u8_u32(b.val[0]);
+        uint8x16_t bo = vreinterpretq_u8_u32(b.val[1]);
+        uint16x8_t lo = vaddq_u16(vaddl_u8(vget_low_u8(ae), vget_low_u8(ao)),
+                                  vaddl_u8(vget_low_u8(be), vget_low_u8(bo)));
+        uint16x8_t hi = vaddq_u16(vaddl_u8(vget_high_u8(ae), vget_high_u8(ao)),
+                                  vaddl_u8(vget_high_u8(be), vget_high_u8(bo)));
+        uint32x4_t avg = vreinterpretq_u32_u8(vcombine_u8(vshrn_n_u16(lo, 2), vshrn_n_u16(hi, 2)));
+
+        /*Keep the unused byte of 'out' like 'aa_row_c' or copy the pixel if the 4 are the same*/
+        avg = vbslq_u32(rgb_mask, avg, old);
+        uint32x4_t same = vandq_u32(vceqq_u32(a.val[0], a.val[1]),
+                                    vandq_u32(vceqq_u32(a.val[0], b.val[0]), vceqq_u32(a.val[0], b.val[1])));
+        uint32x4_t res = vbslq_u32(same, a.val[0], avg);
+
+        vst1q_u32((uint32_t *)&out[i], res);
+    }
+#endif
+
+    if(i < out_w) aa_row_c(&out[i], &in1[2 * i], &in2[2 * i], out_w - i);
+}
+#endif /*LV_SIMD_ARM && LV_SIMD_COLOR*/
+
+#endif /*LV_ANTIALIAS != 0*/
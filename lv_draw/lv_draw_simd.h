@@ -0,0 +1,128 @@
+/**
+ * @file lv_draw_simd.h
+ *
+ */
+
+#ifndef LV_DRAW_SIMD_H
+#define LV_DRAW_SIMD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf.h"
+#include <stdint.h>
+#include "../lv_misc/lv_color.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef USE_LV_SIMD
+#define USE_LV_SIMD     0
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*CPU features used by the drawing kernels*/
+typedef enum
+{
+    LV_SIMD_NONE = 0x00,
+    LV_SIMD_SSE2 = 0x01,
+    LV_SIMD_AVX2 = 0x02,
+    LV_SIMD_NEON = 0x04,
+}lv_simd_feature_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Detect the features of the CPU and select the fastest drawing kernels.
+ * Called by 'lv_init()'. Until it the portable C kernels are used.
+ */
+void lv_simd_init(void);
+
+/**
+ * Get the CPU features used by the drawing kernels
+ * @return OR-ed values of 'lv_simd_feature_t' (LV_SIMD_NONE if 'USE_LV_SIMD' is 0)
+ */
+uint8_t lv_simd_get_features(void);
+
+/**
+ * Fill a row of pixels with a color
+ * @param dest pointer to the first pixel
+ * @param length number of pixels
+ * @param color fill color
+ */
+void lv_simd_fill(lv_color_t * dest, uint32_t length, lv_color_t color);
+
+/**
+ * Mix a color to a row of pixels (like 'lv_color_mix(color, dest[i], opa)')
+ * @param dest pointer to the first pixel
+ * @param length number of pixels
+ * @param color fill color
+ * @param opa opacity of the color
+ */
+void lv_simd_fill_opa(lv_color_t * dest, uint32_t length, lv_color_t color, lv_opa_t opa);
+
+/**
+ * Copy or blend pixels to a row of pixels (like 'lv_color_mix(src[i], dest[i], opa)')
+ * @param dest pointer to the first destination pixel
+ * @param src pointer to the first source pixel
+ * @param length number of pixels
+ * @param opa opacity of 'src' (LV_OPA_COVER: copy)
+ */
+void lv_simd_blend(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa);
+
+/**
+ * Copy or blend pixels to a row of pixels except the pixels with 'key' color (chroma keying)
+ * @param dest pointer to the first destination pixel
+ * @param src pointer to the first source pixel
+ * @param length number of pixels
+ * @param opa opacity of 'src' (LV_OPA_COVER: copy)
+ * @param key the 'src' pixels with this color are not drawn (e.g. LV_COLOR_TRANSP)
+ */
+void lv_simd_blend_key(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa, lv_color_t key);
+
+/**
+ * Blend pixels with their own opacity to a row of pixels and recolor them in the same pass
+ * (like 'lv_color_mix(lv_color_mix(recolor, src[i], recolor_opa), dest[i], alpha[i] * opa / 255)'
+ * but the fully opaque pixels are copied and the fully transparent pixels are skipped)
+ * @param dest pointer to the first destination pixel
+ * @param src pointer to the first source pixel
+ * @param alpha pointer to the opacity of the first source pixel
+ * @param length number of pixels
+ * @param opa opacity of the whole 'src' (LV_OPA_COVER: use only 'alpha')
+ * @param recolor mix the source pixels with this color
+ * @param recolor_opa the intense of recoloring (LV_OPA_TRANSP: no recolor)
+ */
+void lv_simd_blend_alpha(lv_color_t * dest, const lv_color_t * src, const lv_opa_t * alpha, uint32_t length,
+                         lv_opa_t opa, lv_color_t recolor, lv_opa_t recolor_opa);
+
+#if LV_ANTIALIAS != 0
+/**
+ * Downscale two rows of an anti-aliased VDB to one row: get the average of every 2x2 pixels.
+ * The result is bit-exact with every kernel.
+ * 'out' can be the same as 'in1' or can be before it (the VDB is filtered in place)
+ * @param out store the result here ('out_w' pixels)
+ * @param in1 pointer to the first row ('2 * out_w' pixels)
+ * @param in2 pointer to the second row ('2 * out_w' pixels)
+ * @param out_w number of result pixels
+ */
+void lv_simd_aa_row(lv_color_t * out, const lv_color_t * in1, const lv_color_t * in2, uint32_t out_w);
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  /*LV_DRAW_SIMD_H*/
@@ -18,6 +18,8 @@
 
 #include <stddef.h>
 #include "../lv_core/lv_vdb.h"
+#include "../lv_core/lv_refr.h"
+#include "lv_draw_simd.h"
 
 /*********************
  *      INCLUDES
@@ -36,6 +38,13 @@
  *  STATIC PROTOTYPES
  **********************/
 static void sw_mem_blend(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa);
+#if LV_FONT_ANTIALIAS == 0
+static void vletter_blend(lv_color_t * vdb_buf_tmp, lv_coord_t vdb_width, const lv_font_glyph_dsc_t * glyph,
+                          lv_coord_t col_start, lv_coord_t col_end, lv_coord_t row_start, lv_coord_t row_end,
+                          lv_color_t color, lv_opa_t opa);
+static inline void vletter_blend_row(lv_color_t * dest, const uint8_t * map_row, lv_coord_t col_start, lv_coord_t len,
+                                     uint8_t bpp, const lv_opa_t * opa_table, lv_color_t color, lv_opa_t opa);
+#endif
 static void sw_color_fill(lv_area_t * mem_area, lv_color_t * mem, const lv_area_t * fill_area, lv_color_t color, lv_opa_t opa);
 
 /**********************
@@ -81,6 +90,8 @@ void lv_vpx(lv_coord_t x, lv_coord_t y, const lv_area_t * mask_p, lv_color_t col
         *vdb_px_p = lv_color_mix(color,*vdb_px_p, opa);
     }
 
+    /*The drawn pixels are not counted here (it would be too slow for every pixel).
+     *The callers add them to the statistics once per drawing*/
 }
 
 
@@ -106,6 +117,10 @@ void lv_vfill(const lv_area_t * cords_p, const lv_area_t * mask_p,
     /*If there are common part of the three area then draw to the vdb*/
     if(union_ok == false) return;
 
+#if LV_REFR_STAT_NUM != 0
+    lv_refr_stat_add(LV_REFR_STAT_DRAW_PX, lv_area_get_size(&res_a));
+#endif
+
     lv_area_t vdb_rel_a;   /*Stores relative coordinates on vdb*/
     vdb_rel_a.x1 = res_a.x1 - vdb_p->area.x1;
     vdb_rel_a.y1 = res_a.y1 - vdb_p->area.y1;
@@ -119,8 +134,14 @@ void lv_vfill(const lv_area_t * cords_p, const lv_area_t * mask_p,
 
 
 #if USE_LV_GPU
+#if LV_REFR_THREAD_CNT == 0
     static lv_color_t color_array_tmp[LV_HOR_RES << LV_ANTIALIAS];       /*Used by 'sw_color_fill'*/
     static lv_coord_t last_width = -1;
+#else
+    /*Every rendering worker thread has its own buffer*/
+    static __thread lv_color_t color_array_tmp[LV_HOR_RES << LV_ANTIALIAS];
+    static __thread lv_coord_t last_width = -1;
+#endif
 
     lv_coord_t w = lv_area_get_width(&vdb_rel_a);
     /*Don't use hw. acc. for every small fill (because of the init overhead)*/
@@ -195,23 +216,19 @@ void lv_vfill(const lv_area_t * cords_p, const lv_area_t * mask_p,
  * Draw a letter in the Virtual Display Buffer
  * @param pos_p left-top coordinate of the latter
  * @param mask_p the letter will be drawn only on this area  (truncated to VDB area)
- * @param font_p pointer to font 
- * @param letter a letter to draw
+ * @param glyph_p pointer to the description of the glyph (from 'lv_font_get_glyph_dsc')
  * @param color color of letter
  * @param opa opacity of letter (0..255)
  */
-void lv_vletter(const lv_point_t * pos_p, const lv_area_t * mask_p, 
-                     const lv_font_t * font_p, uint32_t letter,
-                     lv_color_t color, lv_opa_t opa)
-{      
-    if(font_p == NULL) return;
-
-    uint8_t letter_w = lv_font_get_width(font_p, letter);
-    uint8_t letter_h = lv_font_get_height(font_p);
-
-    const uint8_t * map_p = lv_font_get_bitmap(font_p, letter);
+void lv_vletter(const lv_point_t * pos_p, const lv_area_t * mask_p,
+                const lv_font_glyph_dsc_t * glyph_p,
+                lv_color_t color, lv_opa_t opa)
+{
+    if(glyph_p->bitmap == NULL) return;
 
-    if(map_p == NULL) return;
+    uint8_t letter_w = glyph_p->w;
+    uint8_t letter_h = glyph_p->h;
+    const uint8_t * map_p = glyph_p->bitmap;
 
     /*If the letter is completely out of mask don't draw it */
     if(pos_p->x + letter_w < mask_p->x1 || pos_p->x > mask_p->x2 ||
@@ -233,6 +250,12 @@ void lv_vletter(const lv_point_t * pos_p, const lv_area_t * mask_p,
     lv_coord_t row_start = pos_p->y > mask_p->y1 ? 0 : mask_p->y1 - pos_p->y;
     lv_coord_t row_end  = pos_p->y + (letter_h >> LV_FONT_ANTIALIAS) < mask_p->y2 ? (letter_h >> LV_FONT_ANTIALIAS) : mask_p->y2 - pos_p->y + 1;
 
+#if LV_REFR_STAT_NUM != 0
+    if(row_end > row_start && col_end > col_start) {
+        lv_refr_stat_add(LV_REFR_STAT_DRAW_PX, (uint32_t)(row_end - row_start) * (col_end - col_start));
+    }
+#endif
+
     /*Set a pointer on VDB to the first pixel of the letter*/
     vdb_buf_tmp += ((pos_p->y - vdb_p->area.y1) * vdb_width)
                     + pos_p->x - vdb_p->area.x1;
@@ -240,6 +263,28 @@ void lv_vletter(const lv_point_t * pos_p, const lv_area_t * mask_p,
     /*If the letter is partially out of mask the move there on VDB*/
     vdb_buf_tmp += (row_start * vdb_width) + col_start;
 
+    /*Anti-aliased fonts: blend the colors with the coverage of the pixels*/
+    if(glyph_p->bpp > 1) {
+#if LV_FONT_ANTIALIAS == 0
+        vletter_blend(vdb_buf_tmp, vdb_width, glyph_p, col_start, col_end, row_start, row_end, color, opa);
+#else
+        /*The double sized glyphs are reduced: average the coverage of 2x2 pixels*/
+        for(row = row_start; row < row_end; row ++) {
+            for(col = col_start; col < col_end; col ++) {
+                uint16_t cov = lv_font_get_glyph_px(glyph_p, col << 1, row << 1) +
+                               lv_font_get_glyph_px(glyph_p, (col << 1) + 1, row << 1) +
+                               lv_font_get_glyph_px(glyph_p, col << 1, (row << 1) + 1) +
+                               lv_font_get_glyph_px(glyph_p, (col << 1) + 1, (row << 1) + 1);
+                lv_opa_t px_opa = ((uint32_t)(cov >> 2) * opa) / LV_OPA_COVER;
+                if(px_opa != LV_OPA_TRANSP) *vdb_buf_tmp = lv_color_mix(color, *vdb_buf_tmp, px_opa);
+                vdb_buf_tmp++;
+            }
+            vdb_buf_tmp += vdb_width  - (col_end - col_start); /*Next row in VDB*/
+        }
+#endif
+        return;
+    }
+
     /*Move on the map too*/
     map_p += ((row_start << LV_FONT_ANTIALIAS) * width_byte) + ((col_start << LV_FONT_ANTIALIAS) >> 3);
 
@@ -320,14 +365,15 @@ void lv_vletter(const lv_point_t * pos_p, const lv_area_t * mask_p,
  * @param cords_p coordinates the color map
  * @param mask_p the map will drawn only on this area  (truncated to VDB area)
  * @param map_p pointer to a lv_color_t array
- * @param opa opacity of the map (ignored, only for compatibility with lv_vmap)
+ * @param alpha_p pointer to the opacity of the pixels of 'map_p' or NULL ('transp' is not used then)
+ * @param opa opacity of the map
  * @param transp true: enable transparency of LV_IMG_LV_COLOR_TRANSP color pixels
  * @param upscale true: upscale to double size
  * @param recolor mix the pixels with this color
  * @param recolor_opa the intense of recoloring
  */
 void lv_vmap(const lv_area_t * cords_p, const lv_area_t * mask_p, 
-             const lv_color_t * map_p, lv_opa_t opa, bool transp, bool upscale,
+             const lv_color_t * map_p, const lv_opa_t * alpha_p, lv_opa_t opa, bool transp, bool upscale,
 			 lv_color_t recolor, lv_opa_t recolor_opa)
 {
     lv_area_t masked_a;
@@ -342,17 +388,23 @@ void lv_vmap(const lv_area_t * cords_p, const lv_area_t * mask_p,
     /*If there are common part of the three area then draw to the vdb*/
     if(union_ok == false)  return;
 
+#if LV_REFR_STAT_NUM != 0
+    lv_refr_stat_add(LV_REFR_STAT_DRAW_PX, lv_area_get_size(&masked_a));
+#endif
+
     uint8_t ds_shift = 0;
     if(upscale != false) ds_shift = 1;
 
     /*If the map starts OUT of the masked area then calc. the first pixel*/
     lv_coord_t map_width = lv_area_get_width(cords_p) >> ds_shift;
+    uint32_t map_ofs = 0;
     if(cords_p->y1 < masked_a.y1) {
-        map_p += (uint32_t) map_width * ((masked_a.y1 - cords_p->y1) >> ds_shift);
+        map_ofs += (uint32_t) map_width * ((masked_a.y1 - cords_p->y1) >> ds_shift);
     }
     if(cords_p->x1 < masked_a.x1) {
-        map_p += (masked_a.x1 - cords_p->x1) >> ds_shift;
+        map_ofs += (masked_a.x1 - cords_p->x1) >> ds_shift;
     }
+    map_p += map_ofs;
 
     /*Stores coordinates relative to the act vdb*/
     masked_a.x1 = masked_a.x1 - vdb_p->area.x1;
@@ -366,6 +418,45 @@ void lv_vmap(const lv_area_t * cords_p, const lv_area_t * mask_p,
 
     map_p -= (masked_a.x1 >> ds_shift); /*Move back. It will be easier to index 'map_p' later*/
 
+    /*Pixels with own opacity: blend them, apply 'opa' and recolor in one pass*/
+    if(alpha_p != NULL) {
+        alpha_p += map_ofs;
+        alpha_p -= (masked_a.x1 >> ds_shift);
+
+        lv_coord_t row;
+        lv_coord_t map_useful_w = lv_area_get_width(&masked_a);
+        if(upscale == false) {
+            for(row = masked_a.y1; row <= masked_a.y2; row++) {
+                lv_simd_blend_alpha(&vdb_buf_tmp[masked_a.x1], &map_p[masked_a.x1], &alpha_p[masked_a.x1], map_useful_w,
+                                    opa, recolor, recolor_opa);
+
+                map_p += map_width;         /*Next row on the map*/
+                alpha_p += map_width;
+                vdb_buf_tmp += vdb_width;   /*Next row on the VDB*/
+            }
+        } else {
+            /*Double the pixels of a map row and blend the doubled row*/
+            lv_color_t map_row[map_useful_w];
+            lv_opa_t alpha_row[map_useful_w];
+            lv_coord_t col;
+            for(row = masked_a.y1; row <= masked_a.y2; row++) {
+                for(col = masked_a.x1; col <= masked_a.x2; col++) {
+                    map_row[col - masked_a.x1] = map_p[col >> 1];
+                    alpha_row[col - masked_a.x1] = alpha_p[col >> 1];
+                }
+                lv_simd_blend_alpha(&vdb_buf_tmp[masked_a.x1], map_row, alpha_row, map_useful_w,
+                                    opa, recolor, recolor_opa);
+
+                if((row & 0x1) != 0) {      /*Next row on the map*/
+                    map_p += map_width;
+                    alpha_p += map_width;
+                }
+                vdb_buf_tmp += vdb_width;   /*Next row on the VDB*/
+            }
+        }
+        return;
+    }
+
     /*No upscalse*/
     if(upscale == false) {
         if(transp == false) { /*Simply copy the pixels to the VDB*/
@@ -395,28 +486,12 @@ void lv_vmap(const lv_area_t * cords_p, const lv_area_t * mask_p,
             lv_color_t transp_color = LV_COLOR_TRANSP;
 
             if(recolor_opa == LV_OPA_TRANSP) {/*No recolor*/
-                if(opa == LV_OPA_COVER)  { /*no opa */
-                    for(row = masked_a.y1; row <= masked_a.y2; row++) {
-                        for(col = masked_a.x1; col <= masked_a.x2; col ++) {
-                            if(map_p[col].full != transp_color.full) {
-                                vdb_buf_tmp[col] = map_p[col];
-                            }
-                        }
-
-                        map_p += map_width;         /*Next row on the map*/
-                        vdb_buf_tmp += vdb_width;   /*Next row on the VDB*/
-                    }
-                } else {
-                    for(row = masked_a.y1; row <= masked_a.y2; row++) {
-                        for(col = masked_a.x1; col <= masked_a.x2; col ++) {
-                            if(map_p[col].full != transp_color.full) {
-                                vdb_buf_tmp[col] = lv_color_mix( map_p[col], vdb_buf_tmp[col], opa);
-                            }
-                        }
+                lv_coord_t map_useful_w = lv_area_get_width(&masked_a);
+                for(row = masked_a.y1; row <= masked_a.y2; row++) {
+                    lv_simd_blend_key(&vdb_buf_tmp[masked_a.x1], &map_p[masked_a.x1], map_useful_w, opa, transp_color);
 
-                        map_p += map_width;          /*Next row on the map*/
-                        vdb_buf_tmp += vdb_width;   /*Next row on the VDB*/
-                    }
+                    map_p += map_width;         /*Next row on the map*/
+                    vdb_buf_tmp += vdb_width;   /*Next row on the VDB*/
                 }
             } else { /*Recolor needed*/
                 lv_color_t lv_color_tmp;
@@ -529,15 +604,109 @@ void lv_vmap(const lv_area_t * cords_p, const lv_area_t * mask_p,
  */
 static void sw_mem_blend(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa)
 {
-    if(opa == LV_OPA_COVER) {
-        memcpy(dest, src, length * sizeof(lv_color_t));
-    } else {
-        uint32_t col;
-        for(col = 0; col < length; col++) {
-        	dest[col] = lv_color_mix(src[col], dest[col], opa);
-		}
+    /*Copy with 'memcpy' or blend with the fastest kernel of the CPU*/
+    lv_simd_blend(dest, src, length, opa);
+}
+
+#if LV_FONT_ANTIALIAS == 0
+/**
+ * Blend the pixels of an anti-aliased glyph (2, 4 or 8 bpp) to the VDB
+ * @param vdb_buf_tmp pointer to the VDB pixel of the first drawn pixel of the glyph
+ * @param vdb_width width of the VDB
+ * @param glyph pointer to the description of the glyph
+ * @param col_start the first drawn column of the glyph
+ * @param col_end after the last drawn column
+ * @param row_start the first drawn row of the glyph
+ * @param row_end after the last drawn row
+ * @param color color of letter
+ * @param opa opacity of letter (0..255)
+ */
+static void vletter_blend(lv_color_t * vdb_buf_tmp, lv_coord_t vdb_width, const lv_font_glyph_dsc_t * glyph,
+                          lv_coord_t col_start, lv_coord_t col_end, lv_coord_t row_start, lv_coord_t row_end,
+                          lv_color_t color, lv_opa_t opa)
+{
+    uint8_t bpp = glyph->bpp;
+    uint32_t width_byte = ((uint32_t)glyph->w * bpp + 7) >> 3;
+    const uint8_t * map_row = glyph->bitmap + row_start * width_byte;
+    lv_coord_t len = col_end - col_start;
+
+    /*The opacity of the coverage values (calculated per pixel with 8 bpp)*/
+    lv_opa_t opa_table[16];
+    if(bpp < 8) {
+        uint8_t max = (1 << bpp) - 1;
+        uint8_t v;
+        for(v = 0; v <= max; v++) opa_table[v] = ((uint16_t)v * opa) / max;
+    }
+
+    /*The rows are blended with constant 'bpp' so the bit operations are simple*/
+    lv_coord_t row;
+    for(row = row_start; row < row_end; row++) {
+        switch(bpp) {
+            case 2:
+                vletter_blend_row(vdb_buf_tmp, map_row, col_start, len, 2, opa_table, color, opa);
+                break;
+            case 4:
+                vletter_blend_row(vdb_buf_tmp, map_row, col_start, len, 4, opa_table, color, opa);
+                break;
+            default:
+                vletter_blend_row(vdb_buf_tmp, map_row, col_start, len, 8, opa_table, color, opa);
+                break;
+        }
+
+        map_row += width_byte;
+        vdb_buf_tmp += vdb_width;
+    }
+}
+
+/**
+ * Blend a row of an anti-aliased glyph
+ * @param dest pointer to the VDB pixel of the first drawn pixel of the row
+ * @param map_row pointer to the first byte of the row in the bitmap
+ * @param col_start the first drawn column
+ * @param len number of pixels to draw
+ * @param bpp bits per pixel of the bitmap (2, 4 or 8)
+ * @param opa_table the opacity of the coverage values (not used with 8 bpp)
+ * @param color color of letter
+ * @param opa opacity of letter (0..255)
+ */
+static inline void vletter_blend_row(lv_color_t * dest, const uint8_t * map_row, lv_coord_t col_start, lv_coord_t len,
+                                     uint8_t bpp, const lv_opa_t * opa_table, lv_color_t color, lv_opa_t opa)
+{
+    uint8_t max = (1 << bpp) - 1;
+    uint8_t px_per_byte = 8 / bpp;
+    const uint8_t * map_p = &map_row[((uint32_t)col_start * bpp) >> 3];
+    uint8_t first = col_start % px_per_byte;        /*The first drawn pixel in the first byte*/
+    lv_coord_t i = 0;
+
+    /*Read a byte at once and skip the empty bytes (most of a glyph)*/
+    while(i < len) {
+        uint8_t byte = *map_p;
+        uint8_t px_num = px_per_byte - first;
+        if(px_num > len - i) px_num = len - i;
+
+        if(byte != 0) {
+            uint8_t shift = 8 - bpp - first * bpp;
+            uint8_t j;
+            for(j = 0; j < px_num; j++) {
+                uint8_t v = (byte >> shift) & max;
+                if(v != 0) {
+                    lv_opa_t px_opa;
+                    if(bpp == 8) px_opa = opa == LV_OPA_COVER ? v : ((uint16_t)v * opa) / max;
+                    else px_opa = opa_table[v];
+
+                    if(px_opa == LV_OPA_COVER) dest[i + j] = color;
+                    else dest[i + j] = lv_color_mix(color, dest[i + j], px_opa);
+                }
+                shift -= bpp;
+            }
+        }
+
+        i += px_num;
+        first = 0;
+        map_p++;
     }
 }
+#endif
 
 /**
  *
@@ -552,15 +721,13 @@ static void sw_color_fill(lv_area_t * mem_area, lv_color_t * mem, const lv_area_
 
     /*Set all row in vdb to the given color*/
     lv_coord_t row;
-    lv_coord_t col;
     lv_coord_t mem_width = lv_area_get_width(mem_area);
+    lv_coord_t fill_width = lv_area_get_width(fill_area);
 
     /*Run simpler function without opacity*/
     if(opa == LV_OPA_COVER) {
         /*Fill the first row with 'color'*/
-        for(col = fill_area->x1; col <= fill_area->x2; col++) {
-            mem[col] = color;
-        }
+        lv_simd_fill(&mem[fill_area->x1], fill_width, color);
 
         /*Copy the first row to all other rows*/
         lv_color_t * mem_first = &mem[fill_area->x1];
@@ -574,17 +741,8 @@ static void sw_color_fill(lv_area_t * mem_area, lv_color_t * mem, const lv_area_
     }
     /*Calculate with alpha too*/
     else {
-        lv_color_t bg_tmp = LV_COLOR_BLACK;
-        lv_color_t opa_tmp = lv_color_mix(color, bg_tmp, opa);
         for(row = fill_area->y1; row <= fill_area->y2; row++) {
-            for(col = fill_area->x1; col <= fill_area->x2; col++) {
-                /*If the bg color changed recalculate the result color*/
-                if(mem[col].full != bg_tmp.full) {
-                    bg_tmp = mem[col];
-                    opa_tmp = lv_color_mix(color, bg_tmp, opa);
-                }
-                mem[col] = opa_tmp;
-            }
+            lv_simd_fill_opa(&mem[fill_area->x1], fill_width, color, opa);
             mem += mem_width;
         }
     }
@@ -48,13 +48,12 @@ void lv_vfill(const lv_area_t * cords_p, const lv_area_t * mask_p,
  * Draw a letter in the Virtual Display Buffer
  * @param pos_p left-top coordinate of the latter
  * @param mask_p the letter will be drawn only on this area
- * @param font_p pointer to font
- * @param letter a letter to draw
+ * @param glyph_p pointer to the description of the glyph (from 'lv_font_get_glyph_dsc')
  * @param color color of letter
  * @param opa opacity of letter (0..255)
  */
 void lv_vletter(const lv_point_t * pos_p, const lv_area_t * mask_p,
-                const lv_font_t * font_p, uint32_t letter,
+                const lv_font_glyph_dsc_t * glyph_p,
                 lv_color_t color, lv_opa_t opa);
 
 /**
@@ -62,14 +61,15 @@ void lv_vletter(const lv_point_t * pos_p, const lv_area_t * mask_p,
  * @param cords_p coordinates the color map
  * @param mask_p the map will drawn only on this area
  * @param map_p pointer to a lv_color_t array
- * @param opa opacity of the map (ignored, only for compatibility with lv_vmap)
+ * @param alpha_p pointer to the opacity of the pixels of 'map_p' or NULL ('transp' is not used then)
+ * @param opa opacity of the map
  * @param transp true: enable transparency of LV_IMG_LV_COLOR_TRANSP color pixels
  * @param upscale true: upscale to double size
  * @param recolor mix the pixels with this color
  * @param recolor_opa the intense of recoloring
  */
 void lv_vmap(const lv_area_t * cords_p, const lv_area_t * mask_p,
-            const lv_color_t * map_p, lv_opa_t opa, bool transp, bool upscale,
+            const lv_color_t * map_p, const lv_opa_t * alpha_p, lv_opa_t opa, bool transp, bool upscale,
             lv_color_t recolor, lv_opa_t recolor_opa);
 
 
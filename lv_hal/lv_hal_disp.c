@@ -52,6 +52,13 @@ void lv_disp_drv_init(lv_disp_drv_t *driver)
     driver->disp_fill = NULL;
     driver->disp_map = NULL;
     driver->disp_flush = NULL;
+    driver->disp_copy_area = NULL;
+    driver->draw_backend = NULL;
+
+#if LV_VDB_DIRECT
+    driver->disp_get_fb = NULL;
+    driver->disp_flip = NULL;
+#endif
 
 #if USE_LV_GPU
     driver->mem_blend = NULL;
@@ -164,6 +171,82 @@ void lv_disp_map(int32_t x1, int32_t y1, int32_t x2, int32_t y2, const lv_color_
     if(active->driver.disp_map != NULL)  active->driver.disp_map(x1, y1, x2, y2, color_map);
 }
 
+/**
+ * Copy an area of the active display to an other position
+ * @param x1 left coordinate of the source area
+ * @param y1 top coordinate of the source area
+ * @param x2 right coordinate of the source area
+ * @param y2 bottom coordinate of the source area
+ * @param dx horizontal offset of the destination
+ * @param dy vertical offset of the destination
+ */
+void lv_disp_copy_area(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t dx, int32_t dy)
+{
+    if(active == NULL) return;
+    if(active->driver.disp_copy_area != NULL) active->driver.disp_copy_area(x1, y1, x2, y2, dx, dy);
+}
+
+/**
+ * Set the draw backend of a display
+ * @param disp pointer to a display (return value of 'lv_disp_register')
+ * @param backend pointer to a draw backend (NULL: use the software drawing).
+ *                Only its pointer is saved so it can't be a local variable.
+ */
+void lv_disp_set_draw_backend(lv_disp_t * disp, const struct _lv_draw_backend_t * backend)
+{
+    disp->driver.draw_backend = backend;
+
+    /*Redraw everything with the new backend*/
+    if(disp == active) lv_obj_invalidate(lv_scr_act());
+}
+
+/**
+ * Get the draw backend of the active display
+ * @return pointer to the draw backend or NULL if only the software drawing is used
+ */
+const struct _lv_draw_backend_t * lv_disp_get_draw_backend(void)
+{
+    if(active == NULL) return NULL;
+    return active->driver.draw_backend;
+}
+
+/**
+ * Shows if copying an area of the display is supported or not
+ * @return false: 'disp_copy_area' is not supported in the driver; true: 'disp_copy_area' is supported in the driver
+ */
+bool lv_disp_is_copy_area_supported(void)
+{
+    if(active == NULL) return false;
+    if(active->driver.disp_copy_area) return true;
+    else return false;
+}
+
+#if LV_VDB_DIRECT
+/**
+ * Get a full screen frame buffer from the active display to render the next frame into
+ * @param age pointer to a variable to store the age of the frame buffer (0: unknown content)
+ * @return pointer to the frame buffer or NULL if not available
+ */
+lv_color_t * lv_disp_get_fb(uint8_t * age)
+{
+    *age = 0;
+    if(active == NULL) return NULL;
+    if(active->driver.disp_get_fb == NULL) return NULL;
+
+    return active->driver.disp_get_fb(age);
+}
+
+/**
+ * Show a rendered frame buffer on the active display
+ * @param fb pointer to a frame buffer given by 'lv_disp_get_fb'
+ */
+void lv_disp_flip(lv_color_t * fb)
+{
+    if(active == NULL) return;
+    if(active->driver.disp_flip != NULL) active->driver.disp_flip(fb);
+}
+#endif
+
 #if USE_LV_GPU
 
 /**
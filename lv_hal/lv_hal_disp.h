@@ -27,6 +27,7 @@ extern "C" {
 /**********************
  *      TYPEDEFS
  **********************/
+struct _lv_draw_backend_t;      /*Declared in 'lv_draw.h'*/
 
 /**
  * Display Driver structure to be registered by HAL
@@ -41,6 +42,20 @@ typedef struct _disp_drv_t {
     /*Write pixel map (e.g. image) to the display*/
     void (*disp_map)(int32_t x1, int32_t y1, int32_t x2, int32_t y2, const lv_color_t * color_p);
 
+    /* Copy an area of the display by 'dx' and 'dy' (the source and destination can overlap) (optional)
+     * Used to scroll without redrawing. Not used with LV_VDB_DIRECT*/
+    void (*disp_copy_area)(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t dx, int32_t dy);
+
+#if LV_VDB_DIRECT
+    /* Give a full screen frame buffer to render the next frame into (LV_VDB_DIRECT only)
+     * Save the age of the buffer to 'age': 1 if it shows the previous frame, 2 if the frame before it, ...
+     * 0 if its content is unknown*/
+    lv_color_t * (*disp_get_fb)(uint8_t * age);
+
+    /*Show the frame buffer given by 'disp_get_fb' when the frame is ready (e.g. page flip) (LV_VDB_DIRECT only)*/
+    void (*disp_flip)(lv_color_t * fb);
+#endif
+
 #if USE_LV_GPU
     /*Blend two memories using opacity (GPU only)*/
     void (*mem_blend)(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa);
@@ -49,6 +64,10 @@ typedef struct _disp_drv_t {
     void (*mem_fill)(lv_color_t * dest, uint32_t length, lv_color_t color);
 #endif
 
+    /* Draw backend of the display: hooks to replace drawing operations (optional, NULL: software drawing)
+     * The operations not handled by the backend are drawn by the software*/
+    const struct _lv_draw_backend_t * draw_backend;
+
 } lv_disp_drv_t;
 
 typedef struct _disp_t {
@@ -125,6 +144,52 @@ void lv_disp_fill(int32_t x1, int32_t y1, int32_t x2, int32_t y2, lv_color_t col
  */
 void lv_disp_map(int32_t x1, int32_t y1, int32_t x2, int32_t y2, const lv_color_t * color_map);
 
+/**
+ * Copy an area of the active display to an other position
+ * @param x1 left coordinate of the source area
+ * @param y1 top coordinate of the source area
+ * @param x2 right coordinate of the source area
+ * @param y2 bottom coordinate of the source area
+ * @param dx horizontal offset of the destination
+ * @param dy vertical offset of the destination
+ */
+void lv_disp_copy_area(int32_t x1, int32_t y1, int32_t x2, int32_t y2, int32_t dx, int32_t dy);
+
+/**
+ * Set the draw backend of a display
+ * @param disp pointer to a display (return value of 'lv_disp_register')
+ * @param backend pointer to a draw backend (NULL: use the software drawing).
+ *                Only its pointer is saved so it can't be a local variable.
+ */
+void lv_disp_set_draw_backend(lv_disp_t * disp, const struct _lv_draw_backend_t * backend);
+
+/**
+ * Get the draw backend of the active display
+ * @return pointer to the draw backend or NULL if only the software drawing is used
+ */
+const struct _lv_draw_backend_t * lv_disp_get_draw_backend(void);
+
+/**
+ * Shows if copying an area of the display is supported or not
+ * @return false: 'disp_copy_area' is not supported in the driver; true: 'disp_copy_area' is supported in the driver
+ */
+bool lv_disp_is_copy_area_supported(void);
+
+#if LV_VDB_DIRECT
+/**
+ * Get a full screen frame buffer from the active display to render the next frame into
+ * @param age pointer to a variable to store the age of the frame buffer (0: unknown content)
+ * @return pointer to the frame buffer or NULL if not available
+ */
+lv_color_t * lv_disp_get_fb(uint8_t * age);
+
+/**
+ * Show a rendered frame buffer on the active display
+ * @param fb pointer to a frame buffer given by 'lv_disp_get_fb'
+ */
+void lv_disp_flip(lv_color_t * fb);
+#endif
+
 #if USE_LV_GPU
 /**
  * Blend pixels to a destination memory from a source memory
@@ -228,6 +228,43 @@ bool lv_area_is_in(const lv_area_t * ain_p, const lv_area_t * aholder_p)
     return is_in;
 }
 
+/**
+ * Get the parts of an area which are out of an other area
+ * @param res_p pointer to an array of 4 areas, the result will be stored here
+ * @param a_p pointer to an area
+ * @param sub_p pointer to the area to remove from 'a_p'
+ * @return number of areas stored in 'res_p' (0..4)
+ */
+uint8_t lv_area_sub(lv_area_t * res_p, const lv_area_t * a_p, const lv_area_t * sub_p)
+{
+    lv_area_t com;
+    if(lv_area_union(&com, a_p, sub_p) == false) {
+        lv_area_copy(&res_p[0], a_p);
+        return 1;
+    }
+
+    /*Full width stripes above and below, the remaining stripes on the left and right*/
+    uint8_t cnt = 0;
+    if(a_p->y1 < com.y1) {
+        lv_area_set(&res_p[cnt], a_p->x1, a_p->y1, a_p->x2, com.y1 - 1);
+        cnt++;
+    }
+    if(a_p->y2 > com.y2) {
+        lv_area_set(&res_p[cnt], a_p->x1, com.y2 + 1, a_p->x2, a_p->y2);
+        cnt++;
+    }
+    if(a_p->x1 < com.x1) {
+        lv_area_set(&res_p[cnt], a_p->x1, com.y1, com.x1 - 1, com.y2);
+        cnt++;
+    }
+    if(a_p->x2 > com.x2) {
+        lv_area_set(&res_p[cnt], com.x2 + 1, com.y1, a_p->x2, com.y2);
+        cnt++;
+    }
+
+    return cnt;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
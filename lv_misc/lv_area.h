@@ -157,6 +157,15 @@ bool lv_area_is_on(const lv_area_t * a1_p, const lv_area_t * a2_p);
  */
 bool lv_area_is_in(const lv_area_t * ain_p, const lv_area_t * aholder_p);
 
+/**
+ * Get the parts of an area which are out of an other area
+ * @param res_p pointer to an array of 4 areas, the result will be stored here
+ * @param a_p pointer to an area
+ * @param sub_p pointer to the area to remove from 'a_p'
+ * @return number of areas stored in 'res_p' (0..4)
+ */
+uint8_t lv_area_sub(lv_area_t * res_p, const lv_area_t * a_p, const lv_area_t * sub_p);
+
 /**********************
  *      MACROS
  **********************/
@@ -10,6 +10,7 @@
 
 #include <stddef.h>
 #include "lv_font.h"
+#include "lv_mem.h"
 
 /*********************
  *      DEFINES
@@ -19,13 +20,34 @@
  *      TYPEDEFS
  **********************/
 
+/*The letters of a page*/
+typedef struct
+{
+    uint32_t first;
+    uint32_t last;
+    const lv_font_t * page;
+}lv_font_range_t;
+
+/*The pages of a font sorted by their letters to find the page of a letter with binary search*/
+typedef struct _lv_font_index_t
+{
+    lv_font_t * font;                       /*The indexed font (its first page)*/
+    const lv_font_t * last_page;            /*If a page is added after it the index is outdated*/
+    lv_font_range_t * ranges;
+    uint16_t range_cnt;                     /*0: the pages overlap, search page by page*/
+    struct _lv_font_index_t * next;         /*The next indexed font*/
+}lv_font_index_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static const lv_font_t * lv_font_get_page(const lv_font_t * font_p, uint32_t letter);
+static void lv_font_index_update(lv_font_t * font);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static lv_font_index_t * index_list;        /*Every indexed font*/
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -420,6 +442,7 @@ void lv_font_init(void)
 
 /**
  * Create a pair from font name and font dsc. get function. After it 'font_get' can be used for this font
+ * The pages of 'parent' are indexed to find the letters with binary search.
  * @param name name of the font
  * @param dsc_get_fp the font descriptor get function
  * @param parent add this font as charter set extension of 'parent'
@@ -428,12 +451,66 @@ void lv_font_add(lv_font_t *child, lv_font_t *parent)
 {
     if(parent == NULL) return;
 
-    while(parent->next_page != NULL) {
-        parent = parent->next_page; /*Got to the last page and add the new font there*/
+    lv_font_t * last = parent;
+    while(last->next_page != NULL) {
+        last = last->next_page; /*Got to the last page and add the new font there*/
+    }
+
+    last->next_page = child;
+
+    /*Index the pages of 'parent' and the fonts which got a new page with it*/
+    lv_font_index_update(parent);
+
+    lv_font_index_t * index;
+    for(index = index_list; index != NULL; index = index->next) {
+        if(index->last_page->next_page != NULL) lv_font_index_update(index->font);
+    }
+}
+
+/**
+ * Get the bitmap and the size of a letter with one lookup
+ * @param font_p pointer to a font
+ * @param letter a letter
+ * @param dsc store the description of the glyph here
+ * @return false: the letter is not in the font (the 'dsc' is cleared)
+ */
+bool lv_font_get_glyph_dsc(const lv_font_t * font_p, uint32_t letter, lv_font_glyph_dsc_t * dsc)
+{
+    const lv_font_t * page = lv_font_get_page(font_p, letter);
+    if(page == NULL) {
+        dsc->bitmap = NULL;
+        dsc->w = 0;
+        dsc->h = 0;
+        dsc->bpp = 1;
+        return false;
     }
 
-    parent->next_page = child;
+    uint32_t index = (letter - page->first_ascii);
+    dsc->bitmap = &page->bitmap[page->map[index]];
+    dsc->w = page->width[index];
+    dsc->h = font_p->height_row;
+    dsc->bpp = page->bpp == 0 ? 1 : page->bpp;
 
+    return true;
+}
+
+/**
+ * Get the coverage of a pixel of a glyph (for the slow paths, the letter drawing reads the bitmaps directly)
+ * @param dsc pointer to a glyph description
+ * @param x x coordinate of the pixel in the glyph
+ * @param y y coordinate of the pixel in the glyph
+ * @return 0: transparent ... 255: cover (0 out of the glyph)
+ */
+uint8_t lv_font_get_glyph_px(const lv_font_glyph_dsc_t * dsc, uint16_t x, uint16_t y)
+{
+    if(x >= dsc->w || y >= dsc->h) return 0;
+
+    uint32_t width_byte = ((uint32_t)dsc->w * dsc->bpp + 7) >> 3;
+    uint32_t bit = (uint32_t)x * dsc->bpp;
+    uint8_t max = (1 << dsc->bpp) - 1;
+    uint8_t v = (dsc->bitmap[y * width_byte + (bit >> 3)] >> (8 - dsc->bpp - (bit & 0x7))) & max;
+
+    return (uint16_t)v * 255 / max;
 }
 
 /**
@@ -444,17 +521,11 @@ void lv_font_add(lv_font_t *child, lv_font_t *parent)
  */
 const uint8_t * lv_font_get_bitmap(const lv_font_t * font_p, uint32_t letter)
 {
-    const lv_font_t * font_i = font_p;
-    while(font_i != NULL) {
-        if(letter >= font_i->first_ascii && letter <= font_i->last_ascii) {
-            uint32_t index = (letter - font_i->first_ascii);
-            return &font_i->bitmap[font_i->map[index]];
-        }
-
-        font_i = font_i->next_page;
-    }
+    const lv_font_t * page = lv_font_get_page(font_p, letter);
+    if(page == NULL) return NULL;
 
-    return NULL;
+    uint32_t index = (letter - page->first_ascii);
+    return &page->bitmap[page->map[index]];
 }
 
 /**
@@ -465,18 +536,107 @@ const uint8_t * lv_font_get_bitmap(const lv_font_t * font_p, uint32_t letter)
  */
 uint8_t lv_font_get_width(const lv_font_t * font_p, uint32_t letter)
 {
-    const lv_font_t * font_i = font_p;
-    while(font_i != NULL) {
-        if(letter >= font_i->first_ascii && letter <= font_i->last_ascii) {
-            uint32_t index = (letter - font_i->first_ascii);
-            return font_i->width[index];
-        }
-        font_i = font_i->next_page;
-    }
+    const lv_font_t * page = lv_font_get_page(font_p, letter);
+    if(page == NULL) return 0;
 
-    return 0;
+    uint32_t index = (letter - page->first_ascii);
+    return page->width[index];
 }
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+/**
+ * Find the page of a font which contains a letter
+ * @param font_p pointer to a font
+ * @param letter a letter
+ * @return the page of the letter or NULL if the letter is not in the font
+ */
+static const lv_font_t * lv_font_get_page(const lv_font_t * font_p, uint32_t letter)
+{
+    /*Most of the letters are on the first page*/
+    if(letter >= font_p->first_ascii && letter <= font_p->last_ascii) return font_p;
+
+    /*Binary search in the sorted ranges if no page was added since the indexing*/
+    const lv_font_index_t * index = font_p->index;
+    if(index != NULL && index->range_cnt != 0 && index->last_page->next_page == NULL) {
+        int32_t min = 0;
+        int32_t max = index->range_cnt - 1;
+        while(min <= max) {
+            int32_t mid = (min + max) >> 1;
+            const lv_font_range_t * range = &index->ranges[mid];
+            if(letter < range->first) max = mid - 1;
+            else if(letter > range->last) min = mid + 1;
+            else return range->page;
+        }
+
+        return NULL;
+    }
+
+    /*Without index search page by page*/
+    const lv_font_t * font_i = font_p->next_page;
+    while(font_i != NULL) {
+        if(letter >= font_i->first_ascii && letter <= font_i->last_ascii) return font_i;
+        font_i = font_i->next_page;
+    }
+
+    return NULL;
+}
+
+/**
+ * Create or update the index of a font with the letter ranges of its pages.
+ * Without memory the font remains without (or with an outdated) index and it's searched page by page.
+ * @param font pointer to a font
+ */
+static void lv_font_index_update(lv_font_t * font)
+{
+    lv_font_index_t * index = font->index;
+    if(index == NULL) {
+        index = lv_mem_alloc(sizeof(lv_font_index_t));
+        if(index == NULL) return;
+
+        index->font = font;
+        index->last_page = font;
+        index->ranges = NULL;
+        index->range_cnt = 0;
+        index->next = index_list;
+        index_list = index;
+        font->index = index;
+    }
+
+    const lv_font_t * page;
+    uint16_t page_cnt = 0;
+    for(page = font; page != NULL; page = page->next_page) page_cnt++;
+
+    lv_font_range_t * ranges = lv_mem_realloc(index->ranges, page_cnt * sizeof(lv_font_range_t));
+    if(ranges == NULL) return;
+    index->ranges = ranges;
+
+    /*Insertion sort by the first letters (there are only a few pages)*/
+    uint16_t cnt = 0;
+    for(page = font; page != NULL; page = page->next_page) {
+        uint16_t i = cnt;
+        while(i > 0 && ranges[i - 1].first > page->first_ascii) {
+            ranges[i] = ranges[i - 1];
+            i--;
+        }
+        ranges[i].first = page->first_ascii;
+        ranges[i].last = page->last_ascii;
+        ranges[i].page = page;
+
+        index->last_page = page;
+        cnt++;
+    }
+
+    /*If the pages overlap the earlier page has to win so the binary search can't be used*/
+    uint16_t i;
+    for(i = 1; i < cnt; i++) {
+        if(ranges[i].first <= ranges[i - 1].last) {
+            cnt = 0;
+            break;
+        }
+    }
+
+    index->range_cnt = cnt;
+}
@@ -18,6 +18,7 @@ extern "C" {
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 
 #include "lv_fonts/lv_symbol_def.h"
 
@@ -29,6 +30,8 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+struct _lv_font_index_t;
+
 typedef struct _lv_font_struct
 {
     uint32_t first_ascii;
@@ -38,8 +41,21 @@ typedef struct _lv_font_struct
     const uint32_t * map;
     const uint8_t * width;
     struct _lv_font_struct * next_page;    /*Pointer to a font extension*/
+    struct _lv_font_index_t * index;       /*Sorted letter ranges of the pages (created by 'lv_font_add')*/
+    uint8_t bpp;                           /*Bits per pixel of the bitmaps: 1, 2, 4 or 8 (0: 1).
+                                            *Every row starts in a new byte, the first pixel is in the MSB.
+                                            *With more bits the pixels are anti-aliased (0: transparent, max: cover)*/
 }lv_font_t;
 
+/*Everything about a glyph from one lookup*/
+typedef struct
+{
+    const uint8_t * bitmap;     /*The bitmap of the letter*/
+    uint8_t w;                  /*Width of the letter (columns)*/
+    uint8_t h;                  /*Height of the letter (rows)*/
+    uint8_t bpp;                /*Bits per pixel of the bitmap (1, 2, 4 or 8)*/
+}lv_font_glyph_dsc_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -51,11 +67,30 @@ void lv_font_init(void);
 
 /**
  * Create a pair from font name and font dsc. get function. After it 'font_get' can be used for this font
+ * The pages of 'parent' are indexed to find the letters with binary search.
  * @param child pointer to a font to join to the 'parent'
  * @param parent pointer to a font. 'child' will be joined here
  */
 void lv_font_add(lv_font_t *child, lv_font_t *parent);
 
+/**
+ * Get the bitmap and the size of a letter with one lookup
+ * @param font_p pointer to a font
+ * @param letter a letter
+ * @param dsc store the description of the glyph here
+ * @return false: the letter is not in the font (the 'dsc' is cleared)
+ */
+bool lv_font_get_glyph_dsc(const lv_font_t * font_p, uint32_t letter, lv_font_glyph_dsc_t * dsc);
+
+/**
+ * Get the coverage of a pixel of a glyph (for the slow paths, the letter drawing reads the bitmaps directly)
+ * @param dsc pointer to a glyph description
+ * @param x x coordinate of the pixel in the glyph
+ * @param y y coordinate of the pixel in the glyph
+ * @return 0: transparent ... 255: cover (0 out of the glyph)
+ */
+uint8_t lv_font_get_glyph_px(const lv_font_glyph_dsc_t * dsc, uint16_t x, uint16_t y);
+
 /**
  * Return with the bitmap of a font.
  * @param font_p pointer to a font
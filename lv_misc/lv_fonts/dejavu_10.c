@@ -1190,7 +1190,9 @@ lv_font_t lv_font_dejavu_10 =
     dejavu_10_bitmap,    /*Glyph's bitmap*/
     dejavu_10_map,    /*Glyph start indexes in the bitmap*/
     dejavu_10_width,    /*Glyph widths (columns)*/
-    NULL         /*No next page by default*/
+    NULL,        /*No next page by default*/
+    NULL,        /*Not indexed yet*/
+    1,        /*Bits per pixel*/
 };
 
 #endif /*USE_LV_FONT_DEJAVU_10*/
@@ -2574,7 +2574,9 @@ lv_font_t lv_font_dejavu_10_latin_ext_b =
     dejavu_10_latin_ext_b_bitmap,    /*Glyph's bitmap*/
     dejavu_10_latin_ext_b_map,    /*Glyph start indexes in the bitmap*/
     dejavu_10_latin_ext_b_width,    /*Glyph widths (columns)*/
-    NULL         /*No next page by default*/
+    NULL,        /*No next page by default*/
+    NULL,        /*Not indexed yet*/
+    1,        /*Bits per pixel*/
 };
 
 #endif /*USE_LV_FONT_DEJAVU_10_LATIN_EXT_B*/
@@ -2140,7 +2140,9 @@ lv_font_t lv_font_dejavu_20 =
     dejavu_20_bitmap,    /*Glyph's bitmap*/
     dejavu_20_map,    /*Glyph start indexes in the bitmap*/
     dejavu_20_width,    /*Glyph widths (columns)*/
-    NULL         /*No next page by default*/
+    NULL,        /*No next page by default*/
+    NULL,        /*Not indexed yet*/
+    1,        /*Bits per pixel*/
 };
 
 #endif /*USE_LV_FONT_DEJAVU_20*/
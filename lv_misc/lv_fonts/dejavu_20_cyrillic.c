@@ -5722,7 +5722,9 @@ lv_font_t lv_font_dejavu_20_cyrillic =
     dejavu_20_cyrillic_bitmap,    /*Glyph's bitmap*/
     dejavu_20_cyrillic_map,    /*Glyph start indexes in the bitmap*/
     dejavu_20_cyrillic_width,    /*Glyph widths (columns)*/
-    NULL         /*No next page by default*/
+    NULL,        /*No next page by default*/
+    NULL,        /*Not indexed yet*/
+    1,        /*Bits per pixel*/
 };
 
 #endif /*USE_LV_FONT_DEJAVU_20_CYRILLIC*/
@@ -2162,7 +2162,9 @@ lv_font_t lv_font_dejavu_20_sup =
     dejavu_20_sup_bitmap,    /*Glyph's bitmap*/
     dejavu_20_sup_map,    /*Glyph start indexes in the bitmap*/
     dejavu_20_sup_width,    /*Glyph widths (columns)*/
-    NULL         /*No next page by default*/
+    NULL,        /*No next page by default*/
+    NULL,        /*Not indexed yet*/
+    1,        /*Bits per pixel*/
 };
 
 #endif /*USE_LV_FONT_DEJAVU_20_SUP*/
@@ -10842,7 +10842,9 @@ lv_font_t lv_font_dejavu_40_cyrillic =
     dejavu_40_cyrillic_bitmap,    /*Glyph's bitmap*/
     dejavu_40_cyrillic_map,    /*Glyph start indexes in the bitmap*/
     dejavu_40_cyrillic_width,    /*Glyph widths (columns)*/
-    NULL         /*No next page by default*/
+    NULL,        /*No next page by default*/
+    NULL,        /*Not indexed yet*/
+    1,        /*Bits per pixel*/
 };
 
 #endif /*USE_LV_FONT_DEJAVU_40_CYRILLIC*/
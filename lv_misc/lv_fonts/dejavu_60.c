@@ -5940,7 +5940,9 @@ lv_font_t lv_font_dejavu_60 =
     dejavu_60_bitmap,    /*Glyph's bitmap*/
     dejavu_60_map,    /*Glyph start indexes in the bitmap*/
     dejavu_60_width,    /*Glyph widths (columns)*/
-    NULL         /*No next page by default*/
+    NULL,        /*No next page by default*/
+    NULL,        /*Not indexed yet*/
+    1,        /*Bits per pixel*/
 };
 
 #endif /*USE_LV_FONT_DEJAVU_60*/
@@ -15962,7 +15962,9 @@ lv_font_t lv_font_dejavu_60_cyrillic =
     dejavu_60_cyrillic_bitmap,    /*Glyph's bitmap*/
     dejavu_60_cyrillic_map,    /*Glyph start indexes in the bitmap*/
     dejavu_60_cyrillic_width,    /*Glyph widths (columns)*/
-    NULL         /*No next page by default*/
+    NULL,        /*No next page by default*/
+    NULL,        /*Not indexed yet*/
+    1,        /*Bits per pixel*/
 };
 
 #endif /*USE_LV_FONT_DEJAVU_60_CYRILLIC*/
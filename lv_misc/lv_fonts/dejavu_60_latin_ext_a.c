@@ -7994,7 +7994,9 @@ lv_font_t lv_font_dejavu_60_latin_ext_a =
     dejavu_60_latin_ext_a_bitmap,    /*Glyph's bitmap*/
     dejavu_60_latin_ext_a_map,    /*Glyph start indexes in the bitmap*/
     dejavu_60_latin_ext_a_width,    /*Glyph widths (columns)*/
-    NULL         /*No next page by default*/
+    NULL,        /*No next page by default*/
+    NULL,        /*Not indexed yet*/
+    1,        /*Bits per pixel*/
 };
 
 #endif /*USE_LV_FONT_DEJAVU_60_LATIN_EXT_A*/
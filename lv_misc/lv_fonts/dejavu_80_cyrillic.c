@@ -21082,7 +21082,9 @@ lv_font_t lv_font_dejavu_80_cyrillic =
     dejavu_80_cyrillic_bitmap,    /*Glyph's bitmap*/
     dejavu_80_cyrillic_map,    /*Glyph start indexes in the bitmap*/
     dejavu_80_cyrillic_width,    /*Glyph widths (columns)*/
-    NULL         /*No next page by default*/
+    NULL,        /*No next page by default*/
+    NULL,        /*Not indexed yet*/
+    1,        /*Bits per pixel*/
 };
 
 #endif /*USE_LV_FONT_DEJAVU_80_CYRILLIC*/
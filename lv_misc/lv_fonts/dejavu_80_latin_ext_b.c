@@ -17134,7 +17134,9 @@ lv_font_t lv_font_dejavu_80_latin_ext_b =
     dejavu_80_latin_ext_b_bitmap,    /*Glyph's bitmap*/
     dejavu_80_latin_ext_b_map,    /*Glyph start indexes in the bitmap*/
     dejavu_80_latin_ext_b_width,    /*Glyph widths (columns)*/
-    NULL         /*No next page by default*/
+    NULL,        /*No next page by default*/
+    NULL,        /*Not indexed yet*/
+    1,        /*Bits per pixel*/
 };
 
 #endif /*USE_LV_FONT_DEJAVU_80_LATIN_EXT_B*/
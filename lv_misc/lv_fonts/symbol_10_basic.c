@@ -203,7 +203,9 @@ lv_font_t lv_font_symbol_10_basic =
     symbol_10_basic_bitmap,    /*Glyph's bitmap*/
     symbol_10_basic_map,    /*Glyph start indexes in the bitmap*/
     symbol_10_basic_width,    /*Glyph widths (columns)*/
-    NULL         /*No next page by default*/
+    NULL,        /*No next page by default*/
+    NULL,        /*Not indexed yet*/
+    1,        /*Bits per pixel*/
 };
 
 #endif /*USE_LV_FONT_SYMBOL_10_BASIC*/
@@ -365,7 +365,9 @@ lv_font_t lv_font_symbol_20_feedback =
     symbol_20_feedback_bitmap,    /*Glyph's bitmap*/
     symbol_20_feedback_map,    /*Glyph start indexes in the bitmap*/
     symbol_20_feedback_width,    /*Glyph widths (columns)*/
-    NULL         /*No next page by default*/
+    NULL,        /*No next page by default*/
+    NULL,        /*Not indexed yet*/
+    1,        /*Bits per pixel*/
 };
 
 #endif /*USE_LV_FONT_SYMBOL_20_FEEDBACK*/
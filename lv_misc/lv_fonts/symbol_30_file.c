@@ -709,7 +709,9 @@ lv_font_t lv_font_symbol_30_file =
     symbol_30_file_bitmap,    /*Glyph's bitmap*/
     symbol_30_file_map,    /*Glyph start indexes in the bitmap*/
     symbol_30_file_width,    /*Glyph widths (columns)*/
-    NULL         /*No next page by default*/
+    NULL,        /*No next page by default*/
+    NULL,        /*Not indexed yet*/
+    1,        /*Bits per pixel*/
 };
 
 #endif /*USE_LV_FONT_SYMBOL_30_FILE*/
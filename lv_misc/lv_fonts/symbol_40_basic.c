@@ -623,7 +623,9 @@ lv_font_t lv_font_symbol_40_basic =
     symbol_40_basic_bitmap,    /*Glyph's bitmap*/
     symbol_40_basic_map,    /*Glyph start indexes in the bitmap*/
     symbol_40_basic_width,    /*Glyph widths (columns)*/
-    NULL         /*No next page by default*/
+    NULL,        /*No next page by default*/
+    NULL,        /*Not indexed yet*/
+    1,        /*Bits per pixel*/
 };
 
 #endif /*USE_LV_FONT_SYMBOL_40_BASIC*/
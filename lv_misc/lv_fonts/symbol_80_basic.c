@@ -1183,7 +1183,9 @@ lv_font_t lv_font_symbol_80_basic =
     symbol_80_basic_bitmap,    /*Glyph's bitmap*/
     symbol_80_basic_map,    /*Glyph start indexes in the bitmap*/
     symbol_80_basic_width,    /*Glyph widths (columns)*/
-    NULL         /*No next page by default*/
+    NULL,        /*No next page by default*/
+    NULL,        /*Not indexed yet*/
+    1,        /*Bits per pixel*/
 };
 
 #endif /*USE_LV_FONT_SYMBOL_80_BASIC*/
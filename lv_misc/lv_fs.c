@@ -12,6 +12,10 @@
 #include "lv_ll.h"
 #include <string.h>
 
+#if LV_REFR_THREAD_CNT != 0
+#include <pthread.h>
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -31,6 +35,10 @@ static lv_fs_drv_t* lv_fs_get_drv(char letter);
  *  STATIC VARIABLES
  **********************/
 static lv_ll_t drv_ll;
+#if LV_REFR_THREAD_CNT != 0
+/*Images are opened and closed by the rendering worker threads too*/
+static pthread_mutex_t drv_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
 
 /**********************
  *      MACROS
@@ -92,7 +100,13 @@ lv_fs_res_t lv_fs_open (lv_fs_file_t * file_p, const char * path, lv_fs_mode_t m
     }
     
     const char * real_path = lv_fs_get_real_path(path);
+#if LV_REFR_THREAD_CNT != 0
+    pthread_mutex_lock(&drv_mutex);
+#endif
     lv_fs_res_t res = file_p->drv->open(file_p->file_d, real_path, mode);
+#if LV_REFR_THREAD_CNT != 0
+    pthread_mutex_unlock(&drv_mutex);
+#endif
     
     if(res != LV_FS_RES_OK) {
         file_p->drv = NULL;
@@ -116,7 +130,13 @@ lv_fs_res_t lv_fs_close (lv_fs_file_t * file_p)
         return LV_FS_RES_NOT_IMP;
     }
     
+#if LV_REFR_THREAD_CNT != 0
+    pthread_mutex_lock(&drv_mutex);
+#endif
     lv_fs_res_t res = file_p->drv->close(file_p->file_d);
+#if LV_REFR_THREAD_CNT != 0
+    pthread_mutex_unlock(&drv_mutex);
+#endif
     
     lv_mem_free(file_p->file_d);   /*Clean up*/
     file_p->file_d = NULL;
@@ -266,6 +286,27 @@ lv_fs_res_t lv_fs_size (lv_fs_file_t * file_p, uint32_t * size)
     return res;
 }
 
+/**
+ * Get a pointer to the content of a file if its driver keeps it in the memory.
+ * It can be used instead of reading the file (zero copy).
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param ptr_p pointer to a variable to store the address of the first byte of the file.
+ *              It's valid until the file is closed.
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum (LV_FS_RES_NOT_IMP: read the file instead)
+ */
+lv_fs_res_t lv_fs_get_ptr (lv_fs_file_t * file_p, const void ** ptr_p)
+{
+    if(file_p->drv == NULL || ptr_p == NULL) {
+        return LV_FS_RES_INV_PARAM;
+    }
+
+    if(file_p->drv->ptr == NULL) return LV_FS_RES_NOT_IMP;
+
+    lv_fs_res_t res = file_p->drv->ptr(file_p->file_d, ptr_p);
+
+    return res;
+}
+
 /**
  * Initialize a 'fs_read_dir_t' variable for directory reading
  * @param rddir_p pointer to a 'fs_read_dir_t' variable
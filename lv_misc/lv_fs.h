@@ -84,6 +84,7 @@ typedef struct __lv_fs_drv_t
     lv_fs_res_t (*tell) (void * file_p, uint32_t * pos_p);
     lv_fs_res_t (*trunc) (void * file_p);
     lv_fs_res_t (*size) (void * file_p, uint32_t * size_p);
+    lv_fs_res_t (*ptr) (void * file_p, const void ** ptr_p);    /*Optional: the file's content is in the memory (RAM, ROM or mapped)*/
     lv_fs_res_t (*free) (uint32_t * total_p, uint32_t * free_p);
     
     lv_fs_res_t (*dir_open) (void * rddir_p, const char * path);
@@ -174,6 +175,16 @@ lv_fs_res_t lv_fs_tell (lv_fs_file_t * file_p, uint32_t  * pos);
  */
 lv_fs_res_t lv_fs_size (lv_fs_file_t * file_p, uint32_t * size);
 
+/**
+ * Get a pointer to the content of a file if its driver keeps it in the memory.
+ * It can be used instead of reading the file (zero copy).
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param ptr_p pointer to a variable to store the address of the first byte of the file.
+ *              It's valid until the file is closed.
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum (LV_FS_RES_NOT_IMP: read the file instead)
+ */
+lv_fs_res_t lv_fs_get_ptr (lv_fs_file_t * file_p, const void ** ptr_p);
+
 /**
  * Initialize a 'fs_dir_t' variable for directory reading
  * @param rddir_p pointer to a 'fs_read_dir_t' variable
@@ -0,0 +1,270 @@
+/**
+ * @file lv_fs_posix.c
+ * Read only file system driver for POSIX systems (e.g. Linux).
+ * The files are mapped into the memory so they can be used without reading (see 'lv_fs_get_ptr()').
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_fs_posix.h"
+#if USE_LV_FILESYSTEM && USE_LV_FS_POSIX
+
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_fs_res_t lv_fs_posix_res(int err);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Create a driver for the POSIX file system and register it with LV_FS_POSIX_LETTER.
+ * The paths are relative to LV_FS_POSIX_ROOT (e.g. "P:/usr/share/img.bin" -> "/usr/share/img.bin")
+ */
+void lv_fs_posix_init(void)
+{
+    lv_fs_drv_t posix_drv;
+    memset(&posix_drv, 0, sizeof(lv_fs_drv_t));    /*Initialization*/
+
+    posix_drv.file_size = sizeof(lv_fs_posix_file_t);
+    posix_drv.letter = LV_FS_POSIX_LETTER;
+
+    posix_drv.open = lv_fs_posix_open;
+    posix_drv.close = lv_fs_posix_close;
+    posix_drv.read = lv_fs_posix_read;
+    posix_drv.seek = lv_fs_posix_seek;
+    posix_drv.tell = lv_fs_posix_tell;
+    posix_drv.size = lv_fs_posix_size;
+    posix_drv.ptr = lv_fs_posix_ptr;
+
+    lv_fs_add_drv(&posix_drv);
+}
+
+/**
+ * Open a file and map it into the memory
+ * @param file_p pointer to a lv_fs_posix_file_t variable
+ * @param fn path of the file relative to LV_FS_POSIX_ROOT
+ * @param mode only LV_FS_MODE_RD is supported
+ * @return LV_FS_RES_OK: no error, the file is opened
+ *         any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_posix_open (void * file_p, const char * fn, lv_fs_mode_t mode)
+{
+    lv_fs_posix_file_t * fp = file_p;    /*Convert type*/
+
+    fp->data = NULL;
+    fp->size = 0;
+    fp->rp = 0;
+
+    if((mode & LV_FS_MODE_WR) != 0) return LV_FS_RES_DENIED;   /*Read only*/
+
+    char path[strlen(LV_FS_POSIX_ROOT) + strlen(fn) + 1];
+    strcpy(path, LV_FS_POSIX_ROOT);
+    strcat(path, fn);
+
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) return lv_fs_posix_res(errno);
+
+    struct stat st;
+    if(fstat(fd, &st) != 0) {
+        lv_fs_res_t res = lv_fs_posix_res(errno);
+        close(fd);
+        return res;
+    }
+
+    if(S_ISREG(st.st_mode) == 0 || (uint64_t) st.st_size > UINT32_MAX) {
+        close(fd);
+        return LV_FS_RES_INV_PARAM;
+    }
+
+    /*An empty file can't be mapped*/
+    if(st.st_size != 0) {
+        void * data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(data == MAP_FAILED) {
+            lv_fs_res_t res = lv_fs_posix_res(errno);
+            close(fd);
+            return res;
+        }
+        fp->data = data;
+        fp->size = st.st_size;
+    }
+
+    /*The mapping remains valid without the file descriptor*/
+    close(fd);
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Close an opened file (unmap it)
+ * @param file_p pointer to a 'lv_fs_posix_file_t' variable. (opened with lv_fs_posix_open)
+ * @return LV_FS_RES_OK: no error, the file is closed
+ *         any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_posix_close (void * file_p)
+{
+    lv_fs_posix_file_t * fp = file_p;    /*Convert type*/
+
+    if(fp->data != NULL) {
+        if(munmap((void *) fp->data, fp->size) != 0) return lv_fs_posix_res(errno);
+        fp->data = NULL;
+    }
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Read data from an opened file
+ * @param file_p pointer to a 'lv_fs_posix_file_t' variable. (opened with lv_fs_posix_open)
+ * @param buf pointer to a memory block where to store the read data
+ * @param btr number of Bytes To Read
+ * @param br the real number of read bytes (Byte Read)
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_posix_read (void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    lv_fs_posix_file_t * fp = file_p;    /*Convert type*/
+
+    /*No more data than the rest of the file*/
+    if(fp->rp >= fp->size) btr = 0;
+    else if(btr > fp->size - fp->rp) btr = fp->size - fp->rp;
+
+    if(btr != 0) memcpy(buf, &fp->data[fp->rp], btr);
+    fp->rp += btr;
+    *br = btr;
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Set the read pointer
+ * @param file_p pointer to a 'lv_fs_posix_file_t' variable. (opened with lv_fs_posix_open)
+ * @param pos the new position of read pointer
+ * @return LV_FS_RES_OK: no error, the position is set
+ *         any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_posix_seek (void * file_p, uint32_t pos)
+{
+    lv_fs_posix_file_t * fp = file_p;    /*Convert type*/
+
+    /*The file can't be expanded*/
+    if(pos > fp->size) return LV_FS_RES_INV_PARAM;
+
+    fp->rp = pos;
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Give the position of the read pointer
+ * @param file_p pointer to a 'lv_fs_posix_file_t' variable. (opened with lv_fs_posix_open)
+ * @param pos_p pointer to to store the result
+ * @return LV_FS_RES_OK: no error
+ *         any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_posix_tell (void * file_p, uint32_t * pos_p)
+{
+    lv_fs_posix_file_t * fp = file_p;    /*Convert type*/
+
+    *pos_p = fp->rp;
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Give the size of the file in bytes
+ * @param file_p pointer to a 'lv_fs_posix_file_t' variable. (opened with lv_fs_posix_open)
+ * @param size_p pointer to store the size
+ * @return LV_FS_RES_OK: no error
+ *         any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_posix_size (void * file_p, uint32_t * size_p)
+{
+    lv_fs_posix_file_t * fp = file_p;    /*Convert type*/
+
+    *size_p = fp->size;
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Give a pointer to the mapped content of the file
+ * @param file_p pointer to a 'lv_fs_posix_file_t' variable. (opened with lv_fs_posix_open)
+ * @param ptr_p pointer to store the address of the content (valid until the file is closed)
+ * @return LV_FS_RES_OK: no error
+ *         any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_posix_ptr (void * file_p, const void ** ptr_p)
+{
+    lv_fs_posix_file_t * fp = file_p;    /*Convert type*/
+
+    if(fp->data == NULL) return LV_FS_RES_NOT_IMP;  /*Empty file: nothing is mapped*/
+
+    *ptr_p = fp->data;
+
+    return LV_FS_RES_OK;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Convert an 'errno' value to a file system result
+ * @param err value of 'errno'
+ * @return the corresponding element of 'lv_fs_res_t'
+ */
+static lv_fs_res_t lv_fs_posix_res(int err)
+{
+    switch(err) {
+        case ENOENT:
+        case ENOTDIR:
+            return LV_FS_RES_NOT_EX;
+        case EACCES:
+        case EPERM:
+        case EROFS:
+            return LV_FS_RES_DENIED;
+        case ENOMEM:
+        case EMFILE:
+        case ENFILE:
+            return LV_FS_RES_OUT_OF_MEM;
+        case EBUSY:
+        case EAGAIN:
+            return LV_FS_RES_BUSY;
+        case EIO:
+            return LV_FS_RES_HW_ERR;
+        case EINVAL:
+        case ENAMETOOLONG:
+            return LV_FS_RES_INV_PARAM;
+        default:
+            return LV_FS_RES_UNKNOWN;
+    }
+}
+
+#endif /*USE_LV_FILESYSTEM && USE_LV_FS_POSIX*/
@@ -0,0 +1,133 @@
+/**
+ * @file lv_fs_posix.h
+ * Read only file system driver for POSIX systems (e.g. Linux).
+ * The files are mapped into the memory so they can be used without reading (see 'lv_fs_get_ptr()').
+ */
+
+#ifndef LV_FS_POSIX_H
+#define LV_FS_POSIX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf.h"
+#include "lv_fs.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#ifndef USE_LV_FS_POSIX
+#define USE_LV_FS_POSIX         0
+#endif
+
+#ifndef LV_FS_POSIX_LETTER
+#define LV_FS_POSIX_LETTER      'P'
+#endif
+
+#ifndef LV_FS_POSIX_ROOT
+#define LV_FS_POSIX_ROOT        "/"
+#endif
+
+#if USE_LV_FILESYSTEM && USE_LV_FS_POSIX
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+/*File descriptor: the mapped content of the file*/
+typedef struct
+{
+    const uint8_t * data;   /*The mapped file (NULL if the file is empty)*/
+    uint32_t size;          /*Size of the file in bytes*/
+    uint32_t rp;            /*Read pointer*/
+}lv_fs_posix_file_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Create a driver for the POSIX file system and register it with LV_FS_POSIX_LETTER.
+ * The paths are relative to LV_FS_POSIX_ROOT (e.g. "P:/usr/share/img.bin" -> "/usr/share/img.bin")
+ */
+void lv_fs_posix_init(void);
+
+/**
+ * Open a file and map it into the memory
+ * @param file_p pointer to a lv_fs_posix_file_t variable
+ * @param fn path of the file relative to LV_FS_POSIX_ROOT
+ * @param mode only LV_FS_MODE_RD is supported
+ * @return LV_FS_RES_OK: no error, the file is opened
+ *         any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_posix_open (void * file_p, const char * fn, lv_fs_mode_t mode);
+
+/**
+ * Close an opened file (unmap it)
+ * @param file_p pointer to a 'lv_fs_posix_file_t' variable. (opened with lv_fs_posix_open)
+ * @return LV_FS_RES_OK: no error, the file is closed
+ *         any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_posix_close (void * file_p);
+
+/**
+ * Read data from an opened file
+ * @param file_p pointer to a 'lv_fs_posix_file_t' variable. (opened with lv_fs_posix_open)
+ * @param buf pointer to a memory block where to store the read data
+ * @param btr number of Bytes To Read
+ * @param br the real number of read bytes (Byte Read)
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_posix_read (void * file_p, void * buf, uint32_t btr, uint32_t * br);
+
+/**
+ * Set the read pointer
+ * @param file_p pointer to a 'lv_fs_posix_file_t' variable. (opened with lv_fs_posix_open)
+ * @param pos the new position of read pointer
+ * @return LV_FS_RES_OK: no error, the position is set
+ *         any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_posix_seek (void * file_p, uint32_t pos);
+
+/**
+ * Give the position of the read pointer
+ * @param file_p pointer to a 'lv_fs_posix_file_t' variable. (opened with lv_fs_posix_open)
+ * @param pos_p pointer to to store the result
+ * @return LV_FS_RES_OK: no error
+ *         any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_posix_tell (void * file_p, uint32_t * pos_p);
+
+/**
+ * Give the size of the file in bytes
+ * @param file_p pointer to a 'lv_fs_posix_file_t' variable. (opened with lv_fs_posix_open)
+ * @param size_p pointer to store the size
+ * @return LV_FS_RES_OK: no error
+ *         any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_posix_size (void * file_p, uint32_t * size_p);
+
+/**
+ * Give a pointer to the mapped content of the file
+ * @param file_p pointer to a 'lv_fs_posix_file_t' variable. (opened with lv_fs_posix_open)
+ * @param ptr_p pointer to store the address of the content (valid until the file is closed)
+ * @return LV_FS_RES_OK: no error
+ *         any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_posix_ptr (void * file_p, const void ** ptr_p);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*USE_LV_FILESYSTEM && USE_LV_FS_POSIX*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  /*LV_FS_POSIX_H*/
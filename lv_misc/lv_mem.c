@@ -16,6 +16,10 @@
 #include LV_MEM_CUSTOM_INCLUDE
 #endif
 
+#if LV_REFR_THREAD_CNT != 0
+#include <pthread.h>
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -45,6 +49,8 @@ typedef struct
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void * mem_alloc(uint32_t size);
+static void mem_free(const void * data);
 #if LV_MEM_CUSTOM == 0
 static lv_mem_ent_t  * ent_get_next(lv_mem_ent_t * act_e);
 static void * ent_alloc(lv_mem_ent_t * e, uint32_t size);
@@ -60,9 +66,21 @@ static LV_MEM_ATTR uint8_t work_mem[LV_MEM_SIZE];    /*Work memory for allocatio
 
 static uint32_t zero_mem;       /*Give the address of this variable if 0 byte should be allocated*/ 
 
+#if LV_REFR_THREAD_CNT != 0
+/*The rendering worker threads also allocate and free (e.g. when opening image files)*/
+static pthread_mutex_t mem_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
 /**********************
  *      MACROS
  **********************/
+#if LV_REFR_THREAD_CNT != 0
+#define LV_MEM_LOCK()       pthread_mutex_lock(&mem_mutex)
+#define LV_MEM_UNLOCK()     pthread_mutex_unlock(&mem_mutex)
+#else
+#define LV_MEM_LOCK()
+#define LV_MEM_UNLOCK()
+#endif
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -88,46 +106,9 @@ void lv_mem_init(void)
  */
 void * lv_mem_alloc(uint32_t size)
 {
-    if(size == 0) {
-        return &zero_mem;
-    }
-    
-    /*Round the size up to 4*/
-    if(size & 0x3 ) { 
-        size = size & (~0x3);
-        size += 4;
-    }    
-    
-    void * alloc = NULL;
-
-#if LV_MEM_CUSTOM == 0 /*Use the allocation from dyn_mem*/
-    lv_mem_ent_t * e = NULL;
-    
-    //Search for a appropriate entry
-    do {
-        //Get the next entry
-        e = ent_get_next(e);
-        
-        //If there is next entry then try to allocate there
-        if(e != NULL) {
-            alloc = ent_alloc(e, size);
-        }
-    //End if there is not next entry OR the alloc. is successful
-    }while(e != NULL && alloc == NULL); 
-
-#if LV_MEM_ADD_JUNK
-    if(alloc != NULL) memset(alloc, 0xaa, size);
-#endif
-
-#else  /*Use custom, user defined malloc function*/
-    /*Allocate a header too to store the size*/
-    alloc = LV_MEM_CUSTOM_ALLOC(size + sizeof(lv_mem_header_t));
-    if(alloc != NULL) {
-        ((lv_mem_ent_t*) alloc)->header.d_size = size;
-        ((lv_mem_ent_t*) alloc)->header.used = 1;
-        alloc = &((lv_mem_ent_t*) alloc)->first_data;
-    }
-#endif
+    LV_MEM_LOCK();
+    void * alloc = mem_alloc(size);
+    LV_MEM_UNLOCK();
 
     return alloc;
 }
@@ -137,37 +118,10 @@ void * lv_mem_alloc(uint32_t size)
  * @param data pointer to an allocated memory 
  */
 void lv_mem_free(const void * data)
-{    
-    if(data == &zero_mem) return;
-    if(data == NULL) return;
-
-
-#if LV_MEM_ADD_JUNK
-    memset((void*)data, 0xbb, lv_mem_get_size(data));
-#endif
-
-    /*e points to the header*/
-    lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *) data - sizeof(lv_mem_header_t));
-    e->header.used = 0;
-
-#if LV_MEM_CUSTOM == 0
-#if LV_MEM_AUTO_DEFRAG
-    /* Make a simple defrag.
-     * Join the following free entries after this*/
-    lv_mem_ent_t * e_next;
-    e_next = ent_get_next(e);
-    while(e_next != NULL) {
-        if(e_next->header.used == 0) {
-            e->header.d_size += e_next->header.d_size + sizeof(e->header);
-        } else {
-            break;
-        }
-        e_next = ent_get_next(e_next);
-    }
-#endif
-#else /*Use custom, user defined free function*/
-    LV_MEM_CUSTOM_FREE(e);
-#endif
+{
+    LV_MEM_LOCK();
+    mem_free(data);
+    LV_MEM_UNLOCK();
 }
 
 /**
@@ -179,6 +133,9 @@ void lv_mem_free(const void * data)
  */
 void * lv_mem_realloc(void * data_p, uint32_t new_size)
 {
+    /*Hold the lock until the old memory is freed because the rendering threads also reallocate*/
+    LV_MEM_LOCK();
+
     /*data_p could be previously freed pointer (in this case it is invalid)*/
     if(data_p != NULL) {
         lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *) data_p - sizeof(lv_mem_header_t));
@@ -188,7 +145,10 @@ void * lv_mem_realloc(void * data_p, uint32_t new_size)
     }
 
     uint32_t old_size = lv_mem_get_size(data_p);
-    if(old_size == new_size) return data_p;     /*Also avoid reallocating the same memory*/
+    if(old_size == new_size) {      /*Also avoid reallocating the same memory*/
+        LV_MEM_UNLOCK();
+        return data_p;
+    }
 
 #if LV_MEM_CUSTOM == 0
     /* Only truncate the memory is possible
@@ -196,21 +156,24 @@ void * lv_mem_realloc(void * data_p, uint32_t new_size)
     if(new_size < old_size) {
         lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *) data_p - sizeof(lv_mem_header_t));
         ent_trunc(e, new_size);
+        LV_MEM_UNLOCK();
         return &e->first_data;
     }
 #endif
 
     void * new_p;
-    new_p = lv_mem_alloc(new_size);
+    new_p = mem_alloc(new_size);
     
     if(new_p != NULL && data_p != NULL) {
         /*Copy the old data to the new. Use the smaller size*/
         if(old_size != 0) {
             memcpy(new_p, data_p, LV_MATH_MIN(new_size, old_size));
-            lv_mem_free(data_p);
+            mem_free(data_p);
         }
     }
-    
+
+    LV_MEM_UNLOCK();
+
     return new_p;    
 }
 
@@ -310,6 +273,94 @@ uint32_t lv_mem_get_size(const void * data)
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Allocate a memory dynamically (without locking)
+ * @param size size of the memory to allocate in bytes
+ * @return pointer to the allocated memory 
+ */
+static void * mem_alloc(uint32_t size)
+{
+    if(size == 0) {
+        return &zero_mem;
+    }
+    
+    /*Round the size up to 4*/
+    if(size & 0x3 ) { 
+        size = size & (~0x3);
+        size += 4;
+    }    
+    
+    void * alloc = NULL;
+
+#if LV_MEM_CUSTOM == 0 /*Use the allocation from dyn_mem*/
+    lv_mem_ent_t * e = NULL;
+    
+    //Search for a appropriate entry
+    do {
+        //Get the next entry
+        e = ent_get_next(e);
+        
+        //If there is next entry then try to allocate there
+        if(e != NULL) {
+            alloc = ent_alloc(e, size);
+        }
+    //End if there is not next entry OR the alloc. is successful
+    }while(e != NULL && alloc == NULL); 
+
+#if LV_MEM_ADD_JUNK
+    if(alloc != NULL) memset(alloc, 0xaa, size);
+#endif
+
+#else  /*Use custom, user defined malloc function*/
+    /*Allocate a header too to store the size*/
+    alloc = LV_MEM_CUSTOM_ALLOC(size + sizeof(lv_mem_header_t));
+    if(alloc != NULL) {
+        ((lv_mem_ent_t*) alloc)->header.d_size = size;
+        ((lv_mem_ent_t*) alloc)->header.used = 1;
+        alloc = &((lv_mem_ent_t*) alloc)->first_data;
+    }
+#endif
+
+    return alloc;
+}
+
+/**
+ * Free an allocated data (without locking)
+ * @param data pointer to an allocated memory 
+ */
+static void mem_free(const void * data)
+{    
+    if(data == &zero_mem) return;
+    if(data == NULL) return;
+
+#if LV_MEM_ADD_JUNK
+    memset((void*)data, 0xbb, lv_mem_get_size(data));
+#endif
+
+    /*e points to the header*/
+    lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *) data - sizeof(lv_mem_header_t));
+    e->header.used = 0;
+
+#if LV_MEM_CUSTOM == 0
+#if LV_MEM_AUTO_DEFRAG
+    /* Make a simple defrag.
+     * Join the following free entries after this*/
+    lv_mem_ent_t * e_next;
+    e_next = ent_get_next(e);
+    while(e_next != NULL) {
+        if(e_next->header.used == 0) {
+            e->header.d_size += e_next->header.d_size + sizeof(e->header);
+        } else {
+            break;
+        }
+        e_next = ent_get_next(e_next);
+    }
+#endif
+#else /*Use custom, user defined free function*/
+    LV_MEM_CUSTOM_FREE(e);
+#endif
+}
+
 #if LV_MEM_CUSTOM == 0
 /**
  * Give the next entry after 'act_e'
@@ -9,6 +9,7 @@ CSRCS += lv_ll.c
 CSRCS += lv_color.c
 CSRCS += lv_txt.c
 CSRCS += lv_ufs.c
+CSRCS += lv_fs_posix.c
 CSRCS += lv_trigo.c
 
 DEPPATH += --dep-path lvgl/lv_misc
@@ -20,6 +20,7 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static int32_t trigo_round_div(int64_t a, int32_t b);
 
 /**********************
  *  STATIC VARIABLES
@@ -76,7 +77,90 @@ int16_t lv_trigo_sin(int16_t angle)
     return ret;
 }
 
+/**
+ * Return with sinus of a fine angle. It's interpolated between the degrees.
+ * @param angle angle in 1 / (1 << TRIGO_ANGLE_SHIFT) degrees
+ * @return sinus of 'angle'. sin(-90) = -32767, sin(90) = 32767
+ */
+int16_t lv_trigo_sin_fine(int32_t angle)
+{
+    int32_t full = (int32_t)360 << TRIGO_ANGLE_SHIFT;
+    int32_t half = (int32_t)180 << TRIGO_ANGLE_SHIFT;
+    int32_t quarter = (int32_t)90 << TRIGO_ANGLE_SHIFT;
+
+    angle = angle % full;
+    if(angle < 0) angle += full;
+
+    int16_t sign = 1;
+    if(angle >= half) {
+        angle -= half;
+        sign = -1;
+    }
+    if(angle > quarter) angle = half - angle;       /*sin(180 - a) = sin(a)*/
+
+    /*Interpolate between the table's values (the 90th is TRIGO_SIN_MAX)*/
+    int32_t deg = angle >> TRIGO_ANGLE_SHIFT;
+    int32_t frac = angle & ((1 << TRIGO_ANGLE_SHIFT) - 1);
+    int32_t s1 = deg < 90 ? sin0_90_table[deg] : TRIGO_SIN_MAX;
+    int32_t s2 = deg + 1 < 90 ? sin0_90_table[deg + 1] : TRIGO_SIN_MAX;
+    int32_t ret = s1 + (((s2 - s1) * frac + (1 << (TRIGO_ANGLE_SHIFT - 1))) >> TRIGO_ANGLE_SHIFT);
+
+    return sign * ret;
+}
+
+/**
+ * Get a point on a circle (0 degree is on the right, the angle grows clockwise)
+ * @param angle angle in 1 / (1 << TRIGO_ANGLE_SHIFT) degrees
+ * @param r radius of the circle (in any unit, e.g. in pixels or in sub-pixels)
+ * @param x store the x coordinate relative to the center here (rounded, in the unit of 'r')
+ * @param y store the y coordinate relative to the center here (rounded, in the unit of 'r')
+ */
+void lv_trigo_polar(int32_t angle, int32_t r, int32_t * x, int32_t * y)
+{
+    int64_t s = lv_trigo_sin_fine(angle);
+    int64_t c = lv_trigo_sin_fine(angle + ((int32_t)90 << TRIGO_ANGLE_SHIFT));
+
+    *x = trigo_round_div(c * r, TRIGO_SIN_MAX);
+    *y = trigo_round_div(s * r, TRIGO_SIN_MAX);
+}
+
+/**
+ * Integer square root
+ * @param x a number
+ * @return the square root of 'x' rounded down
+ */
+uint32_t lv_trigo_sqrt(uint64_t x)
+{
+    uint64_t res = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while(bit > x) bit >>= 2;
+
+    while(bit != 0) {
+        if(x >= res + bit) {
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return res;
+}
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+/**
+ * Divide and round to the nearest integer
+ * @param a the dividend
+ * @param b the divisor (positive)
+ * @return the rounded quotient
+ */
+static int32_t trigo_round_div(int64_t a, int32_t b)
+{
+    if(a >= 0) return (a + b / 2) / b;
+    else return (a - b / 2) / b;
+}
@@ -20,6 +20,7 @@ extern "C" {
  *      DEFINES
  *********************/
 #define TRIGO_SIN_MAX 32767
+#define TRIGO_ANGLE_SHIFT 4     /*The fine angles are in 1/16 degrees*/
 
 /**********************
  *      TYPEDEFS
@@ -36,6 +37,29 @@ extern "C" {
  */
 int16_t lv_trigo_sin(int16_t angle);
 
+/**
+ * Return with sinus of a fine angle. It's interpolated between the degrees.
+ * @param angle angle in 1 / (1 << TRIGO_ANGLE_SHIFT) degrees
+ * @return sinus of 'angle'. sin(-90) = -32767, sin(90) = 32767
+ */
+int16_t lv_trigo_sin_fine(int32_t angle);
+
+/**
+ * Get a point on a circle (0 degree is on the right, the angle grows clockwise)
+ * @param angle angle in 1 / (1 << TRIGO_ANGLE_SHIFT) degrees
+ * @param r radius of the circle (in any unit, e.g. in pixels or in sub-pixels)
+ * @param x store the x coordinate relative to the center here (rounded, in the unit of 'r')
+ * @param y store the y coordinate relative to the center here (rounded, in the unit of 'r')
+ */
+void lv_trigo_polar(int32_t angle, int32_t r, int32_t * x, int32_t * y);
+
+/**
+ * Integer square root
+ * @param x a number
+ * @return the square root of 'x' rounded down
+ */
+uint32_t lv_trigo_sqrt(uint64_t x);
+
 /**********************
  *      MACROS
  **********************/
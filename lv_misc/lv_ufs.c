@@ -65,6 +65,7 @@ void lv_ufs_init(void)
     ufs_drv.seek = lv_ufs_seek;
     ufs_drv.tell = lv_ufs_tell;
     ufs_drv.size = lv_ufs_size;
+    ufs_drv.ptr = lv_ufs_ptr;
     ufs_drv.trunc = lv_ufs_trunc;
     ufs_drv.free = lv_ufs_free;
     
@@ -380,6 +381,26 @@ lv_fs_res_t lv_ufs_size (void * file_p, uint32_t * size_p)
     return LV_FS_RES_OK;
 }
 
+/**
+ * Give a pointer to the data of the file (the files of ufs are in the RAM)
+ * @param file_p file_p pointer to an 'ufs_file_t' variable. (opened with lv_ufs_open )
+ * @param ptr_p pointer to store the address of the data
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_ufs_ptr (void * file_p, const void ** ptr_p)
+{
+    lv_ufs_file_t * fp = file_p;    /*Convert type*/
+    lv_ufs_ent_t* ent = fp->ent;
+
+    if(fp->ar == 0) return LV_FS_RES_DENIED;    /*Not opened for read*/
+    if(ent->data_d == NULL) return LV_FS_RES_NOT_IMP;  /*Empty file*/
+
+    *ptr_p = ent->data_d;
+
+    return LV_FS_RES_OK;
+}
+
 /**
  * Initialize a lv_ufs_read_dir_t variable to directory reading
  * @param rddir_p pointer to a 'ufs_dir_t' variable
@@ -162,6 +162,15 @@ lv_fs_res_t lv_ufs_trunc (void * file_p);
  */
 lv_fs_res_t lv_ufs_size (void * file_p, uint32_t * size_p);
 
+/**
+ * Give a pointer to the data of the file (the files of ufs are in the RAM)
+ * @param file_p file_p pointer to an 'ufs_file_t' variable. (opened with lv_ufs_open )
+ * @param ptr_p pointer to store the address of the data
+ * @return LV_FS_RES_OK: no error, the file is read
+ *         any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_ufs_ptr (void * file_p, const void ** ptr_p);
+
 /**
  * Initialize a lv_ufs_read_dir_t variable to directory reading
  * @param rddir_p pointer to a 'ufs_read_dir_t' variable
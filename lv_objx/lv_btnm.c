@@ -404,6 +404,7 @@ static bool lv_btnm_design(lv_obj_t * btnm, const lv_area_t * mask, lv_design_mo
     	lv_coord_t btn_w;
     	lv_coord_t btn_h;
     	bool border_mod = false;
+    	lv_style_t style_tmp;
 
     	uint16_t btn_i = 0;
     	uint16_t txt_i = 0;
@@ -431,19 +432,21 @@ static bool lv_btnm_design(lv_obj_t * btnm, const lv_area_t * mask, lv_design_mo
             else if(btn_i == ext->btn_id_pr && btn_i == ext->btn_id_tgl) btn_style = lv_btnm_get_style(btnm, LV_BTNM_STYLE_BTN_TGL_PR);
             else btn_style = lv_btnm_get_style(btnm, LV_BTNM_STYLE_BTN_REL);    /*Not possible option, just to be sure*/
 
-			/*On the right buttons clear the border if only right borders are drawn*/
+			/* On the right buttons clear the border if only right borders are drawn
+			 * (in a temporal style because the button matrix can be drawn parallel on more threads)*/
 			if(ext->map_p[txt_i + 1][0] == '\0' || ext->map_p[txt_i + 1][0] == '\n') {
 			    if(btn_style->body.border.part == LV_BORDER_RIGHT) {
-			        btn_style->body.border.part  = LV_BORDER_NONE;
+			        lv_style_copy(&style_tmp, btn_style);
+			        style_tmp.body.border.part  = LV_BORDER_NONE;
 			        border_mod = true;
 			    }
 			}
 
-			lv_draw_rect(&area_tmp, mask, btn_style);
-
 			if(border_mod) {
 			    border_mod = false;
-                btn_style->body.border.part = LV_BORDER_RIGHT;
+			    lv_draw_rect(&area_tmp, mask, &style_tmp);
+			} else {
+			    lv_draw_rect(&area_tmp, mask, btn_style);
 			}
 
 
@@ -11,6 +11,7 @@
 
 #include "lv_cb.h"
 #include "../lv_core/lv_group.h"
+#include "../lv_draw/lv_draw.h"
 #include "../lv_themes/lv_theme.h"
 
 /*********************
@@ -247,27 +248,25 @@ static bool lv_bullet_design(lv_obj_t * bullet, const lv_area_t * mask, lv_desig
     if(mode == LV_DESIGN_COVER_CHK) {
         return ancestor_bullet_design(bullet, mask, mode);
     } else if(mode == LV_DESIGN_DRAW_MAIN) {
+        lv_style_t * style = lv_obj_get_style(bullet);
 #if USE_LV_GROUP
+        lv_style_t style_focus;     /*Local because the same object can be drawn parallel on more threads*/
         /* If the check box is the active in a group and
          * the background is not visible (transparent or empty)
          * then activate the style of the bullet*/
-        lv_style_t * style_ori = lv_obj_get_style(bullet);
         lv_obj_t * bg = lv_obj_get_parent(bullet);
         lv_style_t * style_page = lv_obj_get_style(bg);
         lv_group_t * g = lv_obj_get_group(bg);
         if(style_page->body.empty != 0 || style_page->body.opa == LV_OPA_TRANSP) { /*Background is visible?*/
             if(lv_group_get_focused(g) == bg) {
-                lv_style_t * style_mod;
-                style_mod = lv_group_mod_style(g, style_ori);
-                bullet->style_p = style_mod;  /*Temporally change the style to the activated */
+                lv_group_mod_style_copy(g, style, &style_focus);
+                style = &style_focus;
             }
         }
 #endif
-        ancestor_bullet_design(bullet, mask, mode);
-
-#if USE_LV_GROUP
-        bullet->style_p = style_ori;  /*Revert the style*/
-#endif
+        /* Draw like the ancestor but with the activated style.
+         * Don't change 'style_p' because the bullet can be drawn parallel on more threads*/
+        lv_draw_rect(&bullet->coords, mask, style);
     } else if(mode == LV_DESIGN_DRAW_POST) {
         ancestor_bullet_design(bullet, mask, mode);
     }
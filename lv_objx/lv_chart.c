@@ -11,6 +11,7 @@
 
 #include "lv_chart.h"
 #include "../lv_draw/lv_draw.h"
+#include "../lv_misc/lv_mem.h"
 #include "../lv_themes/lv_theme.h"
 
 /*********************
@@ -33,6 +34,7 @@ static bool lv_chart_design(lv_obj_t * chart, const lv_area_t * mask, lv_design_
 static lv_res_t lv_chart_signal(lv_obj_t * chart, lv_signal_t sign, void * param);
 static void lv_chart_draw_div(lv_obj_t * chart, const lv_area_t * mask);
 static void lv_chart_draw_lines(lv_obj_t * chart, const lv_area_t * mask);
+static void lv_chart_draw_areas(lv_obj_t * chart, const lv_area_t * mask);
 static void lv_chart_draw_points(lv_obj_t * chart, const lv_area_t * mask);
 static void lv_chart_draw_cols(lv_obj_t * chart, const lv_area_t * mask);
 
@@ -407,6 +409,7 @@ static bool lv_chart_design(lv_obj_t * chart, const lv_area_t * mask, lv_design_
 
 		lv_chart_draw_div(chart, mask);
 
+		if(ext->type & LV_CHART_TYPE_AREA) lv_chart_draw_areas(chart, mask);
 		if(ext->type & LV_CHART_TYPE_LINE) lv_chart_draw_lines(chart, mask);
 		if(ext->type & LV_CHART_TYPE_COLUMN) lv_chart_draw_cols(chart, mask);
 		if(ext->type & LV_CHART_TYPE_POINT) lv_chart_draw_points(chart, mask);
@@ -514,9 +517,7 @@ static void lv_chart_draw_lines(lv_obj_t * chart, const lv_area_t * mask)
 {
 	lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
 
-	uint8_t i;
-	lv_point_t p1;
-	lv_point_t p2;
+	uint16_t i;
 	lv_coord_t w = lv_obj_get_width(chart);
 	lv_coord_t h = lv_obj_get_height(chart);
     lv_coord_t x_ofs = chart->coords.x1;
@@ -528,29 +529,77 @@ static void lv_chart_draw_lines(lv_obj_t * chart, const lv_area_t * mask)
 	lines.line.opa = ext->series.opa;
     lines.line.width = ext->series.width;
 
+    if(ext->point_cnt < 2) return;
+
+    /*The points of a data line*/
+    lv_point_t * points = lv_mem_alloc(ext->point_cnt * sizeof(lv_point_t));
+    if(points == NULL) return;
+
 	/*Go through all data lines*/
 	LL_READ_BACK(ext->series_ll, ser) {
 		lines.line.color = ser->color;
 
-		p1.x = 0 + x_ofs;
-		p2.x = 0 + x_ofs;
-		y_tmp = (int32_t)((int32_t) ser->points[0] - ext->ymin) * h;
-		y_tmp = y_tmp / (ext->ymax - ext->ymin);
-		p2.y = h - y_tmp + y_ofs;
+		for(i = 0; i < ext->point_cnt; i ++) {
+			points[i].x = ((w * i) / (ext->point_cnt - 1)) + x_ofs;
+
+			y_tmp = (int32_t)((int32_t) ser->points[i] - ext->ymin) * h;
+			y_tmp = y_tmp / (ext->ymax - ext->ymin);
+			points[i].y = h - y_tmp + y_ofs;
+		}
+
+		/*Round joints to connect the segments smoothly*/
+		lv_draw_polyline(points, ext->point_cnt, mask, &lines, LV_DRAW_LINE_CAP_BUTT, LV_DRAW_LINE_JOIN_ROUND);
+	}
+
+	lv_mem_free(points);
+}
+
+/**
+ * Fill the area below the data lines of a chart
+ * @param chart pointer to chart object
+ * @param mask mask, inherited from the design function
+ */
+static void lv_chart_draw_areas(lv_obj_t * chart, const lv_area_t * mask)
+{
+	lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+
+	uint16_t i;
+	lv_coord_t w = lv_obj_get_width(chart);
+	lv_coord_t h = lv_obj_get_height(chart);
+    lv_coord_t x_ofs = chart->coords.x1;
+    lv_coord_t y_ofs = chart->coords.y1;
+	int32_t y_tmp;
+	lv_chart_series_t *ser;
+	lv_style_t areas;
+	lv_style_copy(&areas, &lv_style_plain);
+	areas.body.opa = (uint16_t)((uint16_t)ext->series.opa * LV_OPA_50) >> 8;    /*Lighter to see the lines and the other areas*/
 
-		for(i = 1; i < ext->point_cnt; i ++) {
-			p1.x = p2.x;
-			p1.y = p2.y;
+    if(ext->point_cnt < 2) return;
 
-			p2.x = ((w * i) / (ext->point_cnt - 1)) + x_ofs;
+    /*The points of a data line and the two bottom corners*/
+    lv_point_t * points = lv_mem_alloc((ext->point_cnt + 2) * sizeof(lv_point_t));
+    if(points == NULL) return;
+
+	/*Go through all data lines*/
+	LL_READ_BACK(ext->series_ll, ser) {
+		areas.body.main_color = ser->color;
+
+		for(i = 0; i < ext->point_cnt; i ++) {
+			points[i].x = ((w * i) / (ext->point_cnt - 1)) + x_ofs;
 
 			y_tmp = (int32_t)((int32_t) ser->points[i] - ext->ymin) * h;
 			y_tmp = y_tmp / (ext->ymax - ext->ymin);
-			p2.y = h - y_tmp + y_ofs;
-
-			lv_draw_line(&p1, &p2, mask, &lines);
+			points[i].y = h - y_tmp + y_ofs;
 		}
+		points[ext->point_cnt].x = points[ext->point_cnt - 1].x;
+		points[ext->point_cnt].y = chart->coords.y2;
+		points[ext->point_cnt + 1].x = points[0].x;
+		points[ext->point_cnt + 1].y = chart->coords.y2;
+
+		lv_draw_polygon(points, ext->point_cnt + 2, mask, &areas, LV_DRAW_FILL_RULE_NONZERO);
 	}
+
+	lv_mem_free(points);
 }
 
 /**
@@ -16,6 +16,7 @@
 #include "../lv_misc/lv_txt.h"
 #include "../lv_misc/lv_trigo.h"
 #include "../lv_misc/lv_math.h"
+#include "../lv_core/lv_group.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -38,7 +39,12 @@
 static bool lv_gauge_design(lv_obj_t * gauge, const lv_area_t * mask, lv_design_mode_t mode);
 static lv_res_t lv_gauge_signal(lv_obj_t * gauge, lv_signal_t sign, void * param);
 static void lv_gauge_draw_scale(lv_obj_t * gauge, const lv_area_t * mask);
+static void lv_gauge_draw_label_lines(lv_obj_t * gauge, const lv_area_t * mask);
 static void lv_gauge_draw_needle(lv_obj_t * gauge, const lv_area_t * mask);
+static void lv_gauge_get_needle_end(lv_obj_t * gauge, int16_t value, lv_point_t * end);
+static void lv_gauge_invalidate_needle(lv_obj_t * gauge, int16_t value);
+static void lv_gauge_refr_label_pts(lv_obj_t * gauge);
+static void lv_gauge_get_label_pt(lv_obj_t * gauge, uint8_t id, lv_coord_t r, lv_point_t * p);
 
 /**********************
  *  STATIC VARIABLES
@@ -75,6 +81,10 @@ lv_obj_t * lv_gauge_create(lv_obj_t * par, lv_obj_t * copy)
     ext->values = NULL;
     ext->needle_colors = NULL;
     ext->label_count = LV_GAUGE_DEF_LABEL_COUNT;
+    ext->label_pts = NULL;
+    ext->label_pts_r_txt = 0;
+    ext->label_pts_r_out = 0;
+    ext->label_pts_r_in = 0;
     if(ancestor_signal == NULL) ancestor_signal = lv_obj_get_signal_func(new_gauge);
     if(ancestor_design == NULL) ancestor_design = lv_obj_get_design_func(new_gauge);
 
@@ -163,10 +173,12 @@ void lv_gauge_set_value(lv_obj_t * gauge, uint8_t needle_id, int16_t value)
     if(value > max) value = max;
     else if(value < min) value = min;
 
-    ext->values[needle_id] = value;
-
+    if(ext->values[needle_id] == value) return;
 
-    lv_obj_invalidate(gauge);
+    /*Only the needle moves: redraw its old and new area*/
+    lv_gauge_invalidate_needle(gauge, ext->values[needle_id]);
+    ext->values[needle_id] = value;
+    lv_gauge_invalidate_needle(gauge, value);
 }
 
 
@@ -183,6 +195,8 @@ void lv_gauge_set_scale(lv_obj_t * gauge, uint16_t angle, uint8_t line_cnt, uint
 
     lv_gauge_ext_t * ext = lv_obj_get_ext_attr(gauge);
     ext->label_count = label_cnt;
+
+    lv_gauge_refr_label_pts(gauge);
 }
 
 /*=====================
@@ -250,32 +264,12 @@ static bool lv_gauge_design(lv_obj_t * gauge, const lv_area_t * mask, lv_design_
     }
     /*Draw the object*/
     else if(mode == LV_DESIGN_DRAW_MAIN) {
-
-        /* Store the real pointer because of 'lv_group'
-         * If the object is in focus 'lv_obj_get_style()' will give a pointer to tmp style
-         * and to the real object style. It is important because of style change tricks below*/
-        lv_style_t *style_ori_p = gauge->style_p;
-        lv_style_t *style = lv_obj_get_style(gauge);
-        lv_gauge_ext_t *ext = lv_obj_get_ext_attr(gauge);
-
         lv_gauge_draw_scale(gauge, mask);
 
         /*Draw the ancestor line meter with max value to show the rainbow like line colors*/
-        uint16_t line_cnt_tmp = ext->lmeter.line_cnt;
-        ancestor_design(gauge, mask, mode);           /*To draw lines*/
-
-        /*Temporally modify the line meter to draw thicker and longer lines where labels are*/
-        lv_style_t style_tmp;
-        lv_style_copy(&style_tmp, style);
-        ext->lmeter.line_cnt = ext->label_count;                        /*Only to labels*/
-        style_tmp.line.width = style_tmp.line.width * 2;                /*Ticker lines*/
-        style_tmp.body.padding.hor = style_tmp.body.padding.hor * 2;    /*Longer lines*/
-        gauge->style_p = &style_tmp;
-
         ancestor_design(gauge, mask, mode);           /*To draw lines*/
 
-        ext->lmeter.line_cnt = line_cnt_tmp;          /*Restore the parameters*/
-        gauge->style_p = style_ori_p;                 /*Restore the ORIGINAL style pointer*/
+        lv_gauge_draw_label_lines(gauge, mask);
 
         lv_gauge_draw_needle(gauge, mask);
 
@@ -307,6 +301,17 @@ static lv_res_t lv_gauge_signal(lv_obj_t * gauge, lv_signal_t sign, void * param
     if(sign == LV_SIGNAL_CLEANUP) {
         lv_mem_free(ext->values);
         ext->values = NULL;
+        lv_mem_free(ext->label_pts);
+        ext->label_pts = NULL;
+    }
+    else if(sign == LV_SIGNAL_STYLE_CHG) {
+        lv_gauge_refr_label_pts(gauge);
+    }
+    else if(sign == LV_SIGNAL_CORD_CHG) {
+        if(lv_obj_get_width(gauge) != lv_area_get_width(param) ||
+           lv_obj_get_height(gauge) != lv_area_get_height(param)) {
+            lv_gauge_refr_label_pts(gauge);
+        }
     }
 
     return res;
@@ -326,22 +331,21 @@ static void lv_gauge_draw_scale(lv_obj_t * gauge, const lv_area_t * mask)
     lv_coord_t r = lv_obj_get_width(gauge) / 2 - (3 * style->body.padding.hor) - style->body.padding.inner;
     lv_coord_t x_ofs = lv_obj_get_width(gauge) / 2 + gauge->coords.x1;
     lv_coord_t y_ofs = lv_obj_get_height(gauge) / 2 + gauge->coords.y1;
-    int16_t scale_angle = lv_lmeter_get_scale_angle(gauge);
     uint16_t label_num = ext->label_count;
-    int16_t angle_ofs = 90 + (360 - scale_angle) / 2;
     int16_t min = lv_gauge_get_min_value(gauge);
     int16_t max = lv_gauge_get_max_value(gauge);
+    bool cached = false;
+    if(ext->label_pts != NULL && ext->label_pts_r_txt == r) cached = true;   /*Not the same radius e.g. with a focus style*/
 
     uint8_t i;
     for(i = 0; i < label_num; i++) {
-        /*Calculate the position a scale label*/
-        int16_t angle = (i * scale_angle) / (label_num - 1) + angle_ofs;
-
-        lv_coord_t y = (int32_t)((int32_t)lv_trigo_sin(angle) * r) / TRIGO_SIN_MAX;
-        y += y_ofs;
+        /*Get the position of a scale label*/
+        lv_point_t p;
+        if(cached) p = ext->label_pts[3 * i];
+        else lv_gauge_get_label_pt(gauge, i, r, &p);
 
-        lv_coord_t x = (int32_t)((int32_t)lv_trigo_sin(angle + 90) * r) / TRIGO_SIN_MAX;
-        x += x_ofs;
+        lv_coord_t x = p.x + x_ofs;
+        lv_coord_t y = p.y + y_ofs;
 
         int16_t scale_act = (int32_t)((int32_t)(max - min) * i) /  (label_num - 1);
         scale_act += min;
@@ -361,6 +365,63 @@ static void lv_gauge_draw_scale(lv_obj_t * gauge, const lv_area_t * mask)
         lv_draw_label(&label_cord, mask, style, scale_txt, LV_TXT_FLAG_NONE, NULL);
     }
 }
+
+/**
+ * Draw thicker and longer lines where the labels are (like the line meter draws its lines).
+ * The object is not modified so the gauge can be drawn parallel on more threads.
+ * @param gauge pointer to gauge object
+ * @param mask mask of drawing
+ */
+static void lv_gauge_draw_label_lines(lv_obj_t * gauge, const lv_area_t * mask)
+{
+    lv_gauge_ext_t * ext = lv_obj_get_ext_attr(gauge);
+    lv_style_t * style = lv_obj_get_style(gauge);
+    uint8_t line_cnt = ext->label_count;                /*Only to labels*/
+
+    lv_style_t style_tmp;
+    lv_style_copy(&style_tmp, style);
+    style_tmp.line.width = style_tmp.line.width * 2;    /*Ticker lines*/
+#if USE_LV_GROUP
+    lv_group_t *g = lv_obj_get_group(gauge);
+    if(lv_group_get_focused(g) == gauge) {
+        style_tmp.line.width += 1;
+    }
+#endif
+
+    lv_coord_t r_out = lv_obj_get_width(gauge) / 2;
+    lv_coord_t r_in = r_out - style->body.padding.hor * 2;     /*Longer lines*/
+    lv_coord_t x_ofs = lv_obj_get_width(gauge) / 2 + gauge->coords.x1;
+    lv_coord_t y_ofs = lv_obj_get_height(gauge) / 2 + gauge->coords.y1;
+    int16_t min = lv_gauge_get_min_value(gauge);
+    int16_t max = lv_gauge_get_max_value(gauge);
+    int16_t level = (int32_t)((int32_t)(ext->lmeter.cur_value - min) * line_cnt) / (max - min);
+    bool cached = false;
+    if(ext->label_pts != NULL && ext->label_pts_r_out == r_out && ext->label_pts_r_in == r_in) cached = true;
+    uint8_t i;
+
+    for(i = 0; i < line_cnt; i++) {
+        /*Get the end points of the line of a scale label*/
+        lv_point_t p1;
+        lv_point_t p2;
+        if(cached) {
+            p1 = ext->label_pts[3 * i + 1];
+            p2 = ext->label_pts[3 * i + 2];
+        } else {
+            lv_gauge_get_label_pt(gauge, i, r_out, &p1);
+            lv_gauge_get_label_pt(gauge, i, r_in, &p2);
+        }
+        p1.x += x_ofs;
+        p1.y += y_ofs;
+        p2.x += x_ofs;
+        p2.y += y_ofs;
+
+        if(i >= level) style_tmp.line.color = style->line.color;
+        else style_tmp.line.color = lv_color_mix(style->body.grad_color, style->body.main_color, (255 * i) /  line_cnt);
+
+        lv_draw_line(&p1, &p2, mask, &style_tmp);
+    }
+}
+
 /**
  * Draw the needles of a gauge
  * @param gauge pointer to gauge object
@@ -372,32 +433,25 @@ static void lv_gauge_draw_needle(lv_obj_t * gauge, const lv_area_t * mask)
     lv_gauge_ext_t * ext = lv_obj_get_ext_attr(gauge);
     lv_style_t * style = lv_gauge_get_style(gauge);
 
-    lv_coord_t r = lv_obj_get_width(gauge) / 2 - style->body.padding.hor;
     lv_coord_t x_ofs = lv_obj_get_width(gauge) / 2 + gauge->coords.x1;
     lv_coord_t y_ofs = lv_obj_get_height(gauge) / 2 + gauge->coords.y1;
-    uint16_t angle = lv_lmeter_get_scale_angle(gauge);
-    int16_t angle_ofs = 90 + (360 - angle) / 2;
-    int16_t min = lv_gauge_get_min_value(gauge);
-    int16_t max = lv_gauge_get_max_value(gauge);
-    lv_point_t p_mid;
-    lv_point_t p_end;
+    lv_point_t needle[2];       /*Middle and end point*/
     uint8_t i;
 
     lv_style_copy(&style_needle, style);
 
-    p_mid.x = x_ofs;
-    p_mid.y = y_ofs;
+    needle[0].x = x_ofs;
+    needle[0].y = y_ofs;
     for(i = 0; i < ext->needle_count; i++) {
         /*Calculate the end point of a needle*/
-        int16_t needle_angle = (ext->values[i] - min) * angle / (max - min) + angle_ofs;
-        p_end.y = (lv_trigo_sin(needle_angle) * r) / TRIGO_SIN_MAX + y_ofs;
-        p_end.x = (lv_trigo_sin(needle_angle + 90) * r) / TRIGO_SIN_MAX + x_ofs;
+        lv_gauge_get_needle_end(gauge, ext->values[i], &needle[1]);
 
         /*Draw the needle with the corresponding color*/
         if(ext->needle_colors == NULL) style_needle.line.color = LV_GAUGE_DEF_NEEDLE_COLOR;
         else style_needle.line.color = ext->needle_colors[i];
 
-        lv_draw_line(&p_mid, &p_end, mask, &style_needle);
+        /*Rounded tip*/
+        lv_draw_polyline(needle, 2, mask, &style_needle, LV_DRAW_LINE_CAP_ROUND, LV_DRAW_LINE_JOIN_MITER);
     }
 
     /*Draw the needle middle area*/
@@ -416,4 +470,106 @@ static void lv_gauge_draw_needle(lv_obj_t * gauge, const lv_area_t * mask)
     lv_draw_rect(&nm_cord, mask, &style_neddle_mid);
 }
 
+/**
+ * Get the end point of a needle. The needle moves with sub-degree steps.
+ * @param gauge pointer to gauge object
+ * @param value value of the needle
+ * @param end store the end point here (absolute coordinates)
+ */
+static void lv_gauge_get_needle_end(lv_obj_t * gauge, int16_t value, lv_point_t * end)
+{
+    lv_style_t * style = lv_gauge_get_style(gauge);
+    lv_coord_t r = lv_obj_get_width(gauge) / 2 - style->body.padding.hor;
+    lv_coord_t x_ofs = lv_obj_get_width(gauge) / 2 + gauge->coords.x1;
+    lv_coord_t y_ofs = lv_obj_get_height(gauge) / 2 + gauge->coords.y1;
+    int16_t scale_angle = lv_lmeter_get_scale_angle(gauge);
+    int32_t angle_ofs = ((int32_t)90 << TRIGO_ANGLE_SHIFT) + (((int32_t)(360 - scale_angle) << TRIGO_ANGLE_SHIFT) / 2);
+    int16_t min = lv_gauge_get_min_value(gauge);
+    int16_t max = lv_gauge_get_max_value(gauge);
+
+    int32_t angle = (((int32_t)(value - min) * scale_angle) << TRIGO_ANGLE_SHIFT) / (max - min) + angle_ofs;
+    int32_t x;
+    int32_t y;
+    lv_trigo_polar(angle, r, &x, &y);
+    end->x = x + x_ofs;
+    end->y = y + y_ofs;
+}
+
+/**
+ * Invalidate the area of a needle (with the needle middle circle)
+ * @param gauge pointer to gauge object
+ * @param value value of the needle
+ */
+static void lv_gauge_invalidate_needle(lv_obj_t * gauge, int16_t value)
+{
+    lv_style_t * style = lv_gauge_get_style(gauge);
+    lv_coord_t x_ofs = lv_obj_get_width(gauge) / 2 + gauge->coords.x1;
+    lv_coord_t y_ofs = lv_obj_get_height(gauge) / 2 + gauge->coords.y1;
+    lv_coord_t ext_size = (style->line.width >> 1) + 2;     /*Half width, round cap and anti-aliasing*/
+    lv_point_t end;
+    lv_area_t area;
+
+    lv_gauge_get_needle_end(gauge, value, &end);
+
+    area.x1 = LV_MATH_MIN(x_ofs, end.x) - ext_size;
+    area.y1 = LV_MATH_MIN(y_ofs, end.y) - ext_size;
+    area.x2 = LV_MATH_MAX(x_ofs, end.x) + ext_size;
+    area.y2 = LV_MATH_MAX(y_ofs, end.y) + ext_size;
+
+    /*The needle middle circle*/
+    area.x1 = LV_MATH_MIN(area.x1, x_ofs - style->body.padding.ver);
+    area.y1 = LV_MATH_MIN(area.y1, y_ofs - style->body.padding.ver);
+    area.x2 = LV_MATH_MAX(area.x2, x_ofs + style->body.padding.ver);
+    area.y2 = LV_MATH_MAX(area.y2, y_ofs + style->body.padding.ver);
+
+    lv_obj_invalidate_area(gauge, &area);
+}
+
+/**
+ * Calculate the positions of the labels and the end points of their lines again
+ * (after the size, the style or the scale is changed)
+ * @param gauge pointer to gauge object
+ */
+static void lv_gauge_refr_label_pts(lv_obj_t * gauge)
+{
+    lv_gauge_ext_t * ext = lv_obj_get_ext_attr(gauge);
+    lv_style_t * style = lv_obj_get_style(gauge);
+
+    ext->label_pts = lv_mem_realloc(ext->label_pts, sizeof(lv_point_t) * 3 * ext->label_count);
+    lv_mem_assert(ext->label_pts);
+
+    /*The same radii as in 'lv_gauge_draw_scale' and 'lv_gauge_draw_label_lines'*/
+    ext->label_pts_r_txt = lv_obj_get_width(gauge) / 2 - (3 * style->body.padding.hor) - style->body.padding.inner;
+    ext->label_pts_r_out = lv_obj_get_width(gauge) / 2;
+    ext->label_pts_r_in = ext->label_pts_r_out - style->body.padding.hor * 2;
+
+    uint8_t i;
+    for(i = 0; i < ext->label_count; i++) {
+        lv_gauge_get_label_pt(gauge, i, ext->label_pts_r_txt, &ext->label_pts[3 * i]);
+        lv_gauge_get_label_pt(gauge, i, ext->label_pts_r_out, &ext->label_pts[3 * i + 1]);
+        lv_gauge_get_label_pt(gauge, i, ext->label_pts_r_in, &ext->label_pts[3 * i + 2]);
+    }
+}
+
+/**
+ * Calculate a point in the direction of a scale label relative to the center with sub-degree precision
+ * @param gauge pointer to gauge object
+ * @param id index of the label
+ * @param r distance of the point from the center
+ * @param p store the point here
+ */
+static void lv_gauge_get_label_pt(lv_obj_t * gauge, uint8_t id, lv_coord_t r, lv_point_t * p)
+{
+    lv_gauge_ext_t * ext = lv_obj_get_ext_attr(gauge);
+    int16_t scale_angle = lv_lmeter_get_scale_angle(gauge);
+    int32_t angle_ofs = ((int32_t)90 << TRIGO_ANGLE_SHIFT) + (((int32_t)(360 - scale_angle) << TRIGO_ANGLE_SHIFT) / 2);
+    int32_t angle = (((int32_t)id * scale_angle) << TRIGO_ANGLE_SHIFT) / (ext->label_count - 1) + angle_ofs;
+
+    int32_t x;
+    int32_t y;
+    lv_trigo_polar(angle, r, &x, &y);
+    p->x = x;
+    p->y = y;
+}
+
 #endif
@@ -43,6 +43,10 @@ typedef struct
     const lv_color_t * needle_colors;        /*Color of the needles (lv_color_t my_colors[needle_num])*/
     uint8_t needle_count;             /*Number of needles*/
     uint8_t label_count;              /*Number of labels on the scale*/
+    lv_point_t * label_pts;           /*Center of the label, outer and inner end point of its line relative to the center (to skip the trigonometry on redraw)*/
+    lv_coord_t label_pts_r_txt;       /*The radii the 'label_pts' are calculated with*/
+    lv_coord_t label_pts_r_out;
+    lv_coord_t label_pts_r_in;
 }lv_gauge_ext_t;
 
 /**********************
@@ -11,10 +11,15 @@
 
 #include "lv_img.h"
 #include "../lv_draw/lv_draw.h"
+#include "../lv_draw/lv_draw_img_cache.h"
+#include "../lv_draw/lv_draw_img_dec.h"
 #include "../lv_themes/lv_theme.h"
 #include "../lv_misc/lv_fs.h"
 #include "../lv_misc/lv_ufs.h"
 #include "../lv_misc/lv_txt.h"
+#include "../lv_misc/lv_trigo.h"
+#include "../lv_misc/lv_math.h"
+#include <stdio.h>
 
 /*********************
  *      DEFINES
@@ -30,6 +35,8 @@
 static bool lv_img_design(lv_obj_t * img, const lv_area_t * mask, lv_design_mode_t mode);
 static lv_res_t lv_img_signal(lv_obj_t * img, lv_signal_t sign, void * param);
 static bool lv_img_is_symbol(const char * txt);
+static bool lv_img_is_transformed(lv_obj_t * img);
+static void lv_img_get_tile_size(lv_obj_t * img, lv_point_t * size);
 
 /**********************
  *  STATIC VARIABLES
@@ -68,6 +75,9 @@ lv_obj_t * lv_img_create(lv_obj_t * par, lv_obj_t * copy)
     ext->transp = 0;
     ext->upscale = 0;
     ext->auto_size = 1;
+    ext->zoom = LV_IMG_ZOOM_NONE;
+    ext->angle = 0;
+    ext->antialias = 1;
 
     /*Init the new object*/    
     lv_obj_set_signal_func(new_img, lv_img_signal);
@@ -85,6 +95,9 @@ lv_obj_t * lv_img_create(lv_obj_t * par, lv_obj_t * copy)
         lv_img_ext_t * copy_ext = lv_obj_get_ext_attr(copy);
     	ext->auto_size = copy_ext->auto_size;
         ext->upscale = copy_ext->upscale;
+        ext->zoom = copy_ext->zoom;
+        ext->angle = copy_ext->angle;
+        ext->antialias = copy_ext->antialias;
     	lv_img_set_file(new_img, copy_ext->fn);
 
         /*Refresh the style with new signal function*/
@@ -97,14 +110,19 @@ lv_obj_t * lv_img_create(lv_obj_t * par, lv_obj_t * copy)
 /**
  * Create a file to the RAMFS from a picture data
  * @param fn file name of the new file (e.g. "pic1", will be available at "U:/pic1")
- * @param data pointer to a color map with lv_img_raw_header_t header
+ * @param data pointer to an image with lv_img_raw_header_t header (raw, indexed or compressed, see 'lv_img_format_t')
  * @return result of the file operation. LV_FS_RES_OK or any error from lv_fs_res_t
  */
 lv_fs_res_t lv_img_create_file(const char * fn, const lv_color_int_t * data)
 {
 	const lv_img_raw_header_t * raw_p = (lv_img_raw_header_t *) data;
 	lv_fs_res_t res;
-	res = lv_ufs_create_const(fn, data, raw_p->w * raw_p->h * sizeof(lv_color_t) + sizeof(lv_img_raw_header_t));
+	res = lv_ufs_create_const(fn, data, lv_draw_img_dec_get_size(raw_p));
+
+	/*An image with the same name might be cached*/
+	char path[LV_FS_MAX_FN_LENGTH + 3];
+	snprintf(path, sizeof(path), "%c:/%s", UFS_LETTER, fn);
+	lv_draw_img_cache_invalidate(path);
 
 	return res;
 }
@@ -124,25 +142,18 @@ void lv_img_set_file(lv_obj_t * img, const char * fn)
     
     /*Handle normal images*/
 	if(lv_img_is_symbol(fn) == false) {
-        lv_fs_file_t file;
         lv_fs_res_t res;
         lv_img_raw_header_t header;
-        uint32_t rn;
-        res = lv_fs_open(&file, fn, LV_FS_MODE_RD);
-        if(res == LV_FS_RES_OK) {
-            res = lv_fs_read(&file, &header, sizeof(header), &rn);
-        }
+        res = lv_draw_img_cache_get_header(fn, &header);
 
         /*Create a dummy header on fs error*/
-        if(res != LV_FS_RES_OK || rn != sizeof(header)) {
+        if(res != LV_FS_RES_OK) {
             header.w = lv_obj_get_width(img);
             header.h = lv_obj_get_height(img);
             header.transp = 0;
             header.cd = 0;
         }
 
-        lv_fs_close(&file);
-
         ext->w = header.w;
         ext->h = header.h;
         ext->transp = header.transp;
@@ -176,11 +187,16 @@ void lv_img_set_file(lv_obj_t * img, const char * fn)
 	}
 
 
+    /*The old image can be out of the object if it's rotated*/
+    lv_obj_invalidate(img);
+
     if(lv_img_get_auto_size(img) != false) {
-        lv_obj_set_size(img, ext->w, ext->h);
+        lv_point_t size;
+        lv_img_get_tile_size(img, &size);
+        lv_obj_set_size(img, size.x, size.y);
     }
 
-    lv_obj_invalidate(img);
+    lv_obj_refresh_ext_size(img);
 }
 
 /**
@@ -216,6 +232,55 @@ void lv_img_set_upscale(lv_obj_t * img, bool upscale_en)
     lv_img_set_file(img, ext->fn);
 }
 
+/**
+ * Set the zoom of an image. It's scaled around its center.
+ * If auto size is enabled the object size will be same as the scaled picture size.
+ * @param img pointer to an image
+ * @param zoom scale in 1/LV_IMG_ZOOM_NONE units (e.g. 128: half size, 512: double size)
+ */
+void lv_img_set_zoom(lv_obj_t * img, uint16_t zoom)
+{
+    lv_img_ext_t * ext = lv_obj_get_ext_attr(img);
+
+    if(zoom == 0) zoom = 1;
+    if(ext->zoom == zoom) return;
+    ext->zoom = zoom;
+
+    /*Refresh the image with the new size*/
+    lv_img_set_file(img, ext->fn);
+}
+
+/**
+ * Set the rotation of an image. It's rotated around its center and it can be drawn out of the object.
+ * @param img pointer to an image
+ * @param angle clockwise rotation in degrees
+ */
+void lv_img_set_angle(lv_obj_t * img, int16_t angle)
+{
+    lv_img_ext_t * ext = lv_obj_get_ext_attr(img);
+
+    angle = angle % 360;
+    if(angle < 0) angle += 360;
+    if(ext->angle == angle) return;
+
+    lv_obj_invalidate(img);     /*The area of the old angle*/
+    ext->angle = angle;
+    lv_obj_refresh_ext_size(img);
+}
+
+/**
+ * Enable the bilinear filtering of the zoomed or rotated images
+ * @param img pointer to an image
+ * @param en true: smooth (bilinear filtering), false: faster (nearest pixel)
+ */
+void lv_img_set_antialias(lv_obj_t * img, bool en)
+{
+    lv_img_ext_t * ext = lv_obj_get_ext_attr(img);
+
+    ext->antialias = (en == false ? 0 : 1);
+    lv_obj_invalidate(img);
+}
+
 /*=====================
  * Getter functions 
  *====================*/
@@ -258,6 +323,42 @@ bool lv_img_get_upscale(lv_obj_t * img)
     return ext->upscale == 0 ? false : true;
 }
 
+/**
+ * Get the zoom of an image
+ * @param img pointer to an image
+ * @return scale in 1/LV_IMG_ZOOM_NONE units
+ */
+uint16_t lv_img_get_zoom(lv_obj_t * img)
+{
+    lv_img_ext_t * ext = lv_obj_get_ext_attr(img);
+
+    return ext->zoom;
+}
+
+/**
+ * Get the rotation of an image
+ * @param img pointer to an image
+ * @return clockwise rotation in degrees
+ */
+int16_t lv_img_get_angle(lv_obj_t * img)
+{
+    lv_img_ext_t * ext = lv_obj_get_ext_attr(img);
+
+    return ext->angle;
+}
+
+/**
+ * Get the bilinear filtering enable attribute
+ * @param img pointer to an image
+ * @return true: bilinear filtering is enabled, false: nearest pixel
+ */
+bool lv_img_get_antialias(lv_obj_t * img)
+{
+    lv_img_ext_t * ext = lv_obj_get_ext_attr(img);
+
+    return ext->antialias == 0 ? false : true;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -279,7 +380,7 @@ static bool lv_img_design(lv_obj_t * img, const lv_area_t * mask, lv_design_mode
 
     if(mode == LV_DESIGN_COVER_CHK) {
         bool cover = false;
-        if(ext->transp == 0) cover = lv_area_is_in(mask, &img->coords);
+        if(ext->transp == 0 && lv_img_is_transformed(img) == false) cover = lv_area_is_in(mask, &img->coords);
         return cover;
 
     } else if(mode == LV_DESIGN_DRAW_MAIN) {
@@ -290,17 +391,34 @@ static bool lv_img_design(lv_obj_t * img, const lv_area_t * mask, lv_design_mode
 
 		lv_obj_get_coords(img, &cords);
 
+		/*The zoomed images are repeated in their zoomed size*/
+		lv_point_t tile;
+		lv_img_get_tile_size(img, &tile);
+		bool trans = lv_img_is_transformed(img);
+		lv_point_t pivot = {ext->w / 2, ext->h / 2};
+
 		lv_area_t cords_tmp;
 		cords_tmp.y1 = cords.y1;
-		cords_tmp.y2 = cords.y1 + ext->h - 1;
+		cords_tmp.y2 = cords.y1 + tile.y - 1;
 
-		for(; cords_tmp.y1 < cords.y2; cords_tmp.y1 += ext->h, cords_tmp.y2 += ext->h) {
+		for(; cords_tmp.y1 < cords.y2; cords_tmp.y1 += tile.y, cords_tmp.y2 += tile.y) {
 			cords_tmp.x1 = cords.x1;
-			cords_tmp.x2 = cords.x1 + ext->w - 1;
-			for(; cords_tmp.x1 < cords.x2; cords_tmp.x1 += ext->w, cords_tmp.x2 += ext->w) {
-			    if(sym == false) lv_draw_img(&cords_tmp, mask, style, ext->fn);
-			    else lv_draw_label(&cords_tmp, mask, style, ext->fn, LV_TXT_FLAG_NONE, NULL);
-
+			cords_tmp.x2 = cords.x1 + tile.x - 1;
+			for(; cords_tmp.x1 < cords.x2; cords_tmp.x1 += tile.x, cords_tmp.x2 += tile.x) {
+			    if(sym != false) {
+			        lv_draw_label(&cords_tmp, mask, style, ext->fn, LV_TXT_FLAG_NONE, NULL);
+			    } else if(trans == false) {
+			        lv_draw_img(&cords_tmp, mask, style, ext->fn);
+			    } else {
+			        /*The original size image with the same center as the tile*/
+			        lv_area_t img_area;
+			        img_area.x1 = cords_tmp.x1 + tile.x / 2 - pivot.x;
+			        img_area.y1 = cords_tmp.y1 + tile.y / 2 - pivot.y;
+			        img_area.x2 = img_area.x1 + ext->w - 1;
+			        img_area.y2 = img_area.y1 + ext->h - 1;
+			        lv_draw_img_transformed(&img_area, mask, style, ext->fn, ext->zoom,
+			                                (int32_t)ext->angle << TRIGO_ANGLE_SHIFT, &pivot, ext->antialias);
+			    }
 			}
 		}
     }
@@ -334,11 +452,55 @@ static lv_res_t lv_img_signal(lv_obj_t * img, lv_signal_t sign, void * param)
             lv_img_set_file(img, ext->fn);
         }
     }
+    else if(sign == LV_SIGNAL_REFR_EXT_SIZE) {
+        if(lv_img_is_transformed(img) != false) {
+            /*Bounding box of the rotated tile (+1 for rounding and the faded edges)*/
+            lv_point_t tile;
+            lv_img_get_tile_size(img, &tile);
+            int32_t s = LV_MATH_ABS(lv_trigo_sin(ext->angle));
+            int32_t c = LV_MATH_ABS(lv_trigo_sin(ext->angle + 90));
+            int32_t rot_w = (tile.x * c + tile.y * s) / TRIGO_SIN_MAX;
+            int32_t rot_h = (tile.x * s + tile.y * c) / TRIGO_SIN_MAX;
+            lv_coord_t ext_size = (LV_MATH_MAX(rot_w - tile.x, rot_h - tile.y) + 1) / 2 + 1;
+            if(ext_size > img->ext_size) img->ext_size = ext_size;
+        }
+    }
 
     return res;
 }
 
 
+/**
+ * Tell whether an image is zoomed or rotated
+ * @param img pointer to an image
+ * @return true: the image is drawn with transformation
+ */
+static bool lv_img_is_transformed(lv_obj_t * img)
+{
+    lv_img_ext_t * ext = lv_obj_get_ext_attr(img);
+
+    if(lv_img_is_symbol(ext->fn) != false) return false;    /*Symbols are not transformed*/
+
+    return ext->zoom != LV_IMG_ZOOM_NONE || ext->angle != 0 ? true : false;
+}
+
+/**
+ * Get the size in which an image is repeated on the object (the zoomed size)
+ * @param img pointer to an image
+ * @param size store the size here
+ */
+static void lv_img_get_tile_size(lv_obj_t * img, lv_point_t * size)
+{
+    lv_img_ext_t * ext = lv_obj_get_ext_attr(img);
+
+    size->x = ext->w;
+    size->y = ext->h;
+    if(lv_img_is_symbol(ext->fn) == false && ext->zoom != LV_IMG_ZOOM_NONE) {
+        size->x = LV_MATH_MAX(((int32_t)ext->w * ext->zoom) / LV_IMG_ZOOM_NONE, 1);
+        size->y = LV_MATH_MAX(((int32_t)ext->h * ext->zoom) / LV_IMG_ZOOM_NONE, 1);
+    }
+}
+
 /**
  * From the settings in lv_conf.h and the file name
  * tells it a filename or a symbol text.
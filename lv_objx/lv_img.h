@@ -36,9 +36,12 @@ typedef struct
     char* fn;                   /*Image file name. E.g. "U:/my_image"*/
     lv_coord_t w;                   /*Width of the image (doubled when upscaled) (Handled by the library)*/
     lv_coord_t h;                   /*Height of the image (doubled when upscaled) (Handled by the library)*/
+    uint16_t zoom;              /*Scale in 1/LV_IMG_ZOOM_NONE units (around the center of the image)*/
+    int16_t angle;              /*Clockwise rotation in degrees (around the center of the image)*/
     uint8_t auto_size :1;       /*1: automatically set the object size to the image size*/
     uint8_t upscale   :1;       /*1: upscale to double size with antialaissing*/
     uint8_t transp    :1;       /*Transp. bit in the image header (Handled by the library)*/
+    uint8_t antialias :1;       /*1: bilinear filtering of the zoomed or rotated image, 0: nearest pixel*/
 }lv_img_ext_t;
 
 /**********************
@@ -88,6 +91,28 @@ void lv_img_set_auto_size(lv_obj_t * img, bool autosize_en);
  */
 void lv_img_set_upscale(lv_obj_t * img, bool en);
 
+/**
+ * Set the zoom of an image. It's scaled around its center.
+ * If auto size is enabled the object size will be same as the scaled picture size.
+ * @param img pointer to an image
+ * @param zoom scale in 1/LV_IMG_ZOOM_NONE units (e.g. 128: half size, 512: double size)
+ */
+void lv_img_set_zoom(lv_obj_t * img, uint16_t zoom);
+
+/**
+ * Set the rotation of an image. It's rotated around its center and it can be drawn out of the object.
+ * @param img pointer to an image
+ * @param angle clockwise rotation in degrees
+ */
+void lv_img_set_angle(lv_obj_t * img, int16_t angle);
+
+/**
+ * Enable the bilinear filtering of the zoomed or rotated images
+ * @param img pointer to an image
+ * @param en true: smooth (bilinear filtering), false: faster (nearest pixel)
+ */
+void lv_img_set_antialias(lv_obj_t * img, bool en);
+
 /**
  * Set the style of an image
  * @param img pointer to an image object
@@ -124,6 +149,27 @@ bool lv_img_get_auto_size(lv_obj_t * img);
  */
 bool lv_img_get_upscale(lv_obj_t * img);
 
+/**
+ * Get the zoom of an image
+ * @param img pointer to an image
+ * @return scale in 1/LV_IMG_ZOOM_NONE units
+ */
+uint16_t lv_img_get_zoom(lv_obj_t * img);
+
+/**
+ * Get the rotation of an image
+ * @param img pointer to an image
+ * @return clockwise rotation in degrees
+ */
+int16_t lv_img_get_angle(lv_obj_t * img);
+
+/**
+ * Get the bilinear filtering enable attribute
+ * @param img pointer to an image
+ * @return true: bilinear filtering is enabled, false: nearest pixel
+ */
+bool lv_img_get_antialias(lv_obj_t * img);
+
 /**
  * Get the style of an image object
  * @param img pointer to an image object
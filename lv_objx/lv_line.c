@@ -12,6 +12,7 @@
 #include "lv_line.h"
 #include "../lv_draw/lv_draw.h"
 #include "../lv_misc/lv_math.h"
+#include "../lv_misc/lv_mem.h"
 #include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
@@ -205,26 +206,23 @@ static bool lv_line_design(lv_obj_t * line, const lv_area_t * mask, lv_design_mo
 		lv_obj_get_coords(line, &area);
 		lv_coord_t x_ofs = area.x1;
 		lv_coord_t y_ofs = area.y1;
-		lv_point_t p1;
-		lv_point_t p2;
 		lv_coord_t h = lv_obj_get_height(line);
 		uint16_t i;
 
-		/*Read all pints and draw the lines*/
-		for (i = 0; i < ext->point_num - 1; i++) {
+		/*Convert the points to screen coordinates*/
+		lv_point_t * points = lv_mem_alloc(ext->point_num * sizeof(lv_point_t));
+		if(points == NULL) return false;
 
-			p1.x = ext->point_array[i].x + x_ofs;
-			p2.x = ext->point_array[i + 1].x + x_ofs;
-
-			if(ext->y_inv == 0) {
-				p1.y = ext->point_array[i].y + y_ofs;
-				p2.y = ext->point_array[i + 1].y + y_ofs;
-			} else {
-				p1.y = h - ext->point_array[i].y  + y_ofs;
-				p2.y = h - ext->point_array[i + 1].y + y_ofs;
-			}
-			lv_draw_line(&p1, &p2, mask, style);
+		for (i = 0; i < ext->point_num; i++) {
+			points[i].x = ext->point_array[i].x + x_ofs;
+			if(ext->y_inv == 0) points[i].y = ext->point_array[i].y + y_ofs;
+			else points[i].y = h - ext->point_array[i].y  + y_ofs;
 		}
+
+		/*Draw the lines as one polyline to draw the joints only once*/
+		lv_draw_polyline(points, ext->point_num, mask, style, LV_DRAW_LINE_CAP_BUTT, LV_DRAW_LINE_JOIN_MITER);
+
+		lv_mem_free(points);
     }
     return true;
 }
@@ -28,6 +28,8 @@
  **********************/
 static bool lv_lmeter_design(lv_obj_t * lmeter, const lv_area_t * mask, lv_design_mode_t mode);
 static lv_res_t lv_lmeter_signal(lv_obj_t * lmeter, lv_signal_t sign, void * param);
+static void lv_lmeter_refr_line_pts(lv_obj_t * lmeter);
+static void lv_lmeter_get_line_pts(lv_obj_t * lmeter, uint8_t id, lv_coord_t r_out, lv_coord_t r_in, lv_point_t * p_out, lv_point_t * p_in);
 
 /**********************
  *  STATIC VARIABLES
@@ -65,6 +67,9 @@ lv_obj_t * lv_lmeter_create(lv_obj_t * par, lv_obj_t * copy)
     ext->cur_value = 0;
     ext->line_cnt = 31;    /*Odd scale number looks better*/
     ext->scale_angle = 240; /*(scale_num - 1) * N looks better */
+    ext->line_pts = NULL;
+    ext->line_pts_r_out = 0;
+    ext->line_pts_r_in = 0;
 
     /*The signal and design functions are not copied so set them here*/
     lv_obj_set_signal_func(new_lmeter, lv_lmeter_signal);
@@ -149,6 +154,7 @@ void lv_lmeter_set_scale(lv_obj_t * lmeter, uint16_t angle, uint8_t line_cnt)
     ext->scale_angle = angle;
     ext->line_cnt = line_cnt;
 
+    lv_lmeter_refr_line_pts(lmeter);
     lv_obj_invalidate(lmeter);
 }
 
@@ -253,29 +259,30 @@ static bool lv_lmeter_design(lv_obj_t * lmeter, const lv_area_t * mask, lv_desig
          lv_coord_t r_in = r_out - style->body.padding.hor;
          lv_coord_t x_ofs = lv_obj_get_width(lmeter) / 2 + lmeter->coords.x1;
          lv_coord_t y_ofs = lv_obj_get_height(lmeter) / 2 + lmeter->coords.y1;
-         int16_t angle_ofs = 90 + (360 - ext->scale_angle) / 2;
          int16_t level = (int32_t)((int32_t)(ext->cur_value - ext->min_value) * ext->line_cnt) / (ext->max_value - ext->min_value);
          uint8_t i;
 
+         /*The cached points can be used if the radii are the same (e.g. not changed by a focus style)*/
+         bool cached = false;
+         if(ext->line_pts != NULL && ext->line_pts_r_out == r_out && ext->line_pts_r_in == r_in) cached = true;
+
          style_tmp.line.color = style->body.main_color;
 
          for(i = 0; i < ext->line_cnt; i++) {
-             /*Calculate the position a scale label*/
-             int16_t angle = (i * ext->scale_angle) / (ext->line_cnt - 1) + angle_ofs;
-
-             lv_coord_t y_out = (int32_t)((int32_t)lv_trigo_sin(angle) * r_out) / TRIGO_SIN_MAX;
-             lv_coord_t x_out = (int32_t)((int32_t)lv_trigo_sin(angle + 90) * r_out) / TRIGO_SIN_MAX;
-             lv_coord_t y_in = (int32_t)((int32_t)lv_trigo_sin(angle) * r_in) / TRIGO_SIN_MAX;
-             lv_coord_t x_in = (int32_t)((int32_t)lv_trigo_sin(angle + 90) * r_in) / TRIGO_SIN_MAX;
-
              lv_point_t p1;
              lv_point_t p2;
 
-             p2.x = x_in + x_ofs;
-             p2.y = y_in +  y_ofs;
+             if(cached) {
+                 p1 = ext->line_pts[2 * i];
+                 p2 = ext->line_pts[2 * i + 1];
+             } else {
+                 lv_lmeter_get_line_pts(lmeter, i, r_out, r_in, &p1, &p2);
+             }
 
-             p1.x = x_out+ x_ofs;
-             p1.y = y_out + y_ofs;
+             p1.x += x_ofs;
+             p1.y += y_ofs;
+             p2.x += x_ofs;
+             p2.y += y_ofs;
 
              if(i >= level) style_tmp.line.color = style->line.color;
              else {
@@ -309,12 +316,72 @@ static lv_res_t lv_lmeter_signal(lv_obj_t * lmeter, lv_signal_t sign, void * par
     res = ancestor_signal(lmeter, sign, param);
     if(res != LV_RES_OK) return res;
 
+    lv_lmeter_ext_t * ext = lv_obj_get_ext_attr(lmeter);
     if(sign == LV_SIGNAL_CLEANUP) {
-        /*Nothing to cleanup. (No dynamically allocated memory in 'ext')*/
+        lv_mem_free(ext->line_pts);
+        ext->line_pts = NULL;
+    }
+    else if(sign == LV_SIGNAL_STYLE_CHG) {
+        lv_lmeter_refr_line_pts(lmeter);
+    }
+    else if(sign == LV_SIGNAL_CORD_CHG) {
+        if(lv_obj_get_width(lmeter) != lv_area_get_width(param) ||
+           lv_obj_get_height(lmeter) != lv_area_get_height(param)) {
+            lv_lmeter_refr_line_pts(lmeter);
+        }
     }
 
     return res;
 }
 
+/**
+ * Calculate the end points of the lines again (after the size, the style or the scale is changed)
+ * @param lmeter pointer to a line meter object
+ */
+static void lv_lmeter_refr_line_pts(lv_obj_t * lmeter)
+{
+    lv_lmeter_ext_t * ext = lv_obj_get_ext_attr(lmeter);
+    lv_style_t * style = lv_obj_get_style(lmeter);
+
+    ext->line_pts = lv_mem_realloc(ext->line_pts, sizeof(lv_point_t) * 2 * ext->line_cnt);
+    lv_mem_assert(ext->line_pts);
+
+    ext->line_pts_r_out = lv_obj_get_width(lmeter) / 2;
+    ext->line_pts_r_in = ext->line_pts_r_out - style->body.padding.hor;
+
+    uint8_t i;
+    for(i = 0; i < ext->line_cnt; i++) {
+        lv_lmeter_get_line_pts(lmeter, i, ext->line_pts_r_out, ext->line_pts_r_in,
+                               &ext->line_pts[2 * i], &ext->line_pts[2 * i + 1]);
+    }
+}
+
+/**
+ * Calculate the end points of a line relative to the center with sub-degree precision
+ * @param lmeter pointer to a line meter object
+ * @param id index of the line
+ * @param r_out outer radius
+ * @param r_in inner radius
+ * @param p_out store the outer end point here
+ * @param p_in store the inner end point here
+ */
+static void lv_lmeter_get_line_pts(lv_obj_t * lmeter, uint8_t id, lv_coord_t r_out, lv_coord_t r_in, lv_point_t * p_out, lv_point_t * p_in)
+{
+    lv_lmeter_ext_t * ext = lv_obj_get_ext_attr(lmeter);
+    int32_t angle_ofs = ((int32_t)90 << TRIGO_ANGLE_SHIFT) + (((int32_t)(360 - ext->scale_angle) << TRIGO_ANGLE_SHIFT) / 2);
+
+    /*The lines are evenly spaced*/
+    int32_t angle = (((int32_t)id * ext->scale_angle) << TRIGO_ANGLE_SHIFT) / (ext->line_cnt - 1) + angle_ofs;
+
+    int32_t x;
+    int32_t y;
+    lv_trigo_polar(angle, r_out, &x, &y);
+    p_out->x = x;
+    p_out->y = y;
+    lv_trigo_polar(angle, r_in, &x, &y);
+    p_in->x = x;
+    p_in->y = y;
+}
+
 
 #endif
@@ -35,6 +35,9 @@ typedef struct
     int16_t cur_value;
     int16_t min_value;
     int16_t max_value;
+    lv_point_t * line_pts;       /*Outer and inner end point of the lines relative to the center (to skip the trigonometry on redraw)*/
+    lv_coord_t line_pts_r_out;   /*The radii the 'line_pts' are calculated with*/
+    lv_coord_t line_pts_r_in;
 }lv_lmeter_ext_t;
 
 /**********************
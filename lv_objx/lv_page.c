@@ -81,6 +81,7 @@ lv_obj_t * lv_page_create(lv_obj_t * par, lv_obj_t * copy)
         lv_obj_set_design_func(ext->scrl, lv_scrl_design);
 		lv_obj_set_drag(ext->scrl, true);
 		lv_obj_set_drag_throw(ext->scrl, true);
+		lv_obj_set_blit(ext->scrl, true);
 		lv_obj_set_protect(ext->scrl, LV_PROTECT_PARENT);
 		lv_cont_set_fit(ext->scrl, false, true);
 
@@ -349,24 +350,22 @@ static bool lv_page_design(lv_obj_t * page, const lv_area_t * mask, lv_design_mo
     if(mode == LV_DESIGN_COVER_CHK) {
     	return ancestor_design(page, mask, mode);
     } else if(mode == LV_DESIGN_DRAW_MAIN) {
-        /*Draw without border*/
+        /*Draw without border (in a temporal style because the page can be drawn parallel on more threads)*/
         lv_style_t *style = lv_page_get_style(page, LV_PAGE_STYLE_BG);
-        lv_coord_t border_width_tmp =  style->body.border.width;
-        style->body.border.width = 0;
-        lv_draw_rect(&page->coords, mask, style);
-        style->body.border.width = border_width_tmp;
+        lv_style_t style_tmp;
+        lv_style_copy(&style_tmp, style);
+        style_tmp.body.border.width = 0;
+        lv_draw_rect(&page->coords, mask, &style_tmp);
 
 	} else if(mode == LV_DESIGN_DRAW_POST) { /*Draw the scroll bars finally*/
 
         /*Draw only a border*/
         lv_style_t *style = lv_page_get_style(page, LV_PAGE_STYLE_BG);
-        lv_coord_t shadow_width_tmp =  style->body.shadow.width;
-        uint8_t empty_tmp =  style->body.empty;
-        style->body.shadow.width = 0;
-        style->body.empty = 1;
-        lv_draw_rect(&page->coords, mask, style);
-        style->body.shadow.width = shadow_width_tmp;
-        style->body.empty = empty_tmp;
+        lv_style_t style_tmp;
+        lv_style_copy(&style_tmp, style);
+        style_tmp.body.shadow.width = 0;
+        style_tmp.body.empty = 1;
+        lv_draw_rect(&page->coords, mask, &style_tmp);
 
 
 		lv_page_ext_t * ext = lv_obj_get_ext_attr(page);
@@ -412,27 +411,25 @@ static bool lv_scrl_design(lv_obj_t * scrl, const lv_area_t * mask, lv_design_mo
     if(mode == LV_DESIGN_COVER_CHK) {
         return ancestor_design(scrl, mask, mode);
     } else if(mode == LV_DESIGN_DRAW_MAIN) {
+        lv_style_t * style = lv_obj_get_style(scrl);
 #if USE_LV_GROUP
+        lv_style_t style_focus;     /*Local because the same object can be drawn parallel on more threads*/
         /* If the page is the active in a group and
          * the background (page) is not visible (transparent or empty)
          * then activate the style of the scrollable*/
-        lv_style_t * style_ori = lv_obj_get_style(scrl);
         lv_obj_t * page = lv_obj_get_parent(scrl);
         lv_style_t * style_page = lv_obj_get_style(page);
         lv_group_t * g = lv_obj_get_group(page);
         if(style_page->body.empty != 0 || style_page->body.opa == LV_OPA_TRANSP) { /*Background is visible?*/
             if(lv_group_get_focused(g) == page) {
-                lv_style_t * style_mod;
-                style_mod = lv_group_mod_style(g, style_ori);
-                scrl->style_p = style_mod;  /*Temporally change the style to the activated */
+                lv_group_mod_style_copy(g, style, &style_focus);
+                style = &style_focus;
             }
         }
 #endif
-        ancestor_design(scrl, mask, mode);
-
-#if USE_LV_GROUP
-        scrl->style_p = style_ori;  /*Revert the style*/
-#endif
+        /* Draw like the ancestor but with the activated style.
+         * Don't change 'style_p' because the scrollable can be drawn parallel on more threads*/
+        lv_draw_rect(&scrl->coords, mask, style);
     } else if(mode == LV_DESIGN_DRAW_POST) {
         ancestor_design(scrl, mask, mode);
     }
@@ -541,6 +538,31 @@ static lv_res_t lv_page_scrollable_signal(lv_obj_t * scrl, lv_signal_t sign, voi
     lv_page_ext_t * page_ext = lv_obj_get_ext_attr(page);
 
     if(sign == LV_SIGNAL_CORD_CHG) {
+        /* If the pixels of the scrollable were moved (see 'lv_obj_set_blit')
+         * the scrollbars were moved with them. Invalidate them on the moved position.*/
+        lv_area_t * ori = param;
+        lv_coord_t x_diff = scrl->coords.x1 - ori->x1;
+        lv_coord_t y_diff = scrl->coords.y1 - ori->y1;
+        if(lv_obj_get_blit(scrl) && (x_diff != 0 || y_diff != 0)) {
+            lv_area_t sb_area_tmp;
+            if(page_ext->sb.hor_draw) {
+                lv_area_copy(&sb_area_tmp, &page_ext->sb.hor_area);
+                sb_area_tmp.x1 += page->coords.x1 + x_diff;
+                sb_area_tmp.y1 += page->coords.y1 + y_diff;
+                sb_area_tmp.x2 += page->coords.x1 + x_diff;
+                sb_area_tmp.y2 += page->coords.y1 + y_diff;
+                lv_inv_area(&sb_area_tmp);
+            }
+            if(page_ext->sb.ver_draw) {
+                lv_area_copy(&sb_area_tmp, &page_ext->sb.ver_area);
+                sb_area_tmp.x1 += page->coords.x1 + x_diff;
+                sb_area_tmp.y1 += page->coords.y1 + y_diff;
+                sb_area_tmp.x2 += page->coords.x1 + x_diff;
+                sb_area_tmp.y2 += page->coords.y1 + y_diff;
+                lv_inv_area(&sb_area_tmp);
+            }
+        }
+
         /*Be sure the width of the scrollable is correct*/
         if(lv_cont_get_hor_fit(scrl) == false) {
             lv_obj_set_width(scrl, lv_obj_get_width(page) - 2 * page_style->body.padding.hor);
@@ -611,8 +633,8 @@ static lv_res_t lv_page_scrollable_signal(lv_obj_t * scrl, lv_signal_t sign, voi
                 lv_area_copy(&sb_area_tmp, &page_ext->sb.hor_area);
                 sb_area_tmp.x1 += page->coords.x1;
                 sb_area_tmp.y1 += page->coords.y1;
-                sb_area_tmp.x2 += page->coords.x2;
-                sb_area_tmp.y2 += page->coords.y2;
+                sb_area_tmp.x2 += page->coords.x1;
+                sb_area_tmp.y2 += page->coords.y1;
                 lv_inv_area(&sb_area_tmp);
                 page_ext->sb.hor_draw = 0;
             }
@@ -620,8 +642,8 @@ static lv_res_t lv_page_scrollable_signal(lv_obj_t * scrl, lv_signal_t sign, voi
                 lv_area_copy(&sb_area_tmp, &page_ext->sb.ver_area);
                 sb_area_tmp.x1 += page->coords.x1;
                 sb_area_tmp.y1 += page->coords.y1;
-                sb_area_tmp.x2 += page->coords.x2;
-                sb_area_tmp.y2 += page->coords.y2;
+                sb_area_tmp.x2 += page->coords.x1;
+                sb_area_tmp.y2 += page->coords.y1;
                 lv_inv_area(&sb_area_tmp);
                 page_ext->sb.ver_draw = 0;
             }
@@ -682,16 +704,16 @@ static void lv_page_sb_refresh(lv_obj_t * page)
         lv_area_copy(&sb_area_tmp, &ext->sb.hor_area);
         sb_area_tmp.x1 += page->coords.x1;
         sb_area_tmp.y1 += page->coords.y1;
-        sb_area_tmp.x2 += page->coords.x2;
-        sb_area_tmp.y2 += page->coords.y2;
+        sb_area_tmp.x2 += page->coords.x1;
+        sb_area_tmp.y2 += page->coords.y1;
         lv_inv_area(&sb_area_tmp);
     }
     if(ext->sb.ver_draw != 0)  {
         lv_area_copy(&sb_area_tmp, &ext->sb.ver_area);
         sb_area_tmp.x1 += page->coords.x1;
         sb_area_tmp.y1 += page->coords.y1;
-        sb_area_tmp.x2 += page->coords.x2;
-        sb_area_tmp.y2 += page->coords.y2;
+        sb_area_tmp.x2 += page->coords.x1;
+        sb_area_tmp.y2 += page->coords.y1;
         lv_inv_area(&sb_area_tmp);
     }
 
@@ -744,16 +766,16 @@ static void lv_page_sb_refresh(lv_obj_t * page)
         lv_area_copy(&sb_area_tmp, &ext->sb.hor_area);
         sb_area_tmp.x1 += page->coords.x1;
         sb_area_tmp.y1 += page->coords.y1;
-        sb_area_tmp.x2 += page->coords.x2;
-        sb_area_tmp.y2 += page->coords.y2;
+        sb_area_tmp.x2 += page->coords.x1;
+        sb_area_tmp.y2 += page->coords.y1;
         lv_inv_area(&sb_area_tmp);
     }
     if(ext->sb.ver_draw != 0)  {
         lv_area_copy(&sb_area_tmp, &ext->sb.ver_area);
         sb_area_tmp.x1 += page->coords.x1;
         sb_area_tmp.y1 += page->coords.y1;
-        sb_area_tmp.x2 += page->coords.x2;
-        sb_area_tmp.y2 += page->coords.y2;
+        sb_area_tmp.x2 += page->coords.x1;
+        sb_area_tmp.y2 += page->coords.y1;
         lv_inv_area(&sb_area_tmp);
     }
 }
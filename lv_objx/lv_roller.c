@@ -417,14 +417,12 @@ static void draw_bg(lv_obj_t *roller, const lv_area_t *mask)
     half_roller.y1 -= style->body.radius;
 
     if(union_ok){
-        lv_color_t main_tmp = style->body.main_color;
-        lv_color_t grad_tmp = style->body.grad_color;
-
-        style->body.main_color = grad_tmp;
-        style->body.grad_color = main_tmp;
-        lv_draw_rect(&half_roller, &half_mask, style);
-        style->body.main_color = main_tmp;
-        style->body.grad_color = grad_tmp;
+        /*Swap the colors in a temporal style because the roller can be drawn parallel on more threads*/
+        lv_style_t style_tmp;
+        lv_style_copy(&style_tmp, style);
+        style_tmp.body.main_color = style->body.grad_color;
+        style_tmp.body.grad_color = style->body.main_color;
+        lv_draw_rect(&half_roller, &half_mask, &style_tmp);
     }
 
 }
@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+"""
+Font converter for LittlevGL
+
+Render a range of letters of a TrueType/OpenType font to a C file with an 'lv_font_t' page.
+The bitmaps have 1, 2, 4 or 8 bits per pixel (see 'bpp' in 'lv_misc/lv_font.h').
+With 2, 4 or 8 bpp the letters are anti-aliased without LV_FONT_ANTIALIAS or LV_ANTIALIAS.
+
+A header with the same name is written next to the C file.
+Enable the font with its 'USE_LV_FONT_...' define in lv_conf.h and add the extra pages
+to the first one with 'lv_font_add()'.
+
+Examples:
+    python3 lv_font_conv.py DejaVuSans.ttf dejavu_20_4bpp.c --size 20 --bpp 4
+    python3 lv_font_conv.py DejaVuSans.ttf dejavu_20_4bpp_cyrillic.c --size 20 --bpp 4 --range 0x400-0x4FF
+"""
+
+import argparse
+import os
+import sys
+
+# Characters to show the coverage of the pixels in the comments (transparent ... cover)
+SHADES = ' .:-=+*#%@'
+
+
+def parse_range(text):
+    """'32-126' or '0x400-0x4FF' -> (first, last)"""
+    try:
+        first, last = (int(v, 0) for v in text.split('-'))
+    except ValueError:
+        raise argparse.ArgumentTypeError('the range has to be like 32-126 or 0x400-0x4FF')
+    if first > last:
+        raise argparse.ArgumentTypeError('the first letter is after the last one')
+    return first, last
+
+
+def render_glyph(font, letter, height, ascent):
+    """Render a letter into a cell of 'height' rows. Return (width, coverage values row by row)"""
+    from PIL import Image, ImageDraw
+
+    ch = chr(letter)
+    width = int(round(font.getlength(ch)))
+    if width == 0:
+        return 0, []
+
+    img = Image.new('L', (width, height), 0)
+    ImageDraw.Draw(img).text((0, ascent), ch, font=font, fill=255, anchor='ls')
+    return width, list(img.tobytes())
+
+
+def pack_rows(width, height, cov, bpp):
+    """Quantize the coverage and pack the pixels (the rows start in new bytes, the first pixel in the MSB).
+    Return the rows as (bytes, preview) pairs"""
+    max_v = (1 << bpp) - 1
+    rows = []
+    for y in range(height):
+        row = bytearray((width * bpp + 7) >> 3)
+        values = [(c * max_v + 127) // 255 for c in cov[y * width:(y + 1) * width]]
+        for x, v in enumerate(values):
+            bit = x * bpp
+            row[bit >> 3] |= v << (8 - bpp - (bit & 0x7))
+        rows.append((row, ''.join(SHADES[v * (len(SHADES) - 1) // max_v] for v in values)))
+    return rows
+
+
+def write_font(path, name, guard, first, last, height, bpp, glyphs):
+    """Write the C file in the format of the built-in fonts and its header"""
+    with open(path, 'w') as f:
+        f.write('#include "../../../lv_conf.h"\n')
+        f.write('#if %s\n\n' % guard)
+        f.write('#include <stdint.h>\n')
+        f.write('#include "../lv_font.h"\n\n')
+
+        f.write('/*Store the image of the letters (glyph) */\n')
+        f.write('static const uint8_t %s_bitmap[] = \n{\n' % name)
+        offsets = []
+        ofs = 0
+        for letter, width, rows in glyphs:
+            offsets.append(ofs)
+            if width == 0:
+                continue
+            f.write('    // ASCII: %d, char width: %d\n' % (letter, width))
+            for row, preview in rows:
+                f.write('    %s  // %s\n' % (' '.join('0x%02x,' % b for b in row), preview))
+                ofs += len(row)
+            f.write('\n')
+        if ofs == 0:
+            f.write('    0x00,   /*No letter has pixels*/\n')
+        f.write('};\n\n')
+
+        f.write('/*Store the start index of the glyphs in the bitmap array*/\n')
+        f.write('static const uint32_t %s_map[] = \n{\n' % name)
+        for i in range(0, len(offsets), 8):
+            f.write('    ' + ', '.join('%d' % v for v in offsets[i:i + 8]) + ', \n')
+        f.write('};\n\n')
+
+        f.write('/*Store the width (column count) of each glyph*/\n')
+        f.write('static const uint8_t %s_width[] = \n{\n' % name)
+        widths = [g[1] for g in glyphs]
+        for i in range(0, len(widths), 8):
+            f.write('    ' + ', '.join('%2d' % v for v in widths[i:i + 8]) + ', \n')
+        f.write('};\n\n')
+
+        f.write('lv_font_t lv_font_%s = \n{\n' % name)
+        f.write('    %d,        /*First letter\'s unicode */\n' % first)
+        f.write('    %d,        /*Last letter\'s unicode */\n' % last)
+        f.write('    %d,        /*Letters height (rows) */\n' % height)
+        f.write('    %s_bitmap,    /*Glyph\'s bitmap*/\n' % name)
+        f.write('    %s_map,    /*Glyph start indexes in the bitmap*/\n' % name)
+        f.write('    %s_width,    /*Glyph widths (columns)*/\n' % name)
+        f.write('    NULL,        /*No next page by default*/\n')
+        f.write('    NULL,        /*Not indexed yet*/\n')
+        f.write('    %d,        /*Bits per pixel*/\n' % bpp)
+        f.write('};\n\n')
+        f.write('#endif /*%s*/\n' % guard)
+
+    h_path = os.path.splitext(path)[0] + '.h'
+    h_guard = name.upper() + '_H'
+    with open(h_path, 'w') as f:
+        f.write('#ifndef %s\n#define %s\n\n' % (h_guard, h_guard))
+        f.write('/*Use UTF-8 encoding in the IDE*/\n\n')
+        f.write('#include "../../../lv_conf.h"\n')
+        f.write('#if %s\n\n' % guard)
+        f.write('#include <stdint.h>\n')
+        f.write('#include "../lv_font.h"\n\n')
+        f.write('extern lv_font_t lv_font_%s;\n\n' % name)
+        f.write('#endif /*%s*/\n' % guard)
+        f.write('#endif   /*%s*/\n' % h_guard)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert a font for LittlevGL')
+    parser.add_argument('input', help='TrueType or OpenType font file')
+    parser.add_argument('output', help='the result: *.c file (the *.h is written next to it)')
+    parser.add_argument('-s', '--size', type=int, required=True,
+                        help="size of the font in pixels (double it for LV_ANTIALIAS or LV_FONT_ANTIALIAS)")
+    parser.add_argument('-b', '--bpp', type=int, choices=[1, 2, 4, 8], default=4,
+                        help='bits per pixel (default: 4). 1: no anti-aliasing')
+    parser.add_argument('-r', '--range', type=parse_range, default=(32, 126),
+                        help='letters to convert, e.g. 0x400-0x4FF (default: 32-126)')
+    parser.add_argument('-n', '--name', help='name of the font (default: from the output file name)')
+    args = parser.parse_args()
+
+    try:
+        from PIL import ImageFont
+    except ImportError:
+        sys.exit('lv_font_conv: Pillow is required (pip install Pillow)')
+
+    name = args.name or os.path.splitext(os.path.basename(args.output))[0]
+    guard = 'USE_LV_FONT_' + name.upper()
+
+    try:
+        font = ImageFont.truetype(args.input, args.size)
+    except (OSError, ValueError) as e:
+        sys.exit('lv_font_conv: %s: %s' % (args.input, e))
+
+    ascent, descent = font.getmetrics()
+    height = ascent + descent
+    first, last = args.range
+
+    glyphs = []
+    size = 0
+    for letter in range(first, last + 1):
+        width, cov = render_glyph(font, letter, height, ascent)
+        if width > 255:
+            sys.exit('lv_font_conv: the letter %d is too wide (max. 255 pixels)' % letter)
+        rows = pack_rows(width, height, cov, args.bpp) if width else []
+        glyphs.append((letter, width, rows))
+        size += sum(len(r[0]) for r in rows)
+
+    write_font(args.output, name, guard, first, last, height, args.bpp, glyphs)
+    print('%s: %d letters, %d px high, %d bpp, %d bytes of bitmaps' %
+          (args.output, last - first + 1, height, args.bpp, size))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,316 @@
+#!/usr/bin/env python3
+"""
+Image converter for LittlevGL
+
+Convert an image to a file (or a C array) which starts with 'lv_img_raw_header_t'
+and stores the pixels in one of the formats of 'lv_img_format_t'.
+The layouts of the formats are described in 'lv_draw/lv_draw_img_dec.h'.
+The result is for little endian targets.
+
+The input can be any image which Pillow can open (PNG, BMP, JPG ...)
+or a raw LittlevGL image file (*.bin, e.g. to compress an existing image).
+
+Examples:
+    python3 lv_img_conv.py logo.png logo.bin --format lz
+    python3 lv_img_conv.py icon.png icon.c --format indexed4 --color-depth 16
+    python3 lv_img_conv.py shadow.png shadow.bin --format alpha
+    python3 lv_img_conv.py wallpaper.bin wallpaper_rle.bin --format rle --block-h 8
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+FORMATS = {
+    'raw': 0,
+    'indexed1': 1,
+    'indexed2': 2,
+    'indexed4': 3,
+    'indexed8': 4,
+    'rle': 5,
+    'lz': 6,
+    'alpha': 7,
+}
+
+INDEXED_BPP = {'indexed1': 1, 'indexed2': 2, 'indexed4': 4, 'indexed8': 8}
+
+# Value of the 'cd' field and size of 'lv_color_t' for the color depths
+DEPTH_CD = {8: 1, 16: 2, 24: 3}
+DEPTH_SIZE = {8: 1, 16: 2, 24: 4}
+CD_DEPTH = {1: 8, 2: 16, 3: 24}
+
+# The transparent pixels get this color (LV_COLOR_TRANSP is LV_COLOR_LIME by default)
+TRANSP_COLOR = (0x00, 0xFF, 0x00)
+
+HEADER_SIZE = 4
+RLE_MAX_RUN = 128           # Max. number of pixels in an RLE packet
+LZ_MIN_MATCH = 4            # Shortest match of the LZ format
+LZ_MAX_OFS = 0xFFFF         # Farthest match of the LZ format
+LZ_MAX_CHAIN = 32           # Number of earlier positions to try for a match (speed/ratio)
+
+
+def color_pack(rgb, depth):
+    """Convert an (r, g, b) tuple to the bytes of an 'lv_color_t'"""
+    r, g, b = rgb
+    if depth == 8:
+        return struct.pack('<B', (r >> 5) << 5 | (g >> 5) << 2 | (b >> 6))
+    if depth == 16:
+        return struct.pack('<H', (r >> 3) << 11 | (g >> 2) << 5 | (b >> 3))
+    return struct.pack('<BBBB', b, g, r, 0xFF)
+
+
+def header_pack(w, h, transp, depth, fmt):
+    """Pack the fields of 'lv_img_raw_header_t' (bit fields from the LSB)"""
+    if w >= 1 << 12 or h >= 1 << 12:
+        raise ValueError('the image is too large (max. 4095 x 4095)')
+    return struct.pack('<I', w | h << 12 | (1 if transp else 0) << 24 | DEPTH_CD[depth] << 25 | fmt << 28)
+
+
+def load_bin(path):
+    """Read a raw LittlevGL image file. Return (w, h, transp, depth, pixels as 'lv_color_t' bytes, opacities)"""
+    with open(path, 'rb') as f:
+        data = f.read()
+    if len(data) < HEADER_SIZE:
+        raise ValueError('%s: too short' % path)
+
+    hdr = struct.unpack_from('<I', data)[0]
+    w = hdr & 0xFFF
+    h = (hdr >> 12) & 0xFFF
+    transp = (hdr >> 24) & 0x1
+    cd = (hdr >> 25) & 0x7
+    fmt = hdr >> 28
+    if fmt != FORMATS['raw']:
+        raise ValueError('%s: only raw images can be converted' % path)
+    if cd not in CD_DEPTH:
+        raise ValueError('%s: unknown color depth' % path)
+
+    depth = CD_DEPTH[cd]
+    size = DEPTH_SIZE[depth]
+    if len(data) < HEADER_SIZE + w * h * size:
+        raise ValueError('%s: too short' % path)
+
+    px = [data[HEADER_SIZE + i * size:HEADER_SIZE + (i + 1) * size] for i in range(w * h)]
+
+    # Only the pixels with the transparent color are transparent
+    key = color_pack(TRANSP_COLOR, depth)
+    alpha = [0 if transp and p == key else 255 for p in px]
+    return w, h, transp, depth, px, alpha
+
+
+def load_img(path, depth, max_colors, keep_colors=False):
+    """Read an image with Pillow. Return (w, h, transp, pixels as 'lv_color_t' bytes, opacities).
+    The mostly transparent pixels get the transparent color unless 'keep_colors' is set"""
+    try:
+        from PIL import Image
+    except ImportError:
+        raise ValueError('Pillow is required to read %s (pip install Pillow)' % path)
+
+    img = Image.open(path).convert('RGBA')
+    w, h = img.size
+    alpha = list(img.getchannel('A').getdata())
+    transp = any(a < 128 for a in alpha)
+
+    rgb = img.convert('RGB')
+    if max_colors is not None:
+        # Leave a place in the palette for the transparent color
+        colors = max_colors - 1 if transp else max_colors
+        rgb = rgb.quantize(colors=max(colors, 1)).convert('RGB')
+
+    px = []
+    for a, c in zip(alpha, rgb.getdata()):
+        px.append(color_pack(TRANSP_COLOR if a < 128 and not keep_colors else c, depth))
+
+    return w, h, transp, px, alpha
+
+
+def encode_indexed(w, h, px, bpp, depth):
+    """Palette and the rows of indices"""
+    palette = sorted(set(px))
+    if len(palette) > 1 << bpp:
+        raise ValueError('the image has %d colors, more than %d' % (len(palette), 1 << bpp))
+
+    index = {c: i for i, c in enumerate(palette)}
+    empty = color_pack((0, 0, 0), depth)
+    out = bytearray(b''.join(palette) + empty * ((1 << bpp) - len(palette)))
+
+    for y in range(h):
+        row = bytearray((w * bpp + 7) >> 3)
+        for x in range(w):
+            bit = x * bpp
+            row[bit >> 3] |= index[px[y * w + x]] << (8 - bpp - (bit & 0x7))
+        out += row
+
+    return bytes(out)
+
+
+def encode_rle(px):
+    """Run length encoding of the pixels of a block"""
+    out = bytearray()
+    i = 0
+    n = len(px)
+    while i < n:
+        run = 1
+        while i + run < n and run < RLE_MAX_RUN and px[i + run] == px[i]:
+            run += 1
+
+        if run >= 2:
+            out.append(0x80 | (run - 1))
+            out += px[i]
+            i += run
+            continue
+
+        # Literals until the next run
+        start = i
+        i += 1
+        while i < n and i - start < RLE_MAX_RUN and (i + 1 >= n or px[i + 1] != px[i]):
+            i += 1
+        out.append(i - start - 1)
+        out += b''.join(px[start:i])
+
+    return bytes(out)
+
+
+def lz_len_ext(out, length):
+    """Write the rest of a length which doesn't fit into the 4 bits of the token"""
+    length -= 15
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+
+
+def lz_sequence(out, literals, match_len, match_ofs):
+    """Write a sequence: token, literals and the match (no match if 'match_len' is 0)"""
+    lit_len = len(literals)
+    ml = match_len - LZ_MIN_MATCH if match_len else 0
+    out.append(min(lit_len, 15) << 4 | min(ml, 15))
+    if lit_len >= 15:
+        lz_len_ext(out, lit_len)
+    out += literals
+    if match_len:
+        out += struct.pack('<H', match_ofs)
+        if ml >= 15:
+            lz_len_ext(out, ml)
+
+
+def encode_lz(data):
+    """LZ compression of the bytes of a block (LZ4 block format with greedy matching)"""
+    out = bytearray()
+    chains = {}             # 4 byte sequence -> its earlier positions (the last one first)
+    n = len(data)
+    lit_start = 0
+    i = 0
+    while i + LZ_MIN_MATCH <= n:
+        key = data[i:i + LZ_MIN_MATCH]
+        best_len = 0
+        best_pos = 0
+        for pos in chains.get(key, ()):
+            if i - pos > LZ_MAX_OFS:
+                break
+            length = LZ_MIN_MATCH
+            while i + length < n and data[pos + length] == data[i + length]:
+                length += 1
+            if length > best_len:
+                best_len = length
+                best_pos = pos
+
+        end = i + best_len if best_len else i + 1
+        for p in range(i, min(end, n - LZ_MIN_MATCH + 1)):
+            chain = chains.setdefault(data[p:p + LZ_MIN_MATCH], [])
+            chain.insert(0, p)
+            del chain[LZ_MAX_CHAIN:]
+
+        if best_len:
+            lz_sequence(out, data[lit_start:i], best_len, i - best_pos)
+            lit_start = end
+        i = end
+
+    # The last sequence has only literals
+    lz_sequence(out, data[lit_start:], 0, 0)
+
+    return bytes(out)
+
+
+def encode_blocks(w, h, px, block_h, encoder):
+    """Compress the rows in independent blocks and add the block table"""
+    blocks = []
+    for y in range(0, h, block_h):
+        blocks.append(encoder(px[y * w:min(y + block_h, h) * w]))
+
+    ofs = [0]
+    for b in blocks:
+        ofs.append(ofs[-1] + len(b))
+
+    return struct.pack('<I', block_h) + struct.pack('<%dI' % len(ofs), *ofs) + b''.join(blocks)
+
+
+def write_c(path, name, data):
+    """Write the image as a C array for 'lv_img_create_file()'"""
+    data += b'\0' * (-len(data) % 4)   # 32 bit words keep the alignment of 'lv_color_t'
+    words = struct.unpack('<%dI' % (len(data) // 4), data)
+
+    with open(path, 'w') as f:
+        f.write('#include <stdint.h>\n\n')
+        f.write('/*Created with lv_img_conv.py\n')
+        f.write(' * Use it with lv_img_create_file("%s", (const lv_color_int_t *) %s)*/\n' % (name, name))
+        f.write('const uint32_t %s[] = {\n' % name)
+        for i in range(0, len(words), 8):
+            f.write('    ' + ', '.join('0x%08x' % v for v in words[i:i + 8]) + ',\n')
+        f.write('};\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert an image for LittlevGL')
+    parser.add_argument('input', help='the image to convert (any image Pillow can open or a raw LittlevGL *.bin)')
+    parser.add_argument('output', help='the result: *.bin file or *.c array')
+    parser.add_argument('-f', '--format', choices=sorted(FORMATS), default='raw', help='encoding of the pixels (default: raw)')
+    parser.add_argument('-d', '--color-depth', type=int, choices=sorted(DEPTH_CD), default=16,
+                        help='LV_COLOR_DEPTH of the target (default: 16, ignored for *.bin input)')
+    parser.add_argument('-b', '--block-h', type=int, default=16,
+                        help='rows in a compressed block (default: 16). Smaller blocks use less RAM to decode')
+    parser.add_argument('-n', '--name', help='name of the C array (default: from the output file name)')
+    args = parser.parse_args()
+
+    if args.block_h < 1:
+        parser.error('--block-h has to be at least 1')
+
+    bpp = INDEXED_BPP.get(args.format)
+    try:
+        if args.input.lower().endswith('.bin'):
+            w, h, transp, depth, px, alpha = load_bin(args.input)
+        else:
+            depth = args.color_depth
+            w, h, transp, px, alpha = load_img(args.input, depth, 1 << bpp if bpp else None, args.format == 'alpha')
+
+        if args.format == 'alpha':
+            # The colors as in a raw image then the alpha plane
+            transp = any(a < 255 for a in alpha)
+            data = b''.join(px) + bytes(alpha)
+        elif bpp:
+            data = encode_indexed(w, h, px, bpp, depth)
+        elif args.format == 'rle':
+            data = encode_blocks(w, h, px, args.block_h, encode_rle)
+        elif args.format == 'lz':
+            data = encode_blocks(w, h, px, args.block_h, lambda p: encode_lz(b''.join(p)))
+        else:
+            data = b''.join(px)
+
+        data = header_pack(w, h, transp, depth, FORMATS[args.format]) + data
+    except ValueError as e:
+        sys.exit('lv_img_conv: %s' % e)
+
+    if args.output.lower().endswith('.c'):
+        name = args.name or os.path.splitext(os.path.basename(args.output))[0]
+        write_c(args.output, name, data)
+    else:
+        with open(args.output, 'wb') as f:
+            f.write(data)
+
+    raw_size = HEADER_SIZE + w * h * DEPTH_SIZE[depth]
+    print('%s: %dx%d, %d bit, %s: %d bytes (%.1f%% of raw %d bytes)' %
+          (args.output, w, h, depth, args.format, len(data), 100.0 * len(data) / raw_size, raw_size))
+
+
+if __name__ == '__main__':
+    main()